@@ -19,12 +19,86 @@
 #include "antimicrosettings.h"
 
 #include <QDebug>
+#include <QEvent>
+#include <QMutexLocker>
+#include <QtConcurrent>
 
 const bool AntiMicroSettings::defaultDisabledWinEnhanced = false;
+const int AntiMicroSettings::SYNC_DELAY_MSECS = 1000;
 
 AntiMicroSettings::AntiMicroSettings(const QString &fileName, Format format, QObject *parent)
     : QSettings(fileName, format, parent)
 {
+    syncTimer.setSingleShot(true);
+    syncTimer.setInterval(SYNC_DELAY_MSECS);
+    connect(&syncTimer, &QTimer::timeout, this, &AntiMicroSettings::startBackgroundSync);
+}
+
+AntiMicroSettings::~AntiMicroSettings()
+{
+    syncTimer.stop();
+    syncFuture.waitForFinished();
+}
+
+/**
+ * @brief Writes pending changes to disk after they settled for
+ *     SYNC_DELAY_MSECS. Every further call within that time postpones
+ *     the write. Can be called from any thread.
+ */
+void AntiMicroSettings::scheduleSync() { QMetaObject::invokeMethod(&syncTimer, "start", Qt::AutoConnection); }
+
+/**
+ * @brief Writes pending changes and reloads changes made by other
+ *     processes immediately. Must not be called while holding getLock().
+ */
+void AntiMicroSettings::flush()
+{
+    syncTimer.stop();
+    syncFuture.waitForFinished();
+
+    QMutexLocker locker(&lock);
+    sync();
+}
+
+/**
+ * @brief QSettings requests an update from the event loop after a value
+ *     changed and would write the file on the GUI thread. Route it to
+ *     the debounced background write instead.
+ */
+bool AntiMicroSettings::event(QEvent *event)
+{
+    if (event->type() == QEvent::UpdateRequest)
+    {
+        scheduleSync();
+        return true;
+    }
+
+    return QSettings::event(event);
+}
+
+void AntiMicroSettings::startBackgroundSync()
+{
+    // A slow write is still running, try again once the current changes settled.
+    if (syncFuture.isRunning())
+    {
+        syncTimer.start();
+        return;
+    }
+
+    // The write goes through a separate QSettings object on the worker. Objects
+    // on the same file share the pending changes through the per-file cache of
+    // QSettings, which guards them internally, so readers of this object never
+    // race with the write and need not take getLock() for it.
+    const QString file = fileName();
+    const Format fileFormat = format();
+
+    syncFuture = QtConcurrent::run([file, fileFormat]() {
+        QSettings writer(file, fileFormat);
+        writer.sync();
+
+        if (writer.status() != QSettings::NoError)
+            qWarning() << "Could not write settings to" << file;
+    });
 }
 
 /**
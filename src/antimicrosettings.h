@@ -21,27 +21,52 @@
 
 #include "commandlineutility.h"
 
+#include <QFuture>
 #include <QSettings>
+#include <QTimer>
 
+/**
+ * @brief Application settings shared by all threads.
+ *
+ *  Changes are kept in memory by QSettings and written in the background
+ *  once they settled for SYNC_DELAY_MSECS, so bursts of changes such as
+ *  profile switches or hotplugged devices cause a single write which
+ *  doesn't block the GUI thread. Use flush() where the file must be
+ *  up to date, e.g. on exit or when another instance changed it.
+ */
 class AntiMicroSettings : public QSettings
 {
     Q_OBJECT
 
   public:
     explicit AntiMicroSettings(const QString &fileName, Format format, QObject *parent = nullptr);
+    ~AntiMicroSettings();
 
     QVariant runtimeValue(const QString &key, const QVariant &defaultValue = QVariant()) const;
     void importFromCommandLine(CommandLineUtility &cmdutility);
     QMutex *getLock();
     QSettings &getCmdSettings();
 
+    void scheduleSync();
+    void flush();
+
     static const bool defaultDisabledWinEnhanced;
+    static const int SYNC_DELAY_MSECS;
 
     void applySettingsToLogger(CommandLineUtility &cmdutility, Logger *logger = nullptr);
 
   protected:
+    virtual bool event(QEvent *event) override;
+
     QSettings cmdSettings;
     QMutex lock;
+
+  private slots:
+    void startBackgroundSync();
+
+  private:
+    QTimer syncTimer;
+    QFuture<void> syncFuture;
 };
 
 #endif // ANTIMICROSETTINGS_H
@@ -24,6 +24,7 @@
 #include "joybuttontypes/joybutton.h"
 
 #include <QDebug>
+#include <QGuiApplication>
 #include <QMapIterator>
 #include <QThread>
 
@@ -130,11 +131,15 @@ void AppLaunchHelper::changeSpringModeScreen()
     int springScreen =
         settings->value("Mouse/SpringScreen", GlobalVariables::AntimicroSettings::defaultSpringScreen).toInt();
 
+    // No screens are known without a GUI application, keep the stored choice untouched.
+    if (QGuiApplication::screens().isEmpty())
+        return;
+
     if (springScreen >= QGuiApplication::screens().count())
     {
         springScreen = -1;
         settings->setValue("Mouse/SpringScreen", GlobalVariables::AntimicroSettings::defaultSpringScreen);
-        settings->sync();
+        settings->scheduleSync();
     }
 
     JoyButton::setSpringModeScreen(springScreen, GlobalVariables::JoyButton::springModeScreen);
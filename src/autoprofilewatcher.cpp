@@ -21,12 +21,16 @@
 #include "antimicrosettings.h"
 #include "autoprofileinfo.h"
 
-#include <QApplication>
+#include <QCoreApplication>
 #include <QDebug>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
 
+#ifndef ANTIMICROX_DAEMON
+    #include <QApplication>
+#endif
+
 #if defined(Q_OS_UNIX) && defined(WITH_X11)
     #include "x11extras.h"
 
@@ -76,7 +80,7 @@ void AutoProfileWatcher::stopTimer() { checkWindowTimer.stop(); }
 
 void AutoProfileWatcher::runAppCheck()
 {
-    qDebug() << qApp->applicationFilePath();
+    qDebug() << QCoreApplication::applicationFilePath();
 
     QString appLocation = QString();
     QString baseAppFileName = QString();
@@ -100,11 +104,13 @@ void AutoProfileWatcher::runAppCheck()
 
     qDebug() << "appLocation is " << appLocation;
 
+#ifndef ANTIMICROX_DAEMON
     // More portable check for whether antimicrox is the current application
     // with focus.
     QWidget *focusedWidget = qApp->activeWindow();
     if (focusedWidget != nullptr)
         qDebug() << "get active window of app";
+#endif
     QString nowWindow = QString();
     QString nowWindowClass = QString();
     QString nowWindowName = QString();
@@ -20,6 +20,7 @@
 
 #include "common.h"
 #include "eventhandlerfactory.h"
+#include "globalvariables.h"
 
 #include <QCommandLineParser>
 #include <QDebug>
@@ -41,6 +42,8 @@ CommandLineUtility::CommandLineUtility(QObject *parent)
     unloadProfile = false;
     startSetNumber = 0;
     listControllers = false;
+    startupProfile = false;
+    statsRequest = false;
     currentLogLevel = Logger::LOG_NONE;
 
     currentListsIndex = 0;
@@ -50,7 +53,7 @@ CommandLineUtility::CommandLineUtility(QObject *parent)
     eventGenerator = EventHandlerFactory::fallBackIdentifier();
 }
 
-void CommandLineUtility::parseArguments(const QApplication &parsed_app)
+void CommandLineUtility::parseArguments(const QCoreApplication &parsed_app)
 {
     QCommandLineParser parser;
     parser.setApplicationDescription(
@@ -102,6 +105,10 @@ void CommandLineUtility::parseArguments(const QApplication &parsed_app)
                                              "even GUID.")},
         {"next", QCoreApplication::translate("main", "Load multiple profiles for different controllers. This option is "
                                                      "meant to be used with profile-controller and profile options.")},
+        {"startup-profile",
+         QCoreApplication::translate("main", "Print time spent in each startup phase once the application is ready.")},
+        {"stats", QCoreApplication::translate("main", "Print input statistics (event rates, queue depth, dispatch time) "
+                                                      "of the running app instance and exit.")},
 
     });
 
@@ -167,6 +174,16 @@ void CommandLineUtility::parseArguments(const QApplication &parsed_app)
             listControllers = true;
         }
 
+        if (parser.isSet("startup-profile"))
+        {
+            startupProfile = true;
+        }
+
+        if (parser.isSet("stats"))
+        {
+            statsRequest = true;
+        }
+
 #if (defined(WITH_UINPUT) && defined(WITH_XTEST))
 
         if (parser.isSet("eventgen"))
@@ -330,7 +347,7 @@ void CommandLineUtility::parseArgsStartSet(const QCommandLineParser &parser)
         bool validNumber = false;
         int tempNumber = startSetText.toInt(&validNumber);
 
-        if (validNumber && (tempNumber >= 1) && (tempNumber <= 8))
+        if (validNumber && (tempNumber >= 1) && (tempNumber <= GlobalVariables::InputDevice::NUMBER_JOYSETS))
         {
             startSetNumber = tempNumber;
             ControllerOptionsInfo tempInfo = getControllerOptionsList().at(currentListsIndex);
@@ -397,6 +414,10 @@ int CommandLineUtility::getJoyStartSetNumber() { return startSetNumber - 1; }
 
 bool CommandLineUtility::shouldListControllers() { return listControllers; }
 
+bool CommandLineUtility::isStartupProfileRequested() { return startupProfile; }
+
+bool CommandLineUtility::isStatsRequested() { return statsRequest; }
+
 QString CommandLineUtility::getEventGenerator() { return eventGenerator; }
 
 Logger::LogLevel CommandLineUtility::getCurrentLogLevel() { return currentLogLevel; }
@@ -22,7 +22,7 @@
 
 class QCommandLineParser;
 
-#include <QApplication>
+#include <QCoreApplication>
 
 #include "logger.h"
 
@@ -91,7 +91,7 @@ class CommandLineUtility : public QObject
      * @param parsed_app
      * @exception std::runtime_error - in case of problems with parsing like unknown flag, wrong value etc
      */
-    void parseArguments(const QApplication &parsed_app);
+    void parseArguments(const QCoreApplication &parsed_app);
 
     bool isLaunchInTrayEnabled();
     bool isTrayHidden();
@@ -102,6 +102,8 @@ class CommandLineUtility : public QObject
     bool isShowRequested();
     bool isUnloadRequested();
     bool shouldListControllers();
+    bool isStartupProfileRequested();
+    bool isStatsRequested();
     bool hasProfileInOptions();
 
     int getControllerNumber();
@@ -126,6 +128,8 @@ class CommandLineUtility : public QObject
     bool showRequest;
     bool unloadProfile;
     bool listControllers;
+    bool startupProfile;
+    bool statsRequest;
 
     int startSetNumber;
     int controllerNumber;
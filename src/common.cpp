@@ -19,7 +19,7 @@
 
 #include "common.h"
 
-#include <QApplication>
+#include <QCoreApplication>
 #include <QDebug>
 #include <QDirIterator>
 #include <QLibraryInfo>
@@ -124,10 +124,10 @@ QStringList parseArgumentsString(QString tempString)
  */
 void reloadTranslations(QTranslator *translator, QTranslator *appTranslator, QString language)
 { // Remove application specific translation strings
-    qApp->removeTranslator(translator);
+    QCoreApplication::removeTranslator(translator);
 
     // Remove old Qt translation strings
-    qApp->removeTranslator(appTranslator);
+    QCoreApplication::removeTranslator(appTranslator);
 
 // Load new Qt translation strings
 #if defined(Q_OS_UNIX)
@@ -137,22 +137,22 @@ void reloadTranslations(QTranslator *translator, QTranslator *appTranslator, QSt
     translator->load(QString("qt_").append(language), QLibraryInfo::location(QLibraryInfo::TranslationsPath));
     #else
     translator->load(QString("qt_").append(language),
-                     QApplication::applicationDirPath().append("\\share\\qt\\translations"));
+                     QCoreApplication::applicationDirPath().append("\\share\\qt\\translations"));
     #endif
 #endif
 
-    qApp->installTranslator(appTranslator);
+    QCoreApplication::installTranslator(appTranslator);
 
 // Load application specific translation strings
 #if defined(Q_OS_UNIX)
     translator->load("antimicrox_" + language,
-                     QApplication::applicationDirPath().append("/../share/antimicrox/translations"));
+                     QCoreApplication::applicationDirPath().append("/../share/antimicrox/translations"));
 #elif defined(Q_OS_WIN)
     translator->load("antimicrox_" + language,
-                     QApplication::applicationDirPath().append("\\share\\antimicrox\\translations"));
+                     QCoreApplication::applicationDirPath().append("\\share\\antimicrox\\translations"));
 #endif
 
-    qApp->installTranslator(translator);
+    QCoreApplication::installTranslator(translator);
 }
 
 void lockInputDevices() { sdlWaitMutex.lock(); }
@@ -126,6 +126,13 @@ const QString wikiPage = QString("%1/wiki").arg(githubProjectPage);
 const QString mouseDeviceName("antimicrox Mouse Emulation");
 const QString keyboardDeviceName("antimicrox Keyboard Emulation");
 const QString springMouseDeviceName("antimicrox Abs Mouse Emulation");
+const QString gamepadDeviceName("antimicrox Gamepad Emulation");
+// Xbox 360 controller IDs, so games and mapping databases know the virtual
+// gamepad. The version tells it apart from a real controller, because SDL
+// may replace the name of known controllers.
+const int gamepadDeviceVendor = 0x045e;
+const int gamepadDeviceProduct = 0x028e;
+const int gamepadDeviceVersion = 0x414d;
 
 const int ANTIMICROX_MAJOR_VERSION = PROJECT_MAJOR_VERSION;
 const int ANTIMICROX_MINOR_VERSION = PROJECT_MINOR_VERSION;
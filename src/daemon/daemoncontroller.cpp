@@ -0,0 +1,377 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "daemoncontroller.h"
+
+#include "antimicrosettings.h"
+#include "autoprofileinfo.h"
+#include "commandlineutility.h"
+#include "common.h"
+#include "globalvariables.h"
+#include "inputdevice.h"
+#include "logger.h"
+#include "uihelpers/joytabwidgethelper.h"
+#include "xmlconfigreader.h"
+
+#include <QFileInfo>
+#include <QThread>
+
+#if defined(WITH_X11) || defined(Q_OS_WIN)
+    #include "autoprofilewatcher.h"
+#endif
+
+#if defined(WITH_X11)
+    #include "x11extras.h"
+#endif
+
+DaemonController::DaemonController(QMap<SDL_JoystickID, InputDevice *> *joysticks, CommandLineUtility *cmdutility,
+                                   AntiMicroSettings *settings, QObject *parent)
+    : QObject(parent)
+    , m_joysticks(joysticks)
+    , m_cmdutility(cmdutility)
+    , m_settings(settings)
+    , appWatcher(nullptr)
+{
+#if defined(WITH_X11) || defined(Q_OS_WIN)
+    #if defined(WITH_X11)
+    // Window matching needs a connection to the X server, there may be none on a headless machine.
+    if (X11Extras::getInstance()->hasValidDisplay())
+    #endif
+    {
+        appWatcher = new AutoProfileWatcher(settings, this);
+        connect(appWatcher, &AutoProfileWatcher::foundApplicableProfile, this, &DaemonController::autoprofileLoad);
+
+        m_settings->getLock()->lock();
+        bool autoProfilesActive = m_settings->value("AutoProfiles/AutoProfilesActive", "0").toString() == "1";
+        m_settings->getLock()->unlock();
+
+        if (autoProfilesActive)
+            appWatcher->startTimer();
+    }
+#endif
+}
+
+DaemonController::~DaemonController()
+{
+    for (JoyTabWidgetHelper *helper : helpers)
+        helper->deleteLater();
+
+    helpers.clear();
+}
+
+/**
+ * @brief Load profiles for all connected controllers. Profiles given on the
+ *   command line take precedence over the last selected ones.
+ */
+void DaemonController::applyStartupProfiles()
+{
+    for (InputDevice *device : *m_joysticks)
+    {
+        if (device == nullptr)
+            continue;
+
+        helperFor(device);
+        QString lastProfile = lastSelectedProfile(device);
+
+        if (!lastProfile.isEmpty())
+            loadProfile(device, lastProfile);
+
+        applyCommandLineOptions(device);
+    }
+}
+
+/**
+ * @brief Settings were changed by another antimicrox instance, follow its
+ *   profile selection.
+ */
+void DaemonController::reloadFromSettings()
+{
+    m_settings->flush();
+
+    for (InputDevice *device : *m_joysticks)
+    {
+        if (device == nullptr)
+            continue;
+
+        QString lastProfile = lastSelectedProfile(device);
+        QString currentProfile = loadedProfiles.value(device->getSDLJoystickID());
+
+        if (lastProfile != currentProfile)
+        {
+            if (lastProfile.isEmpty())
+                unloadProfile(device);
+            else
+                loadProfile(device, lastProfile);
+        }
+    }
+}
+
+void DaemonController::addDevice(InputDevice *device)
+{
+    if (device == nullptr)
+        return;
+
+    QString lastProfile = lastSelectedProfile(device);
+
+    if (!lastProfile.isEmpty())
+        loadProfile(device, lastProfile);
+    else
+        helperFor(device);
+}
+
+void DaemonController::removeDevice(SDL_JoystickID deviceID)
+{
+    JoyTabWidgetHelper *helper = helpers.take(deviceID);
+
+    if (helper != nullptr)
+        helper->deleteLater();
+
+    loadedProfiles.remove(deviceID);
+}
+
+void DaemonController::refreshDevices(QMap<SDL_JoystickID, InputDevice *> *joysticks)
+{
+    Q_UNUSED(joysticks)
+
+    for (JoyTabWidgetHelper *helper : helpers)
+        helper->deleteLater();
+
+    helpers.clear();
+    loadedProfiles.clear();
+
+    applyStartupProfiles();
+}
+
+void DaemonController::loadProfile(InputDevice *device, QString fileLocation)
+{
+    QFileInfo fileInfo(fileLocation);
+
+    if (!fileInfo.exists() || ((fileInfo.suffix() != "amgp") && (fileInfo.suffix() != "xml")))
+    {
+        WARN() << "Profile file " << fileLocation << " does not exist";
+        return;
+    }
+
+    JoyTabWidgetHelper *helper = helperFor(device);
+    qInfo() << "Change joystick " << device->getSDLName() << " profile to: " << fileInfo.absoluteFilePath();
+
+    if (invokeHelper(helper, "readConfigFile", fileInfo.absoluteFilePath()))
+    {
+        loadedProfiles.insert(device->getSDLJoystickID(), fileInfo.absoluteFilePath());
+        storeLastSelectedProfile(device, fileInfo.absoluteFilePath());
+    } else if (helper->hasReader())
+    {
+        PRINT_STDERR() << helper->getReader()->getErrorString() << "\n";
+    }
+}
+
+void DaemonController::unloadProfile(InputDevice *device)
+{
+    JoyTabWidgetHelper *helper = helperFor(device);
+
+    invokeHelper(helper, "reInitDevice");
+    loadedProfiles.remove(device->getSDLJoystickID());
+    storeLastSelectedProfile(device, QString());
+}
+
+/**
+ * @brief Load a profile from the recent profile list of a controller by its name.
+ */
+void DaemonController::switchProfile(InputDevice *device, QString profileName)
+{
+    m_settings->getLock()->lock();
+    m_settings->beginGroup("Controllers");
+
+    QString fileLocation = QString();
+    QString identifier = device->getStringIdentifier();
+
+    for (int configFileNum = 1; fileLocation.isEmpty(); configFileNum++)
+    {
+        QString configFile =
+            m_settings->value(QString("Controller%1ConfigFile%2").arg(identifier).arg(configFileNum), "").toString();
+
+        if (configFile.isEmpty())
+            break;
+
+        QFileInfo fileInfo(configFile);
+        QString name =
+            m_settings->value(QString("Controller%1ProfileName%2").arg(identifier).arg(configFileNum), "").toString();
+
+        if (name.isEmpty())
+            name = PadderCommon::getProfileName(fileInfo);
+
+        if (name == profileName)
+            fileLocation = configFile;
+    }
+
+    m_settings->endGroup();
+    m_settings->getLock()->unlock();
+
+    if (fileLocation.isEmpty())
+        WARN() << "No recent profile named " << profileName << " for controller " << identifier;
+    else
+        loadProfile(device, fileLocation);
+}
+
+void DaemonController::changeSet(InputDevice *device, int setIndex)
+{
+    QMetaObject::invokeMethod(device, "setActiveSetNumber", Q_ARG(int, setIndex));
+}
+
+/**
+ * @brief Simplified version of MainWindow::autoprofileLoad working on devices instead of tabs.
+ */
+void DaemonController::autoprofileLoad(AutoProfileInfo *info)
+{
+#if defined(WITH_X11) || defined(Q_OS_WIN)
+    if (info == nullptr)
+    {
+        qCritical() << QString("Auto-switching to nullptr profile!");
+        return;
+    }
+
+    qDebug() << QString("Auto-switching to profile \"%1\".").arg(info->getProfileLocation());
+
+    for (InputDevice *device : *m_joysticks)
+    {
+        if (device == nullptr)
+            continue;
+
+        bool applies = (info->getUniqueID() == device->getStringIdentifier());
+
+        if (info->getUniqueID() == "all")
+        {
+            // Controller specific associations and locked controllers are switched by a later call.
+            applies = !appWatcher->isUniqueIDLocked(device->getUniqueIDString());
+
+            QList<AutoProfileInfo *> *customs = appWatcher->getCustomDefaults();
+
+            for (AutoProfileInfo *custom : *customs)
+            {
+                if ((custom->getUniqueID() == device->getUniqueIDString()) && info->isCurrentDefault())
+                    applies = false;
+            }
+
+            delete customs;
+            customs = nullptr;
+        }
+
+        if (applies)
+        {
+            if (info->getProfileLocation().isEmpty())
+                unloadProfile(device);
+            else
+                loadProfile(device, info->getProfileLocation());
+        }
+    }
+#else
+    Q_UNUSED(info)
+#endif
+}
+
+JoyTabWidgetHelper *DaemonController::helperFor(InputDevice *device)
+{
+    SDL_JoystickID deviceID = device->getSDLJoystickID();
+    JoyTabWidgetHelper *helper = helpers.value(deviceID, nullptr);
+
+    if (helper == nullptr)
+    {
+        helper = new JoyTabWidgetHelper(device);
+        helper->moveToThread(device->thread());
+        helpers.insert(deviceID, helper);
+
+        // Slots of the "load profile" type ask the device for a new profile.
+        connect(
+            device, &InputDevice::requestProfileLoad, this,
+            [this, device](QString location) { loadProfile(device, location); }, Qt::QueuedConnection);
+    }
+
+    return helper;
+}
+
+/**
+ * @brief Run a JoyTabWidgetHelper slot in the thread of its device and wait for the result.
+ */
+bool DaemonController::invokeHelper(JoyTabWidgetHelper *helper, const char *method, const QString &fileLocation)
+{
+    bool result = true;
+    Qt::ConnectionType type =
+        (helper->thread() == QThread::currentThread()) ? Qt::DirectConnection : Qt::BlockingQueuedConnection;
+
+    if (fileLocation.isEmpty())
+        QMetaObject::invokeMethod(helper, method, type);
+    else
+        QMetaObject::invokeMethod(helper, method, type, Q_RETURN_ARG(bool, result), Q_ARG(QString, fileLocation));
+
+    return result;
+}
+
+void DaemonController::applyCommandLineOptions(InputDevice *device)
+{
+    QList<ControllerOptionsInfo> optionsList = m_cmdutility->getControllerOptionsList();
+
+    if (m_cmdutility->hasProfile())
+    {
+        ControllerOptionsInfo mainOptions;
+        mainOptions.setProfileLocation(m_cmdutility->getProfileLocation());
+        mainOptions.setControllerNumber(m_cmdutility->getControllerNumber());
+        mainOptions.setControllerID(m_cmdutility->getControllerID());
+        optionsList.prepend(mainOptions);
+    }
+
+    for (ControllerOptionsInfo &options : optionsList)
+    {
+        if (options.hasControllerNumber() && (options.getControllerNumber() != device->getRealJoyNumber()))
+            continue;
+
+        if (options.hasControllerID() && (options.getControllerID() != device->getStringIdentifier()))
+            continue;
+
+        if (options.hasProfile())
+            loadProfile(device, options.getProfileLocation());
+        else if (options.isUnloadRequested())
+            unloadProfile(device);
+
+        if (options.getStartSetNumber() > 0)
+            changeSet(device, options.getJoyStartSetNumber());
+    }
+}
+
+QString DaemonController::lastSelectedProfile(InputDevice *device)
+{
+    if (device->getStringIdentifier().isEmpty())
+        return QString();
+
+    QString lastProfile;
+    m_settings->getLock()->lock();
+    if (m_settings->value("AutoOpenLastProfile", true).toBool())
+        lastProfile =
+            m_settings->value(QString("Controllers/Controller%1LastSelected").arg(device->getStringIdentifier()), "")
+                .toString();
+    m_settings->getLock()->unlock();
+
+    return lastProfile;
+}
+
+void DaemonController::storeLastSelectedProfile(InputDevice *device, const QString &fileLocation)
+{
+    if (device->getStringIdentifier().isEmpty())
+        return;
+
+    m_settings->getLock()->lock();
+    m_settings->setValue(QString("Controllers/Controller%1LastSelected").arg(device->getStringIdentifier()), fileLocation);
+    m_settings->getLock()->unlock();
+}
@@ -0,0 +1,80 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DAEMONCONTROLLER_H
+#define DAEMONCONTROLLER_H
+
+#include <QMap>
+#include <QObject>
+
+#include <SDL2/SDL_joystick.h>
+
+class AntiMicroSettings;
+class AutoProfileInfo;
+class AutoProfileWatcher;
+class CommandLineUtility;
+class InputDevice;
+class JoyTabWidgetHelper;
+
+/**
+ * @brief Profile management of antimicrox-daemon.
+ *
+ * Takes over the parts of MainWindow and JoyTabWidget that are needed
+ * without a GUI: loading the last selected or command line profiles,
+ * reacting on hotplug, auto profiles and requests of the local socket.
+ * Selected profiles are stored in the same settings keys as the GUI uses,
+ * so both binaries can be used with one configuration.
+ */
+class DaemonController : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit DaemonController(QMap<SDL_JoystickID, InputDevice *> *joysticks, CommandLineUtility *cmdutility,
+                              AntiMicroSettings *settings, QObject *parent = nullptr);
+    ~DaemonController();
+
+  public slots:
+    void applyStartupProfiles();
+    void reloadFromSettings();
+    void addDevice(InputDevice *device);
+    void removeDevice(SDL_JoystickID deviceID);
+    void refreshDevices(QMap<SDL_JoystickID, InputDevice *> *joysticks);
+
+    void loadProfile(InputDevice *device, QString fileLocation);
+    void unloadProfile(InputDevice *device);
+    void switchProfile(InputDevice *device, QString profileName);
+    void changeSet(InputDevice *device, int setIndex);
+
+  private slots:
+    void autoprofileLoad(AutoProfileInfo *info);
+
+  private:
+    JoyTabWidgetHelper *helperFor(InputDevice *device);
+    bool invokeHelper(JoyTabWidgetHelper *helper, const char *method, const QString &fileLocation = QString());
+    void applyCommandLineOptions(InputDevice *device);
+    QString lastSelectedProfile(InputDevice *device);
+    void storeLastSelectedProfile(InputDevice *device, const QString &fileLocation);
+
+    QMap<SDL_JoystickID, InputDevice *> *m_joysticks;
+    CommandLineUtility *m_cmdutility;
+    AntiMicroSettings *m_settings;
+    AutoProfileWatcher *appWatcher;
+    QMap<SDL_JoystickID, JoyTabWidgetHelper *> helpers;
+    QMap<SDL_JoystickID, QString> loadedProfiles;
+};
+
+#endif // DAEMONCONTROLLER_H
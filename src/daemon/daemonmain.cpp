@@ -0,0 +1,323 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * Entry point of antimicrox-daemon, a headless build of antimicrox without
+ * QtWidgets. Profiles are chosen through the command line, the settings file
+ * shared with the GUI and the local socket protocol of LocalAntiMicroServer.
+ */
+
+#include "antimicrosettings.h"
+#include "antkeymapper.h"
+#include "applaunchhelper.h"
+#include "autoprofileinfo.h"
+#include "commandlineutility.h"
+#include "common.h"
+#include "daemoncontroller.h"
+#include "eventhandlerfactory.h"
+#include "inputdaemon.h"
+#include "inputdevice.h"
+#include "joybuttonslot.h"
+#include "joysensordirection.h"
+#include "joysensortype.h"
+#include "localantimicroserver.h"
+#include "logger.h"
+#include "processspawner.h"
+#include "profileindex.h"
+#include "setjoystick.h"
+#include "startupprofiler.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QLocalSocket>
+#include <QMap>
+#include <QPointer>
+#include <QTextStream>
+#include <QThread>
+#include <QTimer>
+
+#include <iostream>
+#include <stdexcept>
+
+#ifdef Q_OS_UNIX
+    #include <signal.h>
+
+    #ifdef WITH_X11
+        #include "x11extras.h"
+    #endif
+
+static void termSignalHandler(int signal)
+{
+    Q_UNUSED(signal)
+    qDebug() << "Received termination signal. Closing...";
+    QCoreApplication::exit(0);
+}
+
+static void installSignalHandlers()
+{
+    struct sigaction termaction;
+    termaction.sa_handler = &termSignalHandler;
+    sigemptyset(&termaction.sa_mask);
+    termaction.sa_flags = 0;
+
+    sigaction(SIGTERM, &termaction, nullptr);
+    sigaction(SIGINT, &termaction, nullptr);
+}
+#endif
+
+static bool initEventHandler(const QString &identifier, EventHandlerFactory *&factory, AntKeyMapper *&keyMapper)
+{
+    factory = EventHandlerFactory::getInstance(identifier);
+
+    if (!factory)
+        return false;
+
+    keyMapper = AntKeyMapper::getInstance(factory->handler()->getIdentifier());
+    bool status = factory->handler()->init();
+    factory->handler()->printPostMessages();
+
+    return status;
+}
+
+int main(int argc, char *argv[])
+{
+    StartupProfiler::start();
+    qInstallMessageHandler(Logger::loggerMessageHandler);
+
+    QCoreApplication antimicrox(argc, argv);
+    // Same name as the GUI so that both use one settings file and socket.
+    QCoreApplication::setApplicationName("antimicrox");
+    QCoreApplication::setApplicationVersion(PadderCommon::programVersion);
+
+    QTextStream outstream(stdout);
+    Logger *appLogger = Logger::createInstance(&outstream, Logger::LogLevel::LOG_DEBUG);
+
+    qRegisterMetaType<JoyButtonSlot *>();
+    qRegisterMetaType<SetJoystick *>();
+    qRegisterMetaType<InputDevice *>();
+    qRegisterMetaType<AutoProfileInfo *>();
+    qRegisterMetaType<QThread *>();
+    qRegisterMetaType<SDL_JoystickID>("SDL_JoystickID");
+    qRegisterMetaType<JoyButtonSlot::JoySlotInputAction>("JoyButtonSlot::JoySlotInputAction");
+    qRegisterMetaType<JoySensorType>();
+    qRegisterMetaType<JoySensorDirection>();
+
+#if defined(WITH_X11)
+    XInitThreads();
+#endif
+
+    AntiMicroSettings settings(PadderCommon::configFilePath(), QSettings::IniFormat);
+    CommandLineUtility cmdutility;
+
+    try
+    {
+        cmdutility.parseArguments(antimicrox);
+    } catch (const std::runtime_error &e)
+    {
+        std::cerr << e.what() << '\n';
+        std::cerr << "Closing\n";
+        return -1;
+    }
+
+    settings.importFromCommandLine(cmdutility);
+    settings.applySettingsToLogger(cmdutility, appLogger);
+    StartupProfiler::setEnabled(cmdutility.isStartupProfileRequested());
+
+    if (cmdutility.getCurrentLogLevel() == Logger::LOG_NONE && settings.contains("LogLevel"))
+        appLogger->setLogLevel(static_cast<Logger::LogLevel>(settings.value("LogLevel").toInt()));
+
+    if (cmdutility.getCurrentLogFile().isEmpty() && settings.contains("LogFile"))
+        appLogger->setCurrentLogFile(settings.value("LogFile").toString());
+
+    QDir configDir(PadderCommon::configPath());
+
+    if (!configDir.exists())
+        configDir.mkpath(PadderCommon::configPath());
+
+    // Only one instance may own the local socket. Running instances are
+    // controlled through it instead.
+    QLocalSocket socket;
+    socket.connectToServer(PadderCommon::localSocketKey);
+    socket.waitForConnected(1000);
+
+    if (cmdutility.isStatsRequested())
+    {
+        int result = LocalAntiMicroServer::printInstanceStatistics(&socket);
+        delete appLogger;
+        return result;
+    }
+
+    if (socket.state() == QLocalSocket::ConnectedState)
+    {
+        PRINT_STDERR() << "AntiMicroX is already running. Use its local socket to control it.\n";
+        socket.abort();
+        delete appLogger;
+        return EXIT_FAILURE;
+    }
+
+    PadderCommon::log_system_config();
+
+    QMap<SDL_JoystickID, InputDevice *> *joysticks = new QMap<SDL_JoystickID, InputDevice *>();
+    LocalAntiMicroServer *localServer = new LocalAntiMicroServer(joysticks, &settings);
+    localServer->startLocalServer();
+
+#ifdef Q_OS_UNIX
+    installSignalHandlers();
+#endif
+
+    if (cmdutility.shouldListControllers())
+    {
+        QPointer<InputDaemon> joypad_worker = new InputDaemon(joysticks, &settings, false);
+        AppLaunchHelper mainAppHelper(&settings, false);
+        mainAppHelper.printControllerList(joysticks);
+
+        joypad_worker->quit();
+
+        delete joysticks;
+        joysticks = nullptr;
+
+        delete localServer;
+        localServer = nullptr;
+
+        delete joypad_worker;
+        delete appLogger;
+        return 0;
+    }
+
+    EventHandlerFactory *factory = nullptr;
+    AntKeyMapper *keyMapper = nullptr;
+    bool status = initEventHandler(cmdutility.getEventGenerator(), factory, keyMapper);
+
+#if defined(WITH_UINPUT) && defined(WITH_XTEST)
+    if (!status && cmdutility.getEventGenerator() != EventHandlerFactory::fallBackIdentifier())
+    {
+        QString eventDisplayName = EventHandlerFactory::handlerDisplayName(EventHandlerFactory::fallBackIdentifier());
+        qInfo() << QObject::tr("Attempting to use fallback option %1 for event generation.").arg(eventDisplayName);
+
+        if (keyMapper != nullptr)
+        {
+            keyMapper->deleteInstance();
+            keyMapper = nullptr;
+        }
+
+        if (factory)
+            factory->deleteInstance();
+
+        status = initEventHandler(EventHandlerFactory::fallBackIdentifier(), factory, keyMapper);
+    }
+#endif
+
+    if (!status)
+    {
+        PRINT_STDERR() << QObject::tr("Failed to open event generator. Exiting.") << "\n";
+
+        delete joysticks;
+        joysticks = nullptr;
+
+        delete localServer;
+        localServer = nullptr;
+
+        if (keyMapper != nullptr)
+            keyMapper->deleteInstance();
+
+        delete appLogger;
+        return EXIT_FAILURE;
+    }
+
+    qInfo() << QObject::tr("Using %1 as the event generator.").arg(factory->handler()->getName());
+    StartupProfiler::mark("Event generator initialized");
+
+    QPointer<InputDaemon> joypad_worker = new InputDaemon(joysticks, &settings);
+    QThread *inputEventThread = new QThread();
+    inputEventThread->setObjectName("inputEventThread");
+    StartupProfiler::mark("SDL initialized and devices opened");
+
+    DaemonController controller(joysticks, &cmdutility, &settings);
+    AppLaunchHelper mainAppHelper(&settings, true);
+
+    QObject::connect(joypad_worker.data(), &InputDaemon::deviceAdded, &controller, &DaemonController::addDevice);
+    QObject::connect(joypad_worker.data(), &InputDaemon::deviceRemoved, &controller, &DaemonController::removeDevice);
+    QObject::connect(joypad_worker.data(), &InputDaemon::joysticksRefreshed, &controller,
+                     &DaemonController::refreshDevices);
+
+    QObject::connect(localServer, &LocalAntiMicroServer::loadProfileRequested, &controller,
+                     &DaemonController::loadProfile);
+    QObject::connect(localServer, &LocalAntiMicroServer::unloadProfileRequested, &controller,
+                     &DaemonController::unloadProfile);
+    QObject::connect(localServer, &LocalAntiMicroServer::switchProfileRequested, &controller,
+                     &DaemonController::switchProfile);
+    QObject::connect(localServer, &LocalAntiMicroServer::changeSetRequested, &controller, &DaemonController::changeSet);
+    QObject::connect(localServer, &LocalAntiMicroServer::clientdisconnect, &controller,
+                     &DaemonController::reloadFromSettings);
+    QObject::connect(localServer, &LocalAntiMicroServer::quitRequested, &antimicrox, &QCoreApplication::quit);
+
+    QObject::connect(&antimicrox, &QCoreApplication::aboutToQuit, localServer, &LocalAntiMicroServer::close);
+    QObject::connect(&antimicrox, &QCoreApplication::aboutToQuit, &mainAppHelper, &AppLaunchHelper::revertMouseThread);
+    QObject::connect(&antimicrox, &QCoreApplication::aboutToQuit, joypad_worker.data(), &InputDaemon::quit);
+    QObject::connect(&antimicrox, &QCoreApplication::aboutToQuit, joypad_worker.data(), &InputDaemon::deleteLater);
+
+    mainAppHelper.initRunMethods();
+
+    QTimer::singleShot(0, &controller, &DaemonController::applyStartupProfiles);
+    QTimer::singleShot(0, &controller, []() {
+        StartupProfiler::mark("Profiles loaded");
+        StartupProfiler::report();
+    });
+
+    mainAppHelper.changeMouseThread(inputEventThread);
+
+    joypad_worker->startWorker();
+
+    joypad_worker->moveToThread(inputEventThread);
+    PadderCommon::mouseHelperObj.moveToThread(inputEventThread);
+    inputEventThread->start(QThread::HighPriority);
+
+    int app_result = antimicrox.exec();
+
+    qInfo() << QObject::tr("Quitting Program");
+    settings.flush();
+
+    delete localServer;
+    localServer = nullptr;
+
+    if (!joypad_worker.isNull())
+        joypad_worker->deleteLater();
+
+    inputEventThread->quit();
+    inputEventThread->wait();
+
+    delete inputEventThread;
+    inputEventThread = nullptr;
+
+    delete joysticks;
+    joysticks = nullptr;
+
+    keyMapper->deleteInstance();
+
+#if defined(WITH_X11)
+    if (X11Extras::getInstance()->hasValidDisplay())
+        X11Extras::getInstance()->closeDisplay();
+#endif
+
+    EventHandlerFactory::getInstance()->handler()->cleanup();
+    EventHandlerFactory::getInstance()->deleteInstance();
+    ProfileIndex::deleteInstance();
+    ProcessSpawner::deleteInstance();
+
+    delete appLogger;
+    return app_result;
+}
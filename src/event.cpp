@@ -17,12 +17,9 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <QApplication>
 #include <QCursor>
 #include <QDebug>
-#include <QFileInfo>
-#include <QMessageBox>
-#include <QProcess>
+#include <QGuiApplication>
 #include <QScreen>
 #include <QStringList>
 #include <QVariant>
@@ -33,6 +30,7 @@
 #include "globalvariables.h"
 #include "joybuttontypes/joybutton.h"
 #include "logger.h"
+#include "processspawner.h"
 
 #if defined(Q_OS_UNIX)
     #if defined(WITH_X11)
@@ -71,6 +69,13 @@ void fakeAbsMouseCoordinates(double springX, double springY, int width, int heig
     int destMidWidth = 0;
     int destMidHeight = 0;
 
+    if (QGuiApplication::screens().isEmpty())
+    {
+        finalx = 0;
+        finaly = 0;
+        return;
+    }
+
     QRect deskRect = QGuiApplication::screens().at(screen)->geometry();
 
     screenWidth = deskRect.width();
@@ -96,48 +101,6 @@ void fakeAbsMouseCoordinates(double springX, double springY, int width, int heig
     finaly = (screenMidheight + (springY * destMidHeight) + deskRect.y());
 }
 
-/**
- * @brief detects executor for selected file (for .py files python, for .exe "" etc)
- */
-QString detectedScriptExt(QString file)
-{
-    QFileInfo fileinfo(file);
-    QFile inputFile(file);
-
-    QString firstLine = QString();
-
-    if (inputFile.open(QIODevice::ReadOnly))
-    {
-        QTextStream in(&inputFile);
-        firstLine = in.readLine();
-        inputFile.close();
-    } else
-        WARN() << "Could not open file: " << file;
-
-    /*
-     * shell scripts work, but I am not sure about other extensions
-     * neither start method form QProcess nor QProcess::startDetached
-     * don't work as expected
-     * need to find another way
-     */
-
-    if (firstLine.contains("bin/bash"))
-        return "/bin/sh";
-    else if (fileinfo.completeSuffix() == "py" && firstLine.contains("python3"))
-        return "python3";
-    else if (fileinfo.completeSuffix() == "py" && firstLine.contains("python"))
-        return "python";
-    else if (fileinfo.completeSuffix() == "pl" || firstLine.contains("usr/bin/perl"))
-        return "perl";
-    else if (fileinfo.completeSuffix() == "php" || firstLine.contains("/php"))
-        return "php";
-    else if (fileinfo.completeSuffix() == "rb" || firstLine.contains("ruby"))
-        return "ruby";
-
-    // when run "chmod +x file_name"
-    return "";
-}
-
 // Create the event used by the operating system.
 void sendevent(JoyButtonSlot *slot, bool pressed)
 {
@@ -149,50 +112,29 @@ void sendevent(JoyButtonSlot *slot, bool pressed)
     } else if (device == JoyButtonSlot::JoyMouseButton)
     {
         EventHandlerFactory::getInstance()->handler()->sendMouseButtonEvent(slot, pressed);
+    } else if (device == JoyButtonSlot::JoyGamepadButton)
+    {
+        EventHandlerFactory::getInstance()->handler()->sendGamepadButtonEvent(slot->getSlotCode(), pressed);
     } else if ((device == JoyButtonSlot::JoyTextEntry) && pressed && !slot->getTextData().isEmpty())
     {
-        EventHandlerFactory::getInstance()->handler()->sendTextEntryEvent(slot->getTextData());
+        EventHandlerFactory::getInstance()->handler()->sendPlayerTextEntryEvent(JoyButton::slotInputDevice(slot),
+                                                                                slot->getTextData());
     } else if ((device == JoyButtonSlot::JoyExecute) && pressed && !slot->getTextData().isEmpty())
     {
-        QStringList argumentsTempList = {};
-        QString argumentsString = slot->getExtraData().toString();
-        if (slot->getExtraData().canConvert<QString>())
-        {
-            argumentsTempList = PadderCommon::parseArgumentsString(argumentsString);
-        }
-
-        qint64 pid = 0;
-        QString process_executor = detectedScriptExt(slot->getTextData());
-        if (process_executor.isEmpty())
-        {
-            process_executor = slot->getTextData();
-        } else
-        {
-            argumentsTempList.prepend(slot->getTextData());
-        }
-#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
-        QProcess process;
-        process.setProgram(process_executor);
-        process.setArguments(argumentsTempList);
-
-        process.setWorkingDirectory(QFileInfo(slot->getTextData()).absoluteDir().path());
-
-        bool success = process.startDetached(&pid);
-#else
-        bool success = QProcess::startDetached(process_executor, argumentsTempList,
-                                               QFileInfo(slot->getTextData()).absoluteDir().path(), &pid);
-#endif
-        if (success)
-            qInfo() << "Command: " << slot->getTextData() << " " << argumentsString
-                    << " executed successfully with pid: " << pid;
-        else
-            qWarning() << "Command " << slot->getTextData() << " " << argumentsString << " cannot be executed, pid: " << pid;
+        QString arguments = slot->getExtraData().canConvert<QString>() ? slot->getExtraData().toString() : QString();
+        ProcessSpawner::getInstance()->execute(slot->getTextData(), arguments);
     }
 }
 
 // Create the relative mouse event used by the operating system.
 void sendevent(int code1, int code2) { EventHandlerFactory::getInstance()->handler()->sendMouseEvent(code1, code2); }
 
+// Create the relative mouse event of a controller's own mouse.
+void sendevent(InputDevice *device, int code1, int code2)
+{
+    EventHandlerFactory::getInstance()->handler()->sendPlayerMouseEvent(device, code1, code2);
+}
+
 // TODO: Re-implement spring event generation to simplify the process
 // and reduce overhead. Refactor old function to only be used when an absmouse
 // position must be faked.
@@ -204,6 +146,10 @@ void sendSpringEventRefactor(PadderCommon::springModeInfo *fullSpring, PadderCom
     Q_UNUSED(mousePosY)
     PadderCommon::mouseHelperObj.mouseTimer.stop();
 
+    // Without a GUI application (antimicrox-daemon) there is no screen geometry to map onto.
+    if (QGuiApplication::screens().isEmpty())
+        return;
+
     if (fullSpring != nullptr)
     {
         int xmovecoor = 0;
@@ -289,6 +235,10 @@ void sendSpringEvent(PadderCommon::springModeInfo *fullSpring, PadderCommon::spr
 {
     PadderCommon::mouseHelperObj.mouseTimer.stop();
 
+    // Without a GUI application (antimicrox-daemon) there is no screen geometry to map onto.
+    if (QGuiApplication::screens().isEmpty())
+        return;
+
     if (((fullSpring->displacementX >= -2.0) && (fullSpring->displacementX <= 1.0) && (fullSpring->displacementY >= -2.0) &&
          (fullSpring->displacementY <= 1.0)) ||
         (relativeSpring && ((relativeSpring->displacementX >= -2.0) && (relativeSpring->displacementX <= 1.0) &&
@@ -322,7 +272,7 @@ void sendSpringEvent(PadderCommon::springModeInfo *fullSpring, PadderCommon::spr
         height = deskRect.height();
 
         QPoint currentPoint;
-        if (QApplication::platformName() == QStringLiteral("xcb"))
+        if (QGuiApplication::platformName() == QStringLiteral("xcb"))
         {
 #if defined(WITH_X11)
             currentPoint = X11Extras::getInstance()->getPos();
@@ -602,8 +552,7 @@ int X11KeySymToKeycode(QString key)
     #ifdef WITH_XTEST
         if (handler->getIdentifier() == "xtest")
         {
-            Display *display = X11Extras::getInstance()->display();
-            tempcode = XKeysymToKeycode(display, XStringToKeysym(key.toUtf8().data()));
+            tempcode = X11Extras::getInstance()->getKeycode(key);
         }
     #endif
 
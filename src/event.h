@@ -23,8 +23,11 @@
 #include "joybuttonslot.h"
 #include "springmousemoveinfo.h"
 
+class InputDevice;
+
 void sendevent(JoyButtonSlot *slot, bool pressed = true);
 void sendevent(int code1, int code2);
+void sendevent(InputDevice *device, int code1, int code2);
 void sendKeybEvent(JoyButtonSlot *slot, bool pressed = true);
 
 void sendSpringEvent(PadderCommon::springModeInfo *fullSpring, PadderCommon::springModeInfo *relativeSpring = 0,
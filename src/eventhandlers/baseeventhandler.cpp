@@ -21,9 +21,14 @@
 #include "joybuttonslot.h"
 
 #include <QDebug>
+#include <QMutexLocker>
 
 BaseEventHandler::BaseEventHandler(QObject *parent)
     : QObject(parent)
+    , mouseTicks(0)
+    , syscalls(0)
+    , wheelRemainderVertical(0)
+    , wheelRemainderHorizontal(0)
 {
 }
 
@@ -31,12 +36,123 @@ BaseEventHandler::~BaseEventHandler() {}
 
 QString BaseEventHandler::getErrorString() { return lastErrorString; }
 
+/**
+ * @brief Amount of mouse movements sent since the handler was created.
+ *  Used by InputStatistics.
+ */
+quint64 BaseEventHandler::getMouseTickCount() const { return mouseTicks; }
+
+/**
+ * @brief Amount of system calls issued to deliver events since the handler
+ *  was created. Used by InputStatistics.
+ */
+quint64 BaseEventHandler::getSyscallCount() const { return syscalls; }
+
+void BaseEventHandler::countMouseTick() { mouseTicks.fetchAndAddRelaxed(1); }
+
+void BaseEventHandler::countSyscalls(int count) { syscalls.fetchAndAddRelaxed(count); }
+
 /**
  * @brief Do nothing by default. Allow child classes to specify text to output
  *     to a text stream.
  */
 void BaseEventHandler::printPostMessages() {}
 
+/**
+ * @brief Do nothing by default. Child classes able to create a virtual
+ *     gamepad should override it.
+ */
+void BaseEventHandler::sendGamepadButtonEvent(int button, bool pressed)
+{
+    Q_UNUSED(button);
+    Q_UNUSED(pressed);
+}
+
+/**
+ * @brief Do nothing by default. Child classes able to create a virtual
+ *     gamepad should override it.
+ */
+void BaseEventHandler::sendGamepadAxisEvent(int axis, int value)
+{
+    Q_UNUSED(axis);
+    Q_UNUSED(value);
+}
+
+/**
+ * @brief Do nothing by default. Child classes able to create a virtual
+ *     gamepad should override it.
+ */
+void BaseEventHandler::createGamepadDevice() {}
+
+/**
+ * @brief Do nothing by default. Child classes able to create virtual devices
+ *     per controller can send the events of every controller to its own set.
+ * @param Whether devices per controller should be used
+ * @param Controllers which are already connected
+ */
+void BaseEventHandler::setSeparatePlayerDevices(bool enabled, const QList<InputDevice *> &devices)
+{
+    Q_UNUSED(enabled);
+    Q_UNUSED(devices);
+}
+
+/**
+ * @brief No devices per controller by default.
+ */
+bool BaseEventHandler::hasPlayerDevices() const { return false; }
+
+/**
+ * @brief Do nothing by default. Called when a controller is added so
+ *     virtual devices can be created for it.
+ */
+void BaseEventHandler::addPlayerDevices(InputDevice *device) { Q_UNUSED(device); }
+
+/**
+ * @brief Do nothing by default. Called before a controller is removed so
+ *     virtual devices created for it can be destroyed.
+ */
+void BaseEventHandler::removePlayerDevices(InputDevice *device) { Q_UNUSED(device); }
+
+/**
+ * @brief Move the shared cursor by default.
+ */
+void BaseEventHandler::sendPlayerMouseEvent(InputDevice *device, int xDis, int yDis)
+{
+    Q_UNUSED(device);
+
+    sendMouseEvent(xDis, yDis);
+}
+
+/**
+ * @brief Scroll the shared mouse by default.
+ */
+void BaseEventHandler::sendPlayerMouseWheelEvent(InputDevice *device, int vertical, int horizontal)
+{
+    Q_UNUSED(device);
+
+    sendMouseWheelEvent(vertical, horizontal);
+}
+
+/**
+ * @brief Type on the shared keyboard by default.
+ */
+void BaseEventHandler::sendPlayerTextEntryEvent(InputDevice *device, QString maintext)
+{
+    Q_UNUSED(device);
+
+    sendTextEntryEvent(maintext);
+}
+
+/**
+ * @brief Do nothing by default. Events are sent right away.
+ */
+void BaseEventHandler::beginOutputFrame() {}
+
+/**
+ * @brief Do nothing by default. Events are sent right away.
+ */
+void BaseEventHandler::endOutputFrame() {}
+
 /**
  * @brief Do nothing by default. Useful for child classes to define behavior.
  * @param Displacement of X coordinate
@@ -66,3 +182,87 @@ void BaseEventHandler::sendMouseSpringEvent(int xDis, int yDis, int width, int h
 }
 
 void BaseEventHandler::sendTextEntryEvent(QString maintext) { Q_UNUSED(maintext); }
+
+/**
+ * @brief Resolves the text of a text entry slot ahead of time, so typing it
+ *  later doesn't need any key mapper lookups. Called when a profile is loaded.
+ */
+void BaseEventHandler::prepareTextEntry(const QString &text)
+{
+    if (!text.isEmpty())
+        getTextEntrySequence(text);
+}
+
+/**
+ * @brief Drops all resolved texts. They are resolved again on next use,
+ *  which is needed after the keyboard mapping changed.
+ */
+void BaseEventHandler::invalidateTextEntries()
+{
+    QMutexLocker locker(&textEntryMutex);
+    textEntries.clear();
+}
+
+/**
+ * @brief Gets the key codes for the given text, resolving it on first use.
+ */
+TextEntrySequence BaseEventHandler::getTextEntrySequence(const QString &text)
+{
+    {
+        QMutexLocker locker(&textEntryMutex);
+        auto iter = textEntries.constFind(text);
+
+        if (iter != textEntries.constEnd())
+            return iter.value();
+    }
+
+    TextEntrySequence sequence = compileTextEntry(text);
+    QMutexLocker locker(&textEntryMutex);
+
+    // Slots edited at runtime add their texts as well, keep the cache bounded.
+    if (textEntries.size() >= MAX_TEXT_ENTRIES)
+        textEntries.clear();
+
+    textEntries.insert(text, sequence);
+    return sequence;
+}
+
+/**
+ * @brief Resolves every character of a text to key codes. Handlers which
+ *  use getTextEntrySequence override it, the default resolves nothing.
+ */
+TextEntrySequence BaseEventHandler::compileTextEntry(const QString &text)
+{
+    Q_UNUSED(text);
+    return TextEntrySequence();
+}
+
+/**
+ * @brief Fallback for backends without fine grained scrolling. Collects the
+ *  fractions and emits a wheel button click (4 to 7) for every full notch.
+ * @param Vertical amount in 1/WHEEL_UNITS_PER_NOTCH notches, positive scrolls up
+ * @param Horizontal amount in 1/WHEEL_UNITS_PER_NOTCH notches, positive scrolls right
+ */
+void BaseEventHandler::sendMouseWheelEvent(int vertical, int horizontal)
+{
+    wheelRemainderVertical += vertical;
+    wheelRemainderHorizontal += horizontal;
+
+    while (qAbs(wheelRemainderVertical) >= WHEEL_UNITS_PER_NOTCH)
+    {
+        bool up = wheelRemainderVertical > 0;
+        JoyButtonSlot slot(up ? 4 : 5, JoyButtonSlot::JoyMouseButton);
+        sendMouseButtonEvent(&slot, true);
+        sendMouseButtonEvent(&slot, false);
+        wheelRemainderVertical -= up ? WHEEL_UNITS_PER_NOTCH : -WHEEL_UNITS_PER_NOTCH;
+    }
+
+    while (qAbs(wheelRemainderHorizontal) >= WHEEL_UNITS_PER_NOTCH)
+    {
+        bool right = wheelRemainderHorizontal > 0;
+        JoyButtonSlot slot(right ? 7 : 6, JoyButtonSlot::JoyMouseButton);
+        sendMouseButtonEvent(&slot, true);
+        sendMouseButtonEvent(&slot, false);
+        wheelRemainderHorizontal -= right ? WHEEL_UNITS_PER_NOTCH : -WHEEL_UNITS_PER_NOTCH;
+    }
+}
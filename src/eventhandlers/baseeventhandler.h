@@ -19,10 +19,26 @@
 #ifndef BASEEVENTHANDLER_H
 #define BASEEVENTHANDLER_H
 
+#include <QAtomicInteger>
+#include <QHash>
+#include <QMutex>
+#include <QList>
 #include <QObject>
+#include <QVector>
 
+class InputDevice;
 class JoyButtonSlot;
 
+/**
+ * @brief Text of a text entry slot resolved to key codes of an event handler.
+ *  Every typed character is a stroke of its modifiers followed by the key.
+ */
+struct TextEntrySequence
+{
+    QVector<unsigned int> codes;
+    QVector<int> strokeLengths; ///< amount of codes of every stroke
+};
+
 /**
  * @brief Base class for input event handlers
  *
@@ -52,16 +68,80 @@ class BaseEventHandler : public QObject
     virtual void sendMouseAbsEvent(int xDis, int yDis, int screen);
 
     virtual void sendMouseSpringEvent(int xDis, int yDis, int width, int height);
+    /**
+     * @brief Scroll by fractions of a wheel notch. Both amounts are given in
+     *  1/WHEEL_UNITS_PER_NOTCH of a notch, positive values scroll up and right.
+     */
+    virtual void sendMouseWheelEvent(int vertical, int horizontal);
 
     virtual void sendTextEntryEvent(QString maintext);
+    void prepareTextEntry(const QString &text);
+
+    /**
+     * @brief Press or release a button of the virtual gamepad
+     * @param button SDL_GameControllerButton value
+     */
+    virtual void sendGamepadButtonEvent(int button, bool pressed);
+    /**
+     * @brief Move an axis of the virtual gamepad
+     * @param axis SDL_GameControllerAxis value
+     * @param value -32767 to 32767 for sticks, 0 to 32767 for triggers
+     */
+    virtual void sendGamepadAxisEvent(int axis, int value);
+    /**
+     * @brief Create the virtual gamepad. Called when a profile using it is loaded.
+     */
+    virtual void createGamepadDevice();
+
+    virtual void setSeparatePlayerDevices(bool enabled, const QList<InputDevice *> &devices);
+    virtual bool hasPlayerDevices() const;
+    virtual void addPlayerDevices(InputDevice *device);
+    virtual void removePlayerDevices(InputDevice *device);
+    /**
+     * @brief Variants of sendMouseEvent, sendMouseWheelEvent and
+     *  sendTextEntryEvent using the devices of a controller when the
+     *  handler has some for it, the shared ones otherwise.
+     */
+    virtual void sendPlayerMouseEvent(InputDevice *device, int xDis, int yDis);
+    virtual void sendPlayerMouseWheelEvent(InputDevice *device, int vertical, int horizontal);
+    virtual void sendPlayerTextEntryEvent(InputDevice *device, QString maintext);
+
+    /**
+     * @brief Collect the events sent until endOutputFrame and report them
+     *  to the system together. Frames may be nested.
+     */
+    virtual void beginOutputFrame();
+    virtual void endOutputFrame();
 
     virtual QString getName() = 0;
     virtual QString getIdentifier() = 0;
     virtual void printPostMessages();
     QString getErrorString();
 
+    static const int WHEEL_UNITS_PER_NOTCH = 120;
+    static const int MAX_TEXT_ENTRIES = 256;
+
+    quint64 getMouseTickCount() const;
+    quint64 getSyscallCount() const;
+
+  public slots:
+    void invalidateTextEntries();
+
   protected:
+    void countMouseTick();
+    void countSyscalls(int count = 1);
+    TextEntrySequence getTextEntrySequence(const QString &text);
+    virtual TextEntrySequence compileTextEntry(const QString &text);
+
     QString lastErrorString;
+
+  private:
+    QAtomicInteger<quint64> mouseTicks;
+    QAtomicInteger<quint64> syscalls;
+    int wheelRemainderVertical;
+    int wheelRemainderHorizontal;
+    QMutex textEntryMutex;
+    QHash<QString, TextEntrySequence> textEntries;
 };
 
 #endif // BASEEVENTHANDLER_H
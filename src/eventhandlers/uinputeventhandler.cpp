@@ -18,28 +18,70 @@
 
 #include <cmath>
 #include <fcntl.h>
+#include <iterator>
 #include <linux/input.h>
 #include <linux/uinput.h>
 #include <unistd.h>
 
 #include <QDebug>
 #include <QFileInfo>
-#include <QMessageBox>
 #include <QStringList>
 #include <QTimer>
+#include <QVector>
+
+#include <SDL2/SDL_gamecontroller.h>
+
+#ifndef ANTIMICROX_DAEMON
+    #include <QMessageBox>
+#endif
 
 #include <antkeymapper.h>
 #include <common.h>
+#include <inputdevice.h>
 #include <joybuttonslot.h>
+#include <joybuttontypes/joybutton.h>
 #include <logger.h>
 
 static const QString mouseDeviceName = PadderCommon::mouseDeviceName;
 static const QString keyboardDeviceName = PadderCommon::keyboardDeviceName;
 static const QString springMouseDeviceName = PadderCommon::springMouseDeviceName;
+static const QString gamepadDeviceName = PadderCommon::gamepadDeviceName;
+
+// Codes of the virtual gamepad follow the xpad driver so games treat it like an Xbox 360 pad.
+static const int gamepadButtonCodes[] = {
+    BTN_A,      // SDL_CONTROLLER_BUTTON_A
+    BTN_B,      // SDL_CONTROLLER_BUTTON_B
+    BTN_X,      // SDL_CONTROLLER_BUTTON_X
+    BTN_Y,      // SDL_CONTROLLER_BUTTON_Y
+    BTN_SELECT, // SDL_CONTROLLER_BUTTON_BACK
+    BTN_MODE,   // SDL_CONTROLLER_BUTTON_GUIDE
+    BTN_START,  // SDL_CONTROLLER_BUTTON_START
+    BTN_THUMBL, // SDL_CONTROLLER_BUTTON_LEFTSTICK
+    BTN_THUMBR, // SDL_CONTROLLER_BUTTON_RIGHTSTICK
+    BTN_TL,     // SDL_CONTROLLER_BUTTON_LEFTSHOULDER
+    BTN_TR      // SDL_CONTROLLER_BUTTON_RIGHTSHOULDER
+};
+
+static const int gamepadAxisCodes[] = {
+    ABS_X,  // SDL_CONTROLLER_AXIS_LEFTX
+    ABS_Y,  // SDL_CONTROLLER_AXIS_LEFTY
+    ABS_RX, // SDL_CONTROLLER_AXIS_RIGHTX
+    ABS_RY, // SDL_CONTROLLER_AXIS_RIGHTY
+    ABS_Z,  // SDL_CONTROLLER_AXIS_TRIGGERLEFT
+    ABS_RZ  // SDL_CONTROLLER_AXIS_TRIGGERRIGHT
+};
+
+static void appendInputEvent(QVector<struct input_event> &events, struct input_event &ev, int type, int code, int value)
+{
+    ev.type = type;
+    ev.code = code;
+    ev.value = value;
+    events.append(ev);
+}
 
 #ifdef WITH_X11
     #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
-        #include <QApplication>
+        #include <QGuiApplication>
     #endif
 
     #include <x11extras.h>
@@ -56,6 +98,13 @@ UInputEventHandler::UInputEventHandler(QObject *parent)
     keyboardFileHandler = 0;
     mouseFileHandler = 0;
     springMouseFileHandler = 0;
+    gamepadFileHandler = 0;
+    gamepadDeviceFailed = false;
+    gamepadDPadButtons = 0;
+    wheelHiResVertical = 0;
+    wheelHiResHorizontal = 0;
+    separatePlayerDevices = false;
+    outputFrameDepth = 0;
 }
 
 UInputEventHandler::~UInputEventHandler() { cleanupUinputEvHand(); }
@@ -93,7 +142,7 @@ bool UInputEventHandler::init()
     {
     #if (QT_VERSION >= QT_VERSION_CHECK(5, 0, 0))
 
-        if (QApplication::platformName() == QStringLiteral("xcb"))
+        if (QGuiApplication::platformName() == QStringLiteral("xcb"))
         {
     #endif
 
@@ -157,6 +206,12 @@ bool UInputEventHandler::cleanup() { return cleanupUinputEvHand(); }
 
 bool UInputEventHandler::cleanupUinputEvHand()
 {
+    for (auto iter = playerDevices.begin(); iter != playerDevices.end(); ++iter)
+        closePlayerDevices(iter.value());
+
+    playerDevices.clear();
+    outputFrameEvents.clear();
+
     if (keyboardFileHandler > 0)
     {
         closeUInputDevice(keyboardFileHandler);
@@ -175,6 +230,13 @@ bool UInputEventHandler::cleanupUinputEvHand()
         springMouseFileHandler = 0;
     }
 
+    if (gamepadFileHandler > 0)
+    {
+        closeUInputDevice(gamepadFileHandler);
+        gamepadFileHandler = 0;
+        gamepadDPadButtons = 0;
+    }
+
     return true;
 }
 
@@ -185,7 +247,9 @@ void UInputEventHandler::sendKeyboardEvent(JoyButtonSlot *slot, bool pressed)
 
     if (device == JoyButtonSlot::JoyKeyboard)
     {
-        write_uinput_event(keyboardFileHandler, EV_KEY, code, pressed ? 1 : 0);
+        PlayerDevices *player = getPlayerDevices(slot);
+        int filehandle = (player != nullptr) ? player->keyboardFileHandler : keyboardFileHandler;
+        write_uinput_event(filehandle, EV_KEY, code, pressed ? 1 : 0);
     }
 }
 
@@ -196,6 +260,9 @@ void UInputEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
 
     if (device == JoyButtonSlot::JoyMouseButton)
     {
+        PlayerDevices *player = getPlayerDevices(slot);
+        int filehandle = (player != nullptr) ? player->mouseFileHandler : mouseFileHandler;
+
         if (code <= 3)
         {
             unsigned int tempcode;
@@ -215,52 +282,63 @@ void UInputEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
             }
             }
 
-            write_uinput_event(mouseFileHandler, EV_KEY, tempcode, pressed ? 1 : 0);
+            write_uinput_event(filehandle, EV_KEY, tempcode, pressed ? 1 : 0);
         } else if (code == 4)
         {
             if (pressed)
             {
-                write_uinput_event(mouseFileHandler, EV_REL, REL_WHEEL, 1);
+                write_wheel_event(true, WHEEL_UNITS_PER_NOTCH, player);
             }
 
         } else if (code == 5)
         {
             if (pressed)
             {
-                write_uinput_event(mouseFileHandler, EV_REL, REL_WHEEL, -1);
+                write_wheel_event(true, -WHEEL_UNITS_PER_NOTCH, player);
             }
         } else if (code == 6)
         {
             if (pressed)
             {
-                write_uinput_event(mouseFileHandler, EV_REL, REL_HWHEEL, -1);
+                write_wheel_event(false, -WHEEL_UNITS_PER_NOTCH, player);
             }
         } else if (code == 7)
         {
             if (pressed)
             {
-                write_uinput_event(mouseFileHandler, EV_REL, REL_HWHEEL, 1);
+                write_wheel_event(false, WHEEL_UNITS_PER_NOTCH, player);
             }
         } else if (code == 8)
         {
-            write_uinput_event(mouseFileHandler, EV_KEY, BTN_SIDE, pressed ? 1 : 0);
+            write_uinput_event(filehandle, EV_KEY, BTN_SIDE, pressed ? 1 : 0);
         } else if (code == 9)
         {
-            write_uinput_event(mouseFileHandler, EV_KEY, BTN_EXTRA, pressed ? 1 : 0);
+            write_uinput_event(filehandle, EV_KEY, BTN_EXTRA, pressed ? 1 : 0);
         }
     }
 }
 
 void UInputEventHandler::sendMouseEvent(int xDis, int yDis)
 {
+    countMouseTick();
     write_uinput_event(mouseFileHandler, EV_REL, REL_X, xDis, false);
     write_uinput_event(mouseFileHandler, EV_REL, REL_Y, yDis);
 }
 
+void UInputEventHandler::sendMouseWheelEvent(int vertical, int horizontal)
+{
+    if (vertical != 0)
+        write_wheel_event(true, vertical);
+
+    if (horizontal != 0)
+        write_wheel_event(false, horizontal);
+}
+
 void UInputEventHandler::sendMouseAbsEvent(int xDis, int yDis, int screen)
 {
     Q_UNUSED(screen);
 
+    countMouseTick();
     write_uinput_event(springMouseFileHandler, EV_ABS, ABS_X, xDis, false);
     write_uinput_event(springMouseFileHandler, EV_ABS, ABS_Y, yDis);
 }
@@ -342,6 +420,10 @@ void UInputEventHandler::setRelMouseEvents(int filehandle)
     ioctl(filehandle, UI_SET_RELBIT, REL_Y);
     ioctl(filehandle, UI_SET_RELBIT, REL_WHEEL);
     ioctl(filehandle, UI_SET_RELBIT, REL_HWHEEL);
+#ifdef REL_WHEEL_HI_RES
+    ioctl(filehandle, UI_SET_RELBIT, REL_WHEEL_HI_RES);
+    ioctl(filehandle, UI_SET_RELBIT, REL_HWHEEL_HI_RES);
+#endif
 
     ioctl(filehandle, UI_SET_KEYBIT, BTN_LEFT);
     ioctl(filehandle, UI_SET_KEYBIT, BTN_RIGHT);
@@ -367,6 +449,22 @@ void UInputEventHandler::setSpringMouseEvents(int filehandle)
     ioctl(filehandle, UI_SET_KEYBIT, BTN_TOUCH);
 }
 
+void UInputEventHandler::setGamepadEvents(int filehandle)
+{
+    ioctl(filehandle, UI_SET_EVBIT, EV_KEY);
+    ioctl(filehandle, UI_SET_EVBIT, EV_SYN);
+    ioctl(filehandle, UI_SET_EVBIT, EV_ABS);
+
+    for (int code : gamepadButtonCodes)
+        ioctl(filehandle, UI_SET_KEYBIT, code);
+
+    for (int code : gamepadAxisCodes)
+        ioctl(filehandle, UI_SET_ABSBIT, code);
+
+    ioctl(filehandle, UI_SET_ABSBIT, ABS_HAT0X);
+    ioctl(filehandle, UI_SET_ABSBIT, ABS_HAT0Y);
+}
+
 void UInputEventHandler::populateKeyCodes(int filehandle)
 {
     for (unsigned int i = KEY_ESC; i <= KEY_MICMUTE; i++)
@@ -375,12 +473,12 @@ void UInputEventHandler::populateKeyCodes(int filehandle)
     }
 }
 
-void UInputEventHandler::createUInputKeyboardDevice(int filehandle)
+void UInputEventHandler::createUInputKeyboardDevice(int filehandle, const QString &name)
 {
     struct uinput_user_dev uidev;
 
     memset(&uidev, 0, sizeof(uidev));
-    QByteArray temp = keyboardDeviceName.toUtf8();
+    QByteArray temp = name.isEmpty() ? keyboardDeviceName.toUtf8() : name.toUtf8();
     strncpy(uidev.name, temp.constData(), UINPUT_MAX_NAME_SIZE);
     uidev.id.bustype = BUS_USB;
     uidev.id.vendor = 0x0;
@@ -391,12 +489,12 @@ void UInputEventHandler::createUInputKeyboardDevice(int filehandle)
     ioctl(filehandle, UI_DEV_CREATE);
 }
 
-void UInputEventHandler::createUInputMouseDevice(int filehandle)
+void UInputEventHandler::createUInputMouseDevice(int filehandle, const QString &name)
 {
     struct uinput_user_dev uidev;
 
     memset(&uidev, 0, sizeof(uidev));
-    QByteArray temp = mouseDeviceName.toUtf8();
+    QByteArray temp = name.isEmpty() ? mouseDeviceName.toUtf8() : name.toUtf8();
     strncpy(uidev.name, temp.constData(), UINPUT_MAX_NAME_SIZE);
     uidev.id.bustype = BUS_USB;
     uidev.id.vendor = 0x0;
@@ -431,6 +529,64 @@ void UInputEventHandler::createUInputSpringMouseDevice(int filehandle)
     ioctl(filehandle, UI_DEV_CREATE);
 }
 
+void UInputEventHandler::createUInputGamepadDevice(int filehandle)
+{
+    struct uinput_user_dev uidev;
+
+    memset(&uidev, 0, sizeof(uidev));
+    QByteArray temp = gamepadDeviceName.toUtf8();
+    strncpy(uidev.name, temp.constData(), UINPUT_MAX_NAME_SIZE);
+    uidev.id.bustype = BUS_USB;
+    uidev.id.vendor = PadderCommon::gamepadDeviceVendor;
+    uidev.id.product = PadderCommon::gamepadDeviceProduct;
+    uidev.id.version = PadderCommon::gamepadDeviceVersion;
+
+    for (int code : {ABS_X, ABS_Y, ABS_RX, ABS_RY})
+    {
+        uidev.absmin[code] = -32768;
+        uidev.absmax[code] = 32767;
+    }
+
+    for (int code : {ABS_Z, ABS_RZ})
+    {
+        uidev.absmin[code] = 0;
+        uidev.absmax[code] = 32767;
+    }
+
+    for (int code : {ABS_HAT0X, ABS_HAT0Y})
+    {
+        uidev.absmin[code] = -1;
+        uidev.absmax[code] = 1;
+    }
+
+    write(filehandle, &uidev, sizeof(uidev));
+    ioctl(filehandle, UI_DEV_CREATE);
+}
+
+/**
+ * @brief Create the virtual gamepad once a profile using it is loaded, so it
+ *     does not show up for everyone else. Games see the gamepad before the
+ *     first event is sent to it. A failure is not retried.
+ */
+void UInputEventHandler::createGamepadDevice()
+{
+    if ((gamepadFileHandler > 0) || gamepadDeviceFailed)
+        return;
+
+    int filehandle = openUInputHandle();
+
+    if (filehandle > 0)
+    {
+        setGamepadEvents(filehandle);
+        createUInputGamepadDevice(filehandle);
+        gamepadFileHandler = filehandle;
+    } else
+    {
+        qWarning() << "Could not create the virtual gamepad";
+        gamepadDeviceFailed = true;
+    }
+}
+
 void UInputEventHandler::closeUInputDevice(int filehandle)
 {
     ioctl(filehandle, UI_DEV_DESTROY);
@@ -448,7 +604,15 @@ void UInputEventHandler::write_uinput_event(int filehandle, int type, int code,
     ev.code = code;
     ev.value = value;
 
+    // Inside a frame the report is added once per device by endOutputFrame.
+    if (outputFrameDepth > 0)
+    {
+        outputFrameEvents[filehandle].append(reinterpret_cast<const char *>(&ev), sizeof(struct input_event));
+        return;
+    }
+
     write(filehandle, &ev, sizeof(struct input_event));
+    countSyscalls();
 
     if (syn)
     {
@@ -459,9 +623,245 @@ void UInputEventHandler::write_uinput_event(int filehandle, int type, int code,
         ev2.value = 0;
 
         write(filehandle, &ev2, sizeof(struct input_event));
+        countSyscalls();
+    }
+}
+
+void UInputEventHandler::write_wheel_event(bool vertical, int value, PlayerDevices *player)
+{
+    int filehandle = mouseFileHandler;
+    int *collected = vertical ? &wheelHiResVertical : &wheelHiResHorizontal;
+
+    if (player != nullptr)
+    {
+        filehandle = player->mouseFileHandler;
+        collected = vertical ? &player->wheelHiResVertical : &player->wheelHiResHorizontal;
+    }
+
+    *collected += value;
+
+    int notches = *collected / WHEEL_UNITS_PER_NOTCH;
+    *collected -= notches * WHEEL_UNITS_PER_NOTCH;
+
+#ifdef REL_WHEEL_HI_RES
+    write_uinput_event(filehandle, EV_REL, vertical ? REL_WHEEL_HI_RES : REL_HWHEEL_HI_RES, value, notches == 0);
+#endif
+
+    if (notches != 0)
+        write_uinput_event(filehandle, EV_REL, vertical ? REL_WHEEL : REL_HWHEEL, notches);
+}
+
+void UInputEventHandler::beginOutputFrame() { outputFrameDepth++; }
+
+/**
+ * @brief Writes the events collected for every device in one call,
+ *  terminated by a single SYN_REPORT.
+ */
+void UInputEventHandler::endOutputFrame()
+{
+    if ((outputFrameDepth == 0) || (--outputFrameDepth > 0))
+        return;
+
+    struct input_event syn;
+    memset(&syn, 0, sizeof(struct input_event));
+    gettimeofday(&syn.time, nullptr);
+    syn.type = EV_SYN;
+    syn.code = SYN_REPORT;
+
+    for (auto iter = outputFrameEvents.begin(); iter != outputFrameEvents.end(); ++iter)
+    {
+        QByteArray &events = iter.value();
+        events.append(reinterpret_cast<const char *>(&syn), sizeof(struct input_event));
+        write(iter.key(), events.constData(), events.size());
+        countSyscalls();
+    }
+
+    outputFrameEvents.clear();
+}
+
+void UInputEventHandler::sendGamepadButtonEvent(int button, bool pressed)
+{
+    if (gamepadFileHandler <= 0)
+        return;
+
+    if ((button >= SDL_CONTROLLER_BUTTON_DPAD_UP) && (button <= SDL_CONTROLLER_BUTTON_DPAD_RIGHT))
+    {
+        int mask = 1 << (button - SDL_CONTROLLER_BUTTON_DPAD_UP);
+        gamepadDPadButtons = pressed ? (gamepadDPadButtons | mask) : (gamepadDPadButtons & ~mask);
+
+        auto pressedDPad = [this](SDL_GameControllerButton dpadButton) {
+            return (gamepadDPadButtons & (1 << (dpadButton - SDL_CONTROLLER_BUTTON_DPAD_UP))) ? 1 : 0;
+        };
+
+        int hatX = pressedDPad(SDL_CONTROLLER_BUTTON_DPAD_RIGHT) - pressedDPad(SDL_CONTROLLER_BUTTON_DPAD_LEFT);
+        int hatY = pressedDPad(SDL_CONTROLLER_BUTTON_DPAD_DOWN) - pressedDPad(SDL_CONTROLLER_BUTTON_DPAD_UP);
+
+        write_uinput_event(gamepadFileHandler, EV_ABS, ABS_HAT0X, hatX, false);
+        write_uinput_event(gamepadFileHandler, EV_ABS, ABS_HAT0Y, hatY);
+    } else if ((button >= 0) && (button < static_cast<int>(std::size(gamepadButtonCodes))))
+    {
+        write_uinput_event(gamepadFileHandler, EV_KEY, gamepadButtonCodes[button], pressed ? 1 : 0);
+    }
+}
+
+void UInputEventHandler::sendGamepadAxisEvent(int axis, int value)
+{
+    if ((axis < 0) || (axis >= static_cast<int>(std::size(gamepadAxisCodes))) || (gamepadFileHandler <= 0))
+        return;
+
+    write_uinput_event(gamepadFileHandler, EV_ABS, gamepadAxisCodes[axis], value);
+}
+
+/**
+ * @brief Create a virtual keyboard and mouse for every controller instead of
+ *     sending the events of all of them through the shared devices. Devices
+ *     for controllers added later are created by addPlayerDevices. Existing
+ *     per controller devices are destroyed when disabled.
+ */
+void UInputEventHandler::setSeparatePlayerDevices(bool enabled, const QList<InputDevice *> &devices)
+{
+    separatePlayerDevices = enabled;
+
+    if (enabled)
+    {
+        for (InputDevice *device : devices)
+            addPlayerDevices(device);
+    } else
+    {
+        for (auto iter = playerDevices.begin(); iter != playerDevices.end(); ++iter)
+            closePlayerDevices(iter.value());
+
+        playerDevices.clear();
+    }
+}
+
+bool UInputEventHandler::hasPlayerDevices() const { return separatePlayerDevices; }
+
+/**
+ * @brief Create the virtual keyboard and mouse of a controller, named after
+ *     it. Does nothing unless devices per controller are enabled or if the
+ *     controller already has them. A failure is remembered, so the shared
+ *     devices are used for the controller without retrying.
+ */
+void UInputEventHandler::addPlayerDevices(InputDevice *device)
+{
+    if (!separatePlayerDevices || (device == nullptr) || playerDevices.contains(device))
+        return;
+
+    PlayerDevices player;
+    QString suffix = QString(" #%1 (%2)").arg(device->getRealJoyNumber()).arg(device->getSDLName());
+
+    player.keyboardFileHandler = openUInputHandle();
+    player.mouseFileHandler = openUInputHandle();
+
+    if ((player.keyboardFileHandler > 0) && (player.mouseFileHandler > 0))
+    {
+        setKeyboardEvents(player.keyboardFileHandler);
+        populateKeyCodes(player.keyboardFileHandler);
+        createUInputKeyboardDevice(player.keyboardFileHandler, keyboardDeviceName + suffix);
+
+        setRelMouseEvents(player.mouseFileHandler);
+        createUInputMouseDevice(player.mouseFileHandler, mouseDeviceName + suffix);
+    } else
+    {
+        qWarning() << QString("Could not create virtual devices for controller #%1, using the shared ones")
+                          .arg(device->getRealJoyNumber());
+
+        for (int filehandle : {player.keyboardFileHandler, player.mouseFileHandler})
+        {
+            if (filehandle > 0)
+                close(filehandle);
+        }
+
+        player = PlayerDevices();
+    }
+
+    playerDevices.insert(device, player);
+}
+
+/**
+ * @brief Destroy the virtual devices of a controller. The kernel releases
+ *     keys and buttons still held on them.
+ */
+void UInputEventHandler::removePlayerDevices(InputDevice *device)
+{
+    auto iter = playerDevices.find(device);
+
+    if (iter != playerDevices.end())
+    {
+        closePlayerDevices(iter.value());
+        playerDevices.erase(iter);
     }
 }
 
+void UInputEventHandler::sendPlayerMouseEvent(InputDevice *device, int xDis, int yDis)
+{
+    PlayerDevices *player = getPlayerDevices(device);
+    int filehandle = (player != nullptr) ? player->mouseFileHandler : mouseFileHandler;
+
+    countMouseTick();
+    write_uinput_event(filehandle, EV_REL, REL_X, xDis, false);
+    write_uinput_event(filehandle, EV_REL, REL_Y, yDis);
+}
+
+void UInputEventHandler::sendPlayerMouseWheelEvent(InputDevice *device, int vertical, int horizontal)
+{
+    PlayerDevices *player = getPlayerDevices(device);
+
+    if (vertical != 0)
+        write_wheel_event(true, vertical, player);
+
+    if (horizontal != 0)
+        write_wheel_event(false, horizontal, player);
+}
+
+void UInputEventHandler::sendPlayerTextEntryEvent(InputDevice *device, QString maintext)
+{
+    PlayerDevices *player = getPlayerDevices(device);
+    writeTextEntry((player != nullptr) ? player->keyboardFileHandler : keyboardFileHandler, maintext);
+}
+
+/**
+ * @brief Get the virtual devices created for a controller.
+ * @return Player devices or nullptr if the shared devices should be used
+ */
+UInputEventHandler::PlayerDevices *UInputEventHandler::getPlayerDevices(InputDevice *device)
+{
+    if (!separatePlayerDevices || (device == nullptr))
+        return nullptr;
+
+    auto iter = playerDevices.find(device);
+
+    if ((iter == playerDevices.end()) || (iter.value().keyboardFileHandler <= 0))
+        return nullptr;
+
+    return &iter.value();
+}
+
+/**
+ * @brief Get the virtual devices of the controller owning the button of
+ *     the passed slot.
+ * @return Player devices or nullptr if the shared devices should be used
+ */
+UInputEventHandler::PlayerDevices *UInputEventHandler::getPlayerDevices(JoyButtonSlot *slot)
+{
+    if (!separatePlayerDevices)
+        return nullptr;
+
+    return getPlayerDevices(JoyButton::slotInputDevice(slot));
+}
+
+void UInputEventHandler::closePlayerDevices(PlayerDevices &player)
+{
+    if (player.keyboardFileHandler > 0)
+        closeUInputDevice(player.keyboardFileHandler);
+
+    if (player.mouseFileHandler > 0)
+        closeUInputDevice(player.mouseFileHandler);
+
+    player = PlayerDevices();
+}
+
 QString UInputEventHandler::getName() { return QString("uinput"); }
 
 QString UInputEventHandler::getIdentifier() { return getName(); }
@@ -474,7 +874,7 @@ void UInputEventHandler::printPostMessages()
     if (!lastErrorString.isEmpty())
     {
         PRINT_STDERR() << lastErrorString;
-#if defined(Q_OS_UNIX)
+#if defined(Q_OS_UNIX) && !defined(ANTIMICROX_DAEMON)
         if (is_problem_with_opening_uinput_present)
         {
             QMessageBox msgBox;
@@ -496,89 +896,129 @@ void UInputEventHandler::printPostMessages()
     }
 }
 
-void UInputEventHandler::sendTextEntryEvent(QString maintext)
+void UInputEventHandler::sendTextEntryEvent(QString maintext) { writeTextEntry(keyboardFileHandler, maintext); }
+
+/**
+ * @brief Types the text on the passed keyboard device.
+ */
+void UInputEventHandler::writeTextEntry(int filehandle, const QString &text)
 {
-    AntKeyMapper *mapper = AntKeyMapper::getInstance();
+    const TextEntrySequence sequence = getTextEntrySequence(text);
+
+    if (sequence.codes.isEmpty())
+        return;
+
+    struct input_event ev;
+    memset(&ev, 0, sizeof(struct input_event));
+    gettimeofday(&ev.time, nullptr);
+
+    // Every stroke gets its own frames, but the whole text is written at once.
+    QVector<struct input_event> events;
+    events.reserve(2 * (sequence.codes.size() + sequence.strokeLengths.size()));
+    const unsigned int *codes = sequence.codes.constData();
+
+    for (int length : sequence.strokeLengths)
+    {
+        for (int i = 0; i < length; i++)
+            appendInputEvent(events, ev, EV_KEY, codes[i], 1);
+
+        appendInputEvent(events, ev, EV_SYN, SYN_REPORT, 0);
 
-    if ((mapper != nullptr) && mapper->getKeyMapper())
+        for (int i = length - 1; i >= 0; i--)
+            appendInputEvent(events, ev, EV_KEY, codes[i], 0);
+
+        appendInputEvent(events, ev, EV_SYN, SYN_REPORT, 0);
+        codes += length;
+    }
+
+    // Keep the order of events already collected for the device in a frame.
+    if (outputFrameDepth > 0)
     {
-        QtUInputKeyMapper *keymapper = qobject_cast<QtUInputKeyMapper *>(mapper->getKeyMapper());
+        outputFrameEvents[filehandle].append(reinterpret_cast<const char *>(events.constData()),
+                                             events.size() * sizeof(struct input_event));
+        return;
+    }
+
+    write(filehandle, events.constData(), events.size() * sizeof(struct input_event));
+    countSyscalls();
+}
+
+/**
+ * @brief Resolves every character to a uinput key code and the modifiers needed to type it.
+ */
+TextEntrySequence UInputEventHandler::compileTextEntry(const QString &text)
+{
+    TextEntrySequence sequence;
+    AntKeyMapper *mapper = AntKeyMapper::getInstance();
+
+    if ((mapper == nullptr) || !mapper->getKeyMapper())
+        return sequence;
+
+    QtUInputKeyMapper *keymapper = qobject_cast<QtUInputKeyMapper *>(mapper->getKeyMapper());
 #ifdef WITH_X11
-        QtX11KeyMapper *nativeWinKeyMapper = nullptr;
+    QtX11KeyMapper *nativeWinKeyMapper = nullptr;
 
-        if (mapper->getNativeKeyMapper())
-        {
-            nativeWinKeyMapper = qobject_cast<QtX11KeyMapper *>(mapper->getNativeKeyMapper());
-        }
+    if (mapper->getNativeKeyMapper())
+    {
+        nativeWinKeyMapper = qobject_cast<QtX11KeyMapper *>(mapper->getNativeKeyMapper());
+    }
+
+    // The X11 connection of the resolving thread is the one which needs to see the keymap change.
+    connect(X11Extras::getInstance(), &X11Extras::keymapChanged, this, &UInputEventHandler::invalidateTextEntries,
+            Qt::UniqueConnection);
 #endif
 
-        QList<unsigned int> tempList;
+    for (int i = 0; i < text.size(); i++)
+    {
+        QtUInputKeyMapper::charKeyInformation temp;
+        temp.virtualkey = 0;
+        temp.modifiers = Qt::NoModifier;
 
-        for (int i = 0; i < maintext.size(); i++)
+#ifdef WITH_X11
+        if (nativeWinKeyMapper != nullptr)
         {
-            tempList.clear();
-
-            QtUInputKeyMapper::charKeyInformation temp;
-            temp.virtualkey = 0;
-            temp.modifiers = Qt::NoModifier;
+            QtX11KeyMapper::charKeyInformation tempX11 = nativeWinKeyMapper->getCharKeyInformation(text.at(i));
+            tempX11.virtualkey = X11Extras::getInstance()->getGroup1KeySym(tempX11.virtualkey);
+            unsigned int tempQtKey = nativeWinKeyMapper->returnQtKey(tempX11.virtualkey);
 
-#ifdef WITH_X11
-            if (nativeWinKeyMapper != nullptr)
+            if (tempQtKey > 0)
             {
-                QtX11KeyMapper::charKeyInformation tempX11 = nativeWinKeyMapper->getCharKeyInformation(maintext.at(i));
-                tempX11.virtualkey = X11Extras::getInstance()->getGroup1KeySym(tempX11.virtualkey);
-                unsigned int tempQtKey = nativeWinKeyMapper->returnQtKey(tempX11.virtualkey);
-
-                if (tempQtKey > 0)
-                {
-                    temp.virtualkey = keymapper->returnVirtualKey(tempQtKey);
-                    temp.modifiers = tempX11.modifiers;
-                } else
-                {
-                    temp = keymapper->getCharKeyInformation(maintext.at(i));
-                }
+                temp.virtualkey = keymapper->returnVirtualKey(tempQtKey);
+                temp.modifiers = tempX11.modifiers;
             } else
             {
+                temp = keymapper->getCharKeyInformation(text.at(i));
+            }
+        } else
+        {
 #endif
-                temp = keymapper->getCharKeyInformation(maintext.at(i));
+            temp = keymapper->getCharKeyInformation(text.at(i));
 #ifdef WITH_X11
-            }
+        }
 #endif
 
-            if (temp.virtualkey > KEY_RESERVED)
-            {
-                if (temp.modifiers != Qt::NoModifier)
-                {
-                    testAndAppend(temp.modifiers.testFlag(Qt::ShiftModifier), tempList, KEY_LEFTSHIFT);
-                    testAndAppend(temp.modifiers.testFlag(Qt::ControlModifier), tempList, KEY_LEFTCTRL);
-                    testAndAppend(temp.modifiers.testFlag(Qt::AltModifier), tempList, KEY_LEFTALT);
-                    testAndAppend(temp.modifiers.testFlag(Qt::MetaModifier), tempList, KEY_LEFTMETA);
-                }
-
-                tempList.append(temp.virtualkey);
-                write_uinput_event(keyboardFileHandler, EV_KEY, temp.virtualkey, 1, true);
-            }
+        if (temp.virtualkey > KEY_RESERVED)
+        {
+            int first = sequence.codes.size();
 
-            if (tempList.size() > 0)
-            {
-                for (auto iter = tempList.crbegin(); iter != tempList.crend(); ++iter)
-                {
-                    unsigned int currentcode = *iter;
-                    bool sync = std::next(iter) == tempList.crend();
-                    write_uinput_event(keyboardFileHandler, EV_KEY, currentcode, 0, sync);
-                }
-            }
+            if (temp.modifiers.testFlag(Qt::ShiftModifier))
+                sequence.codes.append(KEY_LEFTSHIFT);
+
+            if (temp.modifiers.testFlag(Qt::ControlModifier))
+                sequence.codes.append(KEY_LEFTCTRL);
+
+            if (temp.modifiers.testFlag(Qt::AltModifier))
+                sequence.codes.append(KEY_LEFTALT);
+
+            if (temp.modifiers.testFlag(Qt::MetaModifier))
+                sequence.codes.append(KEY_LEFTMETA);
+
+            sequence.codes.append(temp.virtualkey);
+            sequence.strokeLengths.append(sequence.codes.size() - first);
         }
     }
-}
 
-void UInputEventHandler::testAndAppend(bool tested, QList<unsigned int> &tempList, unsigned int key)
-{
-    if (tested)
-    {
-        tempList.append(key);
-        write_uinput_event(keyboardFileHandler, EV_KEY, key, 1, false);
-    }
+    return sequence;
 }
 
 int UInputEventHandler::getKeyboardFileHandler() { return keyboardFileHandler; }
@@ -587,4 +1027,6 @@ int UInputEventHandler::getMouseFileHandler() { return mouseFileHandler; }
 
 int UInputEventHandler::getSpringMouseFileHandler() { return springMouseFileHandler; }
 
+int UInputEventHandler::getGamepadFileHandler() { return gamepadFileHandler; }
+
 const QString UInputEventHandler::getUinputDeviceLocation() { return uinputDeviceLocation; }
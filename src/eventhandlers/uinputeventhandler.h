@@ -21,6 +21,8 @@
 
 #include "baseeventhandler.h"
 
+#include <QHash>
+
 /**
  * @brief Input event handler class using uinput files
  *
@@ -47,28 +49,59 @@ class UInputEventHandler : public BaseEventHandler
     virtual void sendMouseAbsEvent(int xDis, int yDis, int screen) override;
 
     virtual void sendMouseSpringEvent(int xDis, int yDis, int width, int height) override;
+    virtual void sendMouseWheelEvent(int vertical, int horizontal) override;
 
     virtual QString getName() override;
     virtual QString getIdentifier() override;
     virtual void printPostMessages() override;
 
     virtual void sendTextEntryEvent(QString maintext) override;
+    virtual void sendGamepadButtonEvent(int button, bool pressed) override;
+    virtual void sendGamepadAxisEvent(int axis, int value) override;
+    virtual void createGamepadDevice() override;
+    virtual void setSeparatePlayerDevices(bool enabled, const QList<InputDevice *> &devices) override;
+    virtual bool hasPlayerDevices() const override;
+    virtual void addPlayerDevices(InputDevice *device) override;
+    virtual void removePlayerDevices(InputDevice *device) override;
+    virtual void sendPlayerMouseEvent(InputDevice *device, int xDis, int yDis) override;
+    virtual void sendPlayerMouseWheelEvent(InputDevice *device, int vertical, int horizontal) override;
+    virtual void sendPlayerTextEntryEvent(InputDevice *device, QString maintext) override;
+    virtual void beginOutputFrame() override;
+    virtual void endOutputFrame() override;
 
     int getKeyboardFileHandler();
     int getMouseFileHandler();
     int getSpringMouseFileHandler();
+    int getGamepadFileHandler();
     const QString getUinputDeviceLocation();
 
   protected:
+    /**
+     * @brief Virtual keyboard and mouse created for a single controller
+     *
+     * Handles are 0 if the devices could not be created. The spring mouse
+     * stays shared because it positions the one absolute pointer.
+     */
+    struct PlayerDevices
+    {
+        int keyboardFileHandler = 0;
+        int mouseFileHandler = 0;
+        int wheelHiResVertical = 0;
+        int wheelHiResHorizontal = 0;
+    };
+
     int openUInputHandle();
     void setKeyboardEvents(int filehandle);
     void setRelMouseEvents(int filehandle);
     void setSpringMouseEvents(int filehandle);
+    void setGamepadEvents(int filehandle);
     void populateKeyCodes(int filehandle);
-    void createUInputKeyboardDevice(int filehandle);
-    void createUInputMouseDevice(int filehandle);
+    void createUInputKeyboardDevice(int filehandle, const QString &name = QString());
+    void createUInputMouseDevice(int filehandle, const QString &name = QString());
     void createUInputSpringMouseDevice(int filehandle);
+    void createUInputGamepadDevice(int filehandle);
     void closeUInputDevice(int filehandle);
+    void writeTextEntry(int filehandle, const QString &text);
     /**
      * @brief Write uinput event to selected file uinput file
      *
@@ -79,6 +112,21 @@ class UInputEventHandler : public BaseEventHandler
      * @param syn synchronize after event (emit additional event used for separation of events EV_SYN)
      */
     void write_uinput_event(int filehandle, int type, int code, int value, bool syn = true);
+    /**
+     * @brief Scroll the relative mouse device by a fraction of a notch
+     *
+     * Emits REL_WHEEL_HI_RES/REL_HWHEEL_HI_RES when the kernel headers know them and
+     * the classic REL_WHEEL/REL_HWHEEL every time a full notch has been collected.
+     *
+     * @param vertical scroll vertically (true) or horizontally (false)
+     * @param value amount in 1/WHEEL_UNITS_PER_NOTCH notches
+     * @param player devices of the controller to scroll, shared mouse if nullptr
+     */
+    void write_wheel_event(bool vertical, int value, PlayerDevices *player = nullptr);
+    PlayerDevices *getPlayerDevices(InputDevice *device);
+    PlayerDevices *getPlayerDevices(JoyButtonSlot *slot);
+    void closePlayerDevices(PlayerDevices &player);
+    virtual TextEntrySequence compileTextEntry(const QString &text) override;
 
   private slots:
 #ifdef WITH_X11
@@ -89,13 +137,21 @@ class UInputEventHandler : public BaseEventHandler
     int keyboardFileHandler;
     int mouseFileHandler;
     int springMouseFileHandler;
+    int gamepadFileHandler;
+    bool gamepadDeviceFailed;
+    int gamepadDPadButtons; ///< pressed SDL_CONTROLLER_BUTTON_DPAD_* as bit mask
     QString uinputDeviceLocation;
+    int wheelHiResVertical;
+    int wheelHiResHorizontal;
+    bool separatePlayerDevices;
+    QHash<InputDevice *, PlayerDevices> playerDevices;
+    int outputFrameDepth;
+    QHash<int, QByteArray> outputFrameEvents; ///< file handle -> events written at the end of the frame
 #if defined(Q_OS_UNIX)
     bool is_problem_with_opening_uinput_present;
 #endif
 
     bool cleanupUinputEvHand();
-    void testAndAppend(bool tested, QList<unsigned int> &tempList, unsigned int key);
     void initDevice(int &device, QString name, bool &result);
 };
 
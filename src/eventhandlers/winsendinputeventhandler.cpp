@@ -50,6 +50,7 @@ void WinSendInputEventHandler::sendKeyboardEvent(JoyButtonSlot *slot, bool press
     temp[0].ki.wVk = code;
     temp[0].ki.dwFlags = pressed ? tempflags : (tempflags | KEYEVENTF_KEYUP); // 0 for key press
     SendInput(1, temp, sizeof(INPUT));
+    countSyscalls();
 }
 
 void WinSendInputEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
@@ -94,6 +95,7 @@ void WinSendInputEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pr
     }
 
     SendInput(1, temp, sizeof(INPUT));
+    countSyscalls();
 }
 
 void WinSendInputEventHandler::sendMouseEvent(int xDis, int yDis)
@@ -105,6 +107,39 @@ void WinSendInputEventHandler::sendMouseEvent(int xDis, int yDis)
     temp[0].mi.dx = xDis;
     temp[0].mi.dy = yDis;
     SendInput(1, temp, sizeof(INPUT));
+    countMouseTick();
+    countSyscalls();
+}
+
+/**
+ * @brief SendInput accepts fractions of WHEEL_DELTA directly.
+ */
+void WinSendInputEventHandler::sendMouseWheelEvent(int vertical, int horizontal)
+{
+    INPUT temp[2] = {};
+    int count = 0;
+
+    if (vertical != 0)
+    {
+        temp[count].type = INPUT_MOUSE;
+        temp[count].mi.dwFlags = MOUSEEVENTF_WHEEL;
+        temp[count].mi.mouseData = vertical * WHEEL_DELTA / WHEEL_UNITS_PER_NOTCH;
+        count++;
+    }
+
+    if (horizontal != 0)
+    {
+        temp[count].type = INPUT_MOUSE;
+        temp[count].mi.dwFlags = 0x01000;
+        temp[count].mi.mouseData = horizontal * WHEEL_DELTA / WHEEL_UNITS_PER_NOTCH;
+        count++;
+    }
+
+    if (count > 0)
+    {
+        SendInput(count, temp, sizeof(INPUT));
+        countSyscalls();
+    }
 }
 
 QString WinSendInputEventHandler::getName() { return QString("SendInput"); }
@@ -125,6 +160,8 @@ void WinSendInputEventHandler::sendMouseSpringEvent(int xDis, int yDis, int widt
         temp[0].mi.dx = fx;
         temp[0].mi.dy = fy;
         SendInput(1, temp, sizeof(INPUT));
+        countMouseTick();
+        countSyscalls();
     }
 }
 
@@ -190,6 +227,7 @@ void WinSendInputEventHandler::sendTextEntryEvent(QString maintext)
                 }
 
                 SendInput(j, tempBuffer.data(), sizeof(INPUT));
+                countSyscalls();
 
                 j = 0;
                 memset(tempBuffer.data(), 0, sizeof(INPUT) * inputCount);
@@ -211,6 +249,7 @@ void WinSendInputEventHandler::sendTextEntryEvent(QString maintext)
                 }
 
                 SendInput(j, tempBuffer.data(), sizeof(INPUT));
+                countSyscalls();
             }
         }
     }
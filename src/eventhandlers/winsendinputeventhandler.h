@@ -42,6 +42,7 @@ class WinSendInputEventHandler : public BaseEventHandler
     virtual void sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed) override;
     virtual void sendMouseEvent(int xDis, int yDis) override;
     virtual void sendMouseSpringEvent(int xDis, int yDis, int width, int height) override;
+    virtual void sendMouseWheelEvent(int vertical, int horizontal) override;
     virtual void sendTextEntryEvent(QString maintext) override;
 
     virtual QString getName() override;
@@ -64,7 +64,7 @@ void XTestEventHandler::sendKeyboardEvent(JoyButtonSlot *slot, bool pressed)
         if (tempcode > 0)
         {
             XTestFakeKeyEvent(display, tempcode, pressed, 0);
-            XFlush(display);
+            flushDisplay(display);
         }
     }
 }
@@ -79,7 +79,7 @@ void XTestEventHandler::sendMouseButtonEvent(JoyButtonSlot *slot, bool pressed)
     if (device == JoyButtonSlot::JoyMouseButton)
     {
         XTestFakeButtonEvent(display, code, pressed, 0);
-        XFlush(display);
+        flushDisplay(display);
     }
 }
 
@@ -87,14 +87,26 @@ void XTestEventHandler::sendMouseEvent(int xDis, int yDis)
 {
     Display *display = X11Extras::getInstance()->display();
     XTestFakeRelativeMotionEvent(display, xDis, yDis, 0);
-    XFlush(display);
+    countMouseTick();
+    flushDisplay(display);
 }
 
 void XTestEventHandler::sendMouseAbsEvent(int xDis, int yDis, int screen)
 {
     Display *display = X11Extras::getInstance()->display();
     XTestFakeMotionEvent(display, screen, xDis, yDis, 0);
+    countMouseTick();
+    flushDisplay(display);
+}
+
+/**
+ * @brief Sends the buffered requests to the X server. XTest requests only
+ *  leave the process here, so this is where syscalls are counted.
+ */
+void XTestEventHandler::flushDisplay(Display *display)
+{
     XFlush(display);
+    countSyscalls();
 }
 
 QString XTestEventHandler::getName() { return QString("XTest"); }
@@ -103,72 +115,78 @@ QString XTestEventHandler::getIdentifier() { return QString("xtest"); }
 
 void XTestEventHandler::sendTextEntryEvent(QString maintext)
 {
+    const TextEntrySequence sequence = getTextEntrySequence(maintext);
+
+    if (sequence.codes.isEmpty())
+        return;
+
+    Display *display = X11Extras::getInstance()->display();
+    const unsigned int *codes = sequence.codes.constData();
+
+    // Requests are buffered until the flush, the whole text goes out at once.
+    for (int length : sequence.strokeLengths)
+    {
+        for (int i = 0; i < length; i++)
+            XTestFakeKeyEvent(display, codes[i], 1, 0);
+
+        for (int i = length - 1; i >= 0; i--)
+            XTestFakeKeyEvent(display, codes[i], 0, 0);
+
+        codes += length;
+    }
+
+    flushDisplay(display);
+}
+
+/**
+ * @brief Resolves every character to an X11 key code and the modifier key codes needed to type it.
+ */
+TextEntrySequence XTestEventHandler::compileTextEntry(const QString &text)
+{
+    TextEntrySequence sequence;
     AntKeyMapper *mapper = AntKeyMapper::getInstance();
 
-    if ((mapper != nullptr) && mapper->getKeyMapper())
+    if ((mapper == nullptr) || !mapper->getKeyMapper())
+        return sequence;
+
+    // Resolved with the X11 connection of the current thread, so that is the one which needs to see keymap changes.
+    X11Extras *extras = X11Extras::getInstance();
+    connect(extras, &X11Extras::keymapChanged, this, &XTestEventHandler::invalidateTextEntries, Qt::UniqueConnection);
+
+    Display *display = extras->display();
+    QtX11KeyMapper *keymapper = qobject_cast<QtX11KeyMapper *>(mapper->getKeyMapper());
+    const unsigned int shiftcode = XKeysymToKeycode(display, XK_Shift_L);
+    const unsigned int controlcode = XKeysymToKeycode(display, XK_Control_L);
+    const unsigned int altcode = XKeysymToKeycode(display, XK_Alt_L);
+    const unsigned int metacode = XKeysymToKeycode(display, XK_Meta_L);
+
+    for (int i = 0; i < text.size(); i++)
     {
-        Display *display = X11Extras::getInstance()->display();
-        QtX11KeyMapper *keymapper = qobject_cast<QtX11KeyMapper *>(mapper->getKeyMapper());
+        QtX11KeyMapper::charKeyInformation temp = keymapper->getCharKeyInformation(text.at(i));
+        unsigned int tempcode = XKeysymToKeycode(display, static_cast<KeySym>(temp.virtualkey));
 
-        for (int i = 0; i < maintext.size(); i++)
+        if (tempcode > 0)
         {
-            QtX11KeyMapper::charKeyInformation temp = keymapper->getCharKeyInformation(maintext.at(i));
-            int tempcode = XKeysymToKeycode(display, static_cast<KeySym>(temp.virtualkey));
-
-            if (tempcode > 0)
-            {
-                QList<int> tempList;
-
-                if ((temp.modifiers != Qt::NoModifier) && temp.modifiers.testFlag(Qt::ShiftModifier))
-                {
-                    int shiftcode = XKeysymToKeycode(display, XK_Shift_L);
-                    int modifiercode = shiftcode;
-                    XTestFakeKeyEvent(display, modifiercode, 1, 0);
-                    tempList.append(modifiercode);
-                }
-
-                if ((temp.modifiers != Qt::NoModifier) && temp.modifiers.testFlag(Qt::ControlModifier))
-                {
-                    int controlcode = XKeysymToKeycode(display, XK_Control_L);
-                    int modifiercode = controlcode;
-                    XTestFakeKeyEvent(display, modifiercode, 1, 0);
-                    tempList.append(modifiercode);
-                }
-
-                if ((temp.modifiers != Qt::NoModifier) && temp.modifiers.testFlag(Qt::AltModifier))
-                {
-                    int altcode = XKeysymToKeycode(display, XK_Alt_L);
-                    int modifiercode = altcode;
-                    XTestFakeKeyEvent(display, modifiercode, 1, 0);
-                    tempList.append(modifiercode);
-                }
-
-                if ((temp.modifiers != Qt::NoModifier) && temp.modifiers.testFlag(Qt::MetaModifier))
-                {
-                    int metacode = XKeysymToKeycode(display, XK_Meta_L);
-                    int modifiercode = metacode;
-                    XTestFakeKeyEvent(display, modifiercode, 1, 0);
-                    tempList.append(modifiercode);
-                }
-
-                XTestFakeKeyEvent(display, tempcode, 1, 0);
-                tempList.append(tempcode);
-
-                XFlush(display);
-
-                if (tempList.size() > 0)
-                {
-                    for (auto iter = tempList.crbegin(); iter != tempList.crend(); ++iter)
-                    {
-                        int currentcode = *iter;
-                        XTestFakeKeyEvent(display, currentcode, 0, 0);
-                    }
-
-                    XFlush(display);
-                }
-            }
+            int first = sequence.codes.size();
+
+            if (temp.modifiers.testFlag(Qt::ShiftModifier))
+                sequence.codes.append(shiftcode);
+
+            if (temp.modifiers.testFlag(Qt::ControlModifier))
+                sequence.codes.append(controlcode);
+
+            if (temp.modifiers.testFlag(Qt::AltModifier))
+                sequence.codes.append(altcode);
+
+            if (temp.modifiers.testFlag(Qt::MetaModifier))
+                sequence.codes.append(metacode);
+
+            sequence.codes.append(tempcode);
+            sequence.strokeLengths.append(sequence.codes.size() - first);
         }
     }
+
+    return sequence;
 }
 
 void XTestEventHandler::sendMouseSpringEvent(int xDis, int yDis, int width, int height)
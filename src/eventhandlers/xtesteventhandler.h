@@ -22,6 +22,7 @@
 #include "baseeventhandler.h"
 
 class JoyButtonSlot;
+typedef struct _XDisplay Display;
 
 class XTestEventHandler : public BaseEventHandler
 {
@@ -46,6 +47,12 @@ class XTestEventHandler : public BaseEventHandler
     QString getName() override;
     QString getIdentifier() override;
     void printPostMessages() override;
+
+  protected:
+    TextEntrySequence compileTextEntry(const QString &text) override;
+
+  private:
+    void flushDisplay(Display *display);
 };
 
 #endif // XTESTEVENTHANDLER_H
@@ -48,16 +48,16 @@ GameController::GameController(SDL_GameController *controller, int deviceIndex,
     m_controller_type = SDL_CONTROLLER_TYPE_UNKNOWN;
 #endif
 
-    enableSensors();
-    for (int i = 0; i < GlobalVariables::InputDevice::NUMBER_JOYSETS; i++)
-    {
-        GameControllerSet *controllerset = new GameControllerSet(this, i, this);
-        getJoystick_sets().insert(i, controllerset);
-        enableSetConnections(controllerset);
-    }
+    // Only the first set exists up front, the others are created on first use.
+    getSetJoystick(0);
+
+    // Sensors stay off until a profile or a window needs them.
+    updateSensorDemand();
     INFO() << "Created new GameController:\n" << getDescription();
 }
 
+SetJoystick *GameController::createSetJoystick(int index) { return new GameControllerSet(this, index, this); }
+
 QString GameController::getName()
 {
     return QString(tr("Game Controller")).append(" ").append(QString::number(getRealJoyNumber()));
@@ -221,6 +221,15 @@ bool GameController::hasRawSensor(JoySensorType type)
 
 int GameController::getNumberRawHats() { return 0; }
 
+int GameController::getNumberRawTouchpads()
+{
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+    return SDL_GameControllerGetNumTouchpads(controller);
+#else
+    return 0;
+#endif
+}
+
 void GameController::setCounterUniques(int counter) { counterUniques = counter; }
 
 QString GameController::getBindStringForAxis(int index, bool)
@@ -283,18 +292,27 @@ void GameController::buttonClickEvent(int) {}
 
 void GameController::buttonReleaseEvent(int) {}
 
-void GameController::enableSensors()
+/**
+ * @brief Enables or disables event reporting of a hardware sensor.
+ *  SDL is only called when the state actually changes.
+ */
+void GameController::setRawSensorEnabled(JoySensorType type, bool enabled)
 {
 #if SDL_VERSION_ATLEAST(2, 0, 14)
-    if (SDL_GameControllerHasSensor(controller, SDL_SENSOR_GYRO))
-    {
-        SDL_GameControllerSetSensorEnabled(controller, SDL_SENSOR_GYRO, SDL_TRUE);
-    }
+    SDL_SensorType sensorType = (type == ACCELEROMETER) ? SDL_SENSOR_ACCEL : SDL_SENSOR_GYRO;
 
-    if (SDL_GameControllerHasSensor(controller, SDL_SENSOR_ACCEL))
+    if (!SDL_GameControllerHasSensor(controller, sensorType) ||
+        (SDL_GameControllerIsSensorEnabled(controller, sensorType) == (enabled ? SDL_TRUE : SDL_FALSE)))
     {
-        SDL_GameControllerSetSensorEnabled(controller, SDL_SENSOR_ACCEL, SDL_TRUE);
+        return;
     }
+
+    DEBUG() << (enabled ? "Enabling " : "Disabling ") << (type == ACCELEROMETER ? "accelerometer" : "gyroscope")
+            << " of " << getSDLName();
+    SDL_GameControllerSetSensorEnabled(controller, sensorType, enabled ? SDL_TRUE : SDL_FALSE);
+#else
+    Q_UNUSED(type);
+    Q_UNUSED(enabled);
 #endif
 }
 
@@ -75,6 +75,8 @@ class GameController : public InputDevice
     virtual int getNumberRawHats() override;
     virtual double getRawSensorRate(JoySensorType type) override;
     virtual bool hasRawSensor(JoySensorType type) override;
+    virtual void setRawSensorEnabled(JoySensorType type, bool enabled) override;
+    virtual int getNumberRawTouchpads() override;
     void setCounterUniques(int counter) override;
 
     QString getBindStringForAxis(int index, bool trueIndex = true);
@@ -96,6 +98,9 @@ class GameController : public InputDevice
     SDL_GameController *getController() const;
     virtual SDL_GameControllerType getControllerType() const override;
 
+  protected:
+    virtual SetJoystick *createSetJoystick(int index) override;
+
   protected slots:
     virtual void axisActivatedEvent(int setindex, int axisindex, int value) override;
     virtual void buttonClickEvent(int buttonindex) override;
@@ -110,8 +115,6 @@ class GameController : public InputDevice
     SDL_JoystickID joystickID;
     SDL_GameController *controller;
     SDL_GameControllerType m_controller_type;
-
-    void enableSensors();
 };
 
 #endif // GAMECONTROLLER_H
@@ -21,13 +21,16 @@
 #include "gamecontroller.h"
 #include "gamecontrollerdpad.h"
 #include "gamecontrollertrigger.h"
+#include "globalvariables.h"
 #include "haptictriggerps5.h"
 #include "inputdevice.h"
 #include "joycontrolstick.h"
 #include "joysensor.h"
+#include "joytouchpad.h"
 #include "xml/joyaxisxml.h"
 #include "xml/joybuttonxml.h"
 #include "xml/joydpadxml.h"
+#include "xml/joytouchpadxml.h"
 
 #include <QDebug>
 #include <QXmlStreamReader>
@@ -140,6 +143,9 @@ void GameControllerSet::readConfig(QXmlStreamReader *xml)
             } else if ((xml->name().toString() == "sensor") && xml->isStartElement())
             {
                 getElemFromXml("sensor", xml);
+            } else if ((xml->name().toString() == GlobalVariables::JoyTouchpad::xmlName) && xml->isStartElement())
+            {
+                getElemFromXml(GlobalVariables::JoyTouchpad::xmlName, xml);
             } else if ((xml->name().toString() == "dpad") && xml->isStartElement())
             {
                 getElemFromXml("dpad", xml);
@@ -227,6 +233,18 @@ void GameControllerSet::getElemFromXml(QString elemName, QXmlStreamReader *xml)
         int type = xml->attributes().value("type").toString().toInt();
         JoySensor *sensor = getSensor(static_cast<JoySensorType>(type));
         readConf(sensor, xml);
+    } else if (elemName == GlobalVariables::JoyTouchpad::xmlName)
+    {
+        JoyTouchpad *touchpad = getTouchpad(index - 1);
+
+        if (touchpad != nullptr)
+        {
+            JoyTouchpadXml touchpadXml(touchpad);
+            touchpadXml.readConfig(xml);
+        } else
+        {
+            xml->skipCurrentElement();
+        }
     }
 }
 
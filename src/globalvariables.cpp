@@ -46,6 +46,7 @@ const int GlobalVariables::JoyButton::DEFAULTWHEELY = 20;
 const bool GlobalVariables::JoyButton::DEFAULTCYCLERESETACTIVE = false;
 const int GlobalVariables::JoyButton::DEFAULTCYCLERESET = 0;
 const bool GlobalVariables::JoyButton::DEFAULTRELATIVESPRING = false;
+const bool GlobalVariables::JoyButton::DEFAULTANALOGWHEEL = false;
 const double GlobalVariables::JoyButton::DEFAULTEASINGDURATION = 0.5;
 const double GlobalVariables::JoyButton::MINIMUMEASINGDURATION = 0.2;
 const double GlobalVariables::JoyButton::MAXIMUMEASINGDURATION = 5.0;
@@ -69,6 +70,7 @@ const int GlobalVariables::JoyButton::DEFAULTSPRINGRELEASERADIUS = 0;
 // Keep references to active keys and mouse buttons.
 QHash<int, int> GlobalVariables::JoyButton::activeKeys;
 QHash<int, int> GlobalVariables::JoyButton::activeMouseButtons;
+QHash<int, int> GlobalVariables::JoyButton::activeGamepadButtons;
 
 // History buffers used for mouse smoothing routine.
 QList<double> GlobalVariables::JoyButton::mouseHistoryX;
@@ -95,7 +97,7 @@ const int GlobalVariables::AntimicroSettings::defaultSDLGamepadPollRate = 10; //
 
 // ---- INPUTDEVICE ---- //
 
-const int GlobalVariables::InputDevice::NUMBER_JOYSETS = 8;
+const int GlobalVariables::InputDevice::NUMBER_JOYSETS = 16;
 const int GlobalVariables::InputDevice::DEFAULTKEYPRESSTIME = 100;
 const int GlobalVariables::InputDevice::RAISEDDEADZONE = 20000;
 const int GlobalVariables::InputDevice::DEFAULTKEYREPEATDELAY = 660; // 660 ms
@@ -190,6 +192,7 @@ const bool GlobalVariables::JoyControlStick::DEFAULTMODIFIERZONEINVERTED = false
 const int GlobalVariables::JoyControlStick::DEFAULTDIAGONALRANGE = 45;
 const double GlobalVariables::JoyControlStick::DEFAULTCIRCLE = 0.0;
 const int GlobalVariables::JoyControlStick::DEFAULTSTICKDELAY = 0;
+const bool GlobalVariables::JoyControlStick::DEFAULTRESPONSEMAP = false;
 
 // ---- JoySensor ---- //
 
@@ -201,6 +204,15 @@ const double GlobalVariables::JoySensor::DEFAULTDEADZONE = 20;
 const int GlobalVariables::JoySensor::DEFAULTDIAGONALRANGE = 45;
 const unsigned int GlobalVariables::JoySensor::DEFAULTSENSORDELAY = 0;
 
+// ---- JoyTouchpad ---- //
+
+const QString GlobalVariables::JoyTouchpad::xmlName = "touchpad";
+// Pixels for a swipe over the whole width or height of the touchpad.
+const double GlobalVariables::JoyTouchpad::DEFAULTMOUSESPEEDX = 1600.0;
+const double GlobalVariables::JoyTouchpad::DEFAULTMOUSESPEEDY = 800.0;
+// Wheel notches for a two finger swipe over the whole height of the touchpad.
+const double GlobalVariables::JoyTouchpad::DEFAULTSCROLLSPEED = 10.0;
+
 // ---- JoyButtonSlot ---- //
 
 const int GlobalVariables::JoyButtonSlot::JOYSPEED = 20;
@@ -230,3 +242,7 @@ const QString GlobalVariables::JoySensorButton::xmlName = "sensorbutton";
 // ---- JoyDPadButton ---- //
 
 const QString GlobalVariables::JoyDPadButton::xmlName = "dpadbutton";
+
+// ---- JoyTouchpadButton ---- //
+
+const QString GlobalVariables::JoyTouchpadButton::xmlName = "touchpadbutton";
@@ -47,6 +47,7 @@ class JoyButton
     static const bool DEFAULTUSETURBO;
     static const bool DEFAULTCYCLERESETACTIVE;
     static const bool DEFAULTRELATIVESPRING;
+    static const bool DEFAULTANALOGWHEEL;
 
     static const double DEFAULTMOUSESPEEDMOD;
     static const double DEFAULTSENSITIVITY;
@@ -85,6 +86,7 @@ class JoyButton
 
     static QHash<int, int> activeKeys;
     static QHash<int, int> activeMouseButtons;
+    static QHash<int, int> activeGamepadButtons;
     static QList<double> mouseHistoryX;
     static QList<double> mouseHistoryY;
 };
@@ -221,6 +223,7 @@ class JoyControlStick
     static const int DEFAULTDIAGONALRANGE;
     static const double DEFAULTCIRCLE;
     static const int DEFAULTSTICKDELAY;
+    static const bool DEFAULTRESPONSEMAP;
 };
 
 class JoySensor
@@ -235,6 +238,15 @@ class JoySensor
     static const unsigned int DEFAULTSENSORDELAY;
 };
 
+class JoyTouchpad
+{
+  public:
+    static const QString xmlName;
+    static const double DEFAULTMOUSESPEEDX;
+    static const double DEFAULTMOUSESPEEDY;
+    static const double DEFAULTSCROLLSPEED;
+};
+
 class JoyButtonSlot
 {
   public:
@@ -279,6 +291,12 @@ class JoyDPadButton
     static const QString xmlName;
 };
 
+class JoyTouchpadButton
+{
+  public:
+    static const QString xmlName;
+};
+
 } // namespace GlobalVariables
 
 #endif // GLOBALVARIABLES_H
@@ -23,6 +23,7 @@
 #include "autoprofileinfo.h"
 #include "common.h"
 #include "inputdevice.h"
+#include "profileindex.h"
 
 #if defined(Q_OS_UNIX)
     #ifdef WITH_X11
@@ -37,6 +38,7 @@
 #endif
 
 #include <QApplication>
+#include <QCompleter>
 #include <QDebug>
 #include <QFileInfo>
 #include <QList>
@@ -106,6 +108,15 @@ AddEditAutoProfileDialog::AddEditAutoProfileDialog(AutoProfileInfo *info, AntiMi
     }
 
     ui->profileLineEdit->setText(info->getProfileLocation());
+
+    QStringList profilePaths;
+    for (const QString &path : ProfileIndex::getInstance()->getProfilePaths())
+        profilePaths.append(QDir::toNativeSeparators(path));
+
+    QCompleter *profileCompleter = new QCompleter(profilePaths, this);
+    profileCompleter->setCaseSensitivity(Qt::CaseInsensitive);
+    profileCompleter->setFilterMode(Qt::MatchContains);
+    ui->profileLineEdit->setCompleter(profileCompleter);
     ui->applicationLineEdit->setText(info->getExe());
     ui->winClassLineEdit->setText(info->getWindowClass());
     ui->winNameLineEdit->setText(info->getWindowName());
@@ -1372,14 +1372,16 @@ void AdvanceButtonDialog::populateSetSelectionComboBox()
     ui->setSelectionComboBox->insertItem(0, tr("Disabled"));
     int currentIndex = 1;
 
-    for (auto set = m_button->getParentSet()->getInputDevice()->getJoystick_sets().begin();
-         set != m_button->getParentSet()->getInputDevice()->getJoystick_sets().end(); ++set)
+    InputDevice *device = m_button->getParentSet()->getInputDevice();
+
+    // Sets that were never used are not allocated but can still be selected.
+    for (int originset = 0; originset < GlobalVariables::InputDevice::NUMBER_JOYSETS; originset++)
     {
-        int originset = set.key();
         if (m_button->getOriginSet() != originset)
         {
             QString selectedSetText = QString(tr("Select Set %1").arg(originset + 1));
-            QString setName = set.value()->getName();
+            SetJoystick *set = device->findSetJoystick(originset);
+            QString setName = (set != nullptr) ? set->getName() : QString();
 
             if (!setName.isEmpty())
             {
@@ -1399,8 +1401,6 @@ void AdvanceButtonDialog::populateSetSelectionComboBox()
             ui->setSelectionComboBox->insertItems(currentIndex, setChoices);
             currentIndex += 3;
         }
-
-        originset++;
     }
 }
 
@@ -1409,14 +1409,15 @@ void AdvanceButtonDialog::populateSlotSetSelectionComboBox()
     ui->slotSetChangeComboBox->clear();
     int current_box_index = 0;
 
-    for (auto set = m_button->getParentSet()->getInputDevice()->getJoystick_sets().begin();
-         set != m_button->getParentSet()->getInputDevice()->getJoystick_sets().end(); ++set)
+    InputDevice *device = m_button->getParentSet()->getInputDevice();
+
+    for (int originset = 0; originset < GlobalVariables::InputDevice::NUMBER_JOYSETS; originset++)
     {
-        int originset = set.key();
         if (m_button->getOriginSet() != originset)
         {
             QString selectedSetSlotText = QString(tr("Select Set %1").arg(originset + 1));
-            QString setName = set.value()->getName();
+            SetJoystick *set = device->findSetJoystick(originset);
+            QString setName = (set != nullptr) ? set->getName() : QString();
 
             if (!setName.isEmpty())
             {
@@ -1427,8 +1428,6 @@ void AdvanceButtonDialog::populateSlotSetSelectionComboBox()
             ui->slotSetChangeComboBox->insertItem(current_box_index, selectedSetSlotText, QVariant(originset));
             current_box_index++;
         }
-
-        originset++;
     }
 }
 
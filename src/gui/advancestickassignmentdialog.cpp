@@ -143,11 +143,8 @@ void AdvanceStickAssignmentDialog::checkForAxisAssignmentSticks(QWidget *comboBo
     {
         if (xAxisComboBox->currentIndex() != yAxisComboBox->currentIndex())
         {
-            int originset = 0;
-
-            for (auto set = joystick->getJoystick_sets().begin(); set != joystick->getJoystick_sets().end(); ++set)
+            for (SetJoystick *currentset : joystick->getJoystick_sets())
             {
-                SetJoystick *currentset = set.value();
                 JoyAxis *axis1 = currentset->getJoyAxis(xAxisComboBox->currentIndex() - 1);
                 JoyAxis *axis2 = currentset->getJoyAxis(yAxisComboBox->currentIndex() - 1);
 
@@ -158,11 +155,9 @@ void AdvanceStickAssignmentDialog::checkForAxisAssignmentSticks(QWidget *comboBo
                            (currentset->getJoyStick(controlStickNumber) == nullptr))
                 {
                     JoyControlStick *controlstick =
-                        new JoyControlStick(axis1, axis2, controlStickNumber, originset, currentset);
+                        new JoyControlStick(axis1, axis2, controlStickNumber, currentset->getIndex(), currentset);
                     currentset->addControlStick(controlStickNumber, controlstick);
                 }
-
-                originset++;
             }
 
             JoyControlStick *stick1 = joystick->getActiveSetJoystick()->getJoyStick(0);
@@ -191,21 +186,15 @@ void AdvanceStickAssignmentDialog::changeStateVDPadWidgets(bool enabledVDPads)
     ui->vdpadLeftPushButton->setEnabled(enabledVDPads);
     ui->vdpadRightPushButton->setEnabled(enabledVDPads);
 
-    int originset = 0;
-
-    for (auto set = joystick->getJoystick_sets().begin(); set != joystick->getJoystick_sets().end(); ++set)
+    for (SetJoystick *currentset : joystick->getJoystick_sets())
     {
-        SetJoystick *currentset = set.value();
-
         if (!currentset->getVDPad(0) && enabledVDPads)
         {
-            currentset->addVDPad(0, new VDPad(0, originset, currentset, currentset));
+            currentset->addVDPad(0, new VDPad(0, currentset->getIndex(), currentset, currentset));
         } else
         {
             currentset->removeVDPad(0);
         }
-
-        originset++;
     }
 }
 
@@ -257,9 +246,9 @@ void AdvanceStickAssignmentDialog::changeStateStickTwoWidgets(bool enabled)
 
         if (joystick->getActiveSetJoystick()->getJoyStick(1) != nullptr)
         {
-            for (auto set = joystick->getJoystick_sets().begin(); set != joystick->getJoystick_sets().end(); ++set)
+            for (SetJoystick *currentset : joystick->getJoystick_sets())
             {
-                set.value()->removeControlStick(1);
+                currentset->removeControlStick(1);
             }
         }
     }
@@ -460,9 +449,8 @@ void AdvanceStickAssignmentDialog::changeVDPadUpButton(int index)
             if ((axis > 0) && (button >= 0))
             {
 
-                for (auto set = joystick->getJoystick_sets().begin(); set != joystick->getJoystick_sets().end(); ++set)
+                for (SetJoystick *currentset : joystick->getJoystick_sets())
                 {
-                    SetJoystick *currentset = set.value();
                     VDPad *vdpad = currentset->getVDPad(0);
                     JoyAxis *currentaxis = currentset->getJoyAxis(axis - 1);
                     JoyButton *currentbutton = nullptr;
@@ -480,9 +468,8 @@ void AdvanceStickAssignmentDialog::changeVDPadUpButton(int index)
             } else if (button > 0)
             {
 
-                for (auto set = joystick->getJoystick_sets().begin(); set != joystick->getJoystick_sets().end(); ++set)
+                for (SetJoystick *currentset : joystick->getJoystick_sets())
                 {
-                    SetJoystick *currentset = set.value();
                     VDPad *vdpad = currentset->getVDPad(0);
                     JoyButton *currentbutton = currentset->getJoyButton(button - 1);
 
@@ -496,9 +483,8 @@ void AdvanceStickAssignmentDialog::changeVDPadUpButton(int index)
     } else
     {
 
-        for (auto set = joystick->getJoystick_sets().begin(); set != joystick->getJoystick_sets().end(); ++set)
+        for (SetJoystick *currentset : joystick->getJoystick_sets())
         {
-            SetJoystick *currentset = set.value();
             VDPad *vdpad = currentset->getVDPad(0);
 
             if ((vdpad != nullptr) && vdpad->getVButton(JoyDPadButton::DpadUp))
@@ -535,9 +521,8 @@ void AdvanceStickAssignmentDialog::changeVDPadDownButton(int index)
             if ((axis > 0) && (button >= 0))
             {
 
-                for (auto set = joystick->getJoystick_sets().begin(); set != joystick->getJoystick_sets().end(); ++set)
+                for (SetJoystick *currentset : joystick->getJoystick_sets())
                 {
-                    SetJoystick *currentset = set.value();
                     VDPad *vdpad = currentset->getVDPad(0);
                     JoyAxis *currentaxis = currentset->getJoyAxis(axis - 1);
                     JoyButton *currentbutton = nullptr;
@@ -555,9 +540,8 @@ void AdvanceStickAssignmentDialog::changeVDPadDownButton(int index)
             } else if (button > 0)
             {
 
-                for (auto set = joystick->getJoystick_sets().begin(); set != joystick->getJoystick_sets().end(); ++set)
+                for (SetJoystick *currentset : joystick->getJoystick_sets())
                 {
-                    SetJoystick *currentset = set.value();
                     VDPad *vdpad = currentset->getVDPad(0);
                     JoyButton *currentbutton = currentset->getJoyButton(button - 1);
 
@@ -571,9 +555,8 @@ void AdvanceStickAssignmentDialog::changeVDPadDownButton(int index)
     } else
     {
 
-        for (auto set = joystick->getJoystick_sets().begin(); set != joystick->getJoystick_sets().end(); ++set)
+        for (SetJoystick *currentset : joystick->getJoystick_sets())
         {
-            SetJoystick *currentset = set.value();
             VDPad *vdpad = currentset->getVDPad(0);
 
             if ((vdpad != nullptr) && vdpad->getVButton(JoyDPadButton::DpadDown))
@@ -610,9 +593,8 @@ void AdvanceStickAssignmentDialog::changeVDPadLeftButton(int index)
             if ((axis > 0) && (button >= 0))
             {
 
-                for (auto set = joystick->getJoystick_sets().begin(); set != joystick->getJoystick_sets().end(); ++set)
+                for (SetJoystick *currentset : joystick->getJoystick_sets())
                 {
-                    SetJoystick *currentset = set.value();
                     VDPad *vdpad = currentset->getVDPad(0);
                     JoyAxis *currentaxis = currentset->getJoyAxis(axis - 1);
                     JoyButton *currentbutton = nullptr;
@@ -630,9 +612,8 @@ void AdvanceStickAssignmentDialog::changeVDPadLeftButton(int index)
             } else if (button > 0)
             {
 
-                for (auto set = joystick->getJoystick_sets().begin(); set != joystick->getJoystick_sets().end(); ++set)
+                for (SetJoystick *currentset : joystick->getJoystick_sets())
                 {
-                    SetJoystick *currentset = set.value();
                     VDPad *vdpad = currentset->getVDPad(0);
                     JoyButton *currentbutton = currentset->getJoyButton(button - 1);
 
@@ -646,9 +627,8 @@ void AdvanceStickAssignmentDialog::changeVDPadLeftButton(int index)
     } else
     {
 
-        for (auto set = joystick->getJoystick_sets().begin(); set != joystick->getJoystick_sets().end(); ++set)
+        for (SetJoystick *currentset : joystick->getJoystick_sets())
         {
-            SetJoystick *currentset = set.value();
             VDPad *vdpad = currentset->getVDPad(0);
 
             if ((vdpad != nullptr) && vdpad->getVButton(JoyDPadButton::DpadLeft))
@@ -685,9 +665,8 @@ void AdvanceStickAssignmentDialog::changeVDPadRightButton(int index)
             if ((axis > 0) && (button >= 0))
             {
 
-                for (auto set = joystick->getJoystick_sets().begin(); set != joystick->getJoystick_sets().end(); ++set)
+                for (SetJoystick *currentset : joystick->getJoystick_sets())
                 {
-                    SetJoystick *currentset = set.value();
                     VDPad *vdpad = currentset->getVDPad(0);
                     JoyAxis *currentaxis = currentset->getJoyAxis(axis - 1);
                     JoyButton *currentbutton = nullptr;
@@ -705,9 +684,8 @@ void AdvanceStickAssignmentDialog::changeVDPadRightButton(int index)
             } else if (button > 0)
             {
 
-                for (auto set = joystick->getJoystick_sets().begin(); set != joystick->getJoystick_sets().end(); ++set)
+                for (SetJoystick *currentset : joystick->getJoystick_sets())
                 {
-                    SetJoystick *currentset = set.value();
                     VDPad *vdpad = currentset->getVDPad(0);
                     JoyButton *currentbutton = currentset->getJoyButton(button - 1);
 
@@ -721,9 +699,8 @@ void AdvanceStickAssignmentDialog::changeVDPadRightButton(int index)
     } else
     {
 
-        for (auto set = joystick->getJoystick_sets().begin(); set != joystick->getJoystick_sets().end(); ++set)
+        for (SetJoystick *currentset : joystick->getJoystick_sets())
         {
-            SetJoystick *currentset = set.value();
             VDPad *vdpad = currentset->getVDPad(0);
 
             if ((vdpad != nullptr) && vdpad->getVButton(JoyDPadButton::DpadRight))
@@ -75,6 +75,9 @@ Calibration::Calibration(InputDevice *joystick, QDialog *parent)
         ++device_count;
     }
 
+    // Sensor calibration needs events even if the profile does not use the sensors.
+    m_joystick->requestSensorEvents(true);
+
     connect(m_joystick, &InputDevice::destroyed, this, &Calibration::close);
     connect(m_ui->resetBtn, &QPushButton::clicked, this, &Calibration::resetSettings);
     connect(m_ui->saveBtn, &QPushButton::clicked, this, &Calibration::saveSettings);
@@ -95,7 +98,13 @@ Calibration::Calibration(InputDevice *joystick, QDialog *parent)
     update();
 }
 
-Calibration::~Calibration() { delete m_ui; }
+Calibration::~Calibration()
+{
+    if (!m_joystick.isNull())
+        m_joystick->requestSensorEvents(false);
+
+    delete m_ui;
+}
 
 /**
  * @brief Ask for confirmation when the dialog is closed with unsafed changed.
@@ -280,16 +289,21 @@ void Calibration::selectTypeIndex(unsigned int type_index)
         {
             m_sensor = m_joystick->getActiveSetJoystick()->getSensor(GYROSCOPE);
             m_ui->steps->setText(tr("Gyroscope calibration corrects the sensor offset. "
-                                    "This prevents cursor movement while the controller is at rest."));
+                                    "This prevents cursor movement while the controller is at rest. "
+                                    "The offset is also tracked automatically whenever the controller rests."));
             connect(m_ui->startBtn, &QPushButton::clicked, this, &Calibration::startGyroscopeCalibration);
         }
 
         m_ui->statusStack->setCurrentIndex(0);
         m_calibrated = m_sensor->isCalibrated();
+        double offsetX, offsetY, offsetZ;
 
-        if (m_calibrated)
+        if (m_type == CAL_GYROSCOPE && m_joystick->getGyroscopeBias(&offsetX, &offsetY, &offsetZ))
+        {
+            m_calibrated = true;
+            showSensorCalibrationValues(true, offsetX, true, offsetY, true, offsetZ);
+        } else if (m_calibrated)
         {
-            double offsetX, offsetY, offsetZ;
             m_sensor->getCalibration(&offsetX, &offsetY, &offsetZ);
             showSensorCalibrationValues(true, offsetX, true, offsetY, true, offsetZ);
         } else
@@ -358,6 +372,9 @@ void Calibration::resetCalibrationValues()
     {
         m_sensor->resetCalibration();
         showSensorCalibrationValues(false, 0, false, 0, false, 0);
+
+        if (m_type == CAL_GYROSCOPE)
+            QMetaObject::invokeMethod(m_joystick, "resetGyroscopeBias", Qt::QueuedConnection);
     }
 
     m_calibrated = false;
@@ -23,6 +23,7 @@
 #include <QDateTime>
 #include <QDialog>
 #include <QElapsedTimer>
+#include <QPointer>
 
 class JoyControlStick;
 class JoySensor;
@@ -76,7 +77,7 @@ class Calibration : public QDialog
     bool m_changed;
     JoyControlStick *m_stick;
     JoySensor *m_sensor;
-    InputDevice *m_joystick;
+    QPointer<InputDevice> m_joystick;
 
     StatisticsEstimator m_offset[3];
     StatisticsEstimator m_min[2];
@@ -334,7 +334,7 @@ void GameControllerMappingDialog::saveChanges()
 
     settings->setValue(QString("Mappings/").append(device->getUniqueIDString()), mappingString);
     settings->setValue(QString("Mappings/%1%2").arg(device->getUniqueIDString()).arg("Disable"), "0");
-    settings->sync();
+    settings->scheduleSync();
 
     settings->getLock()->unlock();
 
@@ -473,7 +473,7 @@ void GameControllerMappingDialog::removeControllerMapping()
     // settings->remove(QString("%1Disable").arg(device->getGUIDString()));
     settings->remove(QString("%1Disable").arg(device->getUniqueIDString()));
     settings->endGroup();
-    settings->sync();
+    settings->scheduleSync();
 
     settings->getLock()->unlock();
 }
@@ -38,6 +38,7 @@ JoySensorEditDialog::JoySensorEditDialog(JoySensor *sensor, QWidget *parent)
     : QDialog(parent, Qt::Window)
     , m_ui(new Ui::JoySensorEditDialog)
     , m_sensor(sensor)
+    , m_device(sensor->getParentSet()->getInputDevice())
     , m_preset(sensor)
 {
     m_ui->setupUi(this);
@@ -147,6 +148,8 @@ JoySensorEditDialog::JoySensorEditDialog(JoySensor *sensor, QWidget *parent)
     connect(m_ui->sensorDelayDoubleSpinBox, static_cast<void (QDoubleSpinBox::*)(double)>(&QDoubleSpinBox::valueChanged),
             this, &JoySensorEditDialog::setSensorDelay);
 
+    // The live values are shown even if no slots are assigned yet.
+    m_device->requestSensorEvents(true);
     connect(m_sensor, &JoySensor::moved, this, &JoySensorEditDialog::updateSensorStats);
     connect(m_ui->mouseSettingsPushButton, &QPushButton::clicked, this, &JoySensorEditDialog::openMouseSettingsDialog);
 
@@ -154,7 +157,13 @@ JoySensorEditDialog::JoySensorEditDialog(JoySensor *sensor, QWidget *parent)
     connect(m_sensor, &JoySensor::sensorNameChanged, this, &JoySensorEditDialog::updateWindowTitleSensorName);
 }
 
-JoySensorEditDialog::~JoySensorEditDialog() { delete m_ui; }
+JoySensorEditDialog::~JoySensorEditDialog()
+{
+    if (!m_device.isNull())
+        m_device->requestSensorEvents(false);
+
+    delete m_ui;
+}
 
 /**
  * @brief Preset combo box event handler. Applies selected preset to underlying sensor.
@@ -19,7 +19,9 @@
 #include "joysensorpreset.h"
 
 #include <QDialog>
+#include <QPointer>
 
+class InputDevice;
 class JoySensor;
 class QWidget;
 
@@ -43,6 +45,7 @@ class JoySensorEditDialog : public QDialog
     bool m_keypad_unlocked;
 
     JoySensor *m_sensor;
+    QPointer<InputDevice> m_device;
     JoySensorPreset m_preset;
 
   private slots:
@@ -22,6 +22,7 @@
 #include "common.h"
 #include "globalvariables.h"
 #include "inputdevice.h"
+#include "inputstatistics.h"
 #include "joybuttonstatusbox.h"
 #include "joybuttontypes/joydpadbutton.h"
 #include "joydpad.h"
@@ -32,6 +33,7 @@
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QProgressBar>
+#include <QPushButton>
 #include <QSpacerItem>
 #include <QVBoxLayout>
 #include <QWidget>
@@ -298,11 +300,25 @@ JoystickStatusWindow::JoystickStatusWindow(InputDevice *joystick, QWidget *paren
 
     PadderCommon::inputDaemonMutex.unlock();
 
+    // Raw sensor values are shown even if the profile does not use the sensors.
+    joystick->requestSensorEvents(true);
+
     connect(joystick, &InputDevice::destroyed, this, &JoystickStatusWindow::obliterate);
     connect(this, &JoystickStatusWindow::finished, this, &JoystickStatusWindow::restoreButtonStates);
+
+    updateStatistics();
+    connect(&statisticsTimer, &QTimer::timeout, this, &JoystickStatusWindow::updateStatistics);
+    connect(ui->resetStatisticsButton, &QPushButton::clicked, this, &JoystickStatusWindow::resetStatistics);
+    statisticsTimer.start(InputStatistics::WINDOW_MSECS);
 }
 
-JoystickStatusWindow::~JoystickStatusWindow() { delete ui; }
+JoystickStatusWindow::~JoystickStatusWindow()
+{
+    if (!joystick.isNull())
+        joystick->requestSensorEvents(false);
+
+    delete ui;
+}
 
 void JoystickStatusWindow::restoreButtonStates(int code)
 {
@@ -341,4 +357,58 @@ void JoystickStatusWindow::updateGyroscopeValues(float valueX, float valueY, flo
     m_gyro_axes[2]->setValue(JoySensor::radToDeg(valueZ) * 1000);
 }
 
+/**
+ * @brief Shows event rates of this controller and the load of the input thread
+ *  of the last statistics window.
+ */
+void JoystickStatusWindow::updateStatistics()
+{
+    InputStatistics::Snapshot stats = InputStatistics::snapshot();
+    InputStatistics::DeviceRates rates = stats.devices.value(joystick->getSDLJoystickID());
+
+    QStringList lines;
+    lines.append(tr("Events/s: %1 axis, %2 button, %3 hat, %4 sensor, %5 touchpad")
+                     .arg(rates.rates[InputStatistics::AxisEvent], 0, 'f', 0)
+                     .arg(rates.rates[InputStatistics::ButtonEvent], 0, 'f', 0)
+                     .arg(rates.rates[InputStatistics::HatEvent], 0, 'f', 0)
+                     .arg(rates.rates[InputStatistics::SensorEvent], 0, 'f', 0)
+                     .arg(rates.rates[InputStatistics::TouchpadEvent], 0, 'f', 0));
+    lines.append(tr("Max events per cycle: %1 (overall %2), coalesced events/s: %3")
+                     .arg(rates.maxQueueDepth)
+                     .arg(rates.maxQueueDepthTotal)
+                     .arg(rates.coalescedPerSecond, 0, 'f', 0));
+    lines.append(tr("Dispatch time per cycle: p50 %1 µs, p99 %2 µs, mean %3 ± %4 µs")
+                     .arg(rates.dispatchP50)
+                     .arg(rates.dispatchP99)
+                     .arg(rates.dispatchMean, 0, 'f', 1)
+                     .arg(rates.dispatchStdDev, 0, 'f', 1));
+    lines.append(QString());
+    lines.append(tr("All controllers:"));
+    lines.append(tr("Poll cycles/s: %1, max queue depth: %2 (overall %3), coalesced events/s: %4")
+                     .arg(stats.cyclesPerSecond, 0, 'f', 0)
+                     .arg(stats.maxQueueDepth)
+                     .arg(stats.maxQueueDepthTotal)
+                     .arg(stats.coalescedPerSecond, 0, 'f', 0));
+    lines.append(tr("Dispatch time: p50 %1 µs, p99 %2 µs, mean %3 ± %4 µs")
+                     .arg(stats.dispatchP50)
+                     .arg(stats.dispatchP99)
+                     .arg(stats.dispatchMean, 0, 'f', 1)
+                     .arg(stats.dispatchStdDev, 0, 'f', 1));
+    lines.append(tr("Mouse ticks/s: %1, event handler syscalls/s: %2")
+                     .arg(stats.mouseTicksPerSecond, 0, 'f', 0)
+                     .arg(stats.syscallsPerSecond, 0, 'f', 0));
+
+    ui->statisticsLabel->setText(lines.join("\n"));
+}
+
+/**
+ * @brief Clears the statistics of all controllers, so maxima and estimates
+ *  start over, e.g. after changing a profile.
+ */
+void JoystickStatusWindow::resetStatistics()
+{
+    InputStatistics::reset();
+    updateStatistics();
+}
+
 InputDevice *JoystickStatusWindow::getJoystick() const { return joystick; }
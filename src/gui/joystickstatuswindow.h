@@ -20,6 +20,8 @@
 #define JOYSTICKSTATUSWINDOW_H
 
 #include <QDialog>
+#include <QPointer>
+#include <QTimer>
 
 class InputDevice;
 class QProgressBar;
@@ -46,15 +48,18 @@ class JoystickStatusWindow : public QDialog
   private:
     Ui::JoystickStatusWindow *ui;
 
-    InputDevice *joystick;
+    QPointer<InputDevice> joystick;
     QProgressBar *m_accel_axes[3];
     QProgressBar *m_gyro_axes[3];
+    QTimer statisticsTimer;
 
   private slots:
     void restoreButtonStates(int code);
     void obliterate();
     void updateAccelerometerValues(float valueX, float valueY, float valueZ);
     void updateGyroscopeValues(float valueX, float valueY, float valueZ);
+    void updateStatistics();
+    void resetStatistics();
 };
 
 #endif // JOYSTICKSTATUSWINDOW_H
@@ -36,6 +36,8 @@
 #include "joydpad.h"
 #include "joysensor.h"
 #include "joystick.h"
+#include "profilehotreloader.h"
+#include "profileindex.h"
 #include "quicksetdialog.h"
 #include "sensorpushbuttongroup.h"
 #include "setnamesdialog.h"
@@ -149,166 +151,31 @@ JoyTabWidget::JoyTabWidget(InputDevice *joystick, AntiMicroSettings *settings, Q
     stackedWidget_2 = new QStackedWidget(this);
     stackedWidget_2->setObjectName(QString::fromUtf8("stackedWidget_2"));
 
-    page = new QWidget();
-    page->setObjectName(QString::fromUtf8("page"));
-
-    QVBoxLayout *tempVBoxLayout = new QVBoxLayout(page);
-    QScrollArea *scrollArea = new QScrollArea();
-    scrollArea->setObjectName(QString::fromUtf8("scrollArea1"));
     QSizePolicy sizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-    scrollArea->setSizePolicy(sizePolicy);
-    scrollArea->setWidgetResizable(true);
-
-    QWidget *scrollAreaWidgetContents1 = new QWidget();
-    scrollAreaWidgetContents1->setObjectName(QString::fromUtf8("scrollAreaWidgetContents1"));
-
-    gridLayout = new QGridLayout(scrollAreaWidgetContents1);
-    gridLayout->setSpacing(4);
-    gridLayout->setObjectName(QString::fromUtf8("gridLayout"));
-
-    scrollArea->setWidget(scrollAreaWidgetContents1);
-    tempVBoxLayout->addWidget(scrollArea);
-    stackedWidget_2->addWidget(page);
-
-    page_2 = new QWidget();
-    page_2->setObjectName(QString::fromUtf8("page_2"));
-
-    tempVBoxLayout = new QVBoxLayout(page_2);
-    QScrollArea *scrollArea2 = new QScrollArea();
-    scrollArea2->setObjectName(QString::fromUtf8("scrollArea2"));
-    scrollArea2->setSizePolicy(sizePolicy);
-    scrollArea2->setWidgetResizable(true);
-
-    QWidget *scrollAreaWidgetContents2 = new QWidget();
-    scrollAreaWidgetContents2->setObjectName(QString::fromUtf8("scrollAreaWidgetContents2"));
-
-    gridLayout2 = new QGridLayout(scrollAreaWidgetContents2);
-    gridLayout2->setSpacing(4);
-    gridLayout2->setObjectName(QString::fromUtf8("gridLayout2"));
-
-    scrollArea2->setWidget(scrollAreaWidgetContents2);
-    tempVBoxLayout->addWidget(scrollArea2);
-    stackedWidget_2->addWidget(page_2);
-
-    page_3 = new QWidget();
-    page_3->setObjectName(QString::fromUtf8("page_3"));
-
-    tempVBoxLayout = new QVBoxLayout(page_3);
-    QScrollArea *scrollArea3 = new QScrollArea();
-    scrollArea3->setObjectName(QString::fromUtf8("scrollArea3"));
-    scrollArea3->setSizePolicy(sizePolicy);
-    scrollArea3->setWidgetResizable(true);
-
-    QWidget *scrollAreaWidgetContents3 = new QWidget();
-    scrollAreaWidgetContents3->setObjectName(QString::fromUtf8("scrollAreaWidgetContents3"));
-
-    gridLayout3 = new QGridLayout(scrollAreaWidgetContents3);
-    gridLayout3->setSpacing(4);
-    gridLayout3->setObjectName(QString::fromUtf8("gridLayout3"));
-
-    scrollArea3->setWidget(scrollAreaWidgetContents3);
-    tempVBoxLayout->addWidget(scrollArea3);
-    stackedWidget_2->addWidget(page_3);
-
-    page_4 = new QWidget();
-    page_4->setObjectName(QString::fromUtf8("page_4"));
-
-    tempVBoxLayout = new QVBoxLayout(page_4);
-    QScrollArea *scrollArea4 = new QScrollArea();
-    scrollArea4->setObjectName(QString::fromUtf8("scrollArea4"));
-    scrollArea4->setSizePolicy(sizePolicy);
-    scrollArea4->setWidgetResizable(true);
-
-    QWidget *scrollAreaWidgetContents4 = new QWidget();
-    scrollAreaWidgetContents4->setObjectName(QString::fromUtf8("scrollAreaWidgetContents4"));
-
-    gridLayout4 = new QGridLayout(scrollAreaWidgetContents4);
-    gridLayout4->setSpacing(4);
-    gridLayout4->setObjectName(QString::fromUtf8("gridLayout4"));
-
-    scrollArea4->setWidget(scrollAreaWidgetContents4);
-    tempVBoxLayout->addWidget(scrollArea4);
-    stackedWidget_2->addWidget(page_4);
-
-    page_5 = new QWidget();
-    page_5->setObjectName(QString::fromUtf8("page_5"));
-
-    tempVBoxLayout = new QVBoxLayout(page_5);
-    QScrollArea *scrollArea5 = new QScrollArea();
-    scrollArea5->setObjectName(QString::fromUtf8("scrollArea5"));
-    scrollArea5->setSizePolicy(sizePolicy);
-    scrollArea5->setWidgetResizable(true);
-
-    QWidget *scrollAreaWidgetContents5 = new QWidget();
-    scrollAreaWidgetContents5->setObjectName(QString::fromUtf8("scrollAreaWidgetContents5"));
-
-    gridLayout5 = new QGridLayout(scrollAreaWidgetContents5);
-    gridLayout5->setSpacing(4);
-    gridLayout5->setObjectName(QString::fromUtf8("gridLayout5"));
-
-    scrollArea5->setWidget(scrollAreaWidgetContents5);
-    tempVBoxLayout->addWidget(scrollArea5);
-    stackedWidget_2->addWidget(page_5);
-
-    page_6 = new QWidget();
-    page_6->setObjectName(QString::fromUtf8("page_6"));
-
-    tempVBoxLayout = new QVBoxLayout(page_6);
-    QScrollArea *scrollArea6 = new QScrollArea();
-    scrollArea6->setObjectName(QString::fromUtf8("scrollArea6"));
-    scrollArea6->setSizePolicy(sizePolicy);
-    scrollArea6->setWidgetResizable(true);
 
-    QWidget *scrollAreaWidgetContents6 = new QWidget();
-    scrollAreaWidgetContents6->setObjectName(QString::fromUtf8("scrollAreaWidgetContents6"));
-
-    gridLayout6 = new QGridLayout(scrollAreaWidgetContents6);
-    gridLayout6->setSpacing(4);
-    gridLayout6->setObjectName(QString::fromUtf8("gridLayout6"));
-
-    scrollArea6->setWidget(scrollAreaWidgetContents6);
-    tempVBoxLayout->addWidget(scrollArea6);
-    stackedWidget_2->addWidget(page_6);
-
-    page_7 = new QWidget();
-    page_7->setObjectName(QString::fromUtf8("page_7"));
-
-    tempVBoxLayout = new QVBoxLayout(page_7);
-    QScrollArea *scrollArea7 = new QScrollArea();
-    scrollArea7->setObjectName(QString::fromUtf8("scrollArea7"));
-    scrollArea7->setSizePolicy(sizePolicy);
-    scrollArea7->setWidgetResizable(true);
-
-    QWidget *scrollAreaWidgetContents7 = new QWidget();
-    scrollAreaWidgetContents7->setObjectName(QString::fromUtf8("scrollAreaWidgetContents7"));
-
-    gridLayout7 = new QGridLayout(scrollAreaWidgetContents7);
-    gridLayout7->setSpacing(4);
-    gridLayout7->setObjectName(QString::fromUtf8("gridLayout7"));
-
-    scrollArea7->setWidget(scrollAreaWidgetContents7);
-    tempVBoxLayout->addWidget(scrollArea7);
-    stackedWidget_2->addWidget(page_7);
-
-    page_8 = new QWidget();
-    page_8->setObjectName(QString::fromUtf8("page_8"));
+    for (int i = 0; i < GlobalVariables::InputDevice::NUMBER_JOYSETS; i++)
+    {
+        QWidget *page = new QWidget();
+        page->setObjectName(QString("page_%1").arg(i + 1));
 
-    tempVBoxLayout = new QVBoxLayout(page_8);
-    QScrollArea *scrollArea8 = new QScrollArea();
-    scrollArea8->setObjectName(QString::fromUtf8("scrollArea8"));
-    scrollArea8->setSizePolicy(sizePolicy);
-    scrollArea8->setWidgetResizable(true);
+        QVBoxLayout *tempVBoxLayout = new QVBoxLayout(page);
+        QScrollArea *scrollArea = new QScrollArea();
+        scrollArea->setObjectName(QString("scrollArea%1").arg(i + 1));
+        scrollArea->setSizePolicy(sizePolicy);
+        scrollArea->setWidgetResizable(true);
 
-    QWidget *scrollAreaWidgetContents8 = new QWidget();
-    scrollAreaWidgetContents8->setObjectName(QString::fromUtf8("scrollAreaWidgetContents8"));
+        QWidget *scrollAreaWidgetContents = new QWidget();
+        scrollAreaWidgetContents->setObjectName(QString("scrollAreaWidgetContents%1").arg(i + 1));
 
-    gridLayout8 = new QGridLayout(scrollAreaWidgetContents8);
-    gridLayout8->setSpacing(4);
-    gridLayout8->setObjectName(QString::fromUtf8("gridLayout8"));
+        QGridLayout *gridLayout = new QGridLayout(scrollAreaWidgetContents);
+        gridLayout->setSpacing(4);
+        gridLayout->setObjectName(QString("gridLayout%1").arg(i + 1));
+        setGridLayouts.append(gridLayout);
 
-    scrollArea8->setWidget(scrollAreaWidgetContents8);
-    tempVBoxLayout->addWidget(scrollArea8);
-    stackedWidget_2->addWidget(page_8);
+        scrollArea->setWidget(scrollAreaWidgetContents);
+        tempVBoxLayout->addWidget(scrollArea);
+        stackedWidget_2->addWidget(page);
+    }
 
     verticalLayout->addWidget(stackedWidget_2);
 
@@ -330,88 +197,34 @@ JoyTabWidget::JoyTabWidget(InputDevice *joystick, AntiMicroSettings *settings, Q
 
     refreshCopySetActions();
 
-    setAction1 = new QAction(tr("Set 1"), setMenu);
-    connect(setAction1, &QAction::triggered, this, &JoyTabWidget::changeSetOne);
-    setMenu->addAction(setAction1);
-
-    setAction2 = new QAction(tr("Set 2"), setMenu);
-    connect(setAction2, &QAction::triggered, this, &JoyTabWidget::changeSetTwo);
-    setMenu->addAction(setAction2);
-
-    setAction3 = new QAction(tr("Set 3"), setMenu);
-    connect(setAction3, &QAction::triggered, this, &JoyTabWidget::changeSetThree);
-    setMenu->addAction(setAction3);
-
-    setAction4 = new QAction(tr("Set 4"), setMenu);
-    connect(setAction4, &QAction::triggered, this, &JoyTabWidget::changeSetFour);
-    setMenu->addAction(setAction4);
-
-    setAction5 = new QAction(tr("Set 5"), setMenu);
-    connect(setAction5, &QAction::triggered, this, &JoyTabWidget::changeSetFive);
-    setMenu->addAction(setAction5);
-
-    setAction6 = new QAction(tr("Set 6"), setMenu);
-    connect(setAction6, &QAction::triggered, this, &JoyTabWidget::changeSetSix);
-    setMenu->addAction(setAction6);
-
-    setAction7 = new QAction(tr("Set 7"), setMenu);
-    connect(setAction7, &QAction::triggered, this, &JoyTabWidget::changeSetSeven);
-    setMenu->addAction(setAction7);
-
-    setAction8 = new QAction(tr("Set 8"), setMenu);
-    connect(setAction8, &QAction::triggered, this, &JoyTabWidget::changeSetEight);
-    setMenu->addAction(setAction8);
+    for (int i = 0; i < GlobalVariables::InputDevice::NUMBER_JOYSETS; i++)
+    {
+        QAction *setAction = new QAction(tr("Set %1").arg(i + 1), setMenu);
+        connect(setAction, &QAction::triggered, this, [this, i] { changeSet(i); });
+        setMenu->addAction(setAction);
+        setActions.append(setAction);
+    }
 
     setsMenuButton->setMenu(setMenu);
     horizontalLayout_2->addWidget(setsMenuButton);
 
-    setPushButton1 = new QPushButton("1", this);
-    setPushButton1->setObjectName(QString::fromUtf8("setPushButton1"));
-    setPushButton1->setProperty("setActive", true);
-
-    horizontalLayout_2->addWidget(setPushButton1);
-
-    setPushButton2 = new QPushButton("2", this);
-    setPushButton2->setObjectName(QString::fromUtf8("setPushButton2"));
-    setPushButton2->setProperty("setActive", false);
-
-    horizontalLayout_2->addWidget(setPushButton2);
-
-    setPushButton3 = new QPushButton("3", this);
-    setPushButton3->setObjectName(QString::fromUtf8("setPushButton3"));
-    setPushButton3->setProperty("setActive", false);
+    // Rows of a few buttons keep the tab narrow when many sets are available.
+    QGridLayout *setButtonsLayout = new QGridLayout();
+    setButtonsLayout->setSpacing(6);
+    setButtonsLayout->setObjectName(QString::fromUtf8("setButtonsLayout"));
 
-    horizontalLayout_2->addWidget(setPushButton3);
-
-    setPushButton4 = new QPushButton("4", this);
-    setPushButton4->setObjectName(QString::fromUtf8("setPushButton4"));
-    setPushButton4->setProperty("setActive", false);
-
-    horizontalLayout_2->addWidget(setPushButton4);
-
-    setPushButton5 = new QPushButton("5", this);
-    setPushButton5->setObjectName(QString::fromUtf8("setPushButton5"));
-    setPushButton5->setProperty("setActive", false);
-
-    horizontalLayout_2->addWidget(setPushButton5);
-
-    setPushButton6 = new QPushButton("6", this);
-    setPushButton6->setObjectName(QString::fromUtf8("setPushButton6"));
-    setPushButton6->setProperty("setActive", false);
-
-    horizontalLayout_2->addWidget(setPushButton6);
-
-    setPushButton7 = new QPushButton("7", this);
-    setPushButton7->setObjectName(QString::fromUtf8("setPushButton7"));
-    setPushButton7->setProperty("setActive", false);
-
-    horizontalLayout_2->addWidget(setPushButton7);
+    for (int i = 0; i < GlobalVariables::InputDevice::NUMBER_JOYSETS; i++)
+    {
+        QPushButton *setPushButton = new QPushButton(QString::number(i + 1), this);
+        setPushButton->setObjectName(QString("setPushButton%1").arg(i + 1));
+        setPushButton->setProperty("setActive", i == 0);
+        connect(setPushButton, &QPushButton::clicked, this, [this, i] { changeSet(i); });
 
-    setPushButton8 = new QPushButton("8", this);
-    setPushButton8->setObjectName(QString::fromUtf8("setPushButton8"));
-    setPushButton8->setProperty("setActive", false);
+        setButtonsLayout->addWidget(setPushButton, i / SET_BUTTONS_PER_ROW, i % SET_BUTTONS_PER_ROW);
+        setPushButtons.append(setPushButton);
+    }
 
-    horizontalLayout_2->addWidget(setPushButton8);
+    horizontalLayout_2->addLayout(setButtonsLayout);
 
     refreshSetButtons();
 
@@ -491,14 +304,6 @@ JoyTabWidget::JoyTabWidget(InputDevice *joystick, AntiMicroSettings *settings, Q
     connect(saveAsButton, &QPushButton::clicked, this, &JoyTabWidget::saveAsConfig);
     connect(delayButton, &QPushButton::clicked, this, &JoyTabWidget::showKeyDelayDialog);
     connect(removeButton, &QPushButton::clicked, this, &JoyTabWidget::removeConfig);
-    connect(setPushButton1, &QPushButton::clicked, this, &JoyTabWidget::changeSetOne);
-    connect(setPushButton2, &QPushButton::clicked, this, &JoyTabWidget::changeSetTwo);
-    connect(setPushButton3, &QPushButton::clicked, this, &JoyTabWidget::changeSetThree);
-    connect(setPushButton4, &QPushButton::clicked, this, &JoyTabWidget::changeSetFour);
-    connect(setPushButton5, &QPushButton::clicked, this, &JoyTabWidget::changeSetFive);
-    connect(setPushButton6, &QPushButton::clicked, this, &JoyTabWidget::changeSetSix);
-    connect(setPushButton7, &QPushButton::clicked, this, &JoyTabWidget::changeSetSeven);
-    connect(setPushButton8, &QPushButton::clicked, this, &JoyTabWidget::changeSetEight);
 
     connect(stickAssignPushButton, &QPushButton::clicked, this, &JoyTabWidget::showStickAssignmentDialog);
     connect(gameControllerMappingPushButton, &QPushButton::clicked, this, &JoyTabWidget::openGameControllerMappingWindow);
@@ -510,6 +315,12 @@ JoyTabWidget::JoyTabWidget(InputDevice *joystick, AntiMicroSettings *settings, Q
 
     connect(joystick, &InputDevice::requestProfileLoad, this, &JoyTabWidget::loadConfigFile, Qt::QueuedConnection);
 
+    profileReloader = new ProfileHotReloader(joystick, this);
+    // Queued, so the profile edit notifications of the reloaded elements are handled first.
+    connect(profileReloader, &ProfileHotReloader::profileReloaded, this, &JoyTabWidget::refreshReloadedProfile,
+            Qt::QueuedConnection);
+    connect(profileReloader, &ProfileHotReloader::fullReloadRequired, this, &JoyTabWidget::reloadCurrentProfile);
+
     reconnectCheckUnsavedEvent();
     reconnectMainComboBoxEvents();
 }
@@ -572,30 +383,42 @@ void JoyTabWidget::openConfigFileDialog()
         m_settings->getLock()->lock();
 
         m_settings->setValue("LastProfileDir", outputFilename);
-        m_settings->sync();
+        m_settings->scheduleSync();
 
         m_settings->getLock()->unlock();
+
+        ProfileIndex::getInstance()->setDirectory(PadderCommon::preferredProfileDir(m_settings));
     }
 }
 
 /**
- * @brief Create and render all push buttons corresponding to joystick
- *     controls for all sets.
+ * @brief Request push buttons corresponding to joystick controls for all sets.
+ *     A set page is only rendered once it is shown, so tabs of a hidden window
+ *     and sets that are never looked at cost no widgets.
  */
 void JoyTabWidget::fillButtons()
 {
     m_joystick->establishPropertyUpdatedConnection();
     connect(m_joystick, &InputDevice::setChangeActivated, this, &JoyTabWidget::changeCurrentSet, Qt::QueuedConnection);
 
-    for (int i = 0; i < GlobalVariables::InputDevice::NUMBER_JOYSETS; i++)
-    {
-        SetJoystick *currentSet = m_joystick->getSetJoystick(i);
-        fillSetButtons(currentSet);
-    }
+    setPagesRequested = true;
+    fillCurrentSetPage();
 
     refreshCopySetActions();
 }
 
+/**
+ * @brief Render the push buttons of the set page currently displayed if that
+ *     did not happen yet.
+ */
+void JoyTabWidget::fillCurrentSetPage()
+{
+    int index = stackedWidget_2->currentIndex();
+
+    if (setPagesRequested && isVisible() && !filledSetPages.contains(index))
+        fillSetButtons(m_joystick->getSetJoystick(index));
+}
+
 void JoyTabWidget::showButtonDialog()
 {
     JoyButtonWidget *buttonWidget = qobject_cast<JoyButtonWidget *>(sender()); // static_cast
@@ -718,6 +541,8 @@ void JoyTabWidget::saveConfigFile()
 
                 emit joystickConfigChanged(m_joystick->getJoyNumber());
             }
+
+            profileReloader->watch(fileinfo.absoluteFilePath());
         }
     }
 }
@@ -890,6 +715,8 @@ void JoyTabWidget::saveAsConfig()
                 saveDeviceSettings(true);
                 emit joystickConfigChanged(m_joystick->getJoyNumber());
             }
+
+            profileReloader->watch(fileinfo.absoluteFilePath());
         }
     }
 }
@@ -966,6 +793,7 @@ void JoyTabWidget::changeJoyConfig(int index)
         oldProfileName = "";
     }
 
+    profileReloader->watch(filename);
     comboBoxIndex = index;
 
     connect(m_joystick, &InputDevice::profileUpdated, this, &JoyTabWidget::displayProfileEditNotification);
@@ -1124,8 +952,24 @@ void JoyTabWidget::loadSettings(bool forceRefresh)
 
     m_settings->beginGroup("Controllers");
 
-    convToUniqueIDControllerGroupSett(m_settings, QString("Controller%1LastSelected").arg(m_joystick->getGUIDString()),
-                                      QString("Controller%1LastSelected").arg(m_joystick->getUniqueIDString()));
+    // Entries written by older versions are stored under the GUID. Look for them
+    // once instead of probing every entry, they are gone after the first conversion.
+    const QString guidPrefix = QString("Controller%1").arg(m_joystick->getGUIDString());
+    bool hasGuidEntries = false;
+
+    for (const QString &key : m_settings->childKeys())
+    {
+        if (key.startsWith(guidPrefix + "ConfigFile") || key.startsWith(guidPrefix + "ProfileName") ||
+            (key == guidPrefix + "LastSelected"))
+        {
+            hasGuidEntries = true;
+            break;
+        }
+    }
+
+    if (hasGuidEntries)
+        convToUniqueIDControllerGroupSett(m_settings, QString("Controller%1LastSelected").arg(m_joystick->getGUIDString()),
+                                          QString("Controller%1LastSelected").arg(m_joystick->getUniqueIDString()));
 
     QString controlEntryString = QString("Controller%1ConfigFile%2").arg(m_joystick->getStringIdentifier());
     QString controlEntryLastSelected = QString("Controller%1LastSelected").arg(m_joystick->getStringIdentifier());
@@ -1138,23 +982,29 @@ void JoyTabWidget::loadSettings(bool forceRefresh)
 
         if (!m_joystick->getStringIdentifier().isEmpty())
         {
-            convToUniqueIDControllerGroupSett(
-                m_settings, QString("Controller%1ConfigFile%2").arg(m_joystick->getGUIDString()).arg(configFileNum),
-                QString("Controller%1ConfigFile%2").arg(m_joystick->getUniqueIDString()).arg(configFileNum));
+            if (hasGuidEntries)
+                convToUniqueIDControllerGroupSett(
+                    m_settings, QString("Controller%1ConfigFile%2").arg(m_joystick->getGUIDString()).arg(configFileNum),
+                    QString("Controller%1ConfigFile%2").arg(m_joystick->getUniqueIDString()).arg(configFileNum));
             tempfilepath = m_settings->value(controlEntryString.arg(configFileNum), "").toString();
         }
 
         if (!tempfilepath.isEmpty())
         {
             QFileInfo fileInfo(tempfilepath);
+            ProfileIndex *profileIndex = ProfileIndex::getInstance();
 
-            if (fileInfo.exists() && (configBox->findData(fileInfo.absoluteFilePath()) == -1))
+            // Indexed profiles are known to exist, only others have to be probed.
+            if ((profileIndex->contains(fileInfo.absoluteFilePath()) || fileInfo.exists()) &&
+                (configBox->findData(fileInfo.absoluteFilePath()) == -1))
             {
-                convToUniqueIDControllerGroupSett(
-                    m_settings, QString("Controller%1ProfileName%2").arg(m_joystick->getGUIDString()).arg(configFileNum),
-                    QString("Controller%1ProfileName%2").arg(m_joystick->getUniqueIDString()).arg(configFileNum));
+                if (hasGuidEntries)
+                    convToUniqueIDControllerGroupSett(
+                        m_settings,
+                        QString("Controller%1ProfileName%2").arg(m_joystick->getGUIDString()).arg(configFileNum),
+                        QString("Controller%1ProfileName%2").arg(m_joystick->getUniqueIDString()).arg(configFileNum));
                 QString profileName = m_settings->value(controlEntryProfileName.arg(configFileNum), "").toString();
-                profileName = !profileName.isEmpty() ? profileName : PadderCommon::getProfileName(fileInfo);
+                profileName = !profileName.isEmpty() ? profileName : profileIndex->getProfileName(fileInfo);
                 configBox->addItem(profileName, fileInfo.absoluteFilePath());
             }
         } else
@@ -1237,39 +1087,8 @@ QString JoyTabWidget::getConfigName(int index) { return configBox->itemText(inde
 // Switch widget to currently selected Set
 void JoyTabWidget::changeCurrentSet(int index)
 {
-    int currentPage = stackedWidget_2->currentIndex();
-    QPushButton *oldSetButton = nullptr;
-    QPushButton *activeSetButton = nullptr;
-
-    switch (currentPage)
-    {
-    case 0:
-        oldSetButton = setPushButton1;
-        break;
-    case 1:
-        oldSetButton = setPushButton2;
-        break;
-    case 2:
-        oldSetButton = setPushButton3;
-        break;
-    case 3:
-        oldSetButton = setPushButton4;
-        break;
-    case 4:
-        oldSetButton = setPushButton5;
-        break;
-    case 5:
-        oldSetButton = setPushButton6;
-        break;
-    case 6:
-        oldSetButton = setPushButton7;
-        break;
-    case 7:
-        oldSetButton = setPushButton8;
-        break;
-    default:
-        break;
-    }
+    QPushButton *oldSetButton = setPushButtons.value(stackedWidget_2->currentIndex(), nullptr);
+    QPushButton *activeSetButton = setPushButtons.value(index, nullptr);
 
     if (oldSetButton != nullptr)
     {
@@ -1279,36 +1098,7 @@ void JoyTabWidget::changeCurrentSet(int index)
     }
 
     stackedWidget_2->setCurrentIndex(index);
-
-    switch (index)
-    {
-    case 0:
-        activeSetButton = setPushButton1;
-        break;
-    case 1:
-        activeSetButton = setPushButton2;
-        break;
-    case 2:
-        activeSetButton = setPushButton3;
-        break;
-    case 3:
-        activeSetButton = setPushButton4;
-        break;
-    case 4:
-        activeSetButton = setPushButton5;
-        break;
-    case 5:
-        activeSetButton = setPushButton6;
-        break;
-    case 6:
-        activeSetButton = setPushButton7;
-        break;
-    case 7:
-        activeSetButton = setPushButton8;
-        break;
-    default:
-        break;
-    }
+    fillCurrentSetPage();
 
     if (activeSetButton != nullptr)
     {
@@ -1318,52 +1108,10 @@ void JoyTabWidget::changeCurrentSet(int index)
     }
 }
 
-void JoyTabWidget::changeSetOne()
-{
-    m_joystick->setActiveSetNumber(0);
-    changeCurrentSet(0);
-}
-
-void JoyTabWidget::changeSetTwo()
-{
-    m_joystick->setActiveSetNumber(1);
-    changeCurrentSet(1);
-}
-
-void JoyTabWidget::changeSetThree()
+void JoyTabWidget::changeSet(int index)
 {
-    m_joystick->setActiveSetNumber(2);
-    changeCurrentSet(2);
-}
-
-void JoyTabWidget::changeSetFour()
-{
-    m_joystick->setActiveSetNumber(3);
-    changeCurrentSet(3);
-}
-
-void JoyTabWidget::changeSetFive()
-{
-    m_joystick->setActiveSetNumber(4);
-    changeCurrentSet(4);
-}
-
-void JoyTabWidget::changeSetSix()
-{
-    m_joystick->setActiveSetNumber(5);
-    changeCurrentSet(5);
-}
-
-void JoyTabWidget::changeSetSeven()
-{
-    m_joystick->setActiveSetNumber(6);
-    changeCurrentSet(6);
-}
-
-void JoyTabWidget::changeSetEight()
-{
-    m_joystick->setActiveSetNumber(7);
-    changeCurrentSet(7);
+    m_joystick->setActiveSetNumber(index);
+    changeCurrentSet(index);
 }
 
 void JoyTabWidget::showStickAssignmentDialog()
@@ -1439,11 +1187,10 @@ void JoyTabWidget::removeCurrentButtons()
     m_joystick->disconnectPropertyUpdatedConnection();
     disconnect(m_joystick, &InputDevice::setChangeActivated, this, &JoyTabWidget::changeCurrentSet);
 
-    for (int i = 0; i < GlobalVariables::InputDevice::NUMBER_JOYSETS; i++)
-    {
-        SetJoystick *currentSet = m_joystick->getSetJoystick(i);
-        removeSetButtons(currentSet);
-    }
+    setPagesRequested = false;
+
+    for (int index : filledSetPages.values())
+        removeSetButtons(m_joystick->findSetJoystick(index));
 }
 
 InputDevice *JoyTabWidget::getJoystick() { return m_joystick; }
@@ -1483,7 +1230,7 @@ void JoyTabWidget::saveDeviceSettings(bool sync)
     m_settings->endGroup();
 
     if (sync)
-        m_settings->sync();
+        m_settings->scheduleSync();
 
     m_settings->getLock()->unlock();
 }
@@ -1508,48 +1255,12 @@ void JoyTabWidget::refreshSetButtons()
 {
     for (int i = 0; i < GlobalVariables::InputDevice::NUMBER_JOYSETS; i++)
     {
-        QPushButton *tempSetButton = nullptr;
-        QAction *tempSetAction = nullptr;
-        SetJoystick *tempSet = m_joystick->getSetJoystick(i);
-        switch (i)
-        {
-        case 0:
-            tempSetButton = setPushButton1;
-            tempSetAction = setAction1;
-            break;
-        case 1:
-            tempSetButton = setPushButton2;
-            tempSetAction = setAction2;
-            break;
-        case 2:
-            tempSetButton = setPushButton3;
-            tempSetAction = setAction3;
-            break;
-        case 3:
-            tempSetButton = setPushButton4;
-            tempSetAction = setAction4;
-            break;
-        case 4:
-            tempSetButton = setPushButton5;
-            tempSetAction = setAction5;
-            break;
-        case 5:
-            tempSetButton = setPushButton6;
-            tempSetAction = setAction6;
-            break;
-        case 6:
-            tempSetButton = setPushButton7;
-            tempSetAction = setAction7;
-            break;
-        case 7:
-            tempSetButton = setPushButton8;
-            tempSetAction = setAction8;
-            break;
-        default:
-            break;
-        }
+        QPushButton *tempSetButton = setPushButtons.at(i);
+        QAction *tempSetAction = setActions.at(i);
+        // Only names are shown, sets are not created for them.
+        SetJoystick *tempSet = m_joystick->findSetJoystick(i);
 
-        if (!tempSet->getName().isEmpty())
+        if ((tempSet != nullptr) && !tempSet->getName().isEmpty())
         {
             QString tempName = tempSet->getName();
             QString tempNameEscaped = tempName;
@@ -1605,14 +1316,6 @@ void JoyTabWidget::retranslateUi()
     saveAsButton->setToolTip(tr("Save changes to a new configuration file."));
 
     setsMenuButton->setText(tr("Sets"));
-    setAction1->setText(tr("Set 1"));
-    setAction2->setText(tr("Set 2"));
-    setAction3->setText(tr("Set 3"));
-    setAction4->setText(tr("Set 4"));
-    setAction5->setText(tr("Set 5"));
-    setAction6->setText(tr("Set 6"));
-    setAction7->setText(tr("Set 7"));
-    setAction8->setText(tr("Set 8"));
 
     refreshSetButtons();
     refreshCopySetActions();
@@ -1930,44 +1633,8 @@ void JoyTabWidget::fillSetButtons(SetJoystick *set)
     int column = 0;
 
     // QWidget *child = 0;
-    QGridLayout *current_layout = nullptr;
-    switch (set->getIndex())
-    {
-    case 0: {
-        current_layout = gridLayout;
-        break;
-    }
-    case 1: {
-        current_layout = gridLayout2;
-        break;
-    }
-    case 2: {
-        current_layout = gridLayout3;
-        break;
-    }
-    case 3: {
-        current_layout = gridLayout4;
-        break;
-    }
-    case 4: {
-        current_layout = gridLayout5;
-        break;
-    }
-    case 5: {
-        current_layout = gridLayout6;
-        break;
-    }
-    case 6: {
-        current_layout = gridLayout7;
-        break;
-    }
-    case 7: {
-        current_layout = gridLayout8;
-        break;
-    }
-    default:
-        break;
-    }
+    QGridLayout *current_layout = setGridLayouts.value(set->getIndex(), nullptr);
+    filledSetPages.insert(set->getIndex());
 
     SetJoystick *currentSet = set;
     currentSet->establishPropertyUpdatedConnection();
@@ -2340,47 +2007,10 @@ void JoyTabWidget::removeSetButtons(SetJoystick *set)
 {
     SetJoystick *currentSet = set;
     currentSet->disconnectPropertyUpdatedConnection();
+    filledSetPages.remove(currentSet->getIndex());
 
     QLayoutItem *child = nullptr;
-    QGridLayout *current_layout = nullptr;
-    switch (currentSet->getIndex())
-    {
-    case 0: {
-        current_layout = gridLayout;
-        break;
-    }
-    case 1: {
-        current_layout = gridLayout2;
-        break;
-    }
-    case 2: {
-        current_layout = gridLayout3;
-        break;
-    }
-    case 3: {
-        current_layout = gridLayout4;
-        break;
-    }
-    case 4: {
-        current_layout = gridLayout5;
-        break;
-    }
-    case 5: {
-        current_layout = gridLayout6;
-        break;
-    }
-    case 6: {
-        current_layout = gridLayout7;
-        break;
-    }
-    case 7: {
-        current_layout = gridLayout8;
-        break;
-    }
-    default: {
-        break;
-    }
-    }
+    QGridLayout *current_layout = setGridLayouts.value(currentSet->getIndex(), nullptr);
 
     while (current_layout && ((child = current_layout->takeAt(0)) != nullptr))
     {
@@ -2494,9 +2124,9 @@ void JoyTabWidget::refreshCopySetActions()
 
     for (int i = 0; i < GlobalVariables::InputDevice::NUMBER_JOYSETS; i++)
     {
-        SetJoystick *tempSet = m_joystick->getSetJoystick(i);
+        SetJoystick *tempSet = m_joystick->findSetJoystick(i);
         QAction *newaction = nullptr;
-        if (!tempSet->getName().isEmpty())
+        if ((tempSet != nullptr) && !tempSet->getName().isEmpty())
         {
             QString tempName = tempSet->getName();
             QString tempNameEscaped = tempName;
@@ -2596,6 +2226,33 @@ void JoyTabWidget::changeEvent(QEvent *event)
     QWidget::changeEvent(event);
 }
 
+void JoyTabWidget::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    fillCurrentSetPage();
+}
+
+/**
+ * @brief Shows the elements which were changed by a hot reload of the profile.
+ *  The device matches its profile file again afterwards.
+ */
+void JoyTabWidget::refreshReloadedProfile()
+{
+    removeCurrentButtons();
+    fillButtons();
+    refreshSetButtons();
+    refreshCopySetActions();
+
+    m_joystick->revertProfileEdited();
+    removeProfileEditNotification();
+}
+
+void JoyTabWidget::reloadCurrentProfile()
+{
+    if (configBox->currentIndex() > 0)
+        changeJoyConfig(configBox->currentIndex());
+}
+
 void JoyTabWidget::convToUniqueIDControllerGroupSett(QSettings *sett, QString guidControllerSett,
                                                      QString uniqueControllerSett)
 {
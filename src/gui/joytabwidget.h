@@ -20,6 +20,8 @@
 #define JOYTABWIDGET_H
 
 #include <QLabel>
+#include <QList>
+#include <QSet>
 #include <QWidget>
 
 #include <SDL_joystick.h>
@@ -29,6 +31,7 @@
 class InputDevice;
 class AntiMicroSettings;
 class QEvent;
+class QShowEvent;
 class SetJoystick;
 class QVBoxLayout;
 class QHBoxLayout;
@@ -39,6 +42,7 @@ class QSpacerItem;
 class AxisEditDialog;
 class QAction;
 class QMenu;
+class ProfileHotReloader;
 class QStackedWidget;
 class QSettings;
 
@@ -77,7 +81,9 @@ class JoyTabWidget : public QWidget
 
   protected:
     virtual void changeEvent(QEvent *event);
+    virtual void showEvent(QShowEvent *event);
     void removeCurrentButtons();
+    void fillCurrentSetPage();
     void retranslateUi();
     void disconnectMainComboBoxEvents();
     void reconnectMainComboBoxEvents();
@@ -88,6 +94,7 @@ class JoyTabWidget : public QWidget
     bool isKeypadUnlocked();
 
     static const int DEFAULTNUMBERPROFILES = 5;
+    static const int SET_BUTTONS_PER_ROW = 8;
 
   signals:
     void joystickConfigChanged(int index); // JoyTabSettings class
@@ -121,14 +128,7 @@ class JoyTabWidget : public QWidget
     void toggleNames();
     void updateBatteryIcon();
 
-    void changeSetOne();   // JoyTabWidgetSets class
-    void changeSetTwo();   // JoyTabWidgetSets class
-    void changeSetThree(); // JoyTabWidgetSets class
-    void changeSetFour();  // JoyTabWidgetSets class
-    void changeSetFive();  // JoyTabWidgetSets class
-    void changeSetSix();   // JoyTabWidgetSets class
-    void changeSetSeven(); // JoyTabWidgetSets class
-    void changeSetEight(); // JoyTabWidgetSets class
+    void changeSet(int index); // JoyTabWidgetSets class
     void displayProfileEditNotification();
     void removeProfileEditNotification();
     void checkForUnsavedProfile(int newindex = -1);
@@ -151,6 +151,8 @@ class JoyTabWidget : public QWidget
     void refreshSetButtons();     // JoyTabWidgetSets class
     void openGameControllerMappingWindow();
     void propogateMappingUpdate(QString mapping, InputDevice *device);
+    void refreshReloadedProfile();
+    void reloadCurrentProfile();
 
   private:
     QVBoxLayout *verticalLayout;
@@ -164,38 +166,17 @@ class JoyTabWidget : public QWidget
     QPushButton *saveAsButton;
     QPushButton *delayButton;
     QComboBox *configBox;
-    QGridLayout *gridLayout;
-    QGridLayout *gridLayout2;
-    QGridLayout *gridLayout3;
-    QGridLayout *gridLayout4;
-    QGridLayout *gridLayout5;
-    QGridLayout *gridLayout6;
-    QGridLayout *gridLayout7;
-    QGridLayout *gridLayout8;
+    QList<QGridLayout *> setGridLayouts;
 
     QSpacerItem *spacer1;
     QSpacerItem *spacer2;
     QSpacerItem *spacer3;
     AxisEditDialog *axisDialog;
 
-    QPushButton *setPushButton1;
-    QPushButton *setPushButton2;
-    QPushButton *setPushButton3;
-    QPushButton *setPushButton4;
-    QPushButton *setPushButton5;
-    QPushButton *setPushButton6;
-    QPushButton *setPushButton7;
-    QPushButton *setPushButton8;
+    QList<QPushButton *> setPushButtons;
 
     QPushButton *setsMenuButton;
-    QAction *setAction1;
-    QAction *setAction2;
-    QAction *setAction3;
-    QAction *setAction4;
-    QAction *setAction5;
-    QAction *setAction6;
-    QAction *setAction7;
-    QAction *setAction8;
+    QList<QAction *> setActions;
     QMenu *copySetMenu;
 
     QHBoxLayout *horizontalLayout_2;
@@ -205,14 +186,6 @@ class JoyTabWidget : public QWidget
     QPushButton *gameControllerMappingPushButton;
     QSpacerItem *verticalSpacer_2;
     QStackedWidget *stackedWidget_2;
-    QWidget *page;
-    QWidget *page_2;
-    QWidget *page_3;
-    QWidget *page_4;
-    QWidget *page_5;
-    QWidget *page_6;
-    QWidget *page_7;
-    QWidget *page_8;
     QPushButton *pushButton;
     QSpacerItem *verticalSpacer_3;
 
@@ -222,9 +195,12 @@ class JoyTabWidget : public QWidget
     AntiMicroSettings *m_settings;
     int comboBoxIndex = 0;
     bool hideEmptyButtons = false;
+    bool setPagesRequested = false;
+    QSet<int> filledSetPages;
     QString oldProfileName;
 
     JoyTabWidgetHelper tabHelper;
+    ProfileHotReloader *profileReloader;
 
     SDL_JoystickPowerLevel m_old_power_level = SDL_JOYSTICK_POWER_UNKNOWN;
     QTimer *m_battery_updater;
@@ -21,6 +21,7 @@
 #include "joystick.h"
 #include "joytabwidget.h"
 
+#include <QApplication>
 #include <QDebug>
 #include <QTabBar>
 #include <QWidget>
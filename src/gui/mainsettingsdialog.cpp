@@ -27,6 +27,7 @@
 #include "eventhandlerfactory.h"
 #include "globalvariables.h"
 #include "inputdevice.h"
+#include "profileindex.h"
 
 #ifdef WITH_X11
     #include "x11extras.h"
@@ -191,6 +192,11 @@ MainSettingsDialog::MainSettingsDialog(AntiMicroSettings *settings, QList<InputD
 
     ui->showLowBatteryNotification->setChecked(settings->value("Notifications/notify_about_low_battery", true).toBool());
     ui->showEmptyBatteryNotification->setChecked(settings->value("Notifications/notify_about_empty_battery", true).toBool());
+    ui->separatePlayerDevicesCheckBox->setChecked(settings->value("SeparatePlayerDevices", false).toBool());
+
+    // Only the uinput event handler can create devices per controller.
+    if (EventHandlerFactory::getInstance()->handler()->getIdentifier() != "uinput")
+        ui->separatePlayerDevicesCheckBox->setVisible(false);
 
 #ifdef Q_OS_WIN
     bool associateProfiles = settings->value("AssociateProfiles", true).toBool();
@@ -598,6 +604,10 @@ void MainSettingsDialog::saveNewSettings()
     bool notify_bat_empty = ui->showEmptyBatteryNotification->isChecked();
     settings->setValue("Notifications/notify_about_empty_battery", notify_bat_empty);
 
+    bool separatePlayerDevices = ui->separatePlayerDevicesCheckBox->isChecked();
+    bool separatePlayerDevicesChanged = settings->value("SeparatePlayerDevices", false).toBool() != separatePlayerDevices;
+    settings->setValue("SeparatePlayerDevices", separatePlayerDevices ? "1" : "0");
+
 #ifdef Q_OS_WIN
     bool associateProfiles = ui->associateProfilesCheckBox->isChecked();
     settings->setValue("AssociateProfiles", associateProfiles ? "1" : "0");
@@ -718,8 +728,13 @@ void MainSettingsDialog::saveNewSettings()
 
     PadderCommon::unlockInputDevices();
 
-    settings->sync();
+    settings->scheduleSync();
     settings->getLock()->unlock();
+
+    ProfileIndex::getInstance()->setDirectory(PadderCommon::preferredProfileDir(settings));
+
+    if (separatePlayerDevicesChanged)
+        emit playerDevicesChanged();
 }
 
 void MainSettingsDialog::selectDefaultProfileDir()
@@ -1932,6 +1947,7 @@ void MainSettingsDialog::resetGeneralSett()
     ui->keyRepeatEnableCheckBox->setChecked(false);
     ui->showLowBatteryNotification->setChecked(true);
     ui->showEmptyBatteryNotification->setChecked(true);
+    ui->separatePlayerDevicesCheckBox->setChecked(false);
 
     ui->keyDelayHorizontalSlider->setValue(660);
     ui->keyRateHorizontalSlider->setValue(25);
@@ -72,6 +72,7 @@ class MainSettingsDialog : public QDialog
 
   signals:
     void changeLanguage(QString language); // MainSettingsLang class
+    void playerDevicesChanged();
 
   protected slots:
     void mappingsTableItemChanged(QTableWidgetItem *item); // MainSettingsMapping class
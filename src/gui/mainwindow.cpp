@@ -41,6 +41,7 @@
 #include "joystickstatuswindow.h"
 #include "joytabwidget.h"
 #include "mainsettingsdialog.h"
+#include "profileindex.h"
 #include "qkeydisplaydialog.h"
 #include "xml/inputdevicexml.h"
 #include "xml/joybuttonslotxml.h"
@@ -103,6 +104,8 @@ MainWindow::MainWindow(QMap<SDL_JoystickID, InputDevice *> *joysticks, CommandLi
     m_graphical = graphical;
     m_settings = settings;
 
+    ProfileIndex::getInstance()->setDirectory(PadderCommon::preferredProfileDir(settings));
+
     ui->actionStick_Pad_Assign->setVisible(false);
 
 #if defined(WITH_X11)
@@ -154,13 +157,8 @@ MainWindow::MainWindow(QMap<SDL_JoystickID, InputDevice *> *joysticks, CommandLi
     resize(settings->value("WindowSize", size()).toSize());
     move(settings->value("WindowPosition", pos()).toPoint());
 
-    if (graphical)
-    {
-        aboutDialog = new AboutDialog(this);
-    } else
-    {
-        aboutDialog = nullptr;
-    }
+    // The about dialog gathers build and SDL information, create it only when requested.
+    aboutDialog = nullptr;
 
     QMenu *menuPointer = ui->menuQuit;
     connect(ui->menuQuit, &QMenu::aboutToShow, this, [this, menuPointer] { mainMenuChange(menuPointer); });
@@ -991,7 +989,13 @@ void MainWindow::changeEvent(QEvent *event)
     QMainWindow::changeEvent(event);
 }
 
-void MainWindow::openAboutDialog() { aboutDialog->show(); }
+void MainWindow::openAboutDialog()
+{
+    if (aboutDialog == nullptr)
+        aboutDialog = new AboutDialog(this);
+
+    aboutDialog->show();
+}
 
 void MainWindow::loadConfigFile(QString fileLocation, int joystickIndex)
 {
@@ -1051,10 +1055,74 @@ void MainWindow::removeJoyTabs()
 
 void MainWindow::handleInstanceDisconnect()
 {
-    m_settings->sync();
+    m_settings->flush();
     loadAppConfig(true);
 }
 
+JoyTabWidget *MainWindow::findJoyTab(InputDevice *device)
+{
+    for (int i = 0; i < ui->tabWidget->count(); i++)
+    {
+        JoyTabWidget *tab = qobject_cast<JoyTabWidget *>(ui->tabWidget->widget(i)); // static_cast
+        if ((tab != nullptr) && (tab->getJoystick() == device))
+            return tab;
+    }
+
+    return nullptr;
+}
+
+void MainWindow::loadRemoteProfile(InputDevice *device, QString fileLocation)
+{
+    JoyTabWidget *tab = findJoyTab(device);
+
+    if (tab != nullptr)
+        tab->loadConfigFile(fileLocation);
+}
+
+void MainWindow::unloadRemoteProfile(InputDevice *device)
+{
+    JoyTabWidget *tab = findJoyTab(device);
+
+    if (tab != nullptr)
+        tab->unloadConfig();
+}
+
+void MainWindow::switchRemoteProfile(InputDevice *device, QString profileName)
+{
+    JoyTabWidget *tab = findJoyTab(device);
+
+    if (tab == nullptr)
+        return;
+
+    QHash<int, QString> *configs = tab->recentConfigs();
+    QHashIterator<int, QString> configIter(*configs);
+
+    while (configIter.hasNext())
+    {
+        configIter.next();
+
+        if (configIter.value() == profileName)
+        {
+            tab->setCurrentConfig(configIter.key());
+            break;
+        }
+    }
+
+    delete configs;
+    configs = nullptr;
+}
+
+void MainWindow::changeRemoteSet(InputDevice *device, int setIndex)
+{
+    JoyTabWidget *tab = findJoyTab(device);
+
+    if (tab != nullptr)
+    {
+        device->setActiveSetNumber(setIndex);
+        tab->changeCurrentSet(setIndex);
+    }
+}
+
 void MainWindow::openJoystickStatusWindow()
 {
     int index = ui->tabWidget->currentIndex();
@@ -1218,6 +1286,7 @@ void MainWindow::openMainSettingsDialog()
     QList<InputDevice *> *devices = new QList<InputDevice *>(m_joysticks->values());
     MainSettingsDialog *dialog = new MainSettingsDialog(m_settings, devices, this);
     connect(dialog, &MainSettingsDialog::changeLanguage, this, &MainWindow::changeLanguage);
+    connect(dialog, &MainSettingsDialog::playerDevicesChanged, this, &MainWindow::playerDevicesChanged);
 
     if (appWatcher != nullptr)
     {
@@ -91,6 +91,7 @@ class MainWindow : public QMainWindow
     void joystickRefreshRequested();
     void readConfig(int index); // MainConfiguration class
     void mappingUpdated(QString mapping, InputDevice *device);
+    void playerDevicesChanged();
 
   public slots:
     void checkEachTenMinutesBattery(QMap<SDL_JoystickID, InputDevice *> *joysticks);
@@ -112,6 +113,10 @@ class MainWindow : public QMainWindow
     void addJoyTab(InputDevice *device);
     void selectControllerJoyTab(QString GUID);
     void handleInstanceDisconnect();
+    void loadRemoteProfile(InputDevice *device, QString fileLocation);
+    void unloadRemoteProfile(InputDevice *device);
+    void switchRemoteProfile(InputDevice *device, QString profileName);
+    void changeRemoteSet(InputDevice *device, int setIndex);
 
   private slots:
     void refreshTrayIconMenu();
@@ -152,6 +157,7 @@ class MainWindow : public QMainWindow
      * @brief Check state of batteries in controllers and notify user (only when powerLevSDL matches current battery level)
      */
     void showBatteryLevel(SDL_JoystickPowerLevel powerLevSDL, QString batteryLev, QString percent, InputDevice *device);
+    JoyTabWidget *findJoyTab(InputDevice *device);
 
     Ui::MainWindow *ui;
 
@@ -34,11 +34,14 @@ SetNamesDialog::SetNamesDialog(InputDevice *device, QWidget *parent)
     setAttribute(Qt::WA_DeleteOnClose);
     this->device = device;
 
-    auto joysList = device->getJoystick_sets();
+    ui->setNamesTableWidget->setRowCount(GlobalVariables::InputDevice::NUMBER_JOYSETS);
 
-    for (int i = 0; i < joysList.size(); i++)
+    for (int i = 0; i < GlobalVariables::InputDevice::NUMBER_JOYSETS; i++)
     {
-        auto name = joysList[i]->getName();
+        ui->setNamesTableWidget->setVerticalHeaderItem(i, new QTableWidgetItem(tr("Set %1").arg(i + 1)));
+
+        SetJoystick *set = device->findSetJoystick(i);
+        QString name = (set != nullptr) ? set->getName() : QString();
         ui->setNamesTableWidget->setItem(i, 0, new QTableWidgetItem(name));
     }
 
@@ -53,6 +56,11 @@ void SetNamesDialog::saveSetNameChanges()
     {
         QTableWidgetItem *setNameItem = ui->setNamesTableWidget->item(i, 0);
         QString setNameText = setNameItem->text();
+
+        // Naming an unused set is not a reason to create it.
+        if (setNameText.isEmpty() && (device->findSetJoystick(i) == nullptr))
+            continue;
+
         QString oldSetNameText = device->getSetJoystick(i)->getName();
 
         if (setNameText != oldSetNameText)
@@ -0,0 +1,202 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gyrobiasestimator.h"
+
+#include <QMutexLocker>
+
+#include <cmath>
+#include <cstdlib>
+
+// Weight of a new accelerometer sample in the exponential mean and variance.
+const double GyroBiasEstimator::ACCEL_SMOOTHING = 0.05;
+// Summed variance of all accelerometer axes in (m/s²)², about 0.1 m/s² standard deviation.
+const double GyroBiasEstimator::ACCEL_STILL_VARIANCE = 0.01;
+// Largest remaining rotation rate in rad/s, about 3°/s.
+const double GyroBiasEstimator::GYRO_STILL_RATE = 0.05;
+const unsigned int GyroBiasEstimator::MIN_STILL_MSECS = 500;
+// Accelerometer and gyroscope report at similar rates, so a matching sample is rarely more than a few ms apart.
+const int GyroBiasEstimator::ACCEL_MAX_AGE_MSECS = 50;
+// About 0.03°/s, well below what is noticeable as drift of a mapped gyroscope.
+const double GyroBiasEstimator::MIN_BIAS_CHANGE = 0.0005;
+// Weight of a stored calibration in samples when the estimation starts.
+const unsigned int GyroBiasEstimator::SEED_SAMPLES = 500;
+// Roughly 20 seconds of rest at common sensor rates.
+const unsigned int GyroBiasEstimator::MAX_SAMPLES = 5000;
+
+GyroBiasEstimator::GyroBiasEstimator() { reset(); }
+
+/**
+ * @brief Forgets the current estimate and all accelerometer history.
+ */
+void GyroBiasEstimator::reset()
+{
+    for (int i = 0; i < 3; i++)
+    {
+        m_accel_mean[i] = 0.0;
+        m_bias[i] = 0.0;
+        m_applied[i] = 0.0;
+    }
+
+    m_accel_variance = 0.0;
+    m_has_accel = false;
+    m_accel_timestamp = 0;
+    m_still = false;
+    m_still_since = 0;
+    m_count = 0;
+
+    QMutexLocker locker(&m_mutex);
+    m_published_valid = false;
+    m_published[0] = m_published[1] = m_published[2] = 0.0;
+}
+
+/**
+ * @brief Starts the estimation from a known offset, e.g. a stored manual calibration.
+ * @param[in] offsetX Offset value for X axis in rad/s
+ * @param[in] offsetY Offset value for Y axis in rad/s
+ * @param[in] offsetZ Offset value for Z axis in rad/s
+ */
+void GyroBiasEstimator::seed(double offsetX, double offsetY, double offsetZ)
+{
+    m_bias[0] = m_applied[0] = offsetX;
+    m_bias[1] = m_applied[1] = offsetY;
+    m_bias[2] = m_applied[2] = offsetZ;
+    m_count = SEED_SAMPLES;
+    m_still = false;
+
+    QMutexLocker locker(&m_mutex);
+    m_published_valid = true;
+    m_published[0] = offsetX;
+    m_published[1] = offsetY;
+    m_published[2] = offsetZ;
+}
+
+/**
+ * @brief Updates the exponential mean and variance of the accelerometer
+ *  which are used to detect a resting controller.
+ * @param[in] values Accelerometer values in m/s²
+ * @param[in] timestamp Time of the sample in milliseconds
+ */
+void GyroBiasEstimator::processAccelerometer(const float *values, unsigned int timestamp)
+{
+    m_accel_timestamp = timestamp;
+
+    if (!m_has_accel)
+    {
+        for (int i = 0; i < 3; i++)
+            m_accel_mean[i] = values[i];
+
+        m_accel_variance = ACCEL_STILL_VARIANCE;
+        m_has_accel = true;
+        return;
+    }
+
+    double deltaSq = 0.0;
+
+    for (int i = 0; i < 3; i++)
+    {
+        double delta = values[i] - m_accel_mean[i];
+        m_accel_mean[i] += ACCEL_SMOOTHING * delta;
+        deltaSq += delta * delta;
+    }
+
+    m_accel_variance = (1.0 - ACCEL_SMOOTHING) * (m_accel_variance + ACCEL_SMOOTHING * deltaSq);
+}
+
+/**
+ * @brief Feeds a raw gyroscope sample into the estimation.
+ *  The sample only changes the offset if the controller rested long enough.
+ * @param[in] values Raw gyroscope values in rad/s
+ * @param[in] timestamp Time of the sample in milliseconds
+ * @returns True if the published offset changed.
+ */
+bool GyroBiasEstimator::processGyroscope(const float *values, unsigned int timestamp)
+{
+    double rateSq = 0.0;
+
+    for (int i = 0; i < 3; i++)
+    {
+        double rate = values[i] - m_bias[i];
+        rateSq += rate * rate;
+    }
+
+    // Timestamps of both sensors may be out of order by a sample, hence the signed age.
+    int accelAge = static_cast<int>(timestamp - m_accel_timestamp);
+    bool freshAccel = m_has_accel && (std::abs(accelAge) <= ACCEL_MAX_AGE_MSECS);
+    bool still =
+        freshAccel && (m_accel_variance < ACCEL_STILL_VARIANCE) && (rateSq < (GYRO_STILL_RATE * GYRO_STILL_RATE));
+
+    if (!still)
+    {
+        m_still = false;
+        return false;
+    } else if (!m_still)
+    {
+        m_still = true;
+        m_still_since = timestamp;
+        return false;
+    } else if ((timestamp - m_still_since) < MIN_STILL_MSECS)
+    {
+        return false;
+    }
+
+    if (m_count < MAX_SAMPLES)
+        m_count++;
+
+    bool changed = false;
+
+    for (int i = 0; i < 3; i++)
+    {
+        m_bias[i] += (values[i] - m_bias[i]) / m_count;
+
+        if (std::fabs(m_bias[i] - m_applied[i]) >= MIN_BIAS_CHANGE)
+            changed = true;
+    }
+
+    if (!changed)
+        return false;
+
+    QMutexLocker locker(&m_mutex);
+    m_published_valid = true;
+
+    for (int i = 0; i < 3; i++)
+        m_applied[i] = m_published[i] = m_bias[i];
+
+    return true;
+}
+
+/**
+ * @brief Checks if an offset was seeded or measured yet.
+ */
+bool GyroBiasEstimator::hasEstimate() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_published_valid;
+}
+
+/**
+ * @brief Reads the current offset estimate. Safe to call from any thread.
+ * @param[out] offsetX Offset value for X axis in rad/s
+ * @param[out] offsetY Offset value for Y axis in rad/s
+ * @param[out] offsetZ Offset value for Z axis in rad/s
+ */
+void GyroBiasEstimator::getBias(double *offsetX, double *offsetY, double *offsetZ) const
+{
+    QMutexLocker locker(&m_mutex);
+    *offsetX = m_published[0];
+    *offsetY = m_published[1];
+    *offsetZ = m_published[2];
+}
@@ -0,0 +1,74 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QMutex>
+
+/**
+ * @brief Tracks the gyroscope offset while the controller is at rest.
+ *
+ *  The controller counts as resting when the variance of the accelerometer
+ *  and the remaining gyroscope rate are both small for at least
+ *  MIN_STILL_MSECS. A slow but steady rotation looks like an offset to the
+ *  gyroscope alone, so nothing is learned without accelerometer samples
+ *  younger than ACCEL_MAX_AGE_MSECS. Samples taken at rest update the
+ *  offset with a running mean which turns into an exponential average after
+ *  MAX_SAMPLES, so the estimate keeps following temperature drift.
+ *  The offset is only published once it moved by MIN_BIAS_CHANGE on any
+ *  axis, so sensors are not recalibrated for every resting sample.
+ *  Samples are processed on the input thread, the offset can be read from
+ *  any thread.
+ */
+class GyroBiasEstimator
+{
+  public:
+    GyroBiasEstimator();
+
+    void reset();
+    void seed(double offsetX, double offsetY, double offsetZ);
+    void processAccelerometer(const float *values, unsigned int timestamp);
+    bool processGyroscope(const float *values, unsigned int timestamp);
+
+    bool hasEstimate() const;
+    void getBias(double *offsetX, double *offsetY, double *offsetZ) const;
+
+    static const double ACCEL_SMOOTHING;
+    static const double ACCEL_STILL_VARIANCE;
+    static const double GYRO_STILL_RATE;
+    static const unsigned int MIN_STILL_MSECS;
+    static const int ACCEL_MAX_AGE_MSECS;
+    static const double MIN_BIAS_CHANGE;
+    static const unsigned int SEED_SAMPLES;
+    static const unsigned int MAX_SAMPLES;
+
+  private:
+    // Only touched by the input thread.
+    double m_accel_mean[3];
+    double m_accel_variance;
+    bool m_has_accel;
+    unsigned int m_accel_timestamp;
+    bool m_still;
+    unsigned int m_still_since;
+    unsigned int m_count;
+    double m_bias[3];
+    double m_applied[3];
+
+    // Copy of m_bias for other threads.
+    mutable QMutex m_mutex;
+    bool m_published_valid;
+    double m_published[3];
+};
@@ -20,16 +20,23 @@
 
 #include "antimicrosettings.h"
 #include "common.h"
+#include "eventhandlerfactory.h"
 #include "globalvariables.h"
 #include "inputdevicebitarraystatus.h"
+#include "inputstatistics.h"
+#include "joycontrolstick.h"
 #include "joydpad.h"
 #include "joysensor.h"
 #include "joystick.h"
+#include "joytouchpad.h"
 #include "logger.h"
 #include "sdleventreader.h"
+#include "startupprofiler.h"
 
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QEventLoop>
+#include <QHash>
 #include <QMapIterator>
 #include <QThread>
 #include <QTime>
@@ -44,8 +51,13 @@ InputDaemon::InputDaemon(QMap<SDL_JoystickID, InputDevice *> *joysticks, AntiMic
     // Xbox360Wireless* xbox360class = new Xbox360Wireless();
     // xbox360 = xbox360class->getResult();
     this->stopped = false;
+    firstEventDispatched = false;
     m_graphical = graphical;
     m_settings = settings;
+    separatePlayerDevices = false;
+    updateAxisCoalescing();
+
+    connect(this, &InputDaemon::deviceAdded, this, &InputDaemon::addPlayerDevices);
 
     eventWorker = new SDLEventReader(joysticks, settings);
     refreshJoysticks();
@@ -94,6 +106,8 @@ InputDaemon::~InputDaemon()
 
 void InputDaemon::startWorker()
 {
+    updatePlayerDevices();
+
     if (!sdlWorkerThread->isRunning())
         sdlWorkerThread->start(QThread::HighPriority);
 }
@@ -109,11 +123,29 @@ void InputDaemon::run()
     {
         JoyButton::resetActiveButtonMouseDistances(JoyButton::getMouseHelper());
 
+        QElapsedTimer dispatchTimer;
+        dispatchTimer.start();
+
         QQueue<SDL_Event> sdlEventQueue;
+        pollInputEvents(&sdlEventQueue);
+
+        int queueDepth = sdlEventQueue.size();
+        coalesceAxisEvents(&sdlEventQueue);
+        int coalesced = queueDepth - sdlEventQueue.size();
+
         firstInputPass(&sdlEventQueue);
         modifyUnplugEvents(&sdlEventQueue);
+
+        bool dispatchingFirstEvent = !firstEventDispatched && !sdlEventQueue.isEmpty();
         secondInputPass(&sdlEventQueue);
         clearBitArrayStatusInstances();
+        InputStatistics::finishCycle(queueDepth, coalesced, dispatchTimer.nsecsElapsed());
+
+        if (dispatchingFirstEvent)
+        {
+            firstEventDispatched = true;
+            StartupProfiler::mark("First input event dispatched");
+        }
     }
 
     if (stopped)
@@ -150,6 +182,25 @@ QString InputDaemon::getJoyInfo(Uint16 sdlvalue)
     return QString(buffer);
 }
 
+/**
+ * @brief Check if the device is the virtual gamepad created by the program
+ *     itself. Mapping it would feed its own output back as input.
+ * @param SDL device index
+ */
+bool InputDaemon::isVirtualGamepad(int index)
+{
+    if ((SDL_JoystickGetDeviceVendor(index) == PadderCommon::gamepadDeviceVendor) &&
+        (SDL_JoystickGetDeviceProduct(index) == PadderCommon::gamepadDeviceProduct) &&
+        (SDL_JoystickGetDeviceProductVersion(index) == PadderCommon::gamepadDeviceVersion))
+    {
+        return true;
+    }
+
+    const char *name = SDL_JoystickNameForIndex(index);
+
+    return (name != nullptr) && (QString::fromUtf8(name) == PadderCommon::gamepadDeviceName);
+}
+
 void InputDaemon::refreshJoysticks()
 {
     QMapIterator<SDL_JoystickID, InputDevice *> iter(*m_joysticks);
@@ -160,6 +211,9 @@ void InputDaemon::refreshJoysticks()
 
         if (joystick != nullptr)
         {
+            if (separatePlayerDevices)
+                EventHandlerFactory::getInstance()->handler()->removePlayerDevices(joystick);
+
             m_joysticks->remove(iter.key());
             joystick->deleteLater();
         }
@@ -168,6 +222,10 @@ void InputDaemon::refreshJoysticks()
     m_joysticks->clear();
     getTrackjoysticksLocal().clear();
     trackcontrollers.clear();
+    m_device_ids.clear();
+
+    for (int i = 0; i < SDL_NumJoysticks(); i++)
+        m_device_ids.append(SDL_JoystickGetDeviceInstanceID(i));
 
     m_settings->getLock()->lock();
     m_settings->beginGroup("Mappings");
@@ -180,6 +238,9 @@ void InputDaemon::refreshJoysticks()
     {
         int index = i;
 
+        if (isVirtualGamepad(index))
+            continue;
+
         // Check if device is considered a Game Controller at the start.
         if (SDL_IsGameController(index))
         {
@@ -267,6 +328,8 @@ void InputDaemon::refresh()
     qDebug() << "REFRESH";
 
     stop();
+    updateAxisCoalescing();
+    updatePlayerDevices();
 
     qInfo() << "Refreshing joystick list";
 
@@ -327,76 +390,64 @@ void InputDaemon::quit()
 
 void InputDaemon::refreshMapping(QString mapping, InputDevice *device)
 {
-    bool found = false;
-
     QMap<QString, int> uniques = QMap<QString, int>();
     int counterUniques = 1;
     bool duplicatedGamepad = false;
 
-    for (int i = 0; (i < SDL_NumJoysticks()) && !found; i++)
-    // for (int i = 0; (i < 1) && !found; i++)
-    {
-        SDL_Joystick *joystick = SDL_JoystickOpen(i);
-        // SDL_Joystick *joystick = xbox360;
-        SDL_JoystickID joystickID = SDL_JoystickInstanceID(joystick);
+    SDL_JoystickID joystickID = device->getSDLJoystickID();
+    int i = m_device_ids.indexOf(joystickID);
 
-        if (device->getSDLJoystickID() == joystickID)
-        {
-            found = true;
+    if (i == -1)
+        return;
 
-            if (SDL_IsGameController(i))
-            {
-                // Mapping string updated. Perform basic refresh
-                QByteArray tempbarray = mapping.toUtf8();
-                SDL_GameControllerAddMapping(tempbarray.data());
-            } else
-            {
-                // Previously registered as a plain joystick. Add
-                // mapping and check for validity. If SDL accepts it,
-                // close current device and re-open as
-                // a game controller.
-                SDL_GameControllerAddMapping(mapping.toUtf8().constData());
+    if (SDL_IsGameController(i))
+    {
+        // Mapping string updated. Perform basic refresh
+        QByteArray tempbarray = mapping.toUtf8();
+        SDL_GameControllerAddMapping(tempbarray.data());
+    } else
+    {
+        // Previously registered as a plain joystick. Add
+        // mapping and check for validity. If SDL accepts it,
+        // close current device and re-open as
+        // a game controller.
+        SDL_GameControllerAddMapping(mapping.toUtf8().constData());
 
-                if (SDL_IsGameController(i))
-                {
-                    device->closeSDLDevice();
-                    getTrackjoysticksLocal().remove(joystickID);
-                    m_joysticks->remove(joystickID);
+        if (SDL_IsGameController(i))
+        {
+            device->closeSDLDevice();
+            getTrackjoysticksLocal().remove(joystickID);
+            m_joysticks->remove(joystickID);
 
-                    SDL_GameController *controller = SDL_GameControllerOpen(i);
+            SDL_GameController *controller = SDL_GameControllerOpen(i);
 
-                    QString guidText = getJoyInfo(SDL_JoystickGetGUID(SDL_GameControllerGetJoystick(controller)));
+            QString guidText = getJoyInfo(SDL_JoystickGetGUID(SDL_GameControllerGetJoystick(controller)));
 
-                    if (uniques.contains(guidText))
-                    {
-                        ++uniques[guidText];
-                        duplicatedGamepad = true;
+            if (uniques.contains(guidText))
+            {
+                ++uniques[guidText];
+                duplicatedGamepad = true;
 
-                        // previous value will be erased in map anyway
-                        uniques.insert(guidText, uniques[guidText]);
-                    } else
-                    {
-                        uniques.insert(guidText, counterUniques);
-                    }
+                // previous value will be erased in map anyway
+                uniques.insert(guidText, uniques[guidText]);
+            } else
+            {
+                uniques.insert(guidText, counterUniques);
+            }
 
-                    int resultDuplicated = 0;
-                    if (duplicatedGamepad)
-                        resultDuplicated = counterUniques;
+            int resultDuplicated = 0;
+            if (duplicatedGamepad)
+                resultDuplicated = counterUniques;
 
-                    GameController *damncontroller = new GameController(controller, i, m_settings, resultDuplicated, this);
-                    duplicatedGamepad = false;
-                    connect(damncontroller, &GameController::requestWait, eventWorker, &SDLEventReader::haltServices);
-                    SDL_Joystick *sdlStick = SDL_GameControllerGetJoystick(controller);
-                    joystickID = SDL_JoystickInstanceID(sdlStick);
-                    m_joysticks->insert(joystickID, damncontroller);
-                    trackcontrollers.insert(joystickID, damncontroller);
-                    emit deviceUpdated(i, damncontroller);
-                }
-            }
+            GameController *damncontroller = new GameController(controller, i, m_settings, resultDuplicated, this);
+            duplicatedGamepad = false;
+            connect(damncontroller, &GameController::requestWait, eventWorker, &SDLEventReader::haltServices);
+            SDL_Joystick *sdlStick = SDL_GameControllerGetJoystick(controller);
+            joystickID = SDL_JoystickInstanceID(sdlStick);
+            m_joysticks->insert(joystickID, damncontroller);
+            trackcontrollers.insert(joystickID, damncontroller);
+            emit deviceUpdated(i, damncontroller);
         }
-
-        // Make sure to decrement reference count
-        SDL_JoystickClose(joystick);
     }
 }
 
@@ -409,29 +460,61 @@ void InputDaemon::removeDevice(InputDevice *device)
         m_joysticks->remove(deviceID);
         getTrackjoysticksLocal().remove(deviceID);
         trackcontrollers.remove(deviceID);
+        InputStatistics::removeDevice(deviceID);
+
+        if (separatePlayerDevices)
+            EventHandlerFactory::getInstance()->handler()->removePlayerDevices(device);
 
-        refreshIndexes();
+        forgetDeviceIndex(deviceID);
 
         emit deviceRemoved(deviceID);
     }
 }
 
-void InputDaemon::refreshIndexes()
+/**
+ * @brief Updates the SDL device index of every device starting at position from
+ *  of the index table. Doesn't need to open any device.
+ */
+void InputDaemon::refreshIndexes(int from)
 {
-    for (int i = 0; i < SDL_NumJoysticks(); i++)
-    // for (int i = 0; i < 1; i++)
+    for (int i = qMax(from, 0); i < m_device_ids.size(); i++)
     {
-        SDL_Joystick *joystick = SDL_JoystickOpen(i);
-        // SDL_Joystick *joystick = xbox360;
-        SDL_JoystickID joystickID = SDL_JoystickInstanceID(joystick);
-        SDL_JoystickClose(joystick); // Make sure to decrement reference count
-        InputDevice *tempdevice = m_joysticks->value(joystickID);
+        InputDevice *tempdevice = m_joysticks->value(m_device_ids.at(i));
 
         if (tempdevice != nullptr)
             tempdevice->setIndex(i);
     }
 }
 
+/**
+ * @brief Records a device that SDL reported at the given index. The devices
+ *  behind it move up by one.
+ */
+void InputDaemon::rememberDeviceIndex(int index, SDL_JoystickID deviceID)
+{
+    if ((deviceID < 0) || m_device_ids.contains(deviceID))
+        return;
+
+    index = qBound(0, index, m_device_ids.size());
+    m_device_ids.insert(index, deviceID);
+    refreshIndexes(index + 1);
+}
+
+/**
+ * @brief Drops a detached device from the index table. The devices
+ *  behind it move down by one.
+ */
+void InputDaemon::forgetDeviceIndex(SDL_JoystickID deviceID)
+{
+    int index = m_device_ids.indexOf(deviceID);
+
+    if (index != -1)
+    {
+        m_device_ids.remove(index);
+        refreshIndexes(index);
+    }
+}
+
 void InputDaemon::addInputDevice(int index, QMap<QString, int> &uniques, int &counterUniques, bool &duplicatedGamepad)
 {
 #ifdef USE_NEW_ADD
@@ -504,6 +587,19 @@ void InputDaemon::addInputDevice(int index, QMap<QString, int> &uniques, int &co
         }
     }
 #else
+    // SDL reports game controllers twice, as joystick and as controller.
+    // Known devices are skipped before anything is opened.
+    SDL_JoystickID deviceID = SDL_JoystickGetDeviceInstanceID(index);
+
+    if ((deviceID < 0) || m_joysticks->contains(deviceID) || isVirtualGamepad(index))
+        return;
+
+    rememberDeviceIndex(index, deviceID);
+
+    // Database mappings are only handed to SDL for attached devices.
+    if (eventWorker != nullptr)
+        eventWorker->loadMappingForDevice(index);
+
     SDL_GameController *controller = SDL_GameControllerOpen(index);
     SDL_Joystick *joystick = SDL_JoystickOpen(index);
 
@@ -667,12 +763,33 @@ InputDaemon::createOrGrabBitStatusEntry(QHash<InputDevice *, InputDeviceBitArray
  * @brief Fetches events from SDL event queue, filters them and
  *  updates InputDeviceBitArrayStatus.
  */
-void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
+/**
+ * @brief Fetches all events SDL has queued since the last cycle.
+ */
+void InputDaemon::pollInputEvents(QQueue<SDL_Event> *sdlEventQueue)
 {
     SDL_Event event;
 
     while (SDL_PollEvent(&event) > 0)
     {
+        InputStatistics::countEvent(event);
+        sdlEventQueue->append(event);
+    }
+}
+
+/**
+ * @brief Keeps the fetched events which belong to a mapped element and
+ *  records which elements have pending values.
+ */
+void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
+{
+    QQueue<SDL_Event> rawEvents;
+    rawEvents.swap(*sdlEventQueue);
+
+    while (!rawEvents.isEmpty())
+    {
+        SDL_Event event = rawEvents.dequeue();
+
         if (Logger::isDebugEnabled())
         {
             const QMap<Uint32, QString> STRING_MAP = {
@@ -840,6 +957,17 @@ void InputDaemon::firstInputPass(QQueue<SDL_Event> *sdlEventQueue)
             }
             break;
         }
+
+        case SDL_CONTROLLERTOUCHPADDOWN:
+        case SDL_CONTROLLERTOUCHPADMOTION:
+        case SDL_CONTROLLERTOUCHPADUP: {
+            InputDevice *joy = trackcontrollers.value(event.ctouchpad.which);
+
+            if ((joy != nullptr) && (joy->getActiveSetJoystick()->getTouchpad(event.ctouchpad.touchpad) != nullptr))
+                sdlEventQueue->append(event);
+
+            break;
+        }
 #endif
 
         case SDL_CONTROLLERBUTTONDOWN:
@@ -1009,6 +1137,312 @@ void InputDaemon::modifyUnplugEvents(QQueue<SDL_Event> *sdlEventQueue)
     }
 }
 
+static Sint16 &axisEventValue(SDL_Event &event)
+{
+    return (event.type == SDL_JOYAXISMOTION) ? event.jaxis.value : event.caxis.value;
+}
+
+/**
+ * @brief Side of the dead zone a raw axis value lies on: 0 inside,
+ *  -1 or 1 outside of it.
+ */
+static int axisEventZone(JoyAxis *axis, int value)
+{
+    if (axis->inDeadZone(value))
+        return 0;
+
+    return (value < 0) ? -1 : 1;
+}
+
+/**
+ * @brief Zone of a stick position: 0 inside the dead zone of the stick,
+ *  otherwise the direction it points to.
+ */
+static int stickEventZone(JoyControlStick *stick, int axisXValue, int axisYValue)
+{
+    if (stick->inDeadZone(axisXValue, axisYValue))
+        return 0;
+
+    return static_cast<int>(stick->calculateStickDirection(axisXValue, axisYValue));
+}
+
+/**
+ * @brief Collapses motion events of the same axis queued within one poll
+ *  cycle so superseded values are neither classified by the first input pass
+ *  nor dispatched to JoyAxis.
+ *  A new event is kept whenever the axis enters or leaves its dead zone,
+ *  so no press or release is lost. Axes of a control stick use the dead zone
+ *  and direction of the stick instead, for every position the stick passes
+ *  through once the kept events are dispatched. Button, hat and removal
+ *  events end the current runs of their device to keep the relative order
+ *  of inputs. Events of other types pass through without affecting the runs.
+ */
+void InputDaemon::coalesceAxisEvents(QQueue<SDL_Event> *sdlEventQueue)
+{
+    if ((axisCoalescing == AxisCoalescingOff) || (sdlEventQueue->size() < 2))
+        return;
+
+    struct AxisRun
+    {
+        int start; // position of the retained event in tempQueue
+        int tail;  // position of the trailing event in peak mode, -1 if none
+        int zone;
+        int peak;
+        int partnerValue; // value of the other stick axis at the retained event
+    };
+
+    QQueue<SDL_Event> tempQueue;
+    // Keys combine instance id and axis index.
+    QHash<qint64, AxisRun> runs;
+    // Latest queued value of stick axes, the current value until they have one.
+    QHash<JoyAxis *, int> stickAxisValues;
+
+    auto closeRuns = [&runs](SDL_JoystickID which) {
+        QMutableHashIterator<qint64, AxisRun> iter(runs);
+
+        while (iter.hasNext())
+        {
+            if ((iter.next().key() >> 8) == which)
+                iter.remove();
+        }
+    };
+
+    while (!sdlEventQueue->isEmpty())
+    {
+        SDL_Event event = sdlEventQueue->dequeue();
+        JoyAxis *axis = nullptr;
+        SDL_JoystickID which = 0;
+        int axisIndex = 0;
+
+        switch (event.type)
+        {
+        case SDL_JOYAXISMOTION: {
+            InputDevice *joy = getTrackjoysticksLocal().value(event.jaxis.which);
+
+            if (joy != nullptr)
+                axis = joy->getActiveSetJoystick()->getJoyAxis(event.jaxis.axis);
+
+            which = event.jaxis.which;
+            axisIndex = event.jaxis.axis;
+            break;
+        }
+        case SDL_CONTROLLERAXISMOTION: {
+            InputDevice *joy = trackcontrollers.value(event.caxis.which);
+
+            if (joy != nullptr)
+                axis = joy->getActiveSetJoystick()->getJoyAxis(event.caxis.axis);
+
+            which = event.caxis.which;
+            axisIndex = event.caxis.axis;
+            break;
+        }
+        case SDL_JOYBUTTONDOWN:
+        case SDL_JOYBUTTONUP: {
+            closeRuns(event.jbutton.which);
+            break;
+        }
+        case SDL_JOYHATMOTION: {
+            closeRuns(event.jhat.which);
+            break;
+        }
+        case SDL_CONTROLLERBUTTONDOWN:
+        case SDL_CONTROLLERBUTTONUP: {
+            closeRuns(event.cbutton.which);
+            break;
+        }
+        case SDL_JOYDEVICEREMOVED: {
+            closeRuns(event.jdevice.which);
+            break;
+        }
+        case SDL_CONTROLLERDEVICEREMOVED: {
+            closeRuns(event.cdevice.which);
+            break;
+        }
+        default: {
+            break;
+        }
+        }
+
+        if (axis == nullptr)
+        {
+            tempQueue.enqueue(event);
+            continue;
+        }
+
+        qint64 key = (static_cast<qint64>(which) << 8) | axisIndex;
+        int value = axisEventValue(event);
+        int zone = 0;
+        int partnerValue = 0;
+        bool keepsStickZone = true;
+        JoyControlStick *stick = axis->getControlStick();
+
+        if (stick != nullptr)
+        {
+            int position = qBound(GlobalVariables::JoyAxis::AXISMIN, value, GlobalVariables::JoyAxis::AXISMAX);
+            bool isAxisX = (stick->getAxisX() == axis);
+            JoyAxis *partner = isAxisX ? stick->getAxisY() : stick->getAxisX();
+            auto partnerRun = runs.find((static_cast<qint64>(which) << 8) | partner->getIndex());
+
+            partnerValue = stickAxisValues.value(partner, partner->getCurrentRawValue());
+            stickAxisValues.insert(axis, position);
+            zone = isAxisX ? stickEventZone(stick, position, partnerValue) : stickEventZone(stick, partnerValue, position);
+
+            if ((partnerRun != runs.end()) && (partnerRun->zone != zone))
+            {
+                // Never merge across a zone change of the stick.
+                runs.erase(partnerRun);
+                partnerRun = runs.end();
+            }
+
+            auto ownRun = runs.constFind(key);
+
+            // A value merged into the retained event is dispatched before later
+            // events of the other axis, so the stick passes through the new value
+            // of this axis and the value the other axis had at that point.
+            if ((ownRun != runs.constEnd()) && ((partnerRun == runs.end()) || (partnerRun->start > ownRun->start)))
+            {
+                int earlierZone = isAxisX ? stickEventZone(stick, position, ownRun->partnerValue)
+                                          : stickEventZone(stick, ownRun->partnerValue, position);
+                keepsStickZone = (earlierZone == ownRun->zone);
+            }
+        } else
+        {
+            zone = axisEventZone(axis, value);
+        }
+
+        bool trackPeak = (axisCoalescing == AxisCoalescingPeak) && (stick == nullptr) &&
+                         (axis->getThrottle() != static_cast<int>(JoyAxis::NormalThrottle));
+        int magnitude = trackPeak ? qAbs(axis->calculateThrottledValue(value)) : 0;
+
+        auto run = runs.find(key);
+
+        if ((run != runs.end()) && (run->zone == zone) && keepsStickZone)
+        {
+            SDL_Event &retained = tempQueue[run->start];
+            bool merged = true;
+
+            if (trackPeak)
+            {
+                // Keep the peak in place and let a trailing event carry the latest value.
+                if (magnitude >= run->peak)
+                {
+                    axisEventValue(retained) = value;
+                    run->peak = magnitude;
+                }
+
+                if (run->tail >= 0)
+                {
+                    axisEventValue(tempQueue[run->tail]) = value;
+                } else if (axisEventValue(retained) != value)
+                {
+                    run->tail = tempQueue.size();
+                    tempQueue.enqueue(event);
+                    merged = false;
+                }
+            } else
+            {
+                axisEventValue(retained) = value;
+            }
+
+            if (merged)
+                InputStatistics::countCoalesced(which);
+
+            continue;
+        }
+
+        runs.insert(key, {tempQueue.size(), -1, zone, magnitude, partnerValue});
+        tempQueue.enqueue(event);
+    }
+
+    sdlEventQueue->swap(tempQueue);
+}
+
+/**
+ * @brief Instance id of the device an input event belongs to.
+ * @return False for events which are not input of a single device.
+ */
+static bool inputEventDevice(const SDL_Event &event, SDL_JoystickID &which)
+{
+    switch (event.type)
+    {
+    case SDL_JOYAXISMOTION:
+        which = event.jaxis.which;
+        return true;
+    case SDL_JOYBUTTONDOWN:
+    case SDL_JOYBUTTONUP:
+        which = event.jbutton.which;
+        return true;
+    case SDL_JOYHATMOTION:
+        which = event.jhat.which;
+        return true;
+    case SDL_CONTROLLERAXISMOTION:
+        which = event.caxis.which;
+        return true;
+    case SDL_CONTROLLERBUTTONDOWN:
+    case SDL_CONTROLLERBUTTONUP:
+        which = event.cbutton.which;
+        return true;
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+    case SDL_CONTROLLERSENSORUPDATE:
+        which = event.csensor.which;
+        return true;
+    case SDL_CONTROLLERTOUCHPADDOWN:
+    case SDL_CONTROLLERTOUCHPADMOTION:
+    case SDL_CONTROLLERTOUCHPADUP:
+        which = event.ctouchpad.which;
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Reads the AxisCoalescing setting ("off", "last" or "peak").
+ *  Coalescing is off unless it is enabled there.
+ */
+void InputDaemon::updateAxisCoalescing()
+{
+    m_settings->getLock()->lock();
+    QString mode = m_settings->value("AxisCoalescing", "off").toString().toLower();
+    m_settings->getLock()->unlock();
+
+    if (mode == "last")
+        axisCoalescing = AxisCoalescingLast;
+    else if (mode == "peak")
+        axisCoalescing = AxisCoalescingPeak;
+    else
+        axisCoalescing = AxisCoalescingOff;
+}
+
+/**
+ * @brief Reads the SeparatePlayerDevices setting and passes it to the
+ *  event handler together with the connected controllers. Should only be
+ *  called once the event handler exists.
+ */
+void InputDaemon::updatePlayerDevices()
+{
+    m_settings->getLock()->lock();
+    bool separate = m_settings->value("SeparatePlayerDevices", false).toBool();
+    m_settings->getLock()->unlock();
+
+    if (!separate && !separatePlayerDevices)
+        return;
+
+    separatePlayerDevices = separate;
+    EventHandlerFactory::getInstance()->handler()->setSeparatePlayerDevices(separate, m_joysticks->values());
+}
+
+/**
+ * @brief Creates the virtual devices of a controller as soon as it is
+ *  added, so no event has to wait for them.
+ */
+void InputDaemon::addPlayerDevices(InputDevice *device)
+{
+    if (separatePlayerDevices)
+        EventHandlerFactory::getInstance()->handler()->addPlayerDevices(device);
+}
+
 QBitArray InputDaemon::createUnplugEventBitArray(InputDevice *device)
 {
     InputDeviceBitArrayStatus tempStatus(device, false, this);
@@ -1037,6 +1471,10 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
     QHash<SDL_JoystickID, InputDevice *> activeDevices;
 
+    QElapsedTimer dispatchTimer;
+    dispatchTimer.start();
+    qint64 eventStartNsecs = 0;
+
     while (!sdlEventQueue->isEmpty())
     {
         SDL_Event event = sdlEventQueue->dequeue();
@@ -1146,12 +1584,25 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
             {
                 SetJoystick *set = joy->getActiveSetJoystick();
                 JoySensor *sensor = nullptr;
+#if SDL_VERSION_ATLEAST(2, 26, 0)
+                // Sample time reported by the device if known, event time otherwise.
+                quint64 timestamp = (event.csensor.timestamp_us != 0) ? event.csensor.timestamp_us
+                                                                       : event.csensor.timestamp * quint64(1000);
+#else
+                quint64 timestamp = event.csensor.timestamp * quint64(1000);
+#endif
                 if (event.csensor.sensor == SDL_SENSOR_ACCEL)
+                {
+                    joy->processRawSensorData(ACCELEROMETER, event.csensor.data, timestamp);
                     sensor = set->getSensor(ACCELEROMETER);
-                else if (event.csensor.sensor == SDL_SENSOR_GYRO)
+                } else if (event.csensor.sensor == SDL_SENSOR_GYRO)
+                {
+                    joy->processRawSensorData(GYROSCOPE, event.csensor.data, timestamp);
                     sensor = set->getSensor(GYROSCOPE);
-                else
+                } else
+                {
                     Q_ASSERT(false);
+                }
 
                 if (sensor != nullptr)
                 {
@@ -1164,6 +1615,28 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
 
             break;
         }
+
+        case SDL_CONTROLLERTOUCHPADDOWN:
+        case SDL_CONTROLLERTOUCHPADMOTION:
+        case SDL_CONTROLLERTOUCHPADUP: {
+            InputDevice *joy = trackcontrollers.value(event.ctouchpad.which);
+
+            if (joy != nullptr)
+            {
+                JoyTouchpad *touchpad = joy->getActiveSetJoystick()->getTouchpad(event.ctouchpad.touchpad);
+
+                if (touchpad != nullptr)
+                {
+                    touchpad->touchEvent(event.ctouchpad.finger, event.type != SDL_CONTROLLERTOUCHPADUP,
+                                         event.ctouchpad.x, event.ctouchpad.y);
+
+                    if (!activeDevices.contains(event.ctouchpad.which))
+                        activeDevices.insert(event.ctouchpad.which, joy);
+                }
+            }
+
+            break;
+        }
 #endif
 
         case SDL_CONTROLLERBUTTONDOWN:
@@ -1198,6 +1671,9 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
                                .arg(QTime::currentTime().toString("hh:mm:ss.zzz"));
 
                 removeDevice(device);
+            } else
+            {
+                forgetDeviceIndex(event.jdevice.which);
             }
 
             break;
@@ -1227,6 +1703,7 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
             tempDevice->activatePossibleControlStickEvents();
             tempDevice->activatePossibleAxisEvents();
             tempDevice->activatePossibleSensorEvents();
+            tempDevice->activatePossibleTouchpadEvents();
             tempDevice->activatePossibleDPadEvents();
             tempDevice->activatePossibleVDPadEvents();
             tempDevice->activatePossibleButtonEvents();
@@ -1236,6 +1713,14 @@ void InputDaemon::secondInputPass(QQueue<SDL_Event> *sdlEventQueue)
                                                JoyButton::getTestOldMouseTime()))
             JoyButton::invokeMouseEvents(
                 JoyButton::getMouseHelper()); // Do not wait for next event loop run. Execute immediately.
+
+        qint64 eventEndNsecs = dispatchTimer.nsecsElapsed();
+        SDL_JoystickID eventDevice = 0;
+
+        if (inputEventDevice(event, eventDevice))
+            InputStatistics::countDispatch(eventDevice, eventEndNsecs - eventStartNsecs);
+
+        eventStartNsecs = eventEndNsecs;
     }
 }
 
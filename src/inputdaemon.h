@@ -23,6 +23,8 @@
 //#include "fakeclasses/xbox360wireless.h"
 #include <SDL2/SDL_events.h>
 
+#include <QVector>
+
 class InputDevice;
 class AntiMicroSettings;
 class InputDeviceBitArrayStatus;
@@ -45,16 +47,30 @@ class InputDaemon : public QObject
                          QObject *parent = 0);
     ~InputDaemon();
 
+    /**
+     * @brief Reduction applied to motion events of the same axis which
+     *  arrive within a single poll cycle. Stored in the AxisCoalescing setting.
+     */
+    enum AxisCoalescing
+    {
+        AxisCoalescingOff = 0, ///< dispatch every motion event
+        AxisCoalescingLast,    ///< keep the latest value of an axis
+        AxisCoalescingPeak     ///< keep the most pressed value of throttles, latest value of other axes
+    };
+
   protected:
     InputDeviceBitArrayStatus *createOrGrabBitStatusEntry(QHash<InputDevice *, InputDeviceBitArrayStatus *> *statusHash,
                                                           InputDevice *device, bool readCurrent = true);
 
     QString getJoyInfo(SDL_JoystickGUID sdlvalue);
     QString getJoyInfo(Uint16 sdlvalue);
+    bool isVirtualGamepad(int index);
 
+    void pollInputEvents(QQueue<SDL_Event> *sdlEventQueue);
     void firstInputPass(QQueue<SDL_Event> *sdlEventQueue);
     void secondInputPass(QQueue<SDL_Event> *sdlEventQueue);
     void modifyUnplugEvents(QQueue<SDL_Event> *sdlEventQueue);
+    void coalesceAxisEvents(QQueue<SDL_Event> *sdlEventQueue);
     QBitArray createUnplugEventBitArray(InputDevice *device);
     Joystick *openJoystickDevice(int index);
 
@@ -81,27 +97,37 @@ class InputDaemon : public QObject
     void refreshMapping(QString mapping, InputDevice *device);
     void removeDevice(InputDevice *device);
     void addInputDevice(int index, QMap<QString, int> &uniques, int &counterUniques, bool &duplicatedGamepad);
-    void refreshIndexes();
+    void refreshIndexes(int from = 0);
+    void updateAxisCoalescing();
+    void updatePlayerDevices();
 
   private slots:
     void stop();
     void resetActiveButtonMouseDistances();
     void updatePollResetRate(int tempPollRate);
+    void addPlayerDevices(InputDevice *device);
 
   private:
     QHash<SDL_JoystickID, Joystick *> &getTrackjoysticksLocal();
     QHash<InputDevice *, InputDeviceBitArrayStatus *> &getReleaseEventsGeneratedLocal();
     QHash<InputDevice *, InputDeviceBitArrayStatus *> &getPendingEventValuesLocal();
 
+    void rememberDeviceIndex(int index, SDL_JoystickID deviceID);
+    void forgetDeviceIndex(SDL_JoystickID deviceID);
+
     QMap<SDL_JoystickID, InputDevice *> *m_joysticks;
     QHash<SDL_JoystickID, Joystick *> trackjoysticks;
     QHash<SDL_JoystickID, GameController *> trackcontrollers;
+    QVector<SDL_JoystickID> m_device_ids; ///< instance ids by SDL device index
 
     QHash<InputDevice *, InputDeviceBitArrayStatus *> releaseEventsGenerated;
     QHash<InputDevice *, InputDeviceBitArrayStatus *> pendingEventValues;
 
     bool stopped;
+    bool firstEventDispatched;
     bool m_graphical;
+    bool separatePlayerDevices;
+    AxisCoalescing axisCoalescing;
 
     SDLEventReader *eventWorker;
     QThread *sdlWorkerThread;
@@ -27,17 +27,20 @@
 #include "joycontrolstick.h"
 #include "joydpad.h"
 #include "joysensor.h"
+#include "joytouchpad.h"
 #include "vdpad.h"
 
 #include <typeinfo>
 
 #include <QDebug>
+#include <QThread>
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 
 InputDevice::InputDevice(SDL_Joystick *joystick, int deviceIndex, AntiMicroSettings *settings, QObject *parent)
     : QObject(parent)
     , m_calibrations(this)
+    , sensorEventRequests(0)
 {
     buttonDownCount = 0;
     joyNumber = deviceIndex;
@@ -69,11 +72,10 @@ void InputDevice::reset()
     deviceEdited = false;
     profileName = "";
 
-    for (int i = 0; i < GlobalVariables::InputDevice::NUMBER_JOYSETS; i++)
-    {
-        SetJoystick *set = getJoystick_sets().value(i);
+    for (auto &set : getJoystick_sets())
         set->reset();
-    }
+
+    updateSensorDemand();
 }
 
 /**
@@ -156,7 +158,7 @@ void InputDevice::setActiveSetNumber(int index)
         // Grab current states for all elements in old set
         SetJoystick *current_set = getJoystick_sets().value(active_set);
         SetJoystick *old_set = current_set;
-        SetJoystick *tempSet = getJoystick_sets().value(index);
+        SetJoystick *tempSet = getSetJoystick(index);
 
         for (int i = 0; i < current_set->getNumberButtons(); i++)
         {
@@ -560,7 +562,7 @@ void InputDevice::setActiveSetNumber(int index)
 
 int InputDevice::getActiveSetNumber() { return active_set; }
 
-SetJoystick *InputDevice::getActiveSetJoystick() { return getJoystick_sets().value(active_set); }
+SetJoystick *InputDevice::getActiveSetJoystick() { return findSetJoystick(active_set); }
 
 int InputDevice::getNumberButtons() { return getActiveSetJoystick()->getNumberButtons(); }
 
@@ -578,13 +580,79 @@ bool InputDevice::hasSensor(JoySensorType type) { return getActiveSetJoystick()-
 
 int InputDevice::getNumberVDPads() { return getActiveSetJoystick()->getNumberVDPads(); }
 
-SetJoystick *InputDevice::getSetJoystick(int index) { return getJoystick_sets().value(index); }
+/**
+ * @brief Gets a set of the device and creates it on first use. Sets that
+ *     were never used are not allocated and behave like empty sets.
+ * @return nullptr for an index outside of the available sets
+ */
+SetJoystick *InputDevice::getSetJoystick(int index)
+{
+    if ((index < 0) || (index >= GlobalVariables::InputDevice::NUMBER_JOYSETS))
+        return nullptr;
+
+    SetJoystick *setstick = findSetJoystick(index);
+
+    if (setstick == nullptr)
+    {
+        // Elements of a set have to live in the thread of the device.
+        if (QThread::currentThread() == thread())
+            allocateSetJoystick(index);
+        else
+            QMetaObject::invokeMethod(this, "allocateSetJoystick", Qt::BlockingQueuedConnection, Q_ARG(int, index));
+
+        setstick = findSetJoystick(index);
+    }
+
+    return setstick;
+}
+
+/**
+ * @brief Gets a set of the device without creating it.
+ * @return nullptr if the set was not used yet
+ */
+SetJoystick *InputDevice::findSetJoystick(int index) const
+{
+    QReadLocker tempLocker(&setsLock);
+    return joystick_sets.value(index, nullptr);
+}
+
+/**
+ * @brief Creates an empty set. Devices with their own set class override it.
+ */
+SetJoystick *InputDevice::createSetJoystick(int index) { return new SetJoystick(this, index, this); }
+
+/**
+ * @brief Creates a set and gives it what all sets of the device share with
+ *     the first set, like names, control sticks and calibration.
+ */
+void InputDevice::allocateSetJoystick(int index)
+{
+    // Runs on the thread of the device, the only one changing the map, so reads need no lock here.
+    if (joystick_sets.contains(index))
+        return;
+
+    SetJoystick *setstick = createSetJoystick(index);
+    SetJoystick *firstSet = joystick_sets.value(0, nullptr);
+
+    if (firstSet != nullptr)
+        firstSet->copyLayout(setstick);
+
+    setsLock.lockForWrite();
+    joystick_sets.insert(index, setstick);
+    setsLock.unlock();
+    enableSetConnections(setstick);
+
+    if (firstSet != nullptr)
+        m_calibrations.applyCalibrations();
+
+    DEBUG() << "Allocated set " << (index + 1) << " for device " << getRealJoyNumber();
+}
 
 void InputDevice::propogateSetChange(int index) { emit setChangeActivated(index); }
 
 void InputDevice::changeSetButtonAssociation(int button_index, int originset, int newset, int mode)
 {
-    JoyButton *button = getJoystick_sets().value(newset)->getJoyButton(button_index);
+    JoyButton *button = getSetJoystick(newset)->getJoyButton(button_index);
     JoyButton::SetChangeCondition tempmode = static_cast<JoyButton::SetChangeCondition>(mode);
     button->setChangeSetSelection(originset);
     button->setChangeSetCondition(tempmode, true);
@@ -596,10 +664,10 @@ void InputDevice::changeSetAxisButtonAssociation(int button_index, int axis_inde
 
     if (button_index == 0)
     {
-        button = getJoystick_sets().value(newset)->getJoyAxis(axis_index)->getNAxisButton();
+        button = getSetJoystick(newset)->getJoyAxis(axis_index)->getNAxisButton();
     } else if (button_index == 1)
     {
-        button = getJoystick_sets().value(newset)->getJoyAxis(axis_index)->getPAxisButton();
+        button = getSetJoystick(newset)->getJoyAxis(axis_index)->getPAxisButton();
     } else
     {
         WARN() << "Invalid button_index value: " << button_index;
@@ -615,10 +683,8 @@ void InputDevice::changeSetAxisButtonAssociation(int button_index, int axis_inde
 
 void InputDevice::changeSetStickButtonAssociation(int button_index, int stick_index, int originset, int newset, int mode)
 {
-    JoyControlStickButton *button = getJoystick_sets()
-                                        .value(newset)
-                                        ->getJoyStick(stick_index)
-                                        ->getDirectionButton(static_cast<JoyControlStick::JoyStickDirections>(button_index));
+    JoyControlStickButton *button = getSetJoystick(newset)->getJoyStick(stick_index)->getDirectionButton(
+        static_cast<JoyControlStick::JoyStickDirections>(button_index));
 
     JoyButton::SetChangeCondition tempmode = static_cast<JoyButton::SetChangeCondition>(mode);
     button->setChangeSetSelection(originset);
@@ -632,7 +698,7 @@ void InputDevice::changeSetStickButtonAssociation(int button_index, int stick_in
 void InputDevice::changeSetSensorButtonAssociation(JoySensorDirection direction, JoySensorType type, int originset,
                                                    int newset, int mode)
 {
-    JoySensorButton *button = getJoystick_sets().value(newset)->getSensor(type)->getDirectionButton(direction);
+    JoySensorButton *button = getSetJoystick(newset)->getSensor(type)->getDirectionButton(direction);
 
     JoyButton::SetChangeCondition tempmode = static_cast<JoyButton::SetChangeCondition>(mode);
     button->setChangeSetSelection(originset);
@@ -641,7 +707,7 @@ void InputDevice::changeSetSensorButtonAssociation(JoySensorDirection direction,
 
 void InputDevice::changeSetDPadButtonAssociation(int button_index, int dpad_index, int originset, int newset, int mode)
 {
-    JoyDPadButton *button = getJoystick_sets().value(newset)->getJoyDPad(dpad_index)->getJoyButton(button_index);
+    JoyDPadButton *button = getSetJoystick(newset)->getJoyDPad(dpad_index)->getJoyButton(button_index);
 
     JoyButton::SetChangeCondition tempmode = static_cast<JoyButton::SetChangeCondition>(mode);
     button->setChangeSetSelection(originset);
@@ -650,7 +716,7 @@ void InputDevice::changeSetDPadButtonAssociation(int button_index, int dpad_inde
 
 void InputDevice::changeSetVDPadButtonAssociation(int button_index, int dpad_index, int originset, int newset, int mode)
 {
-    JoyDPadButton *button = getJoystick_sets().value(newset)->getVDPad(dpad_index)->getJoyButton(button_index);
+    JoyDPadButton *button = getSetJoystick(newset)->getVDPad(dpad_index)->getJoyButton(button_index);
 
     JoyButton::SetChangeCondition tempmode = static_cast<JoyButton::SetChangeCondition>(mode);
     button->setChangeSetSelection(originset);
@@ -681,10 +747,8 @@ void InputDevice::propogateSetAxisThrottleChange(int index, int originset)
 
 void InputDevice::removeControlStick(int index)
 {
-    for (int i = 0; i < GlobalVariables::InputDevice::NUMBER_JOYSETS; i++)
+    for (auto &currentset : getJoystick_sets())
     {
-        SetJoystick *currentset = getSetJoystick(i);
-
         if (currentset->getJoyStick(index))
             currentset->removeControlStick(index);
     }
@@ -1141,6 +1205,7 @@ void InputDevice::enableSetConnections(SetJoystick *setstick)
     connect(setstick, &SetJoystick::setAssignmentVDPadChanged, this, &InputDevice::changeSetVDPadButtonAssociation);
     connect(setstick, &SetJoystick::setAssignmentStickChanged, this, &InputDevice::changeSetStickButtonAssociation);
     connect(setstick, &SetJoystick::setAssignmentSensorChanged, this, &InputDevice::changeSetSensorButtonAssociation);
+    connect(setstick, &SetJoystick::sensorSlotsChanged, this, &InputDevice::updateSensorDemand);
     connect(setstick, &SetJoystick::setAssignmentAxisThrottleChanged, this, &InputDevice::propogateSetAxisThrottleChange);
 
     connect(setstick, &SetJoystick::setButtonClick, this, &InputDevice::buttonDownEvent);
@@ -1243,6 +1308,78 @@ void InputDevice::disconnectPropertyUpdatedConnection()
     disconnect(this, &InputDevice::propertyUpdated, this, &InputDevice::profileEdited);
 }
 
+/**
+ * @brief Turns hardware sensors on while any set of the loaded profile assigns
+ *  slots to them or a window requested live sensor data, and off otherwise.
+ *  Unused sensors would flood the input thread with hundreds of events per second.
+ *  Demand does not depend on the active set, so a set change never switches
+ *  to a sensor which has not delivered samples yet.
+ *  Tilt is fused from both sensors and the gyroscope offset is only learned
+ *  while fresh accelerometer samples confirm that the controller rests,
+ *  so both sensors are always turned on and off together.
+ */
+void InputDevice::updateSensorDemand()
+{
+    bool needed = sensorEventRequests.loadAcquire() > 0;
+
+    const QMap<int, SetJoystick *> sets = getJoystick_sets();
+
+    for (auto iter = sets.constBegin(); !needed && (iter != sets.constEnd()); ++iter)
+    {
+        for (size_t i = 0; i < SENSOR_COUNT; ++i)
+        {
+            JoySensor *sensor = iter.value()->getSensor(static_cast<JoySensorType>(i));
+
+            if ((sensor != nullptr) && sensor->hasSlotsAssigned())
+                needed = true;
+        }
+    }
+
+    for (size_t i = 0; i < SENSOR_COUNT; ++i)
+    {
+        JoySensorType type = static_cast<JoySensorType>(i);
+
+        if (!hasRawSensor(type))
+            continue;
+
+        // Without gyroscope data the orientation has to follow the accelerometer again.
+        if ((type == GYROSCOPE) && !needed)
+            m_orientation.reset();
+
+        setRawSensorEnabled(type, needed);
+    }
+}
+
+/**
+ * @brief Keeps sensors enabled regardless of the profile, e.g. while a window
+ *  displays raw sensor values. Every request must be paired with a release.
+ *  Can be called from any thread.
+ */
+void InputDevice::requestSensorEvents(bool requested)
+{
+    if (requested)
+        sensorEventRequests.ref();
+    else
+        sensorEventRequests.deref();
+
+    QMetaObject::invokeMethod(this, "updateSensorDemand", Qt::QueuedConnection);
+}
+
+/**
+ * @brief Enables or disables event reporting of a hardware sensor.
+ *  Does nothing by default.
+ */
+void InputDevice::setRawSensorEnabled(JoySensorType type, bool enabled)
+{
+    Q_UNUSED(type);
+    Q_UNUSED(enabled);
+}
+
+/**
+ * @brief Amount of touchpads of the device. Plain joysticks have none.
+ */
+int InputDevice::getNumberRawTouchpads() { return 0; }
+
 void InputDevice::setKeyRepeatStatus(bool enabled) { keyRepeatEnabled = enabled; }
 
 void InputDevice::setKeyRepeatDelay(int delay)
@@ -1358,10 +1495,8 @@ void InputDevice::setCalibrationThrottle(int axisNum, JoyAxis::ThrottleTypes thr
 {
     if (!getCali().contains(axisNum))
     {
-        for (int i = 0; i < GlobalVariables::InputDevice::NUMBER_JOYSETS; i++)
-        {
-            getJoystick_sets().value(i)->setAxisThrottle(axisNum, throttle);
-        }
+        for (auto &set : getJoystick_sets())
+            set->setAxisThrottle(axisNum, throttle);
 
         getCali().insert(axisNum, throttle);
     }
@@ -1469,6 +1604,19 @@ void InputDevice::activatePossibleSensorEvents()
     }
 }
 
+void InputDevice::activatePossibleTouchpadEvents()
+{
+    SetJoystick *currentSet = getActiveSetJoystick();
+
+    for (int i = 0; i < currentSet->getNumberTouchpads(); i++)
+    {
+        JoyTouchpad *touchpad = currentSet->getTouchpad(i);
+
+        if ((touchpad != nullptr) && touchpad->hasPendingEvent())
+            touchpad->activatePendingEvent();
+    }
+}
+
 void InputDevice::activatePossibleDPadEvents()
 {
     SetJoystick *currentSet = getActiveSetJoystick();
@@ -1714,7 +1862,15 @@ void InputDevice::convertToUniqueMappSett(QSettings *sett, QString gUIDmappGroup
     }
 }
 
-QMap<int, SetJoystick *> &InputDevice::getJoystick_sets() { return joystick_sets; }
+/**
+ * @brief Gets the sets allocated so far. The map is a copy, so other threads
+ *     can walk it while the device creates more sets.
+ */
+QMap<int, SetJoystick *> InputDevice::getJoystick_sets() const
+{
+    QReadLocker tempLocker(&setsLock);
+    return joystick_sets;
+}
 
 QHash<int, JoyAxis::ThrottleTypes> &InputDevice::getCali() { return cali; }
 
@@ -1766,7 +1922,7 @@ void InputDevice::updateStickCalibration(int index, double offsetX, double gainX
  */
 void InputDevice::applyStickCalibration(int index, double offsetX, double gainX, double offsetY, double gainY)
 {
-    for (auto &set : joystick_sets)
+    for (SetJoystick *set : getJoystick_sets())
     {
         JoyControlStick *stick = set->getSticks().value(index);
         if (stick != nullptr)
@@ -1796,7 +1952,7 @@ void InputDevice::updateAccelerometerCalibration(double offsetX, double offsetY,
  */
 void InputDevice::applyAccelerometerCalibration(double offsetX, double offsetY, double offsetZ)
 {
-    for (auto &set : joystick_sets)
+    for (SetJoystick *set : getJoystick_sets())
     {
         JoySensor *accelerometer = set->getSensor(ACCELEROMETER);
         if (accelerometer != nullptr)
@@ -1827,7 +1983,76 @@ void InputDevice::updateGyroscopeCalibration(double offsetX, double offsetY, dou
  */
 void InputDevice::applyGyroscopeCalibration(double offsetX, double offsetY, double offsetZ)
 {
-    for (auto &set : joystick_sets)
+    m_gyro_bias.seed(offsetX, offsetY, offsetZ);
+    setGyroscopeOffsets(offsetX, offsetY, offsetZ);
+}
+
+/**
+ * @brief Feeds raw sensor data into the online gyroscope offset estimation
+ *  and the orientation estimation of the controller. The gyroscope in all
+ *  sets is only recalibrated when the estimated offset changed noticeably.
+ *  Must be called on the input thread before the data is queued for the sensors.
+ * @param[in] type Type of the sensor the data belongs to
+ * @param[in] values Raw sensor values
+ * @param[in] timestamp Time of the sensor sample in microseconds
+ */
+void InputDevice::processRawSensorData(JoySensorType type, const float *values, quint64 timestamp)
+{
+    unsigned int timestampMsecs = static_cast<unsigned int>(timestamp / 1000);
+
+    if (type == ACCELEROMETER)
+    {
+        m_gyro_bias.processAccelerometer(values, timestampMsecs);
+        m_orientation.processAccelerometer(values);
+    } else if (type == GYROSCOPE)
+    {
+        if (!m_orientation.hasRate())
+            m_orientation.setRate(getRawSensorRate(GYROSCOPE));
+
+        double offsetX, offsetY, offsetZ;
+        bool changed = m_gyro_bias.processGyroscope(values, timestampMsecs);
+        m_gyro_bias.getBias(&offsetX, &offsetY, &offsetZ);
+        m_orientation.processGyroscope(values, offsetX, offsetY, offsetZ, timestamp);
+
+        if (changed)
+            setGyroscopeOffsets(offsetX, offsetY, offsetZ);
+    }
+}
+
+/**
+ * @brief Gets the direction of gravity fused from accelerometer and gyroscope
+ *  in raw accelerometer coordinates. Must be called on the input thread.
+ * @returns True if an orientation is known, false otherwise.
+ */
+bool InputDevice::getFusedGravity(double *x, double *y, double *z) const
+{
+    if (!m_orientation.hasOrientation())
+        return false;
+
+    m_orientation.getGravity(x, y, z);
+    return true;
+}
+
+/**
+ * @brief Reads the current gyroscope offset, either measured while the
+ *  controller rested or taken from the stored calibration.
+ *  Safe to call from the GUI thread.
+ * @returns True if an offset is known, false otherwise.
+ */
+bool InputDevice::getGyroscopeBias(double *offsetX, double *offsetY, double *offsetZ) const
+{
+    m_gyro_bias.getBias(offsetX, offsetY, offsetZ);
+    return m_gyro_bias.hasEstimate();
+}
+
+/**
+ * @brief Drops the measured gyroscope offset so that the estimation starts over.
+ */
+void InputDevice::resetGyroscopeBias() { m_gyro_bias.reset(); }
+
+void InputDevice::setGyroscopeOffsets(double offsetX, double offsetY, double offsetZ)
+{
+    for (SetJoystick *set : getJoystick_sets())
     {
         JoySensor *gyroscope = set->getSensor(GYROSCOPE);
         if (gyroscope != nullptr)
@@ -19,13 +19,17 @@
 #ifndef INPUTDEVICE_H
 #define INPUTDEVICE_H
 
+#include "gyrobiasestimator.h"
 #include "inputdevicecalibration.h"
+#include "orientationestimator.h"
 #include "joysensordirection.h"
 #include "joysensortype.h"
 #include "setjoystick.h"
 
 #include <SDL2/SDL_joystick.h>
 
+#include <QReadWriteLock>
+
 class AntiMicroSettings;
 class SetJoystick;
 class QXmlStreamReader;
@@ -67,6 +71,7 @@ class InputDevice : public QObject
     int getActiveSetNumber();
     SetJoystick *getActiveSetJoystick();
     SetJoystick *getSetJoystick(int index);
+    SetJoystick *findSetJoystick(int index) const;
     void removeControlStick(int index);
     bool isActive();
     int getButtonDownCount();
@@ -115,6 +120,9 @@ class InputDevice : public QObject
     virtual int getNumberRawHats() = 0;
     virtual double getRawSensorRate(JoySensorType type) = 0;
     virtual bool hasRawSensor(JoySensorType type) = 0;
+    virtual void setRawSensorEnabled(JoySensorType type, bool enabled);
+    virtual int getNumberRawTouchpads();
+    void requestSensorEvents(bool requested);
 
     int getDeviceKeyPressTime(); // unsigned
 
@@ -144,6 +152,7 @@ class InputDevice : public QObject
     void activatePossibleControlStickEvents(); // InputDeviceStick class
     void activatePossibleAxisEvents();         // InputDeviceAxis class
     void activatePossibleSensorEvents();
+    void activatePossibleTouchpadEvents();
     void activatePossibleDPadEvents();   // InputDeviceHat class
     void activatePossibleVDPadEvents();  // InputDeviceVDPad class
     void activatePossibleButtonEvents(); // InputDeviceButton class
@@ -159,7 +168,7 @@ class InputDevice : public QObject
     void rawAxisEvent(int index, int value); // InputDeviceAxis class
     bool elementsHaveNames();
 
-    QMap<int, SetJoystick *> &getJoystick_sets();
+    QMap<int, SetJoystick *> getJoystick_sets() const;
     SDL_Joystick *getJoyHandle() const;
     virtual SDL_GameControllerType getControllerType() const;
 
@@ -170,9 +179,13 @@ class InputDevice : public QObject
     void applyAccelerometerCalibration(double offsetX, double offsetY, double offsetZ);
     void updateGyroscopeCalibration(double offsetX, double offsetY, double offsetZ);
     void applyGyroscopeCalibration(double offsetX, double offsetY, double offsetZ);
+    void processRawSensorData(JoySensorType type, const float *values, quint64 timestamp);
+    bool getGyroscopeBias(double *offsetX, double *offsetY, double *offsetZ) const;
+    bool getFusedGravity(double *x, double *y, double *z) const;
 
   protected:
     void enableSetConnections(SetJoystick *setstick);
+    virtual SetJoystick *createSetJoystick(int index);
 
     QHash<int, JoyAxis::ThrottleTypes> &getCali();
     SDL_JoystickID *getJoystickID();
@@ -233,6 +246,8 @@ class InputDevice : public QObject
 
     void establishPropertyUpdatedConnection();
     void disconnectPropertyUpdatedConnection();
+    void updateSensorDemand();
+    void resetGyroscopeBias();
 
   protected slots:
     void propogateSetChange(int index);
@@ -263,13 +278,18 @@ class InputDevice : public QObject
     void updateSetDPadNames(int dpadIndex);   // InputDeviceHat class
     void updateSetVDPadNames(int vdpadIndex); // InputDeviceVDPad class
 
+  private slots:
+    void allocateSetJoystick(int index);
+
   private:
     QList<bool> &getButtonstatesLocal();
     QList<int> &getAxesstatesLocal();
     QList<int> &getDpadstatesLocal();
+    void setGyroscopeOffsets(double offsetX, double offsetY, double offsetZ);
 
     SDL_Joystick *m_joyhandle;
     QMap<int, SetJoystick *> joystick_sets;
+    mutable QReadWriteLock setsLock; // Guards joystick_sets. Sets are only inserted on the thread of the device.
     QHash<int, JoyAxis::ThrottleTypes> cali;
     AntiMicroSettings *m_settings;
     int active_set;
@@ -277,6 +297,9 @@ class InputDevice : public QObject
     int buttonDownCount;
     SDL_JoystickID joystickID;
     bool deviceEdited;
+    QAtomicInt sensorEventRequests;
+    GyroBiasEstimator m_gyro_bias;
+    OrientationEstimator m_orientation;
 
     bool keyRepeatEnabled;
     int keyRepeatDelay;
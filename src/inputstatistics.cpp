@@ -0,0 +1,334 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "inputstatistics.h"
+
+#include "eventhandlerfactory.h"
+#include "inputdevice.h"
+
+#include <QtMath>
+
+#include <algorithm>
+#include <iterator>
+
+QHash<SDL_JoystickID, InputStatistics::DeviceCycle> InputStatistics::cycleCounts;
+QMutex InputStatistics::mutex;
+QElapsedTimer InputStatistics::windowTimer;
+QHash<SDL_JoystickID, InputStatistics::DeviceWindow> InputStatistics::windowCounts;
+QVector<qint64> InputStatistics::windowDispatchTimes;
+int InputStatistics::windowCycles = 0;
+int InputStatistics::windowCoalesced = 0;
+int InputStatistics::windowMaxQueueDepth = 0;
+quint64 InputStatistics::windowStartMouseTicks = 0;
+quint64 InputStatistics::windowStartSyscalls = 0;
+StatisticsEstimator InputStatistics::dispatchEstimator;
+InputStatistics::Snapshot InputStatistics::published;
+
+/**
+ * @brief Counts a fetched SDL event for its device. Must only be called
+ *  from the input thread.
+ */
+void InputStatistics::countEvent(const SDL_Event &event)
+{
+    SDL_JoystickID which = 0;
+    EventKind kind = AxisEvent;
+
+    switch (event.type)
+    {
+    case SDL_JOYAXISMOTION:
+        which = event.jaxis.which;
+        break;
+    case SDL_CONTROLLERAXISMOTION:
+        which = event.caxis.which;
+        break;
+    case SDL_JOYBUTTONDOWN:
+    case SDL_JOYBUTTONUP:
+        which = event.jbutton.which;
+        kind = ButtonEvent;
+        break;
+    case SDL_CONTROLLERBUTTONDOWN:
+    case SDL_CONTROLLERBUTTONUP:
+        which = event.cbutton.which;
+        kind = ButtonEvent;
+        break;
+    case SDL_JOYHATMOTION:
+        which = event.jhat.which;
+        kind = HatEvent;
+        break;
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+    case SDL_CONTROLLERSENSORUPDATE:
+        which = event.csensor.which;
+        kind = SensorEvent;
+        break;
+    case SDL_CONTROLLERTOUCHPADDOWN:
+    case SDL_CONTROLLERTOUCHPADMOTION:
+    case SDL_CONTROLLERTOUCHPADUP:
+        which = event.ctouchpad.which;
+        kind = TouchpadEvent;
+        break;
+#endif
+    default:
+        return;
+    }
+
+    cycleCounts[which].totals[kind]++;
+}
+
+/**
+ * @brief Counts an axis event of the device which was merged into another one.
+ *  Must only be called from the input thread.
+ */
+void InputStatistics::countCoalesced(SDL_JoystickID deviceID) { cycleCounts[deviceID].coalesced++; }
+
+/**
+ * @brief Adds time spent dispatching an event of the device in the current
+ *  poll cycle. Must only be called from the input thread.
+ */
+void InputStatistics::countDispatch(SDL_JoystickID deviceID, qint64 dispatchNsecs)
+{
+    cycleCounts[deviceID].dispatchNsecs += dispatchNsecs;
+}
+
+/**
+ * @brief Merges the events counted during the current poll cycle and records
+ *  its queue depth, the amount of coalesced events and the dispatch time,
+ *  for each device and for the whole cycle.
+ */
+void InputStatistics::finishCycle(int queueDepth, int coalesced, qint64 dispatchNsecs)
+{
+    QMutexLocker locker(&mutex);
+
+    for (auto iter = cycleCounts.constBegin(); iter != cycleCounts.constEnd(); ++iter)
+    {
+        const DeviceCycle &cycle = iter.value();
+        DeviceWindow &window = windowCounts[iter.key()];
+        int deviceQueueDepth = 0;
+
+        for (int i = 0; i < EVENT_KIND_COUNT; i++)
+        {
+            window.totals[i] += cycle.totals[i];
+            deviceQueueDepth += static_cast<int>(cycle.totals[i]);
+        }
+
+        window.coalesced += cycle.coalesced;
+        window.maxQueueDepth = qMax(window.maxQueueDepth, deviceQueueDepth);
+
+        if (cycle.dispatchNsecs > 0)
+        {
+            qint64 deviceDispatchUsecs = cycle.dispatchNsecs / 1000;
+            window.dispatchEstimator.process(deviceDispatchUsecs);
+
+            if (window.dispatchTimes.size() < MAX_WINDOW_SAMPLES)
+                window.dispatchTimes.append(deviceDispatchUsecs);
+        }
+    }
+
+    cycleCounts.clear();
+
+    qint64 dispatchUsecs = dispatchNsecs / 1000;
+    windowCycles++;
+    windowCoalesced += coalesced;
+    windowMaxQueueDepth = qMax(windowMaxQueueDepth, queueDepth);
+    dispatchEstimator.process(dispatchUsecs);
+
+    if (windowDispatchTimes.size() < MAX_WINDOW_SAMPLES)
+        windowDispatchTimes.append(dispatchUsecs);
+
+    if (!windowTimer.isValid())
+        windowTimer.start();
+    else if (windowTimer.elapsed() >= WINDOW_MSECS)
+        rollWindow(windowTimer.elapsed());
+}
+
+void InputStatistics::removeDevice(SDL_JoystickID deviceID)
+{
+    QMutexLocker locker(&mutex);
+
+    cycleCounts.remove(deviceID);
+    windowCounts.remove(deviceID);
+    published.devices.remove(deviceID);
+}
+
+/**
+ * @brief Drops all numbers, the overall maxima and dispatch time estimates
+ *  included, and starts a new window.
+ */
+void InputStatistics::reset()
+{
+    QMutexLocker locker(&mutex);
+
+    windowCounts.clear();
+    windowDispatchTimes.clear();
+    windowCycles = 0;
+    windowCoalesced = 0;
+    windowMaxQueueDepth = 0;
+    dispatchEstimator.reset();
+    published = Snapshot();
+    windowTimer.invalidate();
+
+    BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+
+    if (handler != nullptr)
+    {
+        windowStartMouseTicks = handler->getMouseTickCount();
+        windowStartSyscalls = handler->getSyscallCount();
+    }
+}
+
+/**
+ * @brief Gets the numbers of the last completed window. Closes the current
+ *  window first if it is overdue, so an idle input thread reports zero rates.
+ */
+InputStatistics::Snapshot InputStatistics::snapshot()
+{
+    QMutexLocker locker(&mutex);
+
+    if (!windowTimer.isValid())
+        windowTimer.start();
+    else if (windowTimer.elapsed() >= WINDOW_MSECS)
+        rollWindow(windowTimer.elapsed());
+
+    return published;
+}
+
+/**
+ * @brief Describes the current statistics in the key=value format of the local socket.
+ *  The first line covers the input thread, the following ones a device each.
+ */
+QStringList InputStatistics::reportLines(const QMap<SDL_JoystickID, InputDevice *> *joysticks)
+{
+    Snapshot stats = snapshot();
+    QStringList lines;
+
+    lines.append(QString("input cycles=%1/s queue_max=%2 queue_max_total=%3 dispatch_p50_us=%4 dispatch_p99_us=%5 "
+                         "dispatch_mean_us=%6 dispatch_stddev_us=%7 coalesced=%8/s mouse_ticks=%9/s syscalls=%10/s")
+                     .arg(stats.cyclesPerSecond, 0, 'f', 1)
+                     .arg(stats.maxQueueDepth)
+                     .arg(stats.maxQueueDepthTotal)
+                     .arg(stats.dispatchP50)
+                     .arg(stats.dispatchP99)
+                     .arg(stats.dispatchMean, 0, 'f', 1)
+                     .arg(stats.dispatchStdDev, 0, 'f', 1)
+                     .arg(stats.coalescedPerSecond, 0, 'f', 1)
+                     .arg(stats.mouseTicksPerSecond, 0, 'f', 1)
+                     .arg(stats.syscallsPerSecond, 0, 'f', 1));
+
+    if (joysticks == nullptr)
+        return lines;
+
+    for (auto iter = stats.devices.constBegin(); iter != stats.devices.constEnd(); ++iter)
+    {
+        InputDevice *device = joysticks->value(iter.key(), nullptr);
+
+        if (device == nullptr)
+            continue;
+
+        const DeviceRates &rates = iter.value();
+        lines.append(QString("rates %1 axis=%2/s button=%3/s hat=%4/s sensor=%5/s touchpad=%6/s coalesced=%7/s")
+                         .arg(device->getRealJoyNumber())
+                         .arg(rates.rates[AxisEvent], 0, 'f', 1)
+                         .arg(rates.rates[ButtonEvent], 0, 'f', 1)
+                         .arg(rates.rates[HatEvent], 0, 'f', 1)
+                         .arg(rates.rates[SensorEvent], 0, 'f', 1)
+                         .arg(rates.rates[TouchpadEvent], 0, 'f', 1)
+                         .arg(rates.coalescedPerSecond, 0, 'f', 1));
+        lines.append(QString("device %1 queue_max=%2 queue_max_total=%3 dispatch_p50_us=%4 dispatch_p99_us=%5 "
+                             "dispatch_mean_us=%6 dispatch_stddev_us=%7")
+                         .arg(device->getRealJoyNumber())
+                         .arg(rates.maxQueueDepth)
+                         .arg(rates.maxQueueDepthTotal)
+                         .arg(rates.dispatchP50)
+                         .arg(rates.dispatchP99)
+                         .arg(rates.dispatchMean, 0, 'f', 1)
+                         .arg(rates.dispatchStdDev, 0, 'f', 1));
+    }
+
+    return lines;
+}
+
+/**
+ * @brief Publishes the current window and starts a new one. Expects the mutex to be held.
+ */
+void InputStatistics::rollWindow(qint64 elapsed)
+{
+    const double scale = 1000.0 / qMax<qint64>(elapsed, 1);
+
+    for (auto iter = windowCounts.begin(); iter != windowCounts.end(); ++iter)
+    {
+        DeviceWindow &window = iter.value();
+        DeviceRates &device = published.devices[iter.key()];
+
+        for (int i = 0; i < EVENT_KIND_COUNT; i++)
+        {
+            device.rates[i] = window.totals[i] * scale;
+            device.totals[i] += window.totals[i];
+        }
+
+        device.coalescedPerSecond = window.coalesced * scale;
+        device.maxQueueDepth = window.maxQueueDepth;
+        device.maxQueueDepthTotal = qMax(device.maxQueueDepthTotal, window.maxQueueDepth);
+        device.dispatchP50 = percentile(window.dispatchTimes, 0.5);
+        device.dispatchP99 = percentile(window.dispatchTimes, 0.99);
+        device.dispatchMean = window.dispatchEstimator.getMean();
+        device.dispatchStdDev =
+            (window.dispatchEstimator.getCount() > 1) ? qSqrt(window.dispatchEstimator.calculateVariance()) : 0.0;
+
+        std::fill(std::begin(window.totals), std::end(window.totals), 0);
+        window.coalesced = 0;
+        window.maxQueueDepth = 0;
+        window.dispatchTimes.clear();
+    }
+
+    published.cyclesPerSecond = windowCycles * scale;
+    published.coalescedPerSecond = windowCoalesced * scale;
+    published.maxQueueDepth = windowMaxQueueDepth;
+    published.maxQueueDepthTotal = qMax(published.maxQueueDepthTotal, windowMaxQueueDepth);
+    published.dispatchP50 = percentile(windowDispatchTimes, 0.5);
+    published.dispatchP99 = percentile(windowDispatchTimes, 0.99);
+    published.dispatchMean = dispatchEstimator.getMean();
+    published.dispatchStdDev = (dispatchEstimator.getCount() > 1) ? qSqrt(dispatchEstimator.calculateVariance()) : 0.0;
+
+    BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+
+    if (handler != nullptr)
+    {
+        quint64 mouseTicks = handler->getMouseTickCount();
+        quint64 syscalls = handler->getSyscallCount();
+
+        published.mouseTicksPerSecond = (mouseTicks - windowStartMouseTicks) * scale;
+        published.syscallsPerSecond = (syscalls - windowStartSyscalls) * scale;
+        published.mouseTicks = mouseTicks;
+        published.syscalls = syscalls;
+        windowStartMouseTicks = mouseTicks;
+        windowStartSyscalls = syscalls;
+    }
+
+    windowDispatchTimes.clear();
+    windowCycles = 0;
+    windowCoalesced = 0;
+    windowMaxQueueDepth = 0;
+    windowTimer.restart();
+}
+
+qint64 InputStatistics::percentile(QVector<qint64> &samples, double fraction)
+{
+    if (samples.isEmpty())
+        return 0;
+
+    int index = qMin(static_cast<int>(samples.size() * fraction), samples.size() - 1);
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples.at(index);
+}
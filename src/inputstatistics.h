@@ -0,0 +1,139 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INPUTSTATISTICS_H
+#define INPUTSTATISTICS_H
+
+#include "statisticsestimator.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QStringList>
+#include <QVector>
+
+#include <SDL2/SDL_events.h>
+
+class InputDevice;
+
+/**
+ * @brief Cheap counters describing how hard the input thread is working.
+ *
+ * InputDaemon counts every fetched SDL event, every coalesced axis event
+ * and the time spent dispatching the events of each device. Each poll
+ * cycle is finished with its total queue depth and dispatch time.
+ * Rates and percentiles are published once per window of WINDOW_MSECS,
+ * per device and for the whole input thread, so every reader (status
+ * window, local socket) sees the same numbers regardless of how often
+ * it asks. Mouse ticks and syscalls are only known for the whole thread
+ * because the output of all devices is merged in the event handler.
+ * Counting happens without locking on the input thread, the mutex is
+ * only taken once per cycle and per snapshot.
+ */
+class InputStatistics
+{
+  public:
+    enum EventKind
+    {
+        AxisEvent = 0,
+        ButtonEvent,
+        HatEvent,
+        SensorEvent,
+        TouchpadEvent,
+        EVENT_KIND_COUNT
+    };
+
+    struct DeviceRates
+    {
+        double rates[EVENT_KIND_COUNT] = {}; ///< events per second by EventKind
+        quint64 totals[EVENT_KIND_COUNT] = {};
+        double coalescedPerSecond = 0.0;
+        int maxQueueDepth = 0;      ///< most events of the device in one cycle, last window
+        int maxQueueDepthTotal = 0; ///< since the last reset
+        qint64 dispatchP50 = 0;     ///< microseconds per cycle, last window
+        qint64 dispatchP99 = 0;     ///< microseconds per cycle, last window
+        double dispatchMean = 0.0;  ///< microseconds per cycle since the last reset
+        double dispatchStdDev = 0.0;
+    };
+
+    struct Snapshot
+    {
+        QMap<SDL_JoystickID, DeviceRates> devices;
+        double cyclesPerSecond = 0.0;
+        double coalescedPerSecond = 0.0;
+        int maxQueueDepth = 0;      ///< within the last window
+        int maxQueueDepthTotal = 0; ///< since the last reset
+        qint64 dispatchP50 = 0;     ///< microseconds, last window
+        qint64 dispatchP99 = 0;     ///< microseconds, last window
+        double dispatchMean = 0.0;  ///< microseconds since the last reset
+        double dispatchStdDev = 0.0;
+        double mouseTicksPerSecond = 0.0;
+        double syscallsPerSecond = 0.0;
+        quint64 mouseTicks = 0;
+        quint64 syscalls = 0;
+    };
+
+    static const int WINDOW_MSECS = 1000;
+    static const int MAX_WINDOW_SAMPLES = 10000;
+
+    static void countEvent(const SDL_Event &event);
+    static void countCoalesced(SDL_JoystickID deviceID);
+    static void countDispatch(SDL_JoystickID deviceID, qint64 dispatchNsecs);
+    static void finishCycle(int queueDepth, int coalesced, qint64 dispatchNsecs);
+    static void removeDevice(SDL_JoystickID deviceID);
+    static void reset();
+
+    static Snapshot snapshot();
+    static QStringList reportLines(const QMap<SDL_JoystickID, InputDevice *> *joysticks);
+
+  private:
+    struct DeviceCycle
+    {
+        quint64 totals[EVENT_KIND_COUNT] = {};
+        int coalesced = 0;
+        qint64 dispatchNsecs = 0;
+    };
+
+    struct DeviceWindow
+    {
+        quint64 totals[EVENT_KIND_COUNT] = {};
+        int coalesced = 0;
+        int maxQueueDepth = 0;
+        QVector<qint64> dispatchTimes;
+        StatisticsEstimator dispatchEstimator; ///< kept across windows until the device is removed
+    };
+
+    static void rollWindow(qint64 elapsed);
+    static qint64 percentile(QVector<qint64> &samples, double fraction);
+
+    // Only touched by the input thread.
+    static QHash<SDL_JoystickID, DeviceCycle> cycleCounts;
+
+    static QMutex mutex;
+    static QElapsedTimer windowTimer;
+    static QHash<SDL_JoystickID, DeviceWindow> windowCounts;
+    static QVector<qint64> windowDispatchTimes;
+    static int windowCycles;
+    static int windowCoalesced;
+    static int windowMaxQueueDepth;
+    static quint64 windowStartMouseTicks;
+    static quint64 windowStartSyscalls;
+    static StatisticsEstimator dispatchEstimator;
+    static Snapshot published;
+};
+
+#endif // INPUTSTATISTICS_H
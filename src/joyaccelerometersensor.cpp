@@ -19,9 +19,11 @@
 
 #include "joyaccelerometersensor.h"
 #include "globalvariables.h"
+#include "inputdevice.h"
 #include "joybuttontypes/joyaccelerometerbutton.h"
 
 #include <cmath>
+#include <cstring>
 
 const double JoyAccelerometerSensor::SHOCK_DETECT_THRESHOLD = 20.0;
 const double JoyAccelerometerSensor::SHOCK_SUPPRESS_FACTOR = 0.5;
@@ -62,6 +64,64 @@ float JoyAccelerometerSensor::getZCoordinate() const { return m_current_value[2]
  */
 QString JoyAccelerometerSensor::sensorTypeName() const { return tr("Accelerometer"); }
 
+/**
+ * @brief Calculate the pitch angle of the fused controller orientation.
+ *  Safe to call from any thread.
+ * @return Pitch (in radians)
+ */
+double JoyAccelerometerSensor::calculatePitch() const
+{
+    quint32 bits = static_cast<quint32>(m_published_tilt.load(std::memory_order_acquire) >> 32);
+    float pitch;
+    memcpy(&pitch, &bits, sizeof(pitch));
+    return pitch;
+}
+
+/**
+ * @brief Calculate the roll angle of the fused controller orientation.
+ *  Safe to call from any thread.
+ * @return Roll (in radians)
+ */
+double JoyAccelerometerSensor::calculateRoll() const
+{
+    quint32 bits = static_cast<quint32>(m_published_tilt.load(std::memory_order_acquire));
+    float roll;
+    memcpy(&roll, &bits, sizeof(roll));
+    return roll;
+}
+
+/**
+ * @brief Calculates the tilt past the dead zone in the given direction
+ *  as a fraction of the range between dead zone and max zone.
+ *  Shock events are passed through unchanged.
+ * @return Distance factor between 0 and 1 for tilt directions
+ */
+double JoyAccelerometerSensor::calculateDirectionalDistance(JoySensorDirection direction) const
+{
+    double angle = 0.0;
+
+    switch (direction)
+    {
+    case JoySensorDirection::SENSOR_UP:
+    case JoySensorDirection::SENSOR_DOWN:
+        angle = abs(calculatePitch());
+        break;
+    case JoySensorDirection::SENSOR_LEFT:
+    case JoySensorDirection::SENSOR_RIGHT:
+        angle = abs(calculateRoll());
+        break;
+    default:
+        return JoySensor::calculateDirectionalDistance(direction);
+    }
+
+    double range = m_max_zone - m_dead_zone;
+
+    if (isnan(angle) || range <= 0)
+        return 0.0;
+
+    return qBound(0.0, (angle - m_dead_zone) / range, 1.0);
+}
+
 /**
  * @brief Reads the calibration values of the sensor
  * @param[out] offsetX Offset angle around the X axis
@@ -117,6 +177,10 @@ void JoyAccelerometerSensor::reset()
 
     m_shock_filter.reset();
     m_shock_suppress_count = 0;
+
+    m_tilt_value[0] = m_tilt_value[2] = 0.0;
+    m_tilt_value[1] = 1.0;
+    publishTilt();
 }
 
 /**
@@ -165,6 +229,9 @@ void JoyAccelerometerSensor::populateButtons()
  */
 JoySensorDirection JoyAccelerometerSensor::calculateSensorDirection()
 {
+    // The tilt keeps following the orientation while shocks are suppressed.
+    updateTiltValue();
+
     double abs_sum = abs(m_current_value[0]) + abs(m_current_value[1]) + abs(m_current_value[2]);
     if (m_shock_filter.process(abs_sum) > SHOCK_DETECT_THRESHOLD)
     {
@@ -176,8 +243,8 @@ JoySensorDirection JoyAccelerometerSensor::calculateSensorDirection()
         return SENSOR_CENTERED;
     }
 
-    double pitch = calculatePitch();
-    double roll = calculateRoll();
+    double pitch = m_tilt_pitch;
+    double roll = m_tilt_roll;
     double pitch_abs = abs(pitch);
     double roll_abs = abs(roll);
 
@@ -229,3 +296,56 @@ void JoyAccelerometerSensor::applyCalibration()
     m_pending_value[1] = m_calibration_matrix[1][0] * x + m_calibration_matrix[1][1] * y + m_calibration_matrix[1][2] * z;
     m_pending_value[2] = m_calibration_matrix[2][0] * x + m_calibration_matrix[2][1] * y + m_calibration_matrix[2][2] * z;
 }
+
+/**
+ * @brief Takes the gravity direction fused from accelerometer and gyroscope
+ *  as base for pitch and roll. Falls back to the accelerometer values if
+ *  the device has no orientation estimate.
+ *  The gravity direction is rotated into the calibrated neutral position.
+ */
+void JoyAccelerometerSensor::updateTiltValue()
+{
+    double x, y, z;
+    InputDevice *device = getParentSet()->getInputDevice();
+
+    if ((device == nullptr) || !device->getFusedGravity(&x, &y, &z))
+    {
+        m_tilt_value[0] = m_current_value[0];
+        m_tilt_value[1] = m_current_value[1];
+        m_tilt_value[2] = m_current_value[2];
+        publishTilt();
+        return;
+    }
+
+    if (m_calibrated)
+    {
+        m_tilt_value[0] = m_calibration_matrix[0][0] * x + m_calibration_matrix[0][1] * y + m_calibration_matrix[0][2] * z;
+        m_tilt_value[1] = m_calibration_matrix[1][0] * x + m_calibration_matrix[1][1] * y + m_calibration_matrix[1][2] * z;
+        m_tilt_value[2] = m_calibration_matrix[2][0] * x + m_calibration_matrix[2][1] * y + m_calibration_matrix[2][2] * z;
+    } else
+    {
+        m_tilt_value[0] = x;
+        m_tilt_value[1] = y;
+        m_tilt_value[2] = z;
+    }
+
+    publishTilt();
+}
+
+/**
+ * @brief Calculates pitch and roll of the current tilt value and makes
+ *  them available to other threads.
+ */
+void JoyAccelerometerSensor::publishTilt()
+{
+    m_tilt_pitch = JoySensor::calculatePitch(m_tilt_value[0], m_tilt_value[1], m_tilt_value[2]);
+    m_tilt_roll = JoySensor::calculateRoll(m_tilt_value[0], m_tilt_value[1], m_tilt_value[2]);
+
+    float pitch = static_cast<float>(m_tilt_pitch);
+    float roll = static_cast<float>(m_tilt_roll);
+    quint32 pitchBits, rollBits;
+    memcpy(&pitchBits, &pitch, sizeof(pitchBits));
+    memcpy(&rollBits, &roll, sizeof(rollBits));
+
+    m_published_tilt.store((static_cast<quint64>(pitchBits) << 32) | rollBits, std::memory_order_release);
+}
@@ -19,6 +19,8 @@
 
 #include "joysensor.h"
 
+#include <atomic>
+
 class SetJoystick;
 
 /**
@@ -35,6 +37,10 @@ class JoyAccelerometerSensor : public JoySensor
     virtual float getZCoordinate() const override;
     virtual QString sensorTypeName() const override;
 
+    virtual double calculatePitch() const override;
+    virtual double calculateRoll() const override;
+    virtual double calculateDirectionalDistance(JoySensorDirection direction) const override;
+
     virtual void getCalibration(double *offsetX, double *offsetY, double *offsetZ) const override;
     virtual void setCalibration(double offsetX, double offsetY, double offsetZ) override;
 
@@ -49,9 +55,16 @@ class JoyAccelerometerSensor : public JoySensor
     virtual void populateButtons() override;
     virtual JoySensorDirection calculateSensorDirection() override;
     virtual void applyCalibration() override;
+    void updateTiltValue();
+    void publishTilt();
 
     double m_rate;
     PT1Filter m_shock_filter;
     size_t m_shock_suppress_count;
     double m_calibration_matrix[3][3];
+    double m_tilt_value[3];
+    double m_tilt_pitch;
+    double m_tilt_roll;
+    // Pitch and roll packed as two floats, so other threads read a consistent pair.
+    std::atomic<quint64> m_published_tilt;
 };
@@ -19,6 +19,7 @@
 #include "joyaxis.h"
 
 #include "event.h"
+#include "eventhandlerfactory.h"
 #include "globalvariables.h"
 #include "inputdevice.h"
 #include "joyaxis.h"
@@ -44,6 +45,7 @@ JoyAxis::JoyAxis(int index, int originset, SetJoystick *parentSet, QObject *pare
     currentRawValue = 0;
     m_originset = originset;
     m_parentSet = parentSet;
+    gamepadOutputAxis = -1;
     naxisbutton = new JoyAxisButton(this, 0, originset, parentSet, this);
     paxisbutton = new JoyAxisButton(this, 1, originset, parentSet, this);
 
@@ -58,6 +60,12 @@ void JoyAxis::queuePendingEvent(int value, bool ignoresets, bool updateLastValue
     if (m_calibrated)
         value = value * m_gain + m_offset;
 
+    if (gamepadOutputAxis >= 0)
+    {
+        sendGamepadOutputEvent(value);
+        return;
+    }
+
     if (m_stick != nullptr)
     {
         pendingEvent = false;
@@ -422,6 +430,59 @@ void JoyAxis::setInitialThrottle(int value)
 
 int JoyAxis::getThrottle() { return throttle; }
 
+/**
+ * @brief Pass the axis straight to an axis of the virtual gamepad instead of
+ *     its buttons or control stick.
+ * @param SDL_GameControllerAxis value or -1 to disable
+ */
+void JoyAxis::setGamepadOutputAxis(int axis)
+{
+    axis = qMax(-1, axis);
+
+    if (axis != gamepadOutputAxis)
+    {
+        if (isActive)
+        {
+            // Release whatever the axis was pressing before it is bypassed.
+            joyEvent(currentThrottledDeadValue, true);
+        }
+
+        centerGamepadOutput();
+        gamepadOutputAxis = axis;
+        emit propertyUpdated();
+    }
+}
+
+int JoyAxis::getGamepadOutputAxis() { return gamepadOutputAxis; }
+
+/**
+ * @brief Move the axis of the virtual gamepad that is fed by this axis back
+ *     to rest, so it does not stay deflected once the axis is unbound.
+ */
+void JoyAxis::centerGamepadOutput()
+{
+    if (gamepadOutputAxis >= 0)
+        EventHandlerFactory::getInstance()->handler()->sendGamepadAxisEvent(gamepadOutputAxis, 0);
+}
+
+/**
+ * @brief Send the value with dead zone, max zone and throttle applied to
+ *     the virtual gamepad.
+ */
+void JoyAxis::sendGamepadOutputEvent(int value)
+{
+    setCurrentRawValue(value);
+    currentThrottledValue = calculateThrottledValue(value);
+
+    int outputValue = qRound(getDistanceFromDeadZone(currentThrottledValue) * GlobalVariables::JoyAxis::AXISMAX);
+
+    if (currentThrottledValue < 0)
+        outputValue = -outputValue;
+
+    EventHandlerFactory::getInstance()->handler()->sendGamepadAxisEvent(gamepadOutputAxis, outputValue);
+    emit moved(currentRawValue);
+}
+
 void JoyAxis::reset() { resetPrivateVars(); }
 
 void JoyAxis::resetPrivateVars()
@@ -432,6 +493,8 @@ void JoyAxis::resetPrivateVars()
     eventActive = false;
     maxZoneValue = GlobalVariables::JoyAxis::AXISMAXZONE;
     throttle = this->DEFAULTTHROTTLE;
+    centerGamepadOutput();
+    gamepadOutputAxis = -1;
 
     paxisbutton->reset();
     naxisbutton->reset();
@@ -567,6 +630,7 @@ bool JoyAxis::isDefault()
     bool value = true;
     value = value && (deadZone == getDefaultDeadZone());
     value = value && (maxZoneValue == getDefaultMaxZone());
+    value = value && (gamepadOutputAxis == -1);
     value = value && (paxisbutton->isDefault());
     value = value && (naxisbutton->isDefault());
 
@@ -733,6 +797,12 @@ void JoyAxis::setButtonsWheelSpeedY(int value)
     naxisbutton->setWheelSpeed(value, 'Y');
 }
 
+void JoyAxis::setButtonsAnalogWheel(bool enabled)
+{
+    paxisbutton->setAnalogWheel(enabled);
+    naxisbutton->setAnalogWheel(enabled);
+}
+
 void JoyAxis::setDefaultAxisName(QString tempname) { defaultAxisName = tempname; }
 
 QString JoyAxis::getDefaultAxisName() { return defaultAxisName; }
@@ -822,6 +892,7 @@ void JoyAxis::copyAssignments(JoyAxis *destAxis)
     destAxis->reset();
     destAxis->deadZone = deadZone;
     destAxis->maxZoneValue = maxZoneValue;
+    destAxis->gamepadOutputAxis = gamepadOutputAxis;
     destAxis->axisName = axisName;
     paxisbutton->copyAssignments(destAxis->paxisbutton);
     naxisbutton->copyAssignments(destAxis->naxisbutton);
@@ -76,6 +76,8 @@ class JoyAxis : public QObject
 
     int getMaxZoneValue();
     void setThrottle(int value);
+    void setGamepadOutputAxis(int axis);
+    int getGamepadOutputAxis();
     void setInitialThrottle(int value);
     void updateCurrentThrottledValue(int newValue);
     int getThrottle();
@@ -115,6 +117,7 @@ class JoyAxis : public QObject
 
     void setButtonsWheelSpeedX(int value);
     void setButtonsWheelSpeedY(int value);
+    void setButtonsAnalogWheel(bool enabled);
 
     double getButtonsEasingDuration();
 
@@ -165,6 +168,8 @@ class JoyAxis : public QObject
 
     void performCalibration(int value);
     void stickPassEvent(int value, bool ignoresets = false, bool updateLastValues = true); // JoyAxisEvent class
+    void sendGamepadOutputEvent(int value);
+    void centerGamepadOutput();
 
     JoyAxisButton *paxisbutton;
     JoyAxisButton *naxisbutton;
@@ -173,6 +178,7 @@ class JoyAxis : public QObject
     QString defaultAxisName;
 
     int throttle;
+    int gamepadOutputAxis; ///< SDL_GameControllerAxis of the virtual gamepad or -1
     int deadZone;
     int maxZoneValue;
     int currentRawValue;
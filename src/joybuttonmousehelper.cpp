@@ -87,6 +87,7 @@ void JoyButtonMouseHelper::mouseEvent()
     }
 
     moveMouseCursor();
+    JoyButton::moveMouseWheel();
 
     if (JoyButton::hasSpringEvents(JoyButton::getSpringXSpeeds(), JoyButton::getSpringYSpeeds()))
     {
@@ -0,0 +1,206 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "joybuttonprogram.h"
+
+JoyButtonProgram::JoyButtonProgram()
+    : m_flags(0)
+{
+}
+
+/**
+ * @brief Rebuilds the program from the instructions of a slot list.
+ */
+void JoyButtonProgram::compile(const QVector<Instruction> &instructions)
+{
+    clear();
+
+    m_instructions = instructions;
+    m_cycle_delays.fill(false, instructions.size() + 1);
+
+    // Index of the first slot of the current cycle.
+    int cycleStart = 0;
+    bool cycleDone = false;
+
+    for (int index = 0; index < instructions.size(); index++)
+    {
+        JoyButtonSlot::JoySlotInputAction mode = instructions.at(index).mode;
+
+        m_indexes.insert(instructions.at(index).slot, index);
+
+        switch (mode)
+        {
+        case JoyButtonSlot::JoyPause:
+        case JoyButtonSlot::JoyHold:
+            m_flags |= HasSequence;
+            break;
+
+        case JoyButtonSlot::JoyDistance:
+            m_flags |= HasSequence | HasDistance;
+            break;
+
+        case JoyButtonSlot::JoyRelease:
+            m_flags |= HasRelease;
+            break;
+
+        case JoyButtonSlot::JoyMix:
+            m_flags |= HasMix;
+            break;
+
+        case JoyButtonSlot::JoyCycle:
+            m_flags |= HasCycle;
+            break;
+
+        default:
+            break;
+        }
+
+        // A cycle is delayed if a pause or release comes before the next cycle.
+        if (!cycleDone && ((mode == JoyButtonSlot::JoyPause) || (mode == JoyButtonSlot::JoyRelease)))
+        {
+            m_cycle_delays[cycleStart] = true;
+            cycleDone = true;
+        } else if (mode == JoyButtonSlot::JoyCycle)
+        {
+            cycleStart = index + 1;
+            cycleDone = false;
+        }
+    }
+
+    // Walked backwards so every index knows the closest stop following it.
+    m_sequence_ends.resize(m_instructions.size() + 1);
+    m_sequence_ends[m_instructions.size()] = m_instructions.size();
+
+    for (int i = m_instructions.size() - 1; i >= 0; i--)
+    {
+        switch (m_instructions.at(i).mode)
+        {
+        case JoyButtonSlot::JoyRelease:
+        case JoyButtonSlot::JoyCycle:
+        case JoyButtonSlot::JoyHold:
+            m_sequence_ends[i] = i;
+            break;
+
+        default:
+            m_sequence_ends[i] = m_sequence_ends.at(i + 1);
+            break;
+        }
+    }
+}
+
+void JoyButtonProgram::clear()
+{
+    m_instructions.clear();
+    m_indexes.clear();
+    m_cycle_delays.clear();
+    m_sequence_ends.clear();
+    m_flags = 0;
+}
+
+bool JoyButtonProgram::isEmpty() const { return m_instructions.isEmpty(); }
+
+int JoyButtonProgram::size() const { return m_instructions.size(); }
+
+const JoyButtonProgram::Instruction &JoyButtonProgram::at(int index) const { return m_instructions.at(index); }
+
+/**
+ * @brief Gets the position of a slot in the program or -1 if it isn't part of it.
+ */
+int JoyButtonProgram::indexOf(const JoyButtonSlot *slot) const { return m_indexes.value(slot, -1); }
+
+bool JoyButtonProgram::hasFlag(Flag flag) const { return (m_flags & flag) != 0; }
+
+/**
+ * @brief Checks if the part of the list following the given cycle slot,
+ *  or the start of the list for nullptr, contains a pause or release
+ *  slot before the next cycle.
+ */
+bool JoyButtonProgram::delaysCycle(const JoyButtonSlot *cycleStart) const
+{
+    int start = 0;
+
+    if (cycleStart != nullptr)
+    {
+        int index = indexOf(cycleStart);
+
+        if (index == -1)
+            return false;
+
+        start = index + 1;
+    }
+
+    return m_cycle_delays.value(start, false);
+}
+
+JoyButtonProgram::Cursor::Cursor(const JoyButtonProgram &program)
+    : m_program(program)
+    , m_position(0)
+{
+}
+
+bool JoyButtonProgram::Cursor::hasNext() const { return m_position < m_program.size(); }
+
+bool JoyButtonProgram::Cursor::hasPrevious() const { return m_position > 0; }
+
+/**
+ * @brief Returns the next instruction and moves past it. Must only be
+ *  called if hasNext() is true.
+ */
+const JoyButtonProgram::Instruction &JoyButtonProgram::Cursor::next() { return m_program.at(m_position++); }
+
+/**
+ * @brief Returns the previous instruction and moves before it. Must only
+ *  be called if hasPrevious() is true.
+ */
+const JoyButtonProgram::Instruction &JoyButtonProgram::Cursor::previous() { return m_program.at(--m_position); }
+
+void JoyButtonProgram::Cursor::toFront() { m_position = 0; }
+
+void JoyButtonProgram::Cursor::toBack() { m_position = m_program.size(); }
+
+/**
+ * @brief Moves past the given slot if it follows the current position.
+ *  Otherwise the cursor is moved to the back, like QListIterator::findNext.
+ * @return Whether the slot was found
+ */
+bool JoyButtonProgram::Cursor::findNext(const JoyButtonSlot *slot)
+{
+    int index = m_program.indexOf(slot);
+
+    if (index < m_position)
+    {
+        toBack();
+        return false;
+    }
+
+    m_position = index + 1;
+    return true;
+}
+
+/**
+ * @brief Moves in front of the next release, cycle or hold instruction
+ *  which ends the part of a sequence run by a single press. The cursor
+ *  is moved to the back if there is none.
+ * @return Whether such an instruction was found
+ */
+bool JoyButtonProgram::Cursor::findSequenceEnd()
+{
+    m_position = m_program.m_sequence_ends.value(m_position, m_program.size());
+    return m_position < m_program.size();
+}
+
+int JoyButtonProgram::Cursor::position() const { return m_position; }
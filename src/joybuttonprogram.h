@@ -0,0 +1,110 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef JOYBUTTONPROGRAM_H
+#define JOYBUTTONPROGRAM_H
+
+#include "joybuttonslot.h"
+
+#include <QHash>
+#include <QVector>
+
+/**
+ * @brief Compact form of the slot list of a button.
+ *
+ *  The slot list is compiled once after it changed. Everything a press
+ *  needs to know about the list as a whole (does it contain a sequence,
+ *  distance, release or mix slots, does a cycle wait for a pause or
+ *  release) is answered from the compiled form instead of walking the
+ *  slots again. Slot sequences are executed by stepping a Cursor over
+ *  the instructions, the pause, hold and delay timers of JoyButton
+ *  resume the cursor where it stopped. It doesn't depend on timers or
+ *  other Qt state, so it can be tested on its own.
+ *
+ *  The containers are implicitly shared, copies are cheap and stay
+ *  unchanged when the original is compiled again.
+ */
+class JoyButtonProgram
+{
+  public:
+    enum Flag
+    {
+        HasSequence = 0x01, ///< pause, hold or distance slots
+        HasDistance = 0x02,
+        HasRelease = 0x04,
+        HasMix = 0x08,
+        HasCycle = 0x10
+    };
+
+    struct Instruction
+    {
+        JoyButtonSlot::JoySlotInputAction mode;
+        int code;
+        JoyButtonSlot *slot;
+    };
+
+    class Cursor;
+
+    JoyButtonProgram();
+
+    void compile(const QVector<Instruction> &instructions);
+    void clear();
+
+    bool isEmpty() const;
+    int size() const;
+    const Instruction &at(int index) const;
+    int indexOf(const JoyButtonSlot *slot) const;
+
+    bool hasFlag(Flag flag) const;
+    bool delaysCycle(const JoyButtonSlot *cycleStart) const;
+
+  private:
+    QVector<Instruction> m_instructions;
+    QHash<const JoyButtonSlot *, int> m_indexes;
+    QVector<bool> m_cycle_delays; ///< by index of the first slot of a cycle
+    QVector<int> m_sequence_ends; ///< next release, cycle or hold at or after an index
+    int m_flags;
+};
+
+/**
+ * @brief Program counter of a running slot sequence.
+ *
+ *  Works like a QListIterator over the slot list: the position lies
+ *  between two instructions. The cursor keeps its own copy of the
+ *  program, so recompiling the button doesn't move or invalidate it.
+ */
+class JoyButtonProgram::Cursor
+{
+  public:
+    explicit Cursor(const JoyButtonProgram &program);
+
+    bool hasNext() const;
+    bool hasPrevious() const;
+    const Instruction &next();
+    const Instruction &previous();
+    void toFront();
+    void toBack();
+    bool findNext(const JoyButtonSlot *slot);
+    bool findSequenceEnd();
+    int position() const;
+
+  private:
+    JoyButtonProgram m_program;
+    int m_position;
+};
+
+#endif // JOYBUTTONPROGRAM_H
@@ -26,6 +26,8 @@
 #include <QDebug>
 #include <QFileInfo>
 
+#include <SDL2/SDL_gamecontroller.h>
+
 JoyButtonSlot::JoyButtonSlot(QObject *parent)
     : QObject(parent)
     , extraData()
@@ -327,6 +329,12 @@ QString JoyButtonSlot::getSlotString()
 
             break;
         }
+        case JoyGamepadButton: {
+            const char *name = SDL_GameControllerGetStringForButton(static_cast<SDL_GameControllerButton>(deviceCode));
+            newlabel.append(tr("[Pad] %1").arg((name != nullptr) ? QString(name) : QString::number(deviceCode)));
+
+            break;
+        }
         case JoyButtonSlot::JoyMix: {
             bool firstTime = true;
 
@@ -395,7 +403,8 @@ QVariant JoyButtonSlot::getExtraData() const { return extraData; }
 
 /**
  * @brief Deep-copies member variables from another JoyButtonSlot object
- *   into this object.
+ *   into this object. Copied mix slots get the parent of this object,
+ *   the button owning the mix.
  * @param[in] slot Slot from which data gets copied
  */
 void JoyButtonSlot::copyAssignments(const JoyButtonSlot &slot)
@@ -408,8 +417,8 @@ void JoyButtonSlot::copyAssignments(const JoyButtonSlot &slot)
     {
         mix_slots = new QList<JoyButtonSlot *>();
         for (const auto minislot : *slot.mix_slots)
-            mix_slots->append(
-                new JoyButtonSlot(minislot->getSlotCode(), minislot->getSlotCodeAlias(), minislot->getSlotMode()));
+            mix_slots->append(new JoyButtonSlot(minislot->getSlotCode(), minislot->getSlotCodeAlias(),
+                                                minislot->getSlotMode(), parent()));
     }
 
     m_distance = slot.m_distance;
@@ -24,7 +24,6 @@
 #include <QPointer>
 #include <QTime>
 #include <QVariant>
-#include <QtWidgets/QApplication>
 
 class QXmlStreamReader;
 class QXmlStreamWriter;
@@ -56,7 +55,8 @@ class JoyButtonSlot : public QObject
         JoySetChange,
         JoyTextEntry,
         JoyExecute,
-        JoyMix
+        JoyMix,
+        JoyGamepadButton ///< code is a SDL_GameControllerButton of the virtual gamepad
     };
 
     enum JoySlotMouseDirection
@@ -0,0 +1,92 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "joybuttonturboengine.h"
+
+#include "eventhandlerfactory.h"
+#include "joybuttontypes/joybutton.h"
+
+#include <QTimer>
+
+JoyButtonTurboEngine::JoyButtonTurboEngine()
+    : tickTimer(nullptr)
+    , lastTick(0)
+{
+}
+
+void JoyButtonTurboEngine::addButton(JoyButton *button)
+{
+    if (buttons.contains(button))
+        return;
+
+    buttons.append(button);
+
+    if (tickTimer == nullptr)
+    {
+        tickTimer = new QTimer();
+        tickTimer->setTimerType(Qt::PreciseTimer);
+        tickTimer->setInterval(TICK_MSECS);
+        QObject::connect(tickTimer, &QTimer::timeout, tickTimer, [this]() { tick(); });
+    }
+
+    if (!tickTimer->isActive())
+    {
+        clock.start();
+        lastTick = 0;
+        tickTimer->start();
+    }
+}
+
+void JoyButtonTurboEngine::removeButton(JoyButton *button)
+{
+    if (!buttons.removeOne(button) || !buttons.isEmpty() || (tickTimer == nullptr))
+        return;
+
+    tickTimer->stop();
+    tickTimer->deleteLater();
+    tickTimer = nullptr;
+}
+
+bool JoyButtonTurboEngine::contains(JoyButton *button) const { return buttons.contains(button); }
+
+/**
+ * @brief Advances all buttons by the time since the previous tick. Late
+ *  ticks are caught up by the phase step instead of adding up as drift.
+ */
+void JoyButtonTurboEngine::tick()
+{
+    qint64 now = clock.elapsed();
+    qint64 elapsed = now - lastTick;
+    lastTick = now;
+
+    BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+
+    if (handler != nullptr)
+        handler->beginOutputFrame();
+
+    // A toggle can change sets and stop turbo of other buttons.
+    const QList<JoyButton *> current = buttons;
+
+    for (JoyButton *button : current)
+    {
+        if (buttons.contains(button))
+            button->turboTick(elapsed);
+    }
+
+    if (handler != nullptr)
+        handler->endOutputFrame();
+}
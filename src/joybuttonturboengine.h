@@ -0,0 +1,56 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef JOYBUTTONTURBOENGINE_H
+#define JOYBUTTONTURBOENGINE_H
+
+#include <QElapsedTimer>
+#include <QList>
+
+class JoyButton;
+class QTimer;
+
+/**
+ * @brief Single tick source driving the turbo of every active button.
+ *
+ * Buttons describe their turbo as a period and a duty cycle and advance
+ * their phase on each tick of the shared clock, so they cannot drift
+ * apart and only one wakeup is needed for all of them. Toggles of one
+ * tick are sent as a single output frame. The timer is created on the
+ * thread of the first button and dropped when no turbo is left.
+ */
+class JoyButtonTurboEngine
+{
+  public:
+    JoyButtonTurboEngine();
+
+    void addButton(JoyButton *button);
+    void removeButton(JoyButton *button);
+    bool contains(JoyButton *button) const;
+
+    static const int TICK_MSECS = 5;
+
+  private:
+    void tick();
+
+    QList<JoyButton *> buttons;
+    QTimer *tickTimer;
+    QElapsedTimer clock;
+    qint64 lastTick;
+};
+
+#endif // JOYBUTTONTURBOENGINE_H
@@ -22,6 +22,7 @@
 #include "inputdevice.h"
 #include "logger.h"
 #include "setjoystick.h"
+#include "turbophase.h"
 #include "vdpad.h"
 
 #include "SDL2/SDL_events.h"
@@ -51,12 +52,17 @@ QList<JoyButtonSlot *> JoyButton::mouseSpeedModList;
 QList<JoyButton::mouseCursorInfo> JoyButton::cursorXSpeeds;
 QList<JoyButton::mouseCursorInfo> JoyButton::cursorYSpeeds;
 
+// Cursor state of controllers moving their own mouse.
+QHash<InputDevice *, JoyButton::PlayerCursor> JoyButton::playerCursors;
+
 // Lists used for spring mode calculations.
 QList<PadderCommon::springModeInfo> JoyButton::springXSpeeds;
 QList<PadderCommon::springModeInfo> JoyButton::springYSpeeds;
 
 // Temporary test object to test old mouse time behavior.
 QElapsedTimer JoyButton::testOldMouseTime;
+QElapsedTimer JoyButton::wheelTickTime;
+QHash<InputDevice *, JoyButton::WheelRemainder> JoyButton::wheelRemainders;
 
 // time when minislots next to each other in thread pool are waiting to execute function
 // at the same time
@@ -68,8 +74,12 @@ int JoyButton::allSlotTimeBetweenSlots = 0;
 // instances.
 JoyButtonMouseHelper JoyButton::mouseHelper;
 
+// Single tick source for the turbo of all JoyButton instances.
+JoyButtonTurboEngine JoyButton::turboEngine;
+
 QTimer JoyButton::staticMouseEventTimer;
 QList<JoyButton *> JoyButton::pendingMouseButtons;
+QList<JoyButton *> JoyButton::pendingWheelButtons;
 
 // IT CAN BE HERE
 // LOOK FOR JoyCycle and put JoyMix next to the slots types
@@ -81,7 +91,6 @@ JoyButton::JoyButton(int sdl_button_index, int originset, SetJoystick *parentSet
 
     threadPool = QThreadPool::globalInstance();
 
-    turboTimer.setParent(this);
     pauseTimer.setParent(this);
     holdTimer.setParent(this);
     pauseWaitTimer.setParent(this);
@@ -103,7 +112,6 @@ JoyButton::JoyButton(int sdl_button_index, int originset, SetJoystick *parentSet
     connect(&delayTimer, &QTimer::timeout, this, &JoyButton::delayEvent);
     connect(&createDeskTimer, &QTimer::timeout, this, &JoyButton::waitForDeskEvent);
     connect(&releaseDeskTimer, &QTimer::timeout, this, &JoyButton::waitForReleaseDeskEvent);
-    connect(&turboTimer, &QTimer::timeout, this, &JoyButton::turboEvent);
     connect(&mouseWheelVerticalEventTimer, &QTimer::timeout, this, &JoyButton::wheelEventVertical);
     connect(&mouseWheelHorizontalEventTimer, &QTimer::timeout, this, &JoyButton::wheelEventHorizontal);
     connect(&setChangeTimer, &QTimer::timeout, this, &JoyButton::checkForSetChange);
@@ -245,13 +253,13 @@ void JoyButton::joyEvent(bool pressed, bool ignoresets)
 
             if (m_useTurbo)
             {
-                if (isButtonPressed && activePress && !turboTimer.isActive())
+                if (isButtonPressed && activePress && !turboEngine.contains(this))
                 {
                     startSequenceOfPressActive(true, tr("Processing turbo for #%1 - %2"));
                     turboEvent();
-                } else if (!isButtonPressed && !activePress && turboTimer.isActive())
+                } else if (!isButtonPressed && !activePress && turboEngine.contains(this))
                 {
-                    turboTimer.stop();
+                    turboEngine.removeButton(this);
 
                     Q_ASSERT(!m_parentSet.isNull());
                     qDebug() << tr("Finishing turbo for button #%1 - %2")
@@ -337,8 +345,10 @@ void JoyButton::startSequenceOfPressActive(bool isTurbo, QString debugText)
     keyPressHold.restart();
     cycleResetHold.restart();
     if (isTurbo)
-        turboTimer.start();
-    else
+    {
+        turboPhase = 0.0;
+        turboEngine.addButton(this);
+    } else
         releaseDeskTimer.stop();
 
     // Newly activated button. Just entered safe zone.
@@ -434,16 +444,38 @@ void JoyButton::changeTurboParams(bool _isKeyPressed, bool isButtonPressed)
     else
         releaseDeskEvent();
     isKeyPressed = !_isKeyPressed;
+}
 
-    if (turboTimer.isActive())
-    {
-        int tempInterval = turboInterval / 2;
+/**
+ * @brief Advances the turbo phase by the time since the last tick of the
+ *     turbo engine and toggles the key when it enters or leaves the duty
+ *     part of the period. Presses and releases shorter than a tick still
+ *     toggle the key for one tick.
+ * @param elapsed Milliseconds since the previous tick
+ */
+void JoyButton::turboTick(qint64 elapsed)
+{
+    double period = getTurboPeriod();
 
-        if (turboTimer.interval() != tempInterval)
-            turboTimer.start(tempInterval);
-    }
+    if (period <= 0.0)
+        return;
+
+    bool press = TurboPhase::advance(turboPhase, elapsed / period, getTurboDutyCycle(), isKeyPressed);
+
+    if (press != isKeyPressed)
+        turboEvent();
 }
 
+/**
+ * @brief Length of a full press and release cycle of turbo in milliseconds.
+ */
+double JoyButton::getTurboPeriod() { return turboInterval; }
+
+/**
+ * @brief Part of the turbo period the key stays pressed, 0 to 1.
+ */
+double JoyButton::getTurboDutyCycle() { return 0.5; }
+
 bool JoyButton::distanceEvent()
 {
     bool released = false;
@@ -457,7 +489,7 @@ bool JoyButton::distanceEvent()
             double currentDistance = getDistanceFromDeadZone();
             double tempDistance = 0.0;
             JoyButtonSlot *previousDistanceSlot = nullptr;
-            QListIterator<JoyButtonSlot *> iter(*getAssignedSlots());
+            JoyButtonProgram::Cursor iter(getProgram());
 
             if (previousCycle != nullptr)
             {
@@ -468,18 +500,17 @@ bool JoyButton::distanceEvent()
 
             while (iter.hasNext())
             {
-                JoyButtonSlot *slot = iter.next();
-                int tempcode = slot->getSlotCode();
+                const JoyButtonProgram::Instruction &instruction = iter.next();
 
-                if (slot->getSlotMode() == JoyButtonSlot::JoyDistance)
+                if (instruction.mode == JoyButtonSlot::JoyDistance)
                 {
-                    tempDistance += (tempcode / 100.0);
+                    tempDistance += (instruction.code / 100.0);
 
                     if (currentDistance < tempDistance)
                         iter.toBack();
                     else
-                        previousDistanceSlot = slot;
-                } else if (slot->getSlotMode() == JoyButtonSlot::JoyCycle)
+                        previousDistanceSlot = instruction.slot;
+                } else if (instruction.mode == JoyButtonSlot::JoyCycle)
                 {
                     tempDistance = 0.0;
                     iter.toBack();
@@ -555,7 +586,7 @@ void JoyButton::createDeskEvent()
     if (slotiter == nullptr)
     {
         assignmentsLock.lockForRead();
-        slotiter = new QListIterator<JoyButtonSlot *>(*getAssignedSlots());
+        slotiter = new JoyButtonProgram::Cursor(getProgram());
         assignmentsLock.unlock();
 
         distanceEvent();
@@ -596,9 +627,10 @@ void JoyButton::activateSlots()
 
         while (slotiter->hasNext() && !exit)
         {
-            JoyButtonSlot *slot = slotiter->next();
+            const JoyButtonProgram::Instruction instruction = slotiter->next();
+            JoyButtonSlot *slot = instruction.slot;
 
-            if (slot->getSlotMode() == JoyButtonSlot::JoyMix)
+            if (instruction.mode == JoyButtonSlot::JoyMix)
             {
                 qDebug() << "JOYMIX IN ACTIVATESLOTS";
 
@@ -688,7 +720,7 @@ void JoyButton::activateMiniSlots(JoyButtonSlot *slot, JoyButtonSlot *mix)
 }
 
 void JoyButton::addEachSlotToActives(JoyButtonSlot *slot, int &i, bool &delaySequence, bool &exit,
-                                     QListIterator<JoyButtonSlot *> *slotiter)
+                                     JoyButtonProgram::Cursor *slotiter)
 {
     int tempcode = slot->getSlotCode();
     JoyButtonSlot::JoySlotInputAction mode = slot->getSlotMode();
@@ -725,8 +757,13 @@ void JoyButton::addEachSlotToActives(JoyButtonSlot *slot, int &i, bool &delaySeq
 
         qDebug() << i << ": It's a JoyMouseButton with code: " << tempcode << " and name: " << slot->getSlotString();
 
-        if ((tempcode == static_cast<int>(JoyButtonSlot::MouseWheelUp)) ||
-            (tempcode == static_cast<int>(JoyButtonSlot::MouseWheelDown)))
+        if (analogWheel && (tempcode >= static_cast<int>(JoyButtonSlot::MouseWheelUp)) &&
+            (tempcode <= static_cast<int>(JoyButtonSlot::MouseWheelRight)))
+        {
+            getActiveSlotsLocal().append(slot);
+            activateAnalogWheel(slot);
+        } else if ((tempcode == static_cast<int>(JoyButtonSlot::MouseWheelUp)) ||
+                   (tempcode == static_cast<int>(JoyButtonSlot::MouseWheelDown)))
         {
             slot->getMouseInterval()->restart();
             wheelVerticalTime.restart();
@@ -753,6 +790,16 @@ void JoyButton::addEachSlotToActives(JoyButtonSlot *slot, int &i, bool &delaySeq
 
         break;
     }
+    case JoyButtonSlot::JoyGamepadButton: {
+        i++;
+
+        sendevent(slot, true);
+        getActiveSlotsLocal().append(slot);
+        int oldvalue = GlobalVariables::JoyButton::activeGamepadButtons.value(tempcode, 0) + 1;
+        GlobalVariables::JoyButton::activeGamepadButtons.insert(tempcode, oldvalue);
+
+        break;
+    }
     case JoyButtonSlot::JoyMouseMovement: {
         i++;
 
@@ -1556,6 +1603,125 @@ void JoyButton::wheelEventHorizontal()
     }
 }
 
+/**
+ * @brief Register an analog wheel slot. It is scrolled by moveMouseWheel()
+ *     on every tick of the shared mouse timer.
+ */
+void JoyButton::activateAnalogWheel(JoyButtonSlot *slot)
+{
+    analogWheelSlots.append(slot);
+
+    if (!pendingWheelButtons.contains(this))
+    {
+        if (pendingWheelButtons.isEmpty())
+            wheelTickTime.restart();
+
+        pendingWheelButtons.append(this);
+    }
+
+    // Make sure the mouse timer isn't idling.
+    if (!staticMouseEventTimer.isActive() ||
+        (staticMouseEventTimer.interval() == GlobalVariables::JoyButton::IDLEMOUSEREFRESHRATE))
+    {
+        staticMouseEventTimer.start(GlobalVariables::JoyButton::mouseRefreshRate);
+    }
+}
+
+/**
+ * @brief Add the wheel movement of the active analog wheel slots, in
+ *     fractions of BaseEventHandler::WHEEL_UNITS_PER_NOTCH.
+ */
+void JoyButton::collectWheelDistance(double &vertical, double &horizontal, double seconds)
+{
+    double units = qBound(0.0, getMouseDistanceFromDeadZone(), 1.0) * seconds * BaseEventHandler::WHEEL_UNITS_PER_NOTCH;
+
+    for (JoyButtonSlot *slot : analogWheelSlots)
+    {
+        switch (slot->getSlotCode())
+        {
+        case JoyButtonSlot::MouseWheelUp:
+            vertical += units * wheelSpeedY;
+            break;
+
+        case JoyButtonSlot::MouseWheelDown:
+            vertical -= units * wheelSpeedY;
+            break;
+
+        case JoyButtonSlot::MouseWheelLeft:
+            horizontal -= units * wheelSpeedX;
+            break;
+
+        case JoyButtonSlot::MouseWheelRight:
+            horizontal += units * wheelSpeedX;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Combine the wheel movement of all buttons with active analog
+ *     wheel slots and send it to the event handler, per controller if
+ *     every controller has its own mouse. Fractions that are too small to
+ *     be sent are kept for the next tick.
+ */
+void JoyButton::moveMouseWheel()
+{
+    if (pendingWheelButtons.isEmpty())
+    {
+        wheelRemainders.clear();
+        wheelTickTime.invalidate();
+        return;
+    }
+
+    if (!wheelTickTime.isValid())
+    {
+        wheelTickTime.start();
+        return;
+    }
+
+    // Don't turn a stalled timer into a sudden jump.
+    qint64 elapsed =
+        qMin(wheelTickTime.restart(), static_cast<qint64>(GlobalVariables::JoyButton::IDLEMOUSEREFRESHRATE));
+
+    BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+    bool perPlayer = (handler != nullptr) && handler->hasPlayerDevices();
+
+    // Only controllers that scroll this tick keep their remainder, so no
+    // removed controller lingers in the table.
+    QHash<InputDevice *, WheelRemainder> remainders;
+
+    for (JoyButton *button : pendingWheelButtons)
+    {
+        SetJoystick *set = button->getParentSet();
+        InputDevice *device = (perPlayer && (set != nullptr)) ? set->getInputDevice() : nullptr;
+
+        if (!remainders.contains(device))
+            remainders.insert(device, wheelRemainders.value(device));
+
+        WheelRemainder &wheel = remainders[device];
+        button->collectWheelDistance(wheel.vertical, wheel.horizontal, elapsed / 1000.0);
+    }
+
+    for (auto iter = remainders.begin(); iter != remainders.end(); ++iter)
+    {
+        WheelRemainder &wheel = iter.value();
+        int finalVertical = static_cast<int>(wheel.vertical);
+        int finalHorizontal = static_cast<int>(wheel.horizontal);
+        wheel.vertical -= finalVertical;
+        wheel.horizontal -= finalHorizontal;
+
+        if ((handler == nullptr) || ((finalVertical == 0) && (finalHorizontal == 0)))
+            continue;
+
+        if (iter.key() != nullptr)
+            handler->sendPlayerMouseWheelEvent(iter.key(), finalVertical, finalHorizontal);
+        else
+            handler->sendMouseWheelEvent(finalVertical, finalHorizontal);
+    }
+
+    wheelRemainders.swap(remainders);
+}
+
 void JoyButton::setUseTurbo(bool useTurbo)
 {
     bool initialState = m_useTurbo;
@@ -1803,7 +1969,8 @@ void JoyButton::buildActiveZoneSummarySwitchSlots(JoyButtonSlot::JoySlotInputAct
     {
     case JoyButtonSlot::JoyKeyboard:
     case JoyButtonSlot::JoyMouseButton:
-    case JoyButtonSlot::JoyMouseMovement: {
+    case JoyButtonSlot::JoyMouseMovement:
+    case JoyButtonSlot::JoyGamepadButton: {
         QString temp = slot->getSlotString();
 
         if (behindHold)
@@ -1962,7 +2129,8 @@ QList<JoyButtonSlot *> JoyButton::getActiveZoneList()
             case JoyButtonSlot::JoySetChange:
             case JoyButtonSlot::JoyTextEntry:
             case JoyButtonSlot::JoyExecute:
-            case JoyButtonSlot::JoyMix: {
+            case JoyButtonSlot::JoyMix:
+            case JoyButtonSlot::JoyGamepadButton: {
                 tempSlotList.append(slot);
                 break;
             }
@@ -2050,6 +2218,7 @@ bool JoyButton::setAssignedSlot(int code, JoyButtonSlot::JoySlotInputAction mode
     {
         assignmentsLock.lockForWrite();
         getAssignmentsLocal().append(slot);
+        compileProgram();
         assignmentsLock.unlock();
 
         buildActiveZoneSummaryString();
@@ -2058,6 +2227,7 @@ bool JoyButton::setAssignedSlot(int code, JoyButtonSlot::JoySlotInputAction mode
     {
         assignmentsLock.lockForWrite();
         getAssignmentsLocal().append(slot);
+        compileProgram();
         assignmentsLock.unlock();
 
         buildActiveZoneSummaryString();
@@ -2095,6 +2265,7 @@ bool JoyButton::setAssignedSlot(int code, int alias, JoyButtonSlot::JoySlotInput
     {
         assignmentsLock.lockForWrite();
         getAssignmentsLocal().append(slot);
+        compileProgram();
         assignmentsLock.unlock();
 
         buildActiveZoneSummaryString();
@@ -2103,6 +2274,7 @@ bool JoyButton::setAssignedSlot(int code, int alias, JoyButtonSlot::JoySlotInput
     {
         assignmentsLock.lockForWrite();
         getAssignmentsLocal().append(slot);
+        compileProgram();
         assignmentsLock.unlock();
 
         buildActiveZoneSummaryString();
@@ -2166,6 +2338,7 @@ bool JoyButton::setAssignedSlot(int code, int alias, int index, JoyButtonSlot::J
             getAssignmentsLocal().append(slot);
         }
 
+        compileProgram();
         checkTurboCondition(slot);
         assignmentsLock.unlock();
         buildActiveZoneSummaryString();
@@ -2218,6 +2391,7 @@ bool JoyButton::insertAssignedSlot(int code, int alias, int index, JoyButtonSlot
 
         qDebug() << "assignments variable in joybutton has now: " << getAssignedSlots()->count() << " input slots";
 
+        compileProgram();
         checkTurboCondition(slot);
         assignmentsLock.unlock();
         buildActiveZoneSummaryString();
@@ -2255,6 +2429,7 @@ bool JoyButton::insertAssignedSlot(JoyButtonSlot *newSlot, bool updateActiveStri
         assignmentsLock.lockForWrite();
         checkTurboCondition(newSlot);
         getAssignmentsLocal().append(newSlot);
+        compileProgram();
         assignmentsLock.unlock();
 
         if (updateActiveString)
@@ -2296,6 +2471,7 @@ bool JoyButton::insertAssignedSlot(JoyButtonSlot *newSlot, int index, bool updat
 
         qDebug() << "assignments variable in joybutton has now: " << getAssignedSlots()->count() << " input slots";
 
+        compileProgram();
         checkTurboCondition(slot);
         assignmentsLock.unlock();
         buildActiveZoneSummaryString();
@@ -2375,6 +2551,7 @@ bool JoyButton::setAssignedSlot(JoyButtonSlot *otherSlot, int index)
             getAssignmentsLocal().append(newslot);
         }
 
+        compileProgram();
         assignmentsLock.unlock();
         buildActiveZoneSummaryString();
         emit slotsChanged();
@@ -2415,7 +2592,7 @@ int JoyButton::getMouseSpeedY() { return mouseSpeedY; }
 
 void JoyButton::setChangeSetSelection(int index, bool updateActiveString)
 {
-    if ((index >= -1) && (index <= 7))
+    if ((index >= -1) && (index < GlobalVariables::InputDevice::NUMBER_JOYSETS))
     {
         setSelection = index;
 
@@ -2655,23 +2832,8 @@ void JoyButton::waitForReleaseDeskEvent()
 
 bool JoyButton::containsSequence()
 {
-    bool result = false;
-
     assignmentsLock.lockForRead();
-    QListIterator<JoyButtonSlot *> tempiter(*getAssignedSlots());
-
-    while (tempiter.hasNext())
-    {
-        JoyButtonSlot *slot = tempiter.next();
-        JoyButtonSlot::JoySlotInputAction mode = slot->getSlotMode();
-
-        if ((mode == JoyButtonSlot::JoyPause) || (mode == JoyButtonSlot::JoyHold) || (mode == JoyButtonSlot::JoyDistance))
-        {
-            result = true;
-            tempiter.toBack();
-        }
-    }
-
+    bool result = getProgram().hasFlag(JoyButtonProgram::HasSequence);
     assignmentsLock.unlock();
 
     return result;
@@ -2853,9 +3015,10 @@ void JoyButton::releaseDeskEvent(bool skipsetchange)
 
             while (slotiter->hasNext() && !exit)
             {
-                tempslot = slotiter->next();
+                const JoyButtonProgram::Instruction instruction = slotiter->next();
+                tempslot = instruction.slot;
 
-                if (tempslot->getSlotMode() == JoyButtonSlot::JoyCycle)
+                if (instruction.mode == JoyButtonSlot::JoyCycle)
                 {
                     currentCycle = tempslot;
                     exit = true;
@@ -2975,24 +3138,7 @@ double JoyButton::getTotalSlotDistance(JoyButtonSlot *slot)
     return tempDistance;
 }
 
-bool JoyButton::containsDistanceSlots()
-{
-    bool result = false;
-    QListIterator<JoyButtonSlot *> iter(*getAssignedSlots());
-
-    while (iter.hasNext())
-    {
-        JoyButtonSlot *slot = iter.next();
-
-        if (slot->getSlotMode() == JoyButtonSlot::JoyDistance)
-        {
-            result = true;
-            iter.toBack();
-        }
-    }
-
-    return result;
-}
+bool JoyButton::containsDistanceSlots() { return getProgram().hasFlag(JoyButtonProgram::HasDistance); }
 
 void JoyButton::clearAssignedSlots(bool signalEmit)
 {
@@ -3018,6 +3164,8 @@ void JoyButton::clearAssignedSlots(bool signalEmit)
     }
 
     getAssignmentsLocal().clear();
+    compileProgram();
+
     if (signalEmit)
         emit slotsChanged();
 }
@@ -3039,7 +3187,7 @@ void JoyButton::removeAssignedSlot(int index)
 
     if ((index >= 0) && (index < getAssignedSlots()->size()))
     {
-        JoyButtonSlot *slot = getAssignedSlots()->takeAt(index);
+        JoyButtonSlot *slot = getAssignmentsLocal().takeAt(index);
 
         if (slot->getSlotMode() == JoyButtonSlot::JoyMix)
         {
@@ -3060,6 +3208,7 @@ void JoyButton::removeAssignedSlot(int index)
             slot = nullptr;
         }
 
+        compileProgram();
         tempAssignLocker.unlock();
         buildActiveZoneSummaryString();
         emit slotsChanged();
@@ -3146,6 +3295,8 @@ void JoyButton::releaseActiveSlots()
             mouseEventQueue.clear();
 
         pendingMouseButtons.removeAll(this);
+        analogWheelSlots.clear();
+        pendingWheelButtons.removeAll(this);
         currentWheelVerticalEvent = nullptr;
         currentWheelHorizontalEvent = nullptr;
         mouseWheelVerticalEventTimer.stop();
@@ -3203,8 +3354,15 @@ void JoyButton::releaseEachSlot(bool &changeRepeatState, int &references, int te
             mouseWheelHorizontalEventQueue.removeAll(slot);
         }
 
+        if (analogWheelSlots.removeAll(slot) && analogWheelSlots.isEmpty())
+            pendingWheelButtons.removeAll(this);
+
         slot->setDistance(0.0);
         slot->getMouseInterval()->restart();
+    } else if (mode == JoyButtonSlot::JoyGamepadButton)
+    {
+        countActiveSlots(tempcode, references, slot, GlobalVariables::JoyButton::activeGamepadButtons,
+                         changeRepeatState);
     } else if (mode == JoyButtonSlot::JoyMouseMovement)
     {
         JoyMouseMovementMode mousemode = getMouseMode();
@@ -3328,39 +3486,9 @@ void JoyButton::releaseMoveSlots(QList<JoyButton::mouseCursorInfo> &cursorSpeeds
     indexesToRemove.clear();
 }
 
-bool JoyButton::containsReleaseSlots()
-{
-    bool result = false;
-    QListIterator<JoyButtonSlot *> iter(*getAssignedSlots());
-
-    while (iter.hasNext())
-    {
-        if (iter.next()->getSlotMode() == JoyButtonSlot::JoyRelease)
-        {
-            result = true;
-            iter.toBack();
-        }
-    }
-
-    return result;
-}
-
-bool JoyButton::containsJoyMixSlot()
-{
-    bool result = false;
-    QListIterator<JoyButtonSlot *> iter(*getAssignedSlots());
-
-    while (iter.hasNext())
-    {
-        if (iter.next()->getSlotMode() == JoyButtonSlot::JoyMix)
-        {
-            result = true;
-            iter.toBack();
-        }
-    }
+bool JoyButton::containsReleaseSlots() { return getProgram().hasFlag(JoyButtonProgram::HasRelease); }
 
-    return result;
-}
+bool JoyButton::containsJoyMixSlot() { return getProgram().hasFlag(JoyButtonProgram::HasMix); }
 
 void JoyButton::releaseSlotEvent()
 {
@@ -3421,34 +3549,10 @@ void JoyButton::releaseSlotEvent()
     }
 }
 
-void JoyButton::findJoySlotsEnd(QListIterator<JoyButtonSlot *> *slotiter)
+void JoyButton::findJoySlotsEnd(JoyButtonProgram::Cursor *slotiter)
 {
     if (slotiter != nullptr)
-    {
-        bool found = false;
-        while (!found && slotiter->hasNext())
-        {
-            qDebug() << "slotiter has next element";
-
-            JoyButtonSlot::JoySlotInputAction mode = slotiter->next()->getSlotMode();
-
-            switch (mode)
-            {
-            case JoyButtonSlot::JoyRelease:
-            case JoyButtonSlot::JoyCycle:
-            case JoyButtonSlot::JoyHold:
-
-                found = true;
-                break;
-
-            default:
-                break;
-            }
-        }
-
-        if (found && slotiter->hasPrevious())
-            slotiter->previous();
-    }
+        slotiter->findSequenceEnd();
 }
 
 void JoyButton::setVDPad(VDPad *vdpad)
@@ -3496,6 +3600,7 @@ bool JoyButton::isDefault()
     value = value && (cycleResetActive == GlobalVariables::JoyButton::DEFAULTCYCLERESETACTIVE);
     value = value && (cycleResetInterval == GlobalVariables::JoyButton::DEFAULTCYCLERESET);
     value = value && (relativeSpring == GlobalVariables::JoyButton::DEFAULTRELATIVESPRING);
+    value = value && (analogWheel == GlobalVariables::JoyButton::DEFAULTANALOGWHEEL);
     value = value && qFuzzyCompare(m_easingDuration, GlobalVariables::JoyButton::DEFAULTEASINGDURATION);
     value = value && !extraAccelerationEnabled;
     value = value && qFuzzyCompare(extraAccelerationMultiplier, GlobalVariables::JoyButton::DEFAULTEXTRACCELVALUE);
@@ -3642,59 +3747,21 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed, QLi
     if (mouseHistoryY->size() >= mouseHistorySize)
         mouseHistoryY->removeLast();
 
-    /*
-     * Combine all mouse events to find the distance to move the mouse
-     * along the X and Y axis. If necessary, perform mouse smoothing.
-     * The mouse smoothing technique used is an interpretation of the method
-     * outlined at http://flipcode.net/archives/Smooth_Mouse_Filtering.shtml.
-     */
-    if ((cursorXSpeeds->length() == cursorYSpeeds->length()) && (cursorXSpeeds->length() > 0))
+    // Combine all mouse events to one cursor movement, or to one per
+    // controller if every controller moves its own mouse.
+    if ((cursorXSpeeds->length() == cursorYSpeeds->length()) && (cursorXSpeeds->length() > 0) &&
+        EventHandlerFactory::getInstance()->handler()->hasPlayerDevices())
+    {
+        movePlayerCursors(cursorXSpeeds, cursorYSpeeds, mouseHistorySize, weightModifier, movedX, movedY);
+        mouseHistoryX->prepend(0);
+        mouseHistoryY->prepend(0);
+    } else if ((cursorXSpeeds->length() == cursorYSpeeds->length()) && (cursorXSpeeds->length() > 0))
     {
-        int queueLength = cursorXSpeeds->length();
-        double finalx = 0.0;
-        double finaly = 0.0;
-
-        for (int i = 0; i < queueLength; i++)
-        {
-            mouseCursorInfo infoX = cursorXSpeeds->takeFirst();
-            mouseCursorInfo infoY = cursorYSpeeds->takeFirst();
-
-            distanceForMovingAx(finalx, infoX);
-            distanceForMovingAx(finaly, infoY);
-
-            infoX.slot->getMouseInterval()->restart();
-            infoY.slot->getMouseInterval()->restart();
-        }
-
-        // Only apply remainder if both current displacement and remainder
-        // follow the same direction.
-        if ((cursorRemainderX >= 0) == (finalx >= 0))
-            finalx += cursorRemainderX;
-
-        // Cap maximum relative mouse movement.
-        if (abs(finalx) > 127)
-            finalx = (finalx < 0) ? -127 : 127;
-
-        mouseHistoryX->prepend(finalx);
-
-        // Only apply remainder if both current displacement and remainder
-        // follow the same direction.
-        if ((cursorRemainderY >= 0) == (finaly >= 0))
-            finaly += cursorRemainderY;
-
-        // Cap maximum relative mouse movement.
-        if (abs(finaly) > 127)
-            finaly = (finaly < 0) ? -127 : 127;
-
-        mouseHistoryY->prepend(finaly);
-
-        cursorRemainderX = 0;
-        cursorRemainderY = 0;
         double adjustedX = 0;
         double adjustedY = 0;
 
-        adjustAxForCursor(mouseHistoryX, adjustedX, cursorRemainderX, weightModifier);
-        adjustAxForCursor(mouseHistoryY, adjustedY, cursorRemainderY, weightModifier);
+        combineCursorSpeeds(*cursorXSpeeds, *cursorYSpeeds, mouseHistoryX, mouseHistoryY, cursorRemainderX,
+                            cursorRemainderY, weightModifier, adjustedX, adjustedY);
 
         // This check is more of a precaution than anything. No need to cause
         // a sync to happen when not needed.
@@ -3710,7 +3777,7 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed, QLi
     }
 
     // Check if mouse event timer should use idle time.
-    if (pendingMouseButtons->length() == 0)
+    if ((pendingMouseButtons->length() == 0) && pendingWheelButtons.isEmpty())
     {
         if (staticMouseEventTimer->interval() != idleMouseRefrRate)
         {
@@ -3730,6 +3797,7 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed, QLi
 
         cursorRemainderX = 0;
         cursorRemainderY = 0;
+        playerCursors.clear();
     } else
     {
         if (staticMouseEventTimer->interval() != mouseRefreshRate)
@@ -3740,6 +3808,138 @@ void JoyButton::moveMouseCursor(int &movedX, int &movedY, int &movedElapsed, QLi
     cursorYSpeeds->clear();
 }
 
+/**
+ * @brief Combine the queued cursor speeds to the distance to move the mouse
+ *     along the X and Y axis. If necessary, perform mouse smoothing.
+ *     The mouse smoothing technique used is an interpretation of the method
+ *     outlined at http://flipcode.net/archives/Smooth_Mouse_Filtering.shtml.
+ */
+void JoyButton::combineCursorSpeeds(QList<mouseCursorInfo> &cursorXSpeeds, QList<mouseCursorInfo> &cursorYSpeeds,
+                                    QList<double> *mouseHistoryX, QList<double> *mouseHistoryY, double &cursorRemainderX,
+                                    double &cursorRemainderY, double weightModifier, double &adjustedX, double &adjustedY)
+{
+    int queueLength = cursorXSpeeds.length();
+    double finalx = 0.0;
+    double finaly = 0.0;
+
+    for (int i = 0; i < queueLength; i++)
+    {
+        mouseCursorInfo infoX = cursorXSpeeds.takeFirst();
+        mouseCursorInfo infoY = cursorYSpeeds.takeFirst();
+
+        distanceForMovingAx(finalx, infoX);
+        distanceForMovingAx(finaly, infoY);
+
+        infoX.slot->getMouseInterval()->restart();
+        infoY.slot->getMouseInterval()->restart();
+    }
+
+    // Only apply remainder if both current displacement and remainder
+    // follow the same direction.
+    if ((cursorRemainderX >= 0) == (finalx >= 0))
+        finalx += cursorRemainderX;
+
+    // Cap maximum relative mouse movement.
+    if (abs(finalx) > 127)
+        finalx = (finalx < 0) ? -127 : 127;
+
+    mouseHistoryX->prepend(finalx);
+
+    // Only apply remainder if both current displacement and remainder
+    // follow the same direction.
+    if ((cursorRemainderY >= 0) == (finaly >= 0))
+        finaly += cursorRemainderY;
+
+    // Cap maximum relative mouse movement.
+    if (abs(finaly) > 127)
+        finaly = (finaly < 0) ? -127 : 127;
+
+    mouseHistoryY->prepend(finaly);
+
+    cursorRemainderX = 0;
+    cursorRemainderY = 0;
+    adjustedX = 0;
+    adjustedY = 0;
+
+    adjustAxForCursor(mouseHistoryX, adjustedX, cursorRemainderX, weightModifier);
+    adjustAxForCursor(mouseHistoryY, adjustedY, cursorRemainderY, weightModifier);
+}
+
+/**
+ * @brief Move the mouse of every controller by the cursor speeds of its own
+ *     buttons. Every controller keeps its own smoothing history, so players
+ *     do not drag each other's cursor.
+ */
+void JoyButton::movePlayerCursors(QList<mouseCursorInfo> *cursorXSpeeds, QList<mouseCursorInfo> *cursorYSpeeds,
+                                  int mouseHistorySize, double weightModifier, int &movedX, int &movedY)
+{
+    QHash<InputDevice *, QList<mouseCursorInfo>> playerXSpeeds;
+    QHash<InputDevice *, QList<mouseCursorInfo>> playerYSpeeds;
+
+    for (int i = 0; i < cursorXSpeeds->length(); i++)
+    {
+        InputDevice *device = slotInputDevice(cursorXSpeeds->at(i).slot);
+        playerXSpeeds[device].append(cursorXSpeeds->at(i));
+        playerYSpeeds[device].append(cursorYSpeeds->at(i));
+
+        if (!playerCursors.contains(device))
+        {
+            PlayerCursor cursor;
+
+            for (int j = 0; j < mouseHistorySize; j++)
+            {
+                cursor.historyX.append(0);
+                cursor.historyY.append(0);
+            }
+
+            playerCursors.insert(device, cursor);
+        }
+    }
+
+    for (auto iter = playerCursors.begin(); iter != playerCursors.end(); ++iter)
+    {
+        PlayerCursor &cursor = iter.value();
+
+        while (cursor.historyX.size() >= mouseHistorySize)
+            cursor.historyX.removeLast();
+
+        while (cursor.historyY.size() >= mouseHistorySize)
+            cursor.historyY.removeLast();
+
+        if (!playerXSpeeds.contains(iter.key()))
+        {
+            cursor.historyX.prepend(0);
+            cursor.historyY.prepend(0);
+            continue;
+        }
+
+        double adjustedX = 0;
+        double adjustedY = 0;
+
+        combineCursorSpeeds(playerXSpeeds[iter.key()], playerYSpeeds[iter.key()], &cursor.historyX, &cursor.historyY,
+                            cursor.remainderX, cursor.remainderY, weightModifier, adjustedX, adjustedY);
+
+        if (!qFuzzyIsNull(adjustedX) || !qFuzzyIsNull(adjustedY))
+            sendevent(iter.key(), adjustedX, adjustedY);
+
+        movedX += adjustedX;
+        movedY += adjustedY;
+    }
+}
+
+/**
+ * @brief Controller owning the button of a slot. Slots of a mix are owned
+ *     by the button of the mix.
+ * @return Controller or nullptr if the slot does not belong to a button
+ */
+InputDevice *JoyButton::slotInputDevice(JoyButtonSlot *slot)
+{
+    JoyButton *button = (slot != nullptr) ? qobject_cast<JoyButton *>(slot->parent()) : nullptr;
+    SetJoystick *set = (button != nullptr) ? button->getParentSet() : nullptr;
+
+    return (set != nullptr) ? set->getInputDevice() : nullptr;
+}
+
 /**
  * @brief Combines mouse movement distances from multiple mouse mappings.
  * @param[in,out] finalAx Combined mouse distance from previous iteration. Updated by this function.
@@ -3902,7 +4102,7 @@ void JoyButton::moveSpringMouse(int &movedX, int &movedY, bool &hasMoved, int sp
     }
 
     // Check if mouse event timer should use idle time.
-    if (pendingMouseButtons->length() == 0)
+    if ((pendingMouseButtons->length() == 0) && pendingWheelButtons.isEmpty())
     {
         staticMouseEventTimer->start(idleMouseRefrRate);
     } else
@@ -3946,32 +4146,7 @@ void JoyButton::keyPressEvent()
  * @brief TODO: CHECK IF METHOD WOULD BE USEFUL. CURRENTLY NOT USED.
  * @return Result
  */
-bool JoyButton::checkForDelaySequence()
-{
-    bool result = false;
-    QListIterator<JoyButtonSlot *> tempiter(*getAssignedSlots());
-
-    // Move iterator to start of cycle.
-    if (previousCycle != nullptr)
-        tempiter.findNext(previousCycle);
-
-    while (tempiter.hasNext())
-    {
-        JoyButtonSlot *slot = tempiter.next();
-
-        if ((slot->getSlotMode() == JoyButtonSlot::JoyPause) || (slot->getSlotMode() == JoyButtonSlot::JoyRelease))
-        {
-            result = true;
-            tempiter.toBack();
-        } else if (slot->getSlotMode() == JoyButtonSlot::JoyCycle)
-        {
-            result = false;
-            tempiter.toBack();
-        }
-    }
-
-    return result;
-}
+bool JoyButton::checkForDelaySequence() { return getProgram().delaysCycle(previousCycle); }
 
 SetJoystick *JoyButton::getParentSet() { return m_parentSet; }
 
@@ -4075,6 +4250,23 @@ void JoyButton::setSpringRelativeStatus(bool value)
 
 bool JoyButton::isRelativeSpring() { return relativeSpring; }
 
+/**
+ * @brief Scroll proportionally to the distance of the button instead of
+ *     sending single wheel notches. Wheel slots are then driven by the
+ *     shared mouse timer and their speed is the number of notches per
+ *     second at full distance.
+ */
+void JoyButton::setAnalogWheel(bool enabled)
+{
+    if (enabled != analogWheel)
+    {
+        analogWheel = enabled;
+        emit propertyUpdated();
+    }
+}
+
+bool JoyButton::isAnalogWheel() { return analogWheel; }
+
 /**
  * @brief Copy assignments and properties from one button to another.
  *     Used for set copying.
@@ -4085,6 +4277,7 @@ void JoyButton::copyAssignments(JoyButton *destButton)
     destButton->eventReset();
     destButton->assignmentsLock.lockForWrite();
     destButton->getAssignmentsLocal().clear();
+    destButton->compileProgram();
     destButton->assignmentsLock.unlock();
 
     assignmentsLock.lockForWrite();
@@ -4116,6 +4309,7 @@ void JoyButton::copyAssignments(JoyButton *destButton)
     destButton->cycleResetActive = cycleResetActive;
     destButton->cycleResetInterval = cycleResetInterval;
     destButton->relativeSpring = relativeSpring;
+    destButton->analogWheel = analogWheel;
     destButton->currentTurboMode = currentTurboMode;
     destButton->m_easingDuration = m_easingDuration;
     destButton->extraAccelerationEnabled = extraAccelerationEnabled;
@@ -4198,6 +4392,12 @@ JoyButtonMouseHelper *JoyButton::getMouseHelper() { return &mouseHelper; }
  */
 QList<JoyButton *> *JoyButton::getPendingMouseButtons() { return &pendingMouseButtons; }
 
+/**
+ * @brief Get the list of buttons that have an active analog wheel slot.
+ * @return QList<JoyButton*>*
+ */
+QList<JoyButton *> *JoyButton::getPendingWheelButtons() { return &pendingWheelButtons; }
+
 QList<JoyButton::mouseCursorInfo> *JoyButton::getCursorXSpeeds() { return &cursorXSpeeds; }
 
 QList<JoyButton::mouseCursorInfo> *JoyButton::getCursorYSpeeds() { return &cursorYSpeeds; }
@@ -4364,14 +4564,15 @@ void JoyButton::resetAllProperties()
     cycleResetActive = GlobalVariables::JoyButton::DEFAULTCYCLERESETACTIVE;
     cycleResetInterval = GlobalVariables::JoyButton::DEFAULTCYCLERESET;
     relativeSpring = GlobalVariables::JoyButton::DEFAULTRELATIVESPRING;
+    analogWheel = GlobalVariables::JoyButton::DEFAULTANALOGWHEEL;
     lastDistance = 0.0;
+    turboPhase = 0.0;
     lastMouseDistance = 0.0;
     currentMouseDistance = 0.0;
     updateMouseParams(false, false, 0.0);
     restartAccelParams(false, false, true);
     lastWheelVerticalDistance = 0.0;
     lastWheelHorizontalDistance = 0.0;
-    tempTurboInterval = 0;
     currentTurboMode = DEFAULTTURBOMODE;
     m_easingDuration = GlobalVariables::JoyButton::DEFAULTEASINGDURATION;
     springDeadCircleMultiplier = GlobalVariables::JoyButton::DEFAULTSPRINGRELEASERADIUS;
@@ -4597,4 +4798,30 @@ void JoyButton::setUpdateInitAccel(bool state) { this->updateInitAccelValues = s
 
 QList<JoyButtonSlot *> &JoyButton::getAssignmentsLocal() { return assignments; }
 
+/**
+ * @brief Rebuilds the compiled program after the assignments changed.
+ *     Must be called while assignmentsLock is locked for writing, so
+ *     readers holding the read lock never see a half built program.
+ */
+void JoyButton::compileProgram()
+{
+    QVector<JoyButtonProgram::Instruction> instructions;
+    instructions.reserve(assignments.size());
+
+    for (JoyButtonSlot *slot : assignments)
+    {
+        if (slot != nullptr)
+            instructions.append({slot->getSlotMode(), slot->getSlotCode(), slot});
+    }
+
+    program.compile(instructions);
+}
+
+/**
+ * @brief Gets the compiled assignments. Callers on other threads than
+ *     the one changing the assignments have to hold assignmentsLock
+ *     for reading.
+ */
+const JoyButtonProgram &JoyButton::getProgram() const { return program; }
+
 QList<JoyButtonSlot *> &JoyButton::getActiveSlotsLocal() { return activeSlots; }
@@ -21,7 +21,9 @@
 
 #include "globalvariables.h"
 #include "joybuttonmousehelper.h"
+#include "joybuttonprogram.h"
 #include "joybuttonslot.h"
+#include "joybuttonturboengine.h"
 #include "springmousemoveinfo.h"
 
 #include <QDeadlineTimer>
@@ -33,6 +35,7 @@
 
 class VDPad;
 class SetJoystick;
+class InputDevice;
 class QXmlStreamReader;
 class QXmlStreamWriter;
 // class QThread;
@@ -134,6 +137,7 @@ class JoyButton : public QObject
     bool hasActiveSlots(); // JoyButtonSlots class
     bool isCycleResetActive();
     bool isRelativeSpring();
+    bool isAnalogWheel();
     bool isPartVDPad();
     bool isExtraAccelerationEnabled();
 
@@ -211,7 +215,10 @@ class JoyButton : public QObject
 
     TurboMode getTurboMode();
 
+    void turboTick(qint64 elapsed);
+
     static int calculateFinalMouseSpeed(JoyMouseCurve curve, int value, const float joyspeed);
+    static InputDevice *slotInputDevice(JoyButtonSlot *slot);
 
     static bool hasCursorEvents(QList<JoyButton::mouseCursorInfo> *cursorXSpeedsList,
                                 QList<JoyButton::mouseCursorInfo> *cursorYSpeedsList); // JoyButtonEvents class
@@ -238,6 +245,7 @@ class JoyButton : public QObject
                                     QList<double> *mouseHistoryY, QElapsedTimer *testOldMouseTime,
                                     QTimer *staticMouseEventTimer);
     static void setSpringModeScreen(int screen, int &springModeScreen);
+    static void moveMouseWheel();
     static void resetActiveButtonMouseDistances(JoyButtonMouseHelper *mouseHelper);
     static void setGamepadRefreshRate(int refresh, int &gamepadRefreshRate, JoyButtonMouseHelper *mouseHelper);
     static void restartLastMouseTime(QElapsedTimer *testOldMouseTime);
@@ -248,6 +256,7 @@ class JoyButton : public QObject
 
     static JoyButtonMouseHelper *getMouseHelper();
     static QList<JoyButton *> *getPendingMouseButtons();
+    static QList<JoyButton *> *getPendingWheelButtons();
     static QList<JoyButton::mouseCursorInfo> *getCursorXSpeeds();
     static QList<JoyButton::mouseCursorInfo> *getCursorYSpeeds();
     static QList<PadderCommon::springModeInfo> *getSpringXSpeeds();
@@ -268,6 +277,28 @@ class JoyButton : public QObject
     bool containsJoyMixSlot();
 
   protected:
+    /**
+     * @brief Smoothing history and remainders of the cursor of a controller
+     *     which moves its own mouse.
+     */
+    struct PlayerCursor
+    {
+        QList<double> historyX;
+        QList<double> historyY;
+        double remainderX = 0.0;
+        double remainderY = 0.0;
+    };
+
+    /**
+     * @brief Analog wheel movement of a controller too small to be sent yet,
+     *     in fractions of BaseEventHandler::WHEEL_UNITS_PER_NOTCH.
+     */
+    struct WheelRemainder
+    {
+        double vertical = 0.0;
+        double horizontal = 0.0;
+    };
+
     int getPreferredKeyPressTime(); // unsigned
 
     double getTotalSlotDistance(JoyButtonSlot *slot);
@@ -286,6 +317,8 @@ class JoyButton : public QObject
     static int allSlotTimeBetweenSlots;
 
     virtual double getCurrentSpringDeadCircle();
+    virtual double getTurboPeriod();
+    virtual double getTurboDutyCycle();
 
     TurboMode currentTurboMode;
 
@@ -294,34 +327,35 @@ class JoyButton : public QObject
     static QList<JoyButtonSlot *> mouseSpeedModList; // JoyButtonSlots class
     static QList<mouseCursorInfo> cursorXSpeeds;
     static QList<mouseCursorInfo> cursorYSpeeds;
+    static QHash<InputDevice *, PlayerCursor> playerCursors;
     static QList<PadderCommon::springModeInfo> springXSpeeds;
     static QList<PadderCommon::springModeInfo> springYSpeeds;
     static QList<JoyButton *> pendingMouseButtons;
+    static QList<JoyButton *> pendingWheelButtons;
     static JoyButtonSlot *lastActiveKey; // JoyButtonSlots class
     static JoyButtonMouseHelper mouseHelper;
+    static JoyButtonTurboEngine turboEngine;
 
     int m_index_sdl; // Used to denote the SDL index of the actual joypad button
     int turboInterval;
     int wheelSpeedX;
     int wheelSpeedY;
     int setSelection;
-    int tempTurboInterval;
     int springDeadCircleMultiplier;
 
     bool isButtonPressed; // Used to denote whether the actual joypad button is pressed
     bool isKeyPressed;    // Used to denote whether the virtual key is pressed
 
     double lastDistance;
+    double turboPhase; // Position within the current turbo period, 0 to 1
     double lastWheelVerticalDistance;
     double lastWheelHorizontalDistance;
 
-    QTimer turboTimer;
     QTimer mouseWheelVerticalEventTimer;
     QTimer mouseWheelHorizontalEventTimer;
 
     QElapsedTimer wheelVerticalTime;
     QElapsedTimer wheelHorizontalTime;
-    QElapsedTimer turboHold;
 
     QPointer<SetJoystick> m_parentSet;
     SetChangeCondition setSelectionCondition;
@@ -332,6 +366,7 @@ class JoyButton : public QObject
     QQueue<bool> isButtonPressedQueue;
     QQueue<JoyButtonSlot *> mouseWheelVerticalEventQueue;   // JoyButtonEvents class
     QQueue<JoyButtonSlot *> mouseWheelHorizontalEventQueue; // JoyButtonEvents class
+    QList<JoyButtonSlot *> analogWheelSlots;                // JoyButtonEvents class
 
     QString buttonName;        // User specified button name
     QString defaultButtonName; // Name used by the system
@@ -364,6 +399,7 @@ class JoyButton : public QObject
     void setSpringHeight(int value);
     void setSensitivity(double value);
     void setSpringRelativeStatus(bool value);
+    void setAnalogWheel(bool enabled);
     void setActionName(QString tempName);
     void setButtonName(QString tempName);
     void setEasingDuration(double value);
@@ -454,7 +490,7 @@ class JoyButton : public QObject
 
     inline void stopTimers(bool stoppedSlotSetTimer)
     {
-        turboTimer.stop();
+        turboEngine.removeButton(this);
         pauseWaitTimer.stop();
         createDeskTimer.stop();
         releaseDeskTimer.stop();
@@ -526,7 +562,7 @@ class JoyButton : public QObject
     void resetPrivVars();
     void restartAllForSetChange();
     void startTimerOverrun(int slotCode, QElapsedTimer *currSlotTime, QTimer *currSlotTimer, bool releasedDeskTimer = false);
-    void findJoySlotsEnd(QListIterator<JoyButtonSlot *> *slotiter);
+    void findJoySlotsEnd(JoyButtonProgram::Cursor *slotiter);
     void changeStatesQueue(bool currentReleased);
     void countActiveSlots(int tempcode, int &references, JoyButtonSlot *slot, QHash<int, int> &activeSlotsHash,
                           bool &changeRepeatState, bool activeSlotHashWindows = false); // JoyButtonSlots class
@@ -535,6 +571,11 @@ class JoyButton : public QObject
     void setSpringDeadCircle(double &springDeadCircle, int mouseDirection);
     void checkSpringDeadCircle(int tempcode, double &springDeadCircle, int mouseSlot1, int mouseSlot2);
     static void distanceForMovingAx(double &finalAx, mouseCursorInfo infoAx);
+    static void combineCursorSpeeds(QList<mouseCursorInfo> &cursorXSpeeds, QList<mouseCursorInfo> &cursorYSpeeds,
+                                    QList<double> *mouseHistoryX, QList<double> *mouseHistoryY, double &cursorRemainderX,
+                                    double &cursorRemainderY, double weightModifier, double &adjustedX, double &adjustedY);
+    static void movePlayerCursors(QList<mouseCursorInfo> *cursorXSpeeds, QList<mouseCursorInfo> *cursorYSpeeds,
+                                  int mouseHistorySize, double weightModifier, int &movedX, int &movedY);
     static void adjustAxForCursor(QList<double> *mouseHistoryList, double &adjustedAx, double &cursorRemainder,
                                   double weightModifier);
     void setDistanceForSpring(JoyButtonMouseHelper &mouseHelper, double &mouseFirstAx, double &mouseSecondAx,
@@ -543,6 +584,8 @@ class JoyButton : public QObject
     void updateParamsAfterDistEvent(); // JoyButtonEvents class
     void startSequenceOfPressActive(bool isTurbo, QString debugText);
     QList<JoyButtonSlot *> &getAssignmentsLocal();
+    void compileProgram();
+    const JoyButtonProgram &getProgram() const;
     QList<JoyButtonSlot *> &getActiveSlotsLocal(); // JoyButtonSlots class
     void updateMouseProperties(double newAxisValue, double newSpringDead, int newSpringWidth, int newSpringHeight,
                                bool relatived, int modeScreen, QList<PadderCommon::springModeInfo> &springSpeeds, QChar axis,
@@ -566,6 +609,7 @@ class JoyButton : public QObject
     bool updateStartingMouseDistance; // Should startingMouseDistance be updated. Set after acceleration has finally been
                                       // applied.
     bool relativeSpring;
+    bool analogWheel;
     bool pendingPress;
     bool pendingEvent; // JoyButtonEvents class
     bool pendingIgnoreSets;
@@ -616,8 +660,9 @@ class JoyButton : public QObject
     QString activeZoneString;
 
     QList<JoyButtonSlot *> assignments;
+    JoyButtonProgram program; // compiled assignments, rebuilt under the write lock of assignmentsLock
     QList<JoyButtonSlot *> activeSlots;
-    QListIterator<JoyButtonSlot *> *slotiter;
+    JoyButtonProgram::Cursor *slotiter;
     QQueue<JoyButtonSlot *> mouseEventQueue; // JoyButtonEvents class
     JoyButtonSlot *currentPause;
     JoyButtonSlot *currentHold;
@@ -639,6 +684,11 @@ class JoyButton : public QObject
     QElapsedTimer accelExtraDurationTime;
     QElapsedTimer cycleResetHold;
     static QElapsedTimer testOldMouseTime;
+    static QElapsedTimer wheelTickTime;
+    static QHash<InputDevice *, WheelRemainder> wheelRemainders;
+
+    void activateAnalogWheel(JoyButtonSlot *slot);
+    void collectWheelDistance(double &vertical, double &horizontal, double seconds);
 
     VDPad *m_vdpad;
     JoyMouseMovementMode mouseMode;
@@ -651,7 +701,7 @@ class JoyButton : public QObject
     QThreadPool *threadPool;
 
     void addEachSlotToActives(JoyButtonSlot *slot, int &i, bool &delaySequence, bool &exit,
-                              QListIterator<JoyButtonSlot *> *slotiter);
+                              JoyButtonProgram::Cursor *slotiter);
 };
 
 class MiniSlotRun : public QRunnable, public QObject
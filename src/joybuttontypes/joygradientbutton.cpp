@@ -23,198 +23,42 @@
 
 #include <cmath>
 
-#include <QDebug>
-
 JoyGradientButton::JoyGradientButton(int sdl_button_index, int originset, SetJoystick *parentSet, QObject *parent)
     : JoyButton(sdl_button_index, originset, parentSet, parent)
 {
 }
 
 /**
- * @brief Activate a turbo event on a button.
+ * @brief Gradient turbo keeps the period and holds the key longer the
+ *     further the button is pushed. Pulse turbo keeps the press short and
+ *     shortens the pause instead.
  */
-void JoyGradientButton::turboEvent()
+double JoyGradientButton::getTurboPeriod()
 {
-    int m_turboInterval = containsJoyMixSlot() && allSlotTimeBetweenSlots > 0 ? allSlotTimeBetweenSlots : turboInterval;
-
     if (getTurboMode() == NormalTurbo)
-    {
-        JoyButton::turboEvent();
-    } else if ((getTurboMode() == GradientTurbo) || (getTurboMode() == PulseTurbo))
-    {
-        double diff = fabs(getMouseDistanceFromDeadZone() - lastDistance);
-
-        qDebug() << "DIFF: " << QString::number(diff);
-
-        bool changeState = false;
-
-        if (!turboTimer.isActive() && !isButtonPressed)
-        {
-            changeState = true;
-        } else if ((getTurboMode() == GradientTurbo) && (diff > 0) && (getMouseDistanceFromDeadZone() >= 1.0))
-        {
-            if (isKeyPressed)
-            {
-                changeState = false;
-
-                if (!turboTimer.isActive() || (turboTimer.interval() != 5))
-                {
-                    turboTimer.start(5);
-                }
-
-                turboHold.restart();
-                lastDistance = 1.0;
-            } else
-            {
-                changeState = true;
-            }
-        }
-
-        else if (lastDistance == 0.0 || (turboHold.elapsed() > tempTurboInterval))
-        {
-            changeState = true;
-        } else if (diff >= 0.1)
-        {
-            int tempInterval2 = 0;
-
-            if (isKeyPressed)
-            {
-                if (getTurboMode() == GradientTurbo)
-                {
-                    tempInterval2 = floor((getMouseDistanceFromDeadZone() * m_turboInterval) + 0.5);
-                } else
-                {
-                    tempInterval2 = floor((m_turboInterval * 0.5) + 0.5);
-                }
-            } else
-            {
-                if (getTurboMode() == GradientTurbo)
-                {
-                    tempInterval2 = floor(((1 - getMouseDistanceFromDeadZone()) * m_turboInterval) + 0.5);
-                } else
-                {
-                    double distance = getMouseDistanceFromDeadZone();
-
-                    if (distance > 0.0)
-                    {
-                        tempInterval2 = floor(((m_turboInterval / getMouseDistanceFromDeadZone()) * 0.5) + 0.5);
-                    } else
-                    {
-                        tempInterval2 = 0;
-                    }
-                }
-            }
-
-            if (turboHold.elapsed() < tempInterval2)
-            {
-                // Still some valid time left. Continue current action with
-                // remaining time left.
-                tempTurboInterval = tempInterval2 - turboHold.elapsed();
-                int timerInterval = qMin(tempTurboInterval, 5);
-
-                if (!turboTimer.isActive() || (turboTimer.interval() != timerInterval))
-                {
-                    turboTimer.start(timerInterval);
-                }
-
-                turboHold.restart();
-                changeState = false;
-                lastDistance = getMouseDistanceFromDeadZone();
-
-                qDebug() << "diff tmpTurbo press: " << QString::number(tempTurboInterval);
-                qDebug() << "diff timer press: " << QString::number(timerInterval);
-            } else
-            {
-                changeState = true;
-
-                qDebug() << "YOU GOT CHANGE";
-            }
-        }
+        return JoyButton::getTurboPeriod();
 
-        if (changeState)
-        {
-            if (!isKeyPressed)
-            {
-                if (!isButtonPressedQueue.isEmpty())
-                {
-                    ignoreSetQueue.clear();
-                    isButtonPressedQueue.clear();
+    double interval = (containsJoyMixSlot() && (allSlotTimeBetweenSlots > 0)) ? allSlotTimeBetweenSlots : turboInterval;
+    double distance = qBound(0.0, getMouseDistanceFromDeadZone(), 1.0);
 
-                    ignoreSetQueue.enqueue(false);
-                    isButtonPressedQueue.enqueue(isButtonPressed);
-                }
-
-                createDeskEvent();
-
-                isKeyPressed = true;
-                if (turboTimer.isActive())
-                {
-                    if (getTurboMode() == GradientTurbo)
-                    {
-                        tempTurboInterval = floor((getMouseDistanceFromDeadZone() * m_turboInterval) + 0.5);
-                    } else
-                    {
-                        tempTurboInterval = floor((m_turboInterval * 0.5) + 0.5);
-                    }
+    if ((getTurboMode() == PulseTurbo) && (distance > 0.0))
+        return (interval * 0.5) + ((interval * 0.5) / distance);
 
-                    int timerInterval = qMin(tempTurboInterval, 5);
-
-                    qDebug() << "tmpTurbo press: " << QString::number(tempTurboInterval);
-                    qDebug() << "timer press: " << QString::number(timerInterval);
-
-                    if (turboTimer.interval() != timerInterval)
-                    {
-                        turboTimer.start(timerInterval);
-                    }
-
-                    turboHold.restart();
-                }
-            } else
-            {
-                if (!isButtonPressedQueue.isEmpty())
-                {
-                    ignoreSetQueue.enqueue(false);
-                    isButtonPressedQueue.enqueue(!isButtonPressed);
-                }
-
-                releaseDeskEvent();
-
-                isKeyPressed = false;
+    return interval;
+}
 
-                if (turboTimer.isActive())
-                {
-                    if (getTurboMode() == GradientTurbo)
-                    {
-                        tempTurboInterval = floor(((1 - getMouseDistanceFromDeadZone()) * m_turboInterval) + 0.5);
-                    } else
-                    {
-                        double distance = getMouseDistanceFromDeadZone();
-
-                        if (distance > 0.0)
-                        {
-                            tempTurboInterval = floor(((m_turboInterval / getMouseDistanceFromDeadZone()) * 0.5) + 0.5);
-                        } else
-                        {
-                            tempTurboInterval = 0;
-                        }
-                    }
-
-                    int timerInterval = qMin(tempTurboInterval, 5);
-
-                    qDebug() << "tmpTurbo release: " << QString::number(tempTurboInterval);
-                    qDebug() << "timer release: " << QString::number(timerInterval);
-
-                    if (turboTimer.interval() != timerInterval)
-                    {
-                        turboTimer.start(timerInterval);
-                    }
-
-                    turboHold.restart();
-                }
-            }
+double JoyGradientButton::getTurboDutyCycle()
+{
+    double distance = qBound(0.0, getMouseDistanceFromDeadZone(), 1.0);
 
-            lastDistance = getMouseDistanceFromDeadZone();
-        }
+    switch (getTurboMode())
+    {
+    case GradientTurbo:
+        return distance;
+    case PulseTurbo:
+        return distance / (1.0 + distance);
+    default:
+        return JoyButton::getTurboDutyCycle();
     }
 }
 
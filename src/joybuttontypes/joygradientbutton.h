@@ -33,8 +33,11 @@ class JoyGradientButton : public JoyButton
     using JoyButton::getPartialName;
     using JoyButton::setChangeSetCondition;
 
+  protected:
+    virtual double getTurboPeriod() override;
+    virtual double getTurboDutyCycle() override;
+
   protected slots:
-    virtual void turboEvent();
     virtual void wheelEventVertical();
     virtual void wheelEventHorizontal();
 };
@@ -0,0 +1,83 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "joytouchpadbutton.h"
+
+#include "globalvariables.h"
+#include "joytouchpad.h"
+
+JoyTouchpadButton::JoyTouchpadButton(JoyTouchpad *touchpad, int zone, int originset, SetJoystick *parentSet,
+                                     QObject *parent)
+    : JoyButton(zone, originset, parentSet, parent)
+    , m_touchpad(touchpad)
+{
+}
+
+/**
+ * @brief Get the name of the button.
+ *  Shows the touchpad zone instead of a button number.
+ * @returns Button name
+ */
+QString JoyTouchpadButton::getPartialName(bool forceFullFormat, bool displayNames) const
+{
+    QString temp = m_touchpad->getPartialName(forceFullFormat, displayNames);
+    temp.append(": ");
+
+    if (!buttonName.isEmpty() && displayNames)
+    {
+        if (forceFullFormat)
+            temp.append(tr("Button")).append(" ");
+        temp.append(buttonName);
+    } else if (!defaultButtonName.isEmpty())
+    {
+        if (forceFullFormat)
+            temp.append(tr("Button")).append(" ");
+        temp.append(defaultButtonName);
+    } else
+    {
+        temp.append(tr("Button")).append(" ");
+        temp.append(getZoneName());
+    }
+
+    return temp;
+}
+
+/**
+ * @brief Get the XML tag name of this button type
+ */
+QString JoyTouchpadButton::getXmlName() { return GlobalVariables::JoyTouchpadButton::xmlName; }
+
+QString JoyTouchpadButton::getZoneName() const
+{
+    switch (m_index_sdl)
+    {
+    case JoyTouchpad::ZoneTopLeft:
+        return tr("Top Left");
+    case JoyTouchpad::ZoneTopRight:
+        return tr("Top Right");
+    case JoyTouchpad::ZoneBottomLeft:
+        return tr("Bottom Left");
+    case JoyTouchpad::ZoneBottomRight:
+        return tr("Bottom Right");
+    default:
+        return QString::number(m_index_sdl + 1);
+    }
+}
+
+/**
+ * @brief Get the JoyTouchpad associated to this button.
+ */
+JoyTouchpad *JoyTouchpadButton::getTouchpad() const { return m_touchpad; }
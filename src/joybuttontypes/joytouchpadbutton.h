@@ -0,0 +1,45 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JOYTOUCHPADBUTTON_H
+#define JOYTOUCHPADBUTTON_H
+
+#include "joybutton.h"
+
+class JoyTouchpad;
+class SetJoystick;
+
+/**
+ * @brief A region of a touchpad which acts as a button while touched
+ */
+class JoyTouchpadButton : public JoyButton
+{
+    Q_OBJECT
+
+  public:
+    explicit JoyTouchpadButton(JoyTouchpad *touchpad, int zone, int originset, SetJoystick *parentSet, QObject *parent);
+
+    virtual QString getPartialName(bool forceFullFormat = false, bool displayNames = false) const override;
+    virtual QString getXmlName() override;
+
+    QString getZoneName() const;
+    JoyTouchpad *getTouchpad() const;
+
+  private:
+    JoyTouchpad *m_touchpad;
+};
+
+#endif // JOYTOUCHPADBUTTON_H
@@ -22,13 +22,14 @@
 #include "joyaxis.h"
 #include "joybuttontypes/joycontrolstickbutton.h"
 #include "joybuttontypes/joycontrolstickmodifierbutton.h"
+#include "stickeventvariant.h"
 #include "xml/joybuttonxml.h"
 
 #include <QDebug>
 #include <QHashIterator>
-#include <QLabel>
 #include <QPointer>
 #include <QStringList>
+#include <QThread>
 #include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 //#include <QtTest/QTest>
@@ -36,10 +37,19 @@
 #include <math.h>
 
 const JoyControlStick::JoyMode JoyControlStick::DEFAULTMODE = JoyControlStick::StandardMode;
+const int JoyControlStick::RESPONSE_MAP_DELAY_MSECS = 250;
+const int JoyControlStick::RESPONSE_MAP_ROWS_PER_STEP = 16;
 
 JoyControlStick::JoyControlStick(JoyAxis *axis1, JoyAxis *axis2, int index, int originset, QObject *parent)
     : QObject(parent)
+    , responseMapEnabled(false)
+    , responseMapDirty(true)
+    , responseMapRow(0)
 {
+    responseMapTimer.setParent(this);
+    responseMapTimer.setSingleShot(true);
+    connect(&responseMapTimer, &QTimer::timeout, this, &JoyControlStick::buildResponseMapRows);
+
     this->axisX = axis1;
     this->axisX->setControlStick(this);
     this->axisY = axis2;
@@ -71,6 +81,19 @@ JoyControlStick::~JoyControlStick()
  */
 void JoyControlStick::joyEvent(bool ignoresets)
 {
+    StickEventVariant::dispatch(eventVariant, [this, ignoresets](auto variant) {
+        processJoyEvent<decltype(variant)::value>(ignoresets);
+    });
+}
+
+/**
+ * @brief joyEvent specialized for a variant of StickEventVariant. Sticks
+ *   without a direction delay skip the pending direction check.
+ */
+template <int variant> void JoyControlStick::processJoyEvent(bool ignoresets)
+{
+    const bool immediate = !StickEventVariant::delayed(variant) || ignoresets;
+
     safezone = !inDeadZone();
 
     if (safezone && !isActive)
@@ -78,12 +101,12 @@ void JoyControlStick::joyEvent(bool ignoresets)
         isActive = true;
         emit active(axisX->getCurrentRawValue(), axisY->getCurrentRawValue());
 
-        if (ignoresets || (stickDelay == 0))
+        if (immediate)
         {
             if (directionDelayTimer.isActive())
                 directionDelayTimer.stop();
 
-            createDeskEvent(ignoresets);
+            processDeskEvent<variant>(ignoresets);
         } else
         {
             if (!directionDelayTimer.isActive())
@@ -94,12 +117,12 @@ void JoyControlStick::joyEvent(bool ignoresets)
         isActive = false;
         emit released(axisX->getCurrentRawValue(), axisY->getCurrentRawValue());
 
-        if (ignoresets || (stickDelay == 0))
+        if (immediate)
         {
             if (directionDelayTimer.isActive())
                 directionDelayTimer.stop();
 
-            createDeskEvent(ignoresets);
+            processDeskEvent<variant>(ignoresets);
         } else
         {
             if (!directionDelayTimer.isActive())
@@ -107,12 +130,12 @@ void JoyControlStick::joyEvent(bool ignoresets)
         }
     } else if (isActive)
     {
-        if (ignoresets || (stickDelay == 0))
+        if (immediate)
         {
             if (directionDelayTimer.isActive())
                 directionDelayTimer.stop();
 
-            createDeskEvent(ignoresets);
+            processDeskEvent<variant>(ignoresets);
         } else
         {
             JoyStickDirections pendingDirection = calculateStickDirection();
@@ -126,7 +149,7 @@ void JoyControlStick::joyEvent(bool ignoresets)
                 if (directionDelayTimer.isActive())
                     directionDelayTimer.stop();
 
-                createDeskEvent(ignoresets);
+                processDeskEvent<variant>(ignoresets);
             }
         }
     }
@@ -141,12 +164,14 @@ void JoyControlStick::joyEvent(bool ignoresets)
  *   the assigned dead zone.
  * @return If stick position is in the assigned dead zone
  */
-bool JoyControlStick::inDeadZone()
-{
-    int axis1Value = axisX->getCurrentRawValue();
-    int axis2Value = axisY->getCurrentRawValue();
+bool JoyControlStick::inDeadZone() { return inDeadZone(axisX->getCurrentRawValue(), axisY->getCurrentRawValue()); }
 
-    int squareDist = (axis1Value * axis1Value) + (axis2Value * axis2Value);
+/**
+ * @brief Check if the given axis values lie inside the dead zone of the stick.
+ */
+bool JoyControlStick::inDeadZone(int axisXValue, int axisYValue)
+{
+    int squareDist = (axisXValue * axisXValue) + (axisYValue * axisYValue);
 
     return squareDist <= (deadZone * deadZone);
 }
@@ -206,30 +231,44 @@ int JoyControlStick::getDiagonalRange() { return diagonalRange; }
  */
 void JoyControlStick::createDeskEvent(bool ignoresets)
 {
+    StickEventVariant::dispatch(eventVariant, [this, ignoresets](auto variant) {
+        processDeskEvent<decltype(variant)::value>(ignoresets);
+    });
+}
+
+/**
+ * @brief Select the joyEvent and createDeskEvent variant matching the
+ *   current mode, modifier zone direction and stick delay. Must be called
+ *   whenever one of them changes.
+ */
+void JoyControlStick::selectEventVariant()
+{
+    eventVariant = StickEventVariant::select(currentMode, m_modifier_zone_inverted, stickDelay > 0);
+}
+
+/**
+ * @brief createDeskEvent specialized for a variant of StickEventVariant,
+ *   so neither the mode nor the modifier zone direction has to be checked
+ *   again for every event.
+ */
+template <int variant> void JoyControlStick::processDeskEvent(bool ignoresets)
+{
+    constexpr int mode = StickEventVariant::mode(variant);
+
     JoyControlStickButton *eventbutton1 = nullptr;
     JoyControlStickButton *eventbutton2 = nullptr;
     JoyControlStickButton *eventbutton3 = nullptr;
 
     if (safezone)
     {
-        switch (currentMode)
-        {
-        case StandardMode:
+        if constexpr (mode == StandardMode)
             determineStandardModeEvent(eventbutton1, eventbutton2);
-            break;
-
-        case EightWayMode:
+        else if constexpr (mode == EightWayMode)
             determineEightWayModeEvent(eventbutton1, eventbutton2, eventbutton3);
-            break;
-
-        case FourWayCardinal:
+        else if constexpr (mode == FourWayCardinal)
             determineFourWayCardinalEvent(eventbutton1, eventbutton2);
-            break;
-
-        case FourWayDiagonal:
+        else
             determineFourWayDiagonalEvent(eventbutton3);
-            break;
-        }
     } else
     {
         currentDirection = StickCentered;
@@ -276,19 +315,10 @@ void JoyControlStick::createDeskEvent(bool ignoresets)
     // distance events.
     // Release modifier button after releasing directional buttons.
     double distance = getAbsoluteRawDistance();
-    if (m_modifier_zone_inverted)
-    {
-        if (safezone && distance < m_modifier_zone)
-            modifierButton->joyEvent(true, ignoresets);
-        else
-            modifierButton->joyEvent(false, ignoresets);
-    } else
-    {
-        if (safezone && distance > m_modifier_zone)
-            modifierButton->joyEvent(true, ignoresets);
-        else
-            modifierButton->joyEvent(false, ignoresets);
-    }
+    if constexpr (StickEventVariant::invertedModifierZone(variant))
+        modifierButton->joyEvent(safezone && (distance < m_modifier_zone), ignoresets);
+    else
+        modifierButton->joyEvent(safezone && (distance > m_modifier_zone), ignoresets);
 
     /*
      * Enable stick buttons.
@@ -402,6 +432,23 @@ double JoyControlStick::getDistanceFromDeadZone(int axisXValue, int axisYValue)
 {
     double distance = 0.0;
 
+    if (useResponseMap() && responseMap.lookupDistance(axisXValue, axisYValue, distance))
+        return distance;
+
+    return calculateExactDistanceFromDeadZone(axisXValue, axisYValue);
+}
+
+/**
+ * @brief Get radial distance of the stick position past the assigned dead zone
+ *   without consulting the response map.
+ * @param X axis value
+ * @param Y axis value
+ * @return Distance percentage in the range of 0.0 - 1.0.
+ */
+double JoyControlStick::calculateExactDistanceFromDeadZone(int axisXValue, int axisYValue)
+{
+    double distance = 0.0;
+
     int axis1Value = axisXValue;
     int axis2Value = axisYValue;
 
@@ -409,8 +456,9 @@ double JoyControlStick::getDistanceFromDeadZone(int axisXValue, int axisYValue)
     double ang_sin = sin(angle2);
     double ang_cos = cos(angle2);
 
-    int squared_dist = (axis1Value * axis1Value) + (axis2Value * axis2Value);
-    int dist = sqrt(squared_dist);
+    // The corners of the raw range exceed int when squared, the response map samples them.
+    qint64 squared_dist = (static_cast<qint64>(axis1Value) * axis1Value) + (static_cast<qint64>(axis2Value) * axis2Value);
+    int dist = sqrt(static_cast<double>(squared_dist));
 
     double squareStickFullPhi = qMin((ang_sin != 0.0) ? 1 / fabs(ang_sin) : 2, ang_cos != 0.0 ? 1 / fabs(ang_cos) : 2);
     double circle = this->circle;
@@ -469,9 +517,9 @@ double JoyControlStick::calculateYDistanceFromDeadZone(int axisXValue, int axisY
         JoyStickDirections direction = calculateStickDirection(axis1Value, axis2Value);
         if ((direction == StickRightUp) || (direction == StickUp))
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
+            DiagonalZoneAngles tempangles = getDiagonalZoneAngles();
 
-            double minangle = tempangles.at(1);
+            double minangle = tempangles[1];
             double square_dist = getAbsoluteRawDistance(axis1Value, axis2Value);
             double mindeadY = fabs(square_dist * sin(minangle * GlobalVariables::JoyControlStick::PI / 180.0));
             double currentDeadY = qMax(adjustedDeadYZone, mindeadY);
@@ -484,9 +532,9 @@ double JoyControlStick::calculateYDistanceFromDeadZone(int axisXValue, int axisY
             distance = tempdist4;
         } else if ((direction == StickRightDown) || (direction == StickRight))
         {
-            QList<double> tempfuck = getDiagonalZoneAngles();
+            DiagonalZoneAngles tempfuck = getDiagonalZoneAngles();
 
-            double minangle = tempfuck.at(4);
+            double minangle = tempfuck[4];
             double square_dist = getAbsoluteRawDistance(axis1Value, axis2Value);
             double mindeadY = fabs(square_dist * sin((minangle - 90.0) * GlobalVariables::JoyControlStick::PI / 180.0));
             double currentDeadY = qMax(adjustedDeadYZone, mindeadY);
@@ -499,9 +547,9 @@ double JoyControlStick::calculateYDistanceFromDeadZone(int axisXValue, int axisY
             distance = tempdist4;
         } else if ((direction == StickLeftDown) || (direction == StickDown))
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
+            DiagonalZoneAngles tempangles = getDiagonalZoneAngles();
 
-            double minangle = tempangles.at(6);
+            double minangle = tempangles[6];
             double square_dist = getAbsoluteRawDistance(axis1Value, axis2Value);
             double mindeadY = fabs(square_dist * sin((minangle - 180.0) * GlobalVariables::JoyControlStick::PI / 180.0));
             double currentDeadY = qMax(adjustedDeadYZone, mindeadY);
@@ -514,9 +562,9 @@ double JoyControlStick::calculateYDistanceFromDeadZone(int axisXValue, int axisY
             distance = tempdist4;
         } else if ((direction == StickLeftUp) || (direction == StickLeft))
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
+            DiagonalZoneAngles tempangles = getDiagonalZoneAngles();
 
-            double minangle = tempangles.at(8);
+            double minangle = tempangles[8];
             double square_dist = getAbsoluteRawDistance(axis1Value, axis2Value);
             double mindeadY = fabs(square_dist * sin((minangle - 270.0) * GlobalVariables::JoyControlStick::PI / 180.0));
             double currentDeadY = qMax(adjustedDeadYZone, mindeadY);
@@ -599,9 +647,9 @@ double JoyControlStick::calculateXDistanceFromDeadZone(int axisXValue, int axisY
 
         if ((direction == StickRightUp) || (direction == StickRight))
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
+            DiagonalZoneAngles tempangles = getDiagonalZoneAngles();
 
-            double maxangle = tempangles.at(3);
+            double maxangle = tempangles[3];
             double square_dist = getAbsoluteRawDistance(axis1Value, axis2Value);
             double mindeadX = fabs(square_dist * cos(maxangle * GlobalVariables::JoyControlStick::PI / 180.0));
             double currentDeadX = qMax(mindeadX, adjustedDeadXZone);
@@ -614,9 +662,9 @@ double JoyControlStick::calculateXDistanceFromDeadZone(int axisXValue, int axisY
             distance = tempdist4;
         } else if ((direction == StickRightDown) || (direction == StickDown))
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
+            DiagonalZoneAngles tempangles = getDiagonalZoneAngles();
 
-            double maxangle = tempangles.at(5);
+            double maxangle = tempangles[5];
             double square_dist = getAbsoluteRawDistance(axis1Value, axis2Value);
             double mindeadX = fabs(square_dist * cos((maxangle - 90.0) * GlobalVariables::JoyControlStick::PI / 180.0));
             double currentDeadX = qMax(mindeadX, adjustedDeadXZone);
@@ -629,9 +677,9 @@ double JoyControlStick::calculateXDistanceFromDeadZone(int axisXValue, int axisY
             distance = tempdist4;
         } else if ((direction == StickLeftDown) || (direction == StickLeft))
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
+            DiagonalZoneAngles tempangles = getDiagonalZoneAngles();
 
-            double maxangle = tempangles.at(7);
+            double maxangle = tempangles[7];
             double square_dist = getAbsoluteRawDistance(axis1Value, axis2Value);
             double mindeadX = fabs(square_dist * cos((maxangle - 180.0) * GlobalVariables::JoyControlStick::PI / 180.0));
             double currentDeadX = qMax(mindeadX, adjustedDeadXZone);
@@ -644,9 +692,9 @@ double JoyControlStick::calculateXDistanceFromDeadZone(int axisXValue, int axisY
             distance = tempdist4;
         } else if ((direction == StickLeftUp) || (direction == StickUp))
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
+            DiagonalZoneAngles tempangles = getDiagonalZoneAngles();
 
-            double maxangle = tempangles.at(1);
+            double maxangle = tempangles[1];
             double square_dist = getAbsoluteRawDistance(axis1Value, axis2Value);
             double mindeadX = fabs(square_dist * cos((maxangle - 270.0) * GlobalVariables::JoyControlStick::PI / 180.0));
             double currentDeadX = qMax(mindeadX, adjustedDeadXZone);
@@ -863,6 +911,9 @@ void JoyControlStick::reset()
     stickName.clear();
     circle = GlobalVariables::JoyControlStick::DEFAULTCIRCLE;
     stickDelay = GlobalVariables::JoyControlStick::DEFAULTSTICKDELAY;
+    selectEventVariant();
+    responseMapEnabled = GlobalVariables::JoyControlStick::DEFAULTRESPONSEMAP;
+    invalidateResponseMap();
 
     resetButtons();
 }
@@ -874,6 +925,7 @@ void JoyControlStick::setDeadZone(int value)
     if ((value != deadZone) && (value <= maxZone))
     {
         deadZone = value;
+        invalidateResponseMap();
         emit deadZoneChanged(value);
         emit propertyUpdated();
     }
@@ -886,6 +938,7 @@ void JoyControlStick::setMaxZone(int value)
     if ((value != maxZone) && (value > deadZone))
     {
         maxZone = value;
+        invalidateResponseMap();
         emit maxZoneChanged(value);
         emit propertyUpdated();
     }
@@ -916,6 +969,7 @@ void JoyControlStick::setModifierZoneInverted(bool value)
     if (value != m_modifier_zone_inverted)
     {
         m_modifier_zone_inverted = value;
+        selectEventVariant();
         emit modifierZoneChanged(m_modifier_zone);
         emit propertyUpdated();
     }
@@ -977,6 +1031,7 @@ void JoyControlStick::setDiagonalRange(int value)
     if (value != diagonalRange)
     {
         diagonalRange = value;
+        invalidateResponseMap();
         emit diagonalRangeChanged(value);
         emit propertyUpdated();
     }
@@ -1063,6 +1118,10 @@ void JoyControlStick::readConfig(QXmlStreamReader *xml)
                 QString temptext = xml->readElementText();
                 int tempchoice = temptext.toInt();
                 this->setStickDelay(tempchoice);
+            } else if ((xml->name().toString() == "responseMap") && xml->isStartElement())
+            {
+                QString temptext = xml->readElementText();
+                setResponseMapEnabled(temptext == "true");
             } else
             {
                 xml->skipCurrentElement();
@@ -1128,6 +1187,9 @@ void JoyControlStick::writeConfig(QXmlStreamWriter *xml)
         if (stickDelay > GlobalVariables::JoyControlStick::DEFAULTSTICKDELAY)
             xml->writeTextElement("stickDelay", QString::number(stickDelay));
 
+        if (responseMapEnabled != GlobalVariables::JoyControlStick::DEFAULTRESPONSEMAP)
+            xml->writeTextElement("responseMap", responseMapEnabled ? "true" : "false");
+
         QHashIterator<JoyStickDirections, JoyControlStickButton *> iter(buttons);
 
         while (iter.hasNext())
@@ -1747,10 +1809,15 @@ int JoyControlStick::calculateCircleYValue(int axisXValue, int axisYValue)
     return value;
 }
 
-QList<double> JoyControlStick::getDiagonalZoneAngles()
+/**
+ * @brief Gets the bearings where the direction zones of a standard or
+ *     eight way stick start. Returned by value without allocating as it
+ *     is used for every stick event.
+ * @return Start of up (initialLeft), end of up (initialRight), up-right,
+ *     right, down-right, down, down-left, left and up-left
+ */
+JoyControlStick::DiagonalZoneAngles JoyControlStick::getDiagonalZoneAngles()
 {
-    QList<double> anglesList;
-
     int diagonalAngle = diagonalRange;
 
     double cardinalAngle = (360 - (diagonalAngle * 4)) / 4.0;
@@ -1766,23 +1833,12 @@ QList<double> JoyControlStick::getDiagonalZoneAngles()
     double leftInitial = downLeftInitial + diagonalAngle;
     double upLeftInitial = leftInitial + cardinalAngle;
 
-    anglesList.append(initialLeft);
-    anglesList.append(initialRight);
-    anglesList.append(upRightInitial);
-    anglesList.append(rightInitial);
-    anglesList.append(downRightInitial);
-    anglesList.append(downInitial);
-    anglesList.append(downLeftInitial);
-    anglesList.append(leftInitial);
-    anglesList.append(upLeftInitial);
-
-    return anglesList;
+    return {{initialLeft, initialRight, upRightInitial, rightInitial, downRightInitial, downInitial, downLeftInitial,
+             leftInitial, upLeftInitial}};
 }
 
-QList<int> JoyControlStick::getFourWayCardinalZoneAngles()
+JoyControlStick::FourWayZoneAngles JoyControlStick::getFourWayCardinalZoneAngles()
 {
-    QList<int> anglesList;
-
     int zoneRange = 90;
 
     int rightInitial = 45;
@@ -1790,18 +1846,11 @@ QList<int> JoyControlStick::getFourWayCardinalZoneAngles()
     int leftInitial = downInitial + zoneRange;
     int upInitial = leftInitial + zoneRange;
 
-    anglesList.append(rightInitial);
-    anglesList.append(downInitial);
-    anglesList.append(leftInitial);
-    anglesList.append(upInitial);
-
-    return anglesList;
+    return {{rightInitial, downInitial, leftInitial, upInitial}};
 }
 
-QList<int> JoyControlStick::getFourWayDiagonalZoneAngles()
+JoyControlStick::FourWayZoneAngles JoyControlStick::getFourWayDiagonalZoneAngles()
 {
-    QList<int> anglesList;
-
     int zoneRange = 90;
 
     int upRightInitial = 0;
@@ -1809,12 +1858,7 @@ QList<int> JoyControlStick::getFourWayDiagonalZoneAngles()
     int downLeftInitial = downRightInitial + zoneRange;
     int upLeftInitial = downLeftInitial + zoneRange;
 
-    anglesList.append(upRightInitial);
-    anglesList.append(downRightInitial);
-    anglesList.append(downLeftInitial);
-    anglesList.append(upLeftInitial);
-
-    return anglesList;
+    return {{upRightInitial, downRightInitial, downLeftInitial, upLeftInitial}};
 }
 
 QHash<JoyControlStick::JoyStickDirections, JoyControlStickButton *> *JoyControlStick::getButtons() { return &buttons; }
@@ -1861,12 +1905,32 @@ void JoyControlStick::replaceAxes(JoyAxis *axisX, JoyAxis *axisY)
 void JoyControlStick::setJoyMode(JoyMode mode)
 {
     currentMode = mode;
+    selectEventVariant();
+    invalidateResponseMap();
     emit joyModeChanged();
     emit propertyUpdated();
 }
 
 JoyControlStick::JoyMode JoyControlStick::getJoyMode() { return currentMode; }
 
+/**
+ * @brief Answer direction and distance lookups of the input thread from a
+ *     quantized response map instead of calculating them on every event.
+ *     Positions close to a zone edge still use the exact calculation.
+ * @param Whether the response map should be used.
+ */
+void JoyControlStick::setResponseMapEnabled(bool enabled)
+{
+    if (enabled != responseMapEnabled)
+    {
+        responseMapEnabled = enabled;
+        invalidateResponseMap();
+        emit propertyUpdated();
+    }
+}
+
+bool JoyControlStick::isResponseMapEnabled() { return responseMapEnabled; }
+
 void JoyControlStick::releaseButtonEvents()
 {
     QHashIterator<JoyStickDirections, JoyControlStickButton *> iter(buttons);
@@ -1889,6 +1953,7 @@ bool JoyControlStick::isDefault()
     value = value && (currentMode == DEFAULTMODE);
     value = value && qFuzzyCompare(circle, GlobalVariables::JoyControlStick::DEFAULTCIRCLE);
     value = value && (stickDelay == GlobalVariables::JoyControlStick::DEFAULTSTICKDELAY);
+    value = value && (responseMapEnabled == GlobalVariables::JoyControlStick::DEFAULTRESPONSEMAP);
 
     QHashIterator<JoyStickDirections, JoyControlStickButton *> iter(buttons);
 
@@ -2211,6 +2276,17 @@ void JoyControlStick::setButtonsWheelSpeedY(int value)
     }
 }
 
+void JoyControlStick::setButtonsAnalogWheel(bool enabled)
+{
+    QHashIterator<JoyStickDirections, JoyControlStickButton *> iter(buttons);
+
+    while (iter.hasNext())
+    {
+        JoyControlStickButton *button = iter.next().value();
+        button->setAnalogWheel(enabled);
+    }
+}
+
 /**
  * @brief Get pointer to the set that a stick belongs to.
  * @return Pointer to the set that a stick belongs to.
@@ -2261,16 +2337,16 @@ void JoyControlStick::determineStandardModeEvent(JoyControlStickButton *&eventbu
 {
     double bearing = calculateBearing();
 
-    QList<double> anglesList = getDiagonalZoneAngles();
-    double initialLeft = anglesList.value(0);
-    double initialRight = anglesList.value(1);
-    double upRightInitial = anglesList.value(2);
-    double rightInitial = anglesList.value(3);
-    double downRightInitial = anglesList.value(4);
-    double downInitial = anglesList.value(5);
-    double downLeftInitial = anglesList.value(6);
-    double leftInitial = anglesList.value(7);
-    double upLeftInitial = anglesList.value(8);
+    DiagonalZoneAngles anglesList = getDiagonalZoneAngles();
+    double initialLeft = anglesList[0];
+    double initialRight = anglesList[1];
+    double upRightInitial = anglesList[2];
+    double rightInitial = anglesList[3];
+    double downRightInitial = anglesList[4];
+    double downInitial = anglesList[5];
+    double downLeftInitial = anglesList[6];
+    double leftInitial = anglesList[7];
+    double upLeftInitial = anglesList[8];
 
     if ((bearing <= initialRight) || (bearing >= initialLeft))
     {
@@ -2323,16 +2399,16 @@ void JoyControlStick::determineEightWayModeEvent(JoyControlStickButton *&eventbu
 {
     double bearing = calculateBearing();
 
-    QList<double> anglesList = getDiagonalZoneAngles();
-    double initialLeft = anglesList.value(0);
-    double initialRight = anglesList.value(1);
-    double upRightInitial = anglesList.value(2);
-    double rightInitial = anglesList.value(3);
-    double downRightInitial = anglesList.value(4);
-    double downInitial = anglesList.value(5);
-    double downLeftInitial = anglesList.value(6);
-    double leftInitial = anglesList.value(7);
-    double upLeftInitial = anglesList.value(8);
+    DiagonalZoneAngles anglesList = getDiagonalZoneAngles();
+    double initialLeft = anglesList[0];
+    double initialRight = anglesList[1];
+    double upRightInitial = anglesList[2];
+    double rightInitial = anglesList[3];
+    double downRightInitial = anglesList[4];
+    double downInitial = anglesList[5];
+    double downLeftInitial = anglesList[6];
+    double leftInitial = anglesList[7];
+    double upLeftInitial = anglesList[8];
 
     if ((bearing <= initialRight) || (bearing >= initialLeft))
     {
@@ -2380,11 +2456,11 @@ void JoyControlStick::determineFourWayCardinalEvent(JoyControlStickButton *&even
 {
     double bearing = calculateBearing();
 
-    QList<int> anglesList = getFourWayCardinalZoneAngles();
-    int rightInitial = anglesList.value(0);
-    int downInitial = anglesList.value(1);
-    int leftInitial = anglesList.value(2);
-    int upInitial = anglesList.value(3);
+    FourWayZoneAngles anglesList = getFourWayCardinalZoneAngles();
+    int rightInitial = anglesList[0];
+    int downInitial = anglesList[1];
+    int leftInitial = anglesList[2];
+    int upInitial = anglesList[3];
 
     if ((bearing < rightInitial) || (bearing >= upInitial))
     {
@@ -2414,11 +2490,11 @@ void JoyControlStick::determineFourWayDiagonalEvent(JoyControlStickButton *&even
 {
     double bearing = calculateBearing();
 
-    QList<int> anglesList = getFourWayDiagonalZoneAngles();
-    int upRightInitial = anglesList.value(0);
-    int downRightInitial = anglesList.value(1);
-    int downLeftInitial = anglesList.value(2);
-    int upLeftInitial = anglesList.value(3);
+    FourWayZoneAngles anglesList = getFourWayDiagonalZoneAngles();
+    int upRightInitial = anglesList[0];
+    int downRightInitial = anglesList[1];
+    int downLeftInitial = anglesList[2];
+    int upLeftInitial = anglesList[3];
 
     if ((bearing >= upRightInitial) && (bearing < downRightInitial))
     {
@@ -2454,16 +2530,16 @@ JoyControlStick::JoyStickDirections JoyControlStick::determineStandardModeDirect
 
     double bearing = calculateBearing(axisXValue, axisYValue);
 
-    QList<double> anglesList = getDiagonalZoneAngles();
-    int initialLeft = anglesList.value(0);
-    int initialRight = anglesList.value(1);
-    int upRightInitial = anglesList.value(2);
-    int rightInitial = anglesList.value(3);
-    int downRightInitial = anglesList.value(4);
-    int downInitial = anglesList.value(5);
-    int downLeftInitial = anglesList.value(6);
-    int leftInitial = anglesList.value(7);
-    int upLeftInitial = anglesList.value(8);
+    DiagonalZoneAngles anglesList = getDiagonalZoneAngles();
+    int initialLeft = anglesList[0];
+    int initialRight = anglesList[1];
+    int upRightInitial = anglesList[2];
+    int rightInitial = anglesList[3];
+    int downRightInitial = anglesList[4];
+    int downInitial = anglesList[5];
+    int downLeftInitial = anglesList[6];
+    int leftInitial = anglesList[7];
+    int upLeftInitial = anglesList[8];
 
     if ((bearing <= initialRight) || (bearing >= initialLeft))
     {
@@ -2524,11 +2600,11 @@ JoyControlStick::JoyStickDirections JoyControlStick::determineFourWayCardinalDir
 
     double bearing = calculateBearing(axisXValue, axisYValue);
 
-    QList<int> anglesList = getFourWayCardinalZoneAngles();
-    int rightInitial = anglesList.value(0);
-    int downInitial = anglesList.value(1);
-    int leftInitial = anglesList.value(2);
-    int upInitial = anglesList.value(3);
+    FourWayZoneAngles anglesList = getFourWayCardinalZoneAngles();
+    int rightInitial = anglesList[0];
+    int downInitial = anglesList[1];
+    int leftInitial = anglesList[2];
+    int upInitial = anglesList[3];
 
     if ((bearing < rightInitial) || (bearing >= upInitial))
     {
@@ -2561,11 +2637,11 @@ JoyControlStick::JoyStickDirections JoyControlStick::determineFourWayDiagonalDir
 {
     JoyStickDirections result = StickCentered;
     double bearing = calculateBearing(axisXValue, axisYValue);
-    QList<int> anglesList = getFourWayDiagonalZoneAngles();
-    int upRightInitial = anglesList.value(0);
-    int downRightInitial = anglesList.value(1);
-    int downLeftInitial = anglesList.value(2);
-    int upLeftInitial = anglesList.value(3);
+    FourWayZoneAngles anglesList = getFourWayDiagonalZoneAngles();
+    int upRightInitial = anglesList[0];
+    int downRightInitial = anglesList[1];
+    int downLeftInitial = anglesList[2];
+    int upLeftInitial = anglesList[3];
 
     if ((bearing >= upRightInitial) && (bearing < downRightInitial))
     {
@@ -2595,6 +2671,16 @@ JoyControlStick::JoyStickDirections JoyControlStick::calculateStickDirection()
 }
 
 JoyControlStick::JoyStickDirections JoyControlStick::calculateStickDirection(int axisXValue, int axisYValue)
+{
+    int direction = StickCentered;
+
+    if (useResponseMap() && responseMap.lookupDirection(axisXValue, axisYValue, direction))
+        return static_cast<JoyStickDirections>(direction);
+
+    return calculateExactStickDirection(axisXValue, axisYValue);
+}
+
+JoyControlStick::JoyStickDirections JoyControlStick::calculateExactStickDirection(int axisXValue, int axisYValue)
 {
     JoyStickDirections result = StickCentered;
 
@@ -2714,6 +2800,9 @@ void JoyControlStick::copyAssignments(JoyControlStick *destStick)
     destStick->stickName = stickName;
     destStick->circle = circle;
     destStick->stickDelay = stickDelay;
+    destStick->responseMapEnabled = responseMapEnabled;
+    destStick->selectEventVariant();
+    destStick->invalidateResponseMap();
 
     QHashIterator<JoyStickDirections, JoyControlStickButton *> iter(destStick->buttons);
 
@@ -2750,6 +2839,7 @@ void JoyControlStick::setCircleAdjust(double circle)
     if ((circle >= 0.0) && (circle <= 1.0))
     {
         this->circle = circle;
+        invalidateResponseMap();
         emit circleAdjustChange(circle);
         emit propertyUpdated();
     }
@@ -2773,6 +2863,7 @@ void JoyControlStick::setStickDelay(int value)
     if (((value >= 10) && (value <= 1000)) || (value == 0))
     {
         this->stickDelay = value;
+        selectEventVariant();
         emit stickDelayChanged(value);
         emit propertyUpdated();
     }
@@ -3666,30 +3757,30 @@ double JoyControlStick::calculateXDiagonalDeadZone(int axisXValue, int axisYValu
     {
         if ((direction == StickRightUp) || (direction == StickRight))
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
+            DiagonalZoneAngles tempangles = getDiagonalZoneAngles();
 
-            double maxangle = tempangles.at(3);
+            double maxangle = tempangles[3];
             double mindeadX = fabs(deadZone * cos(maxangle * GlobalVariables::JoyControlStick::PI / 180.0));
             diagonalDeadZone = mindeadX;
         } else if ((direction == StickRightDown) || (direction == StickDown))
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
+            DiagonalZoneAngles tempangles = getDiagonalZoneAngles();
 
-            double maxangle = tempangles.at(5);
+            double maxangle = tempangles[5];
             double mindeadX = fabs(deadZone * cos((maxangle - 90.0) * GlobalVariables::JoyControlStick::PI / 180.0));
             diagonalDeadZone = mindeadX;
         } else if ((direction == StickLeftDown) || (direction == StickLeft))
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
+            DiagonalZoneAngles tempangles = getDiagonalZoneAngles();
 
-            double maxangle = tempangles.at(7);
+            double maxangle = tempangles[7];
             double mindeadX = fabs(deadZone * cos((maxangle - 180.0) * GlobalVariables::JoyControlStick::PI / 180.0));
             diagonalDeadZone = mindeadX;
         } else if ((direction == StickLeftUp) || (direction == StickUp))
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
+            DiagonalZoneAngles tempangles = getDiagonalZoneAngles();
 
-            double maxangle = tempangles.at(1);
+            double maxangle = tempangles[1];
             double mindeadX = fabs(deadZone * cos((maxangle - 270.0) * GlobalVariables::JoyControlStick::PI / 180.0));
             diagonalDeadZone = mindeadX;
         } else
@@ -3713,30 +3804,30 @@ double JoyControlStick::calculateYDiagonalDeadZone(int axisXValue, int axisYValu
     {
         if ((direction == StickRightUp) || (direction == StickUp))
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
+            DiagonalZoneAngles tempangles = getDiagonalZoneAngles();
 
-            double minangle = tempangles.at(1);
+            double minangle = tempangles[1];
             double mindeadY = fabs(deadZone * sin(minangle * GlobalVariables::JoyControlStick::PI / 180.0));
             diagonalDeadZone = mindeadY;
         } else if ((direction == StickRightDown) || (direction == StickRight))
         {
-            QList<double> tempfuck = getDiagonalZoneAngles();
+            DiagonalZoneAngles tempfuck = getDiagonalZoneAngles();
 
-            double minangle = tempfuck.at(4);
+            double minangle = tempfuck[4];
             double mindeadY = fabs(deadZone * sin((minangle - 90.0) * GlobalVariables::JoyControlStick::PI / 180.0));
             diagonalDeadZone = mindeadY;
         } else if ((direction == StickLeftDown) || (direction == StickDown))
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
+            DiagonalZoneAngles tempangles = getDiagonalZoneAngles();
 
-            double minangle = tempangles.at(6);
+            double minangle = tempangles[6];
             double mindeadY = fabs(deadZone * sin((minangle - 180.0) * GlobalVariables::JoyControlStick::PI / 180.0));
             diagonalDeadZone = mindeadY;
         } else if ((direction == StickLeftUp) || (direction == StickLeft))
         {
-            QList<double> tempangles = getDiagonalZoneAngles();
+            DiagonalZoneAngles tempangles = getDiagonalZoneAngles();
 
-            double minangle = tempangles.at(8);
+            double minangle = tempangles[8];
             double mindeadY = fabs(deadZone * sin((minangle - 270.0) * GlobalVariables::JoyControlStick::PI / 180.0));
             diagonalDeadZone = mindeadY;
         } else
@@ -3962,3 +4053,54 @@ JoyControlStick::getButtonsForDirection(JoyControlStick::JoyStickDirections dire
 
     return temphash;
 }
+
+/**
+ * @brief Mark the response map as stale. Lookups use the exact calculation
+ *     until the properties settled for RESPONSE_MAP_DELAY_MSECS and the
+ *     input thread sampled the map again. Can be called from any thread.
+ */
+void JoyControlStick::invalidateResponseMap()
+{
+    responseMapDirty = true;
+
+    if (responseMapEnabled)
+        QMetaObject::invokeMethod(&responseMapTimer, "start", Qt::AutoConnection, Q_ARG(int, RESPONSE_MAP_DELAY_MSECS));
+}
+
+/**
+ * @brief Samples RESPONSE_MAP_ROWS_PER_STEP rows of the response map and
+ *     schedules the next rows, so a rebuild never blocks the input thread
+ *     for more than a fraction of a millisecond at a time. A property
+ *     change in between starts over.
+ */
+void JoyControlStick::buildResponseMapRows()
+{
+    if (responseMapDirty.exchange(false))
+        responseMapRow = 0;
+
+    if (!responseMapEnabled)
+        return;
+
+    // The circle adjustment stretches the max zone up to sqrt(2) times towards the diagonals.
+    int maxZoneHigh = static_cast<int>(ceil(maxZone * (((sqrt(2.0) - 1.0) * circle) + 1.0)));
+
+    responseMapRow = responseMap.rebuildRows(
+        [this](int axisXValue, int axisYValue) {
+            return static_cast<int>(calculateExactStickDirection(axisXValue, axisYValue));
+        },
+        [this](int axisXValue, int axisYValue) { return calculateExactDistanceFromDeadZone(axisXValue, axisYValue); },
+        deadZone, maxZone, maxZoneHigh, responseMapRow, RESPONSE_MAP_ROWS_PER_STEP);
+
+    if (responseMapRow < StickResponseMap::GRID_NODES)
+        responseMapTimer.start(0);
+}
+
+/**
+ * @brief Check whether lookups may be answered by the response map.
+ *     Lookups from other threads than the one owning the stick and
+ *     lookups while the map is stale use the exact calculation.
+ */
+bool JoyControlStick::useResponseMap()
+{
+    return responseMapEnabled && !responseMapDirty && (QThread::currentThread() == thread());
+}
@@ -21,9 +21,13 @@
 
 #include "joybuttontypes/joybutton.h"
 #include "joycontrolstickdirectionstype.h"
+#include "stickresponsemap.h"
 
 #include <QPointer>
 
+#include <array>
+#include <atomic>
+
 class JoyAxis;
 class JoyControlStickButton;
 class JoyControlStickModifierButton;
@@ -50,6 +54,9 @@ class JoyControlStick : public QObject, public JoyStickDirectionsType
         FourWayDiagonal
     };
 
+    typedef std::array<double, 9> DiagonalZoneAngles;
+    typedef std::array<int, 4> FourWayZoneAngles;
+
     void joyEvent(bool ignoresets = false); // JoyControlStickEvent class
     void setIndex(int index);
     void replaceXAxis(JoyAxis *axis);                 // JoyControlStickAxes class
@@ -62,6 +69,7 @@ class JoyControlStick : public QObject, public JoyStickDirectionsType
     void clearPendingEvent();            // JoyControlStickEvent class
 
     bool inDeadZone();
+    bool inDeadZone(int axisXValue, int axisYValue);
     bool hasSlotsAssigned();
     bool isRelativeSpring();
     bool hasPendingEvent(); // JoyControlStickEvent class
@@ -112,11 +120,12 @@ class JoyControlStick : public QObject, public JoyStickDirectionsType
     virtual QString getName(bool forceFullFormat = false, bool displayNames = false);
     virtual QString getPartialName(bool forceFullFormat = false, bool displayNames = false);
 
-    JoyStickDirections getCurrentDirection(); // JoyControlStickAxes class
+    JoyStickDirections getCurrentDirection();                                    // JoyControlStickAxes class
+    JoyStickDirections calculateStickDirection(int axisXValue, int axisYValue); // JoyControlStickAxes class
 
-    QList<double> getDiagonalZoneAngles();     // JoyControlStickAxes class
-    QList<int> getFourWayCardinalZoneAngles(); // JoyControlStickAxes class
-    QList<int> getFourWayDiagonalZoneAngles(); // JoyControlStickAxes class
+    DiagonalZoneAngles getDiagonalZoneAngles();       // JoyControlStickAxes class
+    FourWayZoneAngles getFourWayCardinalZoneAngles(); // JoyControlStickAxes class
+    FourWayZoneAngles getFourWayDiagonalZoneAngles(); // JoyControlStickAxes class
     QHash<JoyStickDirections, JoyControlStickButton *> *getButtons();
 
     JoyControlStickButton *getDirectionButton(JoyStickDirections direction); // JoyControlStickAxes class
@@ -128,6 +137,9 @@ class JoyControlStick : public QObject, public JoyStickDirectionsType
     void setJoyMode(JoyMode mode);
     JoyMode getJoyMode();
 
+    void setResponseMapEnabled(bool enabled);
+    bool isResponseMapEnabled();
+
     void setButtonsMouseMode(JoyButton::JoyMouseMovementMode mode);
     bool hasSameButtonsMouseMode();
     JoyButton::JoyMouseMovementMode getButtonsPresetMouseMode();
@@ -147,6 +159,7 @@ class JoyControlStick : public QObject, public JoyStickDirectionsType
 
     void setButtonsWheelSpeedX(int value);
     void setButtonsWheelSpeedY(int value);
+    void setButtonsAnalogWheel(bool enabled);
 
     void setButtonsExtraAccelerationStatus(bool enabled);
     bool getButtonsExtraAccelerationStatus();
@@ -187,11 +200,16 @@ class JoyControlStick : public QObject, public JoyStickDirectionsType
     virtual void writeConfig(QXmlStreamWriter *xml); // JoyControlStickXml class
 
     static const JoyMode DEFAULTMODE;
+    static const int RESPONSE_MAP_DELAY_MSECS;
+    static const int RESPONSE_MAP_ROWS_PER_STEP;
 
   protected:
     virtual void populateButtons();
 
     void createDeskEvent(bool ignoresets = false); // JoyControlStickEvent class
+    void selectEventVariant();
+    template <int variant> void processJoyEvent(bool ignoresets);
+    template <int variant> void processDeskEvent(bool ignoresets);
     void determineStandardModeEvent(JoyControlStickButton *&eventbutton1,
                                     JoyControlStickButton *&eventbutton2); // JoyControlStickEvent class
     void determineEightWayModeEvent(JoyControlStickButton *&eventbutton1, JoyControlStickButton *&eventbutton2,
@@ -217,7 +235,8 @@ class JoyControlStick : public QObject, public JoyStickDirectionsType
                                                                           int axisYValue); // JoyControlStickAxes class
 
     JoyControlStick::JoyStickDirections calculateStickDirection();                               // JoyControlStickAxes class
-    JoyControlStick::JoyStickDirections calculateStickDirection(int axisXValue, int axisYValue); // JoyControlStickAxes class
+    JoyControlStick::JoyStickDirections calculateExactStickDirection(int axisXValue, int axisYValue);
+    double calculateExactDistanceFromDeadZone(int axisXValue, int axisYValue);
 
     void performButtonPress(JoyControlStickButton *eventbutton, JoyControlStickButton *&activebutton, bool ignoresets);
     void performButtonRelease(JoyControlStickButton *&eventbutton, bool ignoresets);
@@ -273,6 +292,7 @@ class JoyControlStick : public QObject, public JoyStickDirectionsType
 
   private slots:
     void stickDirectionChangeEvent(); // JoyControlStickEvent class
+    void buildResponseMapRows();
 
   private:
     int originset;
@@ -286,6 +306,12 @@ class JoyControlStick : public QObject, public JoyStickDirectionsType
 
     double circle;
 
+    bool responseMapEnabled;
+    std::atomic<bool> responseMapDirty; ///< set from any thread when a property changed
+    int responseMapRow;                 ///< next row of responseMap to sample
+    StickResponseMap responseMap;       ///< only used and rebuilt on the input thread
+    QTimer responseMapTimer;
+
     bool isActive;
     bool safezone;
     bool pendingStickEvent;
@@ -304,11 +330,14 @@ class JoyControlStick : public QObject, public JoyStickDirectionsType
     QString defaultStickName;
 
     QTimer directionDelayTimer;
+    int eventVariant; ///< StickEventVariant chosen by selectEventVariant()
 
     QHash<JoyStickDirections, JoyControlStickButton *> buttons;
     JoyControlStickModifierButton *modifierButton;
 
     void populateStickBtns();
+    void invalidateResponseMap();
+    bool useResponseMap();
 };
 
 #endif // JOYCONTROLSTICK_H
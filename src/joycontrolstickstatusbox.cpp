@@ -128,7 +128,7 @@ void JoyControlStickStatusBox::drawEightWayBox()
     // Draw diagonal zones
     if (m_stick != nullptr)
     {
-        QList<double> anglesList = m_stick->getDiagonalZoneAngles();
+        JoyControlStick::DiagonalZoneAngles anglesList = m_stick->getDiagonalZoneAngles();
         int diagonalRange = m_stick->getDiagonalRange();
 
         penny.setWidth(0);
@@ -138,16 +138,16 @@ void JoyControlStickStatusBox::drawEightWayBox()
 
         painter.drawPie(-GlobalVariables::JoyAxis::AXISMAX, -GlobalVariables::JoyAxis::AXISMAX,
                         GlobalVariables::JoyAxis::AXISMAX * 2, GlobalVariables::JoyAxis::AXISMAX * 2,
-                        static_cast<int>(anglesList.value(2)) * 16, diagonalRange * 16);
+                        static_cast<int>(anglesList[2]) * 16, diagonalRange * 16);
         painter.drawPie(-GlobalVariables::JoyAxis::AXISMAX, -GlobalVariables::JoyAxis::AXISMAX,
                         GlobalVariables::JoyAxis::AXISMAX * 2, GlobalVariables::JoyAxis::AXISMAX * 2,
-                        static_cast<int>(anglesList.value(4)) * 16, diagonalRange * 16);
+                        static_cast<int>(anglesList[4]) * 16, diagonalRange * 16);
         painter.drawPie(-GlobalVariables::JoyAxis::AXISMAX, -GlobalVariables::JoyAxis::AXISMAX,
                         GlobalVariables::JoyAxis::AXISMAX * 2, GlobalVariables::JoyAxis::AXISMAX * 2,
-                        static_cast<int>(anglesList.value(6)) * 16, diagonalRange * 16);
+                        static_cast<int>(anglesList[6]) * 16, diagonalRange * 16);
         painter.drawPie(-GlobalVariables::JoyAxis::AXISMAX, -GlobalVariables::JoyAxis::AXISMAX,
                         GlobalVariables::JoyAxis::AXISMAX * 2, GlobalVariables::JoyAxis::AXISMAX * 2,
-                        static_cast<int>(anglesList.value(8)) * 16, diagonalRange * 16);
+                        static_cast<int>(anglesList[8]) * 16, diagonalRange * 16);
 
         // Draw modifier zone circle
         int modifierZone = m_stick->getModifierZone();
@@ -302,7 +302,7 @@ void JoyControlStickStatusBox::drawFourWayCardinalBox()
     if (m_stick != nullptr)
     {
         // Draw diagonal zones
-        QList<int> anglesList = m_stick->getFourWayCardinalZoneAngles();
+        JoyControlStick::FourWayZoneAngles anglesList = m_stick->getFourWayCardinalZoneAngles();
         penny.setWidth(0);
         penny.setColor(Qt::black);
         painter.setPen(penny);
@@ -311,10 +311,10 @@ void JoyControlStickStatusBox::drawFourWayCardinalBox()
 
         painter.drawPie(-GlobalVariables::JoyAxis::AXISMAX, -GlobalVariables::JoyAxis::AXISMAX,
                         GlobalVariables::JoyAxis::AXISMAX * 2, GlobalVariables::JoyAxis::AXISMAX * 2,
-                        anglesList.value(1) * 16, 90 * 16);
+                        anglesList[1] * 16, 90 * 16);
         painter.drawPie(-GlobalVariables::JoyAxis::AXISMAX, -GlobalVariables::JoyAxis::AXISMAX,
                         GlobalVariables::JoyAxis::AXISMAX * 2, GlobalVariables::JoyAxis::AXISMAX * 2,
-                        anglesList.value(3) * 16, 90 * 16);
+                        anglesList[3] * 16, 90 * 16);
 
         painter.setOpacity(1.0);
 
@@ -471,7 +471,7 @@ void JoyControlStickStatusBox::drawFourWayDiagonalBox()
     if (m_stick != nullptr)
     {
         // Draw diagonal zones
-        QList<int> anglesList = m_stick->getFourWayDiagonalZoneAngles();
+        JoyControlStick::FourWayZoneAngles anglesList = m_stick->getFourWayDiagonalZoneAngles();
         penny.setWidth(0);
         penny.setColor(Qt::black);
         painter.setPen(penny);
@@ -480,10 +480,10 @@ void JoyControlStickStatusBox::drawFourWayDiagonalBox()
 
         painter.drawPie(-GlobalVariables::JoyAxis::AXISMAX, -GlobalVariables::JoyAxis::AXISMAX,
                         GlobalVariables::JoyAxis::AXISMAX * 2, GlobalVariables::JoyAxis::AXISMAX * 2,
-                        anglesList.value(1) * 16, 90 * 16);
+                        anglesList[1] * 16, 90 * 16);
         painter.drawPie(-GlobalVariables::JoyAxis::AXISMAX, -GlobalVariables::JoyAxis::AXISMAX,
                         GlobalVariables::JoyAxis::AXISMAX * 2, GlobalVariables::JoyAxis::AXISMAX * 2,
-                        anglesList.value(3) * 16, 90 * 16);
+                        anglesList[3] * 16, 90 * 16);
 
         painter.setOpacity(1.0);
 
@@ -220,6 +220,28 @@ void JoyDPad::releaseButtonEvents()
     }
 }
 
+/**
+ * @brief Releases the dpad and restores the default settings of it and its buttons.
+ */
+void JoyDPad::reset()
+{
+    directionDelayTimer.stop();
+
+    QHashIterator<int, JoyDPadButton *> iter(buttons);
+    while (iter.hasNext())
+        iter.next().value()->reset();
+
+    activeDiagonalButton = nullptr;
+    prevDirection = JoyDPadButton::DpadCentered;
+    pendingDirection = prevDirection;
+    pendingEvent = false;
+    pendingEventDirection = prevDirection;
+    pendingIgnoreSets = false;
+    currentMode = StandardMode;
+    dpadDelay = GlobalVariables::JoyDPad::DEFAULTDPADDELAY;
+    dpadName.clear();
+}
+
 QHash<int, JoyDPadButton *> *JoyDPad::getButtons() { return &buttons; }
 
 bool JoyDPad::isDefault()
@@ -534,6 +556,16 @@ void JoyDPad::setButtonsWheelSpeedY(int value)
     }
 }
 
+void JoyDPad::setButtonsAnalogWheel(bool enabled)
+{
+    QHashIterator<int, JoyDPadButton *> iter(buttons);
+    while (iter.hasNext())
+    {
+        JoyDPadButton *button = iter.next().value();
+        button->setAnalogWheel(enabled);
+    }
+}
+
 void JoyDPad::setDefaultDPadName(QString tempname)
 {
     defaultDPadName = tempname;
@@ -55,6 +55,7 @@ class JoyDPad : public QObject
     JoyMode getJoyMode();
 
     void releaseButtonEvents(); // JoyDPadEvent class
+    void reset();
 
     void setButtonsMouseMode(JoyButton::JoyMouseMovementMode mode);
     bool hasSameButtonsMouseMode();
@@ -75,6 +76,7 @@ class JoyDPad : public QObject
 
     void setButtonsWheelSpeedX(int value);
     void setButtonsWheelSpeedY(int value);
+    void setButtonsAnalogWheel(bool enabled);
 
     const QString getDpadName();
     const QString getDefaultDpadName();
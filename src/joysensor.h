@@ -78,11 +78,11 @@ class JoySensor : public QObject
     double calculateZDistanceFromDeadZone(double x, double y, double z) const;
     double calculateDistance() const;
     double calculateDistance(double x, double y, double z) const;
-    double calculatePitch() const;
+    virtual double calculatePitch() const;
     double calculatePitch(double x, double y, double z) const;
-    double calculateRoll() const;
+    virtual double calculateRoll() const;
     double calculateRoll(double x, double y, double z) const;
-    double calculateDirectionalDistance(JoySensorDirection direction) const;
+    virtual double calculateDirectionalDistance(JoySensorDirection direction) const;
 
     static double radToDeg(double value);
     static double degToRad(double value);
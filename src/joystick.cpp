@@ -35,12 +35,8 @@ Joystick::Joystick(SDL_Joystick *joyhandle, int deviceIndex, AntiMicroSettings *
     controller = SDL_GameControllerOpen(deviceIndex);
     joystickID = SDL_JoystickInstanceID(joyhandle);
 
-    for (int i = 0; i < GlobalVariables::InputDevice::NUMBER_JOYSETS; i++)
-    {
-        SetJoystick *setstick = new SetJoystick(this, i, this);
-        getJoystick_sets().insert(i, setstick);
-        enableSetConnections(setstick);
-    }
+    // Only the first set exists up front, the others are created on first use.
+    getSetJoystick(0);
     INFO() << "Created new Joystick:\n" << getDescription();
 }
 
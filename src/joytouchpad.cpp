@@ -0,0 +1,401 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "joytouchpad.h"
+
+#include "eventhandlerfactory.h"
+#include "eventhandlers/baseeventhandler.h"
+#include "globalvariables.h"
+#include "inputdevice.h"
+#include "joybuttontypes/joytouchpadbutton.h"
+#include "setjoystick.h"
+
+JoyTouchpad::JoyTouchpad(int index, int originset, SetJoystick *parentSet, QObject *parent)
+    : QObject(parent)
+    , m_index(index)
+    , m_zone_state(0)
+    , m_parent_set(parentSet)
+{
+    for (int i = 0; i < ZONE_COUNT; i++)
+        m_buttons.insert(i, new JoyTouchpadButton(this, i, originset, parentSet, this));
+
+    reset();
+}
+
+JoyTouchpad::~JoyTouchpad() {}
+
+/**
+ * @brief Processes a finger report of the touchpad.
+ *  Coordinates are normalized to 0.0 - 1.0 with the origin in the top left corner.
+ *  The resulting movement is collected until activatePendingEvent is called.
+ */
+void JoyTouchpad::touchEvent(int finger, bool down, float x, float y)
+{
+    if ((finger < 0) || (finger >= MAX_FINGERS))
+        return;
+
+    Finger &current = m_fingers[finger];
+
+    // Fingers which were already down when this set got activated
+    // have no previous position and only start moving with the next report.
+    if (down && current.down && m_mouse_enabled)
+    {
+        double dx = x - current.x;
+        double dy = y - current.y;
+        int count = fingersDown();
+
+        if (count == 1)
+        {
+            m_pending_x += dx * m_mouse_speed_x;
+            m_pending_y += dy * m_mouse_speed_y;
+        } else if (m_scroll_enabled)
+        {
+            // Every finger contributes its share, two fingers moving together scroll as far as one would.
+            double units = m_scroll_speed * BaseEventHandler::WHEEL_UNITS_PER_NOTCH / count;
+            m_pending_scroll_vertical -= dy * units;
+            m_pending_scroll_horizontal += dx * units;
+        }
+    }
+
+    current.down = down;
+    current.x = x;
+    current.y = y;
+
+    int zones = 0;
+
+    for (const Finger &temp : m_fingers)
+    {
+        if (temp.down)
+            zones |= 1 << zoneAt(temp.x, temp.y);
+    }
+
+    m_pending_zone_state = zones;
+    m_pending_event = true;
+}
+
+bool JoyTouchpad::hasPendingEvent() const { return m_pending_event; }
+
+/**
+ * @brief Sends the whole pixels and wheel units collected since the last call
+ *  and updates the zone buttons. Fractions are kept for the next report.
+ */
+void JoyTouchpad::activatePendingEvent()
+{
+    if (!m_pending_event)
+        return;
+
+    int moveX = static_cast<int>(m_pending_x);
+    int moveY = static_cast<int>(m_pending_y);
+    int scrollVertical = static_cast<int>(m_pending_scroll_vertical);
+    int scrollHorizontal = static_cast<int>(m_pending_scroll_horizontal);
+    BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+
+    if (handler != nullptr)
+    {
+        InputDevice *device = (m_parent_set != nullptr) ? m_parent_set->getInputDevice() : nullptr;
+
+        if ((moveX != 0) || (moveY != 0))
+            handler->sendPlayerMouseEvent(device, moveX, moveY);
+
+        if ((scrollVertical != 0) || (scrollHorizontal != 0))
+            handler->sendPlayerMouseWheelEvent(device, scrollVertical, scrollHorizontal);
+    }
+
+    m_pending_x -= moveX;
+    m_pending_y -= moveY;
+    m_pending_scroll_vertical -= scrollVertical;
+    m_pending_scroll_horizontal -= scrollHorizontal;
+
+    int changed = m_zone_state ^ m_pending_zone_state;
+    m_zone_state = m_pending_zone_state;
+
+    for (int i = 0; i < ZONE_COUNT; i++)
+    {
+        JoyTouchpadButton *button = m_buttons.value(i);
+
+        if ((changed & (1 << i)) && (button != nullptr))
+            button->joyEvent(m_zone_state & (1 << i));
+    }
+
+    m_pending_event = false;
+}
+
+void JoyTouchpad::clearPendingEvent()
+{
+    m_pending_event = false;
+    m_pending_zone_state = m_zone_state;
+    m_pending_x = 0.0;
+    m_pending_y = 0.0;
+    m_pending_scroll_vertical = 0.0;
+    m_pending_scroll_horizontal = 0.0;
+}
+
+/**
+ * @brief Forgets all fingers and releases the zone buttons.
+ *  Used when the set gets deactivated.
+ */
+void JoyTouchpad::release()
+{
+    for (Finger &finger : m_fingers)
+        finger = Finger();
+
+    m_zone_state = 0;
+    clearPendingEvent();
+
+    for (const auto &button : m_buttons)
+    {
+        button->clearPendingEvent();
+        button->joyEvent(false, true);
+        button->eventReset();
+    }
+}
+
+/**
+ * @brief Copy slots from all zone buttons and properties from a touchpad
+ *     onto another.
+ * @param JoyTouchpad object to be modified.
+ */
+void JoyTouchpad::copyAssignments(JoyTouchpad *destTouchpad)
+{
+    destTouchpad->reset();
+    destTouchpad->m_touchpad_name = m_touchpad_name;
+    destTouchpad->m_mouse_enabled = m_mouse_enabled;
+    destTouchpad->m_scroll_enabled = m_scroll_enabled;
+    destTouchpad->m_mouse_speed_x = m_mouse_speed_x;
+    destTouchpad->m_mouse_speed_y = m_mouse_speed_y;
+    destTouchpad->m_scroll_speed = m_scroll_speed;
+
+    for (auto iter = m_buttons.cbegin(); iter != m_buttons.cend(); ++iter)
+    {
+        JoyTouchpadButton *destButton = destTouchpad->m_buttons.value(iter.key());
+
+        if (destButton != nullptr)
+            iter.value()->copyAssignments(destButton);
+    }
+
+    if (!destTouchpad->isDefault())
+        emit propertyUpdated();
+}
+
+/**
+ * @brief Check if any zone is mapped to a keyboard or mouse event
+ * @returns True if a mapping exists, false otherwise
+ */
+bool JoyTouchpad::hasSlotsAssigned() const
+{
+    for (const auto &button : m_buttons)
+    {
+        if (button->getAssignedSlots()->count() > 0)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Checks if all touchpad settings and zone mappings are at their default values.
+ *  This is used during XML serialization to skip unnecessary objects.
+ */
+bool JoyTouchpad::isDefault() const
+{
+    bool value = !m_mouse_enabled && m_scroll_enabled && m_touchpad_name.isEmpty();
+    value = value && qFuzzyCompare(m_mouse_speed_x, GlobalVariables::JoyTouchpad::DEFAULTMOUSESPEEDX);
+    value = value && qFuzzyCompare(m_mouse_speed_y, GlobalVariables::JoyTouchpad::DEFAULTMOUSESPEEDY);
+    value = value && qFuzzyCompare(m_scroll_speed, GlobalVariables::JoyTouchpad::DEFAULTSCROLLSPEED);
+
+    for (const auto &button : m_buttons)
+        value = value && button->isDefault();
+
+    return value;
+}
+
+/**
+ * @brief Get the 0 indexed number of the touchpad
+ */
+int JoyTouchpad::getIndex() const { return m_index; }
+
+/**
+ * @brief Get the 1 indexed number of the touchpad used in profiles
+ */
+int JoyTouchpad::getRealJoyNumber() const { return m_index + 1; }
+
+/**
+ * @brief Get the name of this touchpad
+ * @returns Touchpad name
+ */
+QString JoyTouchpad::getPartialName(bool forceFullFormat, bool displayNames) const
+{
+    QString label = QString();
+
+    if (!m_touchpad_name.isEmpty() && displayNames)
+    {
+        if (forceFullFormat)
+            label.append(tr("Touchpad")).append(" ");
+
+        label.append(m_touchpad_name);
+    } else
+    {
+        label.append(tr("Touchpad")).append(" ").append(QString::number(getRealJoyNumber()));
+    }
+
+    return label;
+}
+
+QString JoyTouchpad::getTouchpadName() const { return m_touchpad_name; }
+
+bool JoyTouchpad::isMouseEnabled() const { return m_mouse_enabled; }
+
+bool JoyTouchpad::isScrollEnabled() const { return m_scroll_enabled; }
+
+double JoyTouchpad::getMouseSpeedX() const { return m_mouse_speed_x; }
+
+double JoyTouchpad::getMouseSpeedY() const { return m_mouse_speed_y; }
+
+double JoyTouchpad::getScrollSpeed() const { return m_scroll_speed; }
+
+QHash<int, JoyTouchpadButton *> *JoyTouchpad::getButtons() { return &m_buttons; }
+
+JoyTouchpadButton *JoyTouchpad::getZoneButton(TouchpadZone zone) const { return m_buttons.value(zone); }
+
+/**
+ * @brief Get pointer to the set that a touchpad belongs to.
+ */
+SetJoystick *JoyTouchpad::getParentSet() const { return m_parent_set; }
+
+/**
+ * @brief Resets internal variables and zone buttons back to default
+ */
+void JoyTouchpad::reset()
+{
+    m_touchpad_name.clear();
+    m_mouse_enabled = false;
+    m_scroll_enabled = true;
+    m_mouse_speed_x = GlobalVariables::JoyTouchpad::DEFAULTMOUSESPEEDX;
+    m_mouse_speed_y = GlobalVariables::JoyTouchpad::DEFAULTMOUSESPEEDY;
+    m_scroll_speed = GlobalVariables::JoyTouchpad::DEFAULTSCROLLSPEED;
+
+    for (Finger &finger : m_fingers)
+        finger = Finger();
+
+    m_zone_state = 0;
+    clearPendingEvent();
+
+    for (const auto &button : m_buttons)
+        button->reset();
+}
+
+/**
+ * @brief Moves the cursor with one finger and scrolls with two fingers.
+ */
+void JoyTouchpad::setMouseEnabled(bool enabled)
+{
+    if (enabled != m_mouse_enabled)
+    {
+        m_mouse_enabled = enabled;
+        emit propertyUpdated();
+    }
+}
+
+/**
+ * @brief Allows scrolling with two fingers while the cursor is controlled by the touchpad.
+ */
+void JoyTouchpad::setScrollEnabled(bool enabled)
+{
+    if (enabled != m_scroll_enabled)
+    {
+        m_scroll_enabled = enabled;
+        emit propertyUpdated();
+    }
+}
+
+/**
+ * @brief Sets the pixels the cursor moves for a swipe over the whole width of the touchpad
+ */
+void JoyTouchpad::setMouseSpeedX(double value)
+{
+    if ((value > 0.0) && !qFuzzyCompare(value, m_mouse_speed_x))
+    {
+        m_mouse_speed_x = value;
+        emit propertyUpdated();
+    }
+}
+
+/**
+ * @brief Sets the pixels the cursor moves for a swipe over the whole height of the touchpad
+ */
+void JoyTouchpad::setMouseSpeedY(double value)
+{
+    if ((value > 0.0) && !qFuzzyCompare(value, m_mouse_speed_y))
+    {
+        m_mouse_speed_y = value;
+        emit propertyUpdated();
+    }
+}
+
+/**
+ * @brief Sets the wheel notches scrolled for a swipe over the whole touchpad
+ */
+void JoyTouchpad::setScrollSpeed(double value)
+{
+    if ((value > 0.0) && !qFuzzyCompare(value, m_scroll_speed))
+    {
+        m_scroll_speed = value;
+        emit propertyUpdated();
+    }
+}
+
+/**
+ * @brief Sets the name of this touchpad
+ * @param[in] tempName New touchpad name
+ */
+void JoyTouchpad::setTouchpadName(QString tempName)
+{
+    if ((tempName.length() <= 20) && (tempName != m_touchpad_name))
+    {
+        m_touchpad_name = tempName;
+        emit touchpadNameChanged();
+        emit propertyUpdated();
+    }
+}
+
+void JoyTouchpad::establishPropertyUpdatedConnection()
+{
+    connect(this, &JoyTouchpad::propertyUpdated, getParentSet()->getInputDevice(), &InputDevice::profileEdited);
+}
+
+/**
+ * @brief Zone below the given normalized position
+ */
+int JoyTouchpad::zoneAt(float x, float y)
+{
+    int column = (x >= 0.5f) ? 1 : 0;
+    int row = (y >= 0.5f) ? 1 : 0;
+
+    return row * 2 + column;
+}
+
+int JoyTouchpad::fingersDown() const
+{
+    int count = 0;
+
+    for (const Finger &finger : m_fingers)
+    {
+        if (finger.down)
+            count++;
+    }
+
+    return count;
+}
@@ -0,0 +1,129 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JOYTOUCHPAD_H
+#define JOYTOUCHPAD_H
+
+#include <QHash>
+#include <QObject>
+
+class SetJoystick;
+class JoyTouchpadButton;
+
+/**
+ * @brief Represents one touchpad of a controller in a SetJoystick.
+ *
+ * In trackpad mode, the motion of a single finger moves the cursor and the
+ * motion of two fingers scrolls. Both are sent directly at the report rate of
+ * the touchpad, fractions of pixels and wheel notches are carried over to the
+ * next report. Independently of that, each quarter of the touchpad acts as a
+ * button while a finger rests on it.
+ */
+class JoyTouchpad : public QObject
+{
+    Q_OBJECT
+
+  public:
+    enum TouchpadZone
+    {
+        ZoneTopLeft = 0,
+        ZoneTopRight,
+        ZoneBottomLeft,
+        ZoneBottomRight,
+        ZONE_COUNT
+    };
+
+    static const int MAX_FINGERS = 2;
+
+    explicit JoyTouchpad(int index, int originset, SetJoystick *parentSet, QObject *parent);
+    ~JoyTouchpad();
+
+    void touchEvent(int finger, bool down, float x, float y);
+    bool hasPendingEvent() const;
+    void activatePendingEvent();
+    void clearPendingEvent();
+    void release();
+
+    void copyAssignments(JoyTouchpad *destTouchpad);
+    bool hasSlotsAssigned() const;
+    bool isDefault() const;
+
+    int getIndex() const;
+    int getRealJoyNumber() const;
+    QString getPartialName(bool forceFullFormat = false, bool displayNames = false) const;
+    QString getTouchpadName() const;
+
+    bool isMouseEnabled() const;
+    bool isScrollEnabled() const;
+    double getMouseSpeedX() const;
+    double getMouseSpeedY() const;
+    double getScrollSpeed() const;
+
+    QHash<int, JoyTouchpadButton *> *getButtons();
+    JoyTouchpadButton *getZoneButton(TouchpadZone zone) const;
+    SetJoystick *getParentSet() const;
+
+  signals:
+    void touchpadNameChanged();
+    void propertyUpdated();
+
+  public slots:
+    void reset();
+    void setMouseEnabled(bool enabled);
+    void setScrollEnabled(bool enabled);
+    void setMouseSpeedX(double value);
+    void setMouseSpeedY(double value);
+    void setScrollSpeed(double value);
+    void setTouchpadName(QString tempName);
+    void establishPropertyUpdatedConnection();
+
+  private:
+    struct Finger
+    {
+        bool down = false;
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+    static int zoneAt(float x, float y);
+    int fingersDown() const;
+
+    int m_index;
+    QString m_touchpad_name;
+
+    bool m_mouse_enabled;
+    bool m_scroll_enabled;
+    double m_mouse_speed_x;
+    double m_mouse_speed_y;
+    double m_scroll_speed;
+
+    Finger m_fingers[MAX_FINGERS];
+    int m_zone_state;
+    int m_pending_zone_state;
+    bool m_pending_event;
+
+    // Accumulated movement in pixels and wheel units including the fractions
+    // which could not be sent yet.
+    double m_pending_x;
+    double m_pending_y;
+    double m_pending_scroll_vertical;
+    double m_pending_scroll_horizontal;
+
+    SetJoystick *m_parent_set;
+    QHash<int, JoyTouchpadButton *> m_buttons;
+};
+
+#endif // JOYTOUCHPAD_H
@@ -19,15 +19,29 @@
 #include "localantimicroserver.h"
 
 #include "common.h"
+#include "globalvariables.h"
+#include "inputdevice.h"
+#include "inputstatistics.h"
+#include "logger.h"
 
+#include <QDateTime>
 #include <QDebug>
+#include <QFileInfo>
 #include <QLocalServer>
 #include <QLocalSocket>
 
-LocalAntiMicroServer::LocalAntiMicroServer(QObject *parent)
+#include <cstdlib>
+
+LocalAntiMicroServer::LocalAntiMicroServer(QMap<SDL_JoystickID, InputDevice *> *joysticks, AntiMicroSettings *settings,
+                                           QObject *parent)
     : QObject(parent)
+    , m_joysticks(joysticks)
+    , m_settings(settings)
 {
     localServer = new QLocalServer(this);
+
+    statsTimer.setTimerType(Qt::CoarseTimer);
+    connect(&statsTimer, &QTimer::timeout, this, &LocalAntiMicroServer::broadcastStats);
 }
 
 void LocalAntiMicroServer::startLocalServer()
@@ -39,9 +53,6 @@ void LocalAntiMicroServer::startLocalServer()
         if (!removedServer)
             qDebug() << "Couldn't remove local server named " << PadderCommon::localSocketKey;
 
-        if (localServer->maxPendingConnections() != 1)
-            localServer->setMaxPendingConnections(1);
-
         if (!localServer->isListening())
         {
             if (!localServer->listen(PadderCommon::localSocketKey))
@@ -66,44 +77,421 @@ void LocalAntiMicroServer::handleOutsideConnection()
 {
     if (localServer != nullptr)
     {
-        QLocalSocket *socket = localServer->nextPendingConnection();
+        // A single newConnection notification can cover several queued clients.
+        while (localServer->hasPendingConnections())
+        {
+            QLocalSocket *socket = localServer->nextPendingConnection();
+
+            if (socket != nullptr)
+            {
+                qDebug() << "There is next pending connection: " << socket->socketDescriptor();
+                connect(socket, &QLocalSocket::readyRead, this, &LocalAntiMicroServer::readClientCommands);
+                connect(socket, &QLocalSocket::disconnected, this, &LocalAntiMicroServer::handleSocketDisconnect);
+                connect(socket, &QLocalSocket::disconnected, socket, &QLocalSocket::deleteLater);
+
+                // Data may already be buffered if the client wrote before we accepted it.
+                if (socket->bytesAvailable() > 0)
+                    QMetaObject::invokeMethod(this, "readClientCommands", Qt::QueuedConnection);
+            } else
+            {
+                qDebug() << "There isn't next pending connection: ";
+            }
+        }
+    } else
+    {
+        qDebug() << "LocalAntiMicroXServer::handleOutsideConnection(): localServer is nullptr";
+    }
+}
+
+void LocalAntiMicroServer::handleSocketDisconnect()
+{
+    QLocalSocket *socket = qobject_cast<QLocalSocket *>(sender());
+
+    if (socket != nullptr)
+    {
+        statsSubscribers.remove(socket);
+        statsLastSent.remove(socket);
+        updateStatsTimer();
+
+        // Clients speaking the command protocol got their answer already.
+        // Only legacy instances, which store their changes in the settings
+        // file before disconnecting, require the configuration to be re-read.
+        if (socket->property("commandClient").toBool())
+            return;
+    }
+
+    emit clientdisconnect();
+}
+
+void LocalAntiMicroServer::close()
+{
+    statsTimer.stop();
+    statsSubscribers.clear();
+    statsLastSent.clear();
+    localServer->close();
+}
+
+void LocalAntiMicroServer::readClientCommands()
+{
+    QList<QLocalSocket *> sockets;
+    QLocalSocket *senderSocket = qobject_cast<QLocalSocket *>(sender());
+
+    if (senderSocket != nullptr)
+        sockets.append(senderSocket);
+    else
+        sockets = localServer->findChildren<QLocalSocket *>();
+
+    for (QLocalSocket *socket : sockets)
+    {
+        while (socket->canReadLine())
+        {
+            QByteArray data = socket->readLine(MAX_COMMAND_LENGTH);
+
+            if (!data.endsWith('\n'))
+            {
+                // canReadLine() guarantees the newline is buffered already,
+                // so the rest of the oversized line can be skipped right away.
+                while (!data.isEmpty() && !data.endsWith('\n'))
+                    data = socket->readLine(MAX_COMMAND_LENGTH);
+
+                WARN() << "Ignoring oversized command of local client";
+                replyError(socket, "command too long");
+                continue;
+            }
+
+            QString line = QString::fromUtf8(data).trimmed();
+
+            if (!line.isEmpty())
+                processCommand(socket, line);
+        }
+
+        if (socket->bytesAvailable() > MAX_COMMAND_LENGTH)
+        {
+            WARN() << "Dropping local client with oversized command";
+            replyError(socket, "command too long");
+            socket->disconnectFromServer();
+        } else if (socket->bytesAvailable() > 0 && !socket->property("commandClient").toBool())
+        {
+            // Older instances send a bare command without terminating newline.
+            QString line = QString::fromUtf8(socket->peek(MAX_COMMAND_LENGTH)).trimmed();
+
+            if (line == PadderCommon::unhideCommand)
+            {
+                socket->readAll();
+                DEBUG() << "Showing hidden window because of external request";
+                emit showHiddenWindow();
+            }
+        }
+    }
+}
+
+void LocalAntiMicroServer::processCommand(QLocalSocket *socket, const QString &line)
+{
+    DEBUG() << "Received external message:" << line;
+
+    QStringList args = PadderCommon::parseArgumentsString(line);
+
+    if (args.isEmpty())
+        return;
+
+    const QString command = args.takeFirst().toLower();
+
+    if (command == PadderCommon::unhideCommand.toLower() || command == "show")
+    {
+        DEBUG() << "Showing hidden window because of external request";
+        emit showHiddenWindow();
+        socket->setProperty("commandClient", true);
+        replyOk(socket);
+        return;
+    }
 
-        if (socket != nullptr)
+    socket->setProperty("commandClient", true);
+
+    if (command == "state")
+    {
+        writeLines(socket, stateReport());
+        replyOk(socket);
+    } else if (command == "quit")
+    {
+        INFO() << "Quitting because of external request";
+        replyOk(socket);
+        socket->flush();
+        emit quitRequested();
+    } else if (command == "stats")
+    {
+        if (!args.isEmpty() && args.first().toLower() == "off")
+        {
+            statsSubscribers.remove(socket);
+            statsLastSent.remove(socket);
+        } else if (!args.isEmpty() && args.first().toLower() == "once")
         {
-            qDebug() << "There is next pending connection: " << socket->socketDescriptor();
-            connect(socket, &QLocalSocket::disconnected, this, &LocalAntiMicroServer::handleSocketDisconnect);
-            connect(socket, &QLocalSocket::disconnected, socket, &QLocalSocket::deleteLater);
-            checkForMessages(socket);
+            writeLines(socket, statsReport());
+            replyOk(socket);
+            return;
         } else
         {
-            qDebug() << "There isn't next pending connection: ";
+            bool validInterval = true;
+            int interval = args.isEmpty() ? DEFAULT_STATS_INTERVAL : args.first().toInt(&validInterval);
+
+            if (!validInterval || interval < MIN_STATS_INTERVAL)
+            {
+                replyError(socket, QString("stats interval must be at least %1 ms").arg(MIN_STATS_INTERVAL));
+                return;
+            }
+
+            statsSubscribers.insert(socket, interval);
+            statsLastSent.insert(socket, 0);
+        }
+
+        updateStatsTimer();
+        replyOk(socket);
+    } else if (command == "load" || command == "unload" || command == "switch" || command == "set")
+    {
+        QList<InputDevice *> devices;
+
+        if (args.isEmpty() || !resolveDevices(args.first(), devices))
+        {
+            replyError(socket, "unknown controller");
+            return;
         }
+
+        const QString argument = args.mid(1).join(" ");
+
+        if (command == "unload")
+        {
+            for (InputDevice *device : devices)
+                emit unloadProfileRequested(device);
+        } else if (command == "load")
+        {
+            QFileInfo fileInfo(argument);
+
+            if (argument.isEmpty() || !fileInfo.exists() ||
+                ((fileInfo.suffix() != "amgp") && (fileInfo.suffix() != "xml")))
+            {
+                replyError(socket, "profile file does not exist");
+                return;
+            }
+
+            for (InputDevice *device : devices)
+                emit loadProfileRequested(device, fileInfo.absoluteFilePath());
+        } else if (command == "switch")
+        {
+            if (argument.isEmpty())
+            {
+                replyError(socket, "missing profile name");
+                return;
+            }
+
+            for (InputDevice *device : devices)
+                emit switchProfileRequested(device, argument);
+        } else
+        {
+            bool validSet = false;
+            int setNumber = argument.toInt(&validSet);
+
+            if (!validSet || (setNumber < 1) || (setNumber > GlobalVariables::InputDevice::NUMBER_JOYSETS))
+            {
+                replyError(socket, QString("set number must be between 1 and %1")
+                                       .arg(GlobalVariables::InputDevice::NUMBER_JOYSETS));
+                return;
+            }
+
+            for (InputDevice *device : devices)
+                emit changeSetRequested(device, setNumber - 1);
+        }
+
+        replyOk(socket);
     } else
     {
-        qDebug() << "LocalAntiMicroXServer::handleOutsideConnection(): localServer is nullptr";
+        replyError(socket, QString("unknown command %1").arg(command));
     }
 }
 
-void LocalAntiMicroServer::handleSocketDisconnect() { emit clientdisconnect(); }
+bool LocalAntiMicroServer::resolveDevices(const QString &controller, QList<InputDevice *> &devices) const
+{
+    if (m_joysticks == nullptr)
+        return false;
 
-void LocalAntiMicroServer::close() { localServer->close(); }
+    bool isIndex = false;
+    int index = controller.toInt(&isIndex);
+    bool allDevices = (controller.toLower() == "all") || (isIndex && index == 0);
 
-void LocalAntiMicroServer::checkForMessages(QLocalSocket *socket)
+    for (InputDevice *device : *m_joysticks)
+    {
+        if (device == nullptr)
+            continue;
+
+        if (allDevices || (isIndex && device->getRealJoyNumber() == index) ||
+            (!isIndex && device->getStringIdentifier() == controller))
+        {
+            devices.append(device);
+        }
+    }
+
+    return !devices.isEmpty();
+}
+
+/**
+ * @brief Describe every connected controller, one line per device.
+ * Fields are space separated key=value pairs, values containing spaces are quoted.
+ */
+QStringList LocalAntiMicroServer::stateReport() const
 {
-    DEBUG() << "Waiting for message";
-    socket->waitForConnected(50);
-    bool result = socket->waitForReadyRead(200);
-    DEBUG() << "Waiting for message ended with result: " << (result ? "true" : "false");
-    if (result)
+    QStringList lines;
+
+    if (m_joysticks == nullptr)
+        return lines;
+
+    for (InputDevice *device : *m_joysticks)
     {
-        QString msg = QString(socket->readLine(30));
-        DEBUG() << "Received external message:" << msg;
-        if (msg == PadderCommon::unhideCommand)
+        if (device == nullptr)
+            continue;
+
+        QString profileFile = QString();
+
+        if (m_settings != nullptr)
         {
-            DEBUG() << "Showing hidden window because of external request";
-            emit showHiddenWindow();
+            m_settings->getLock()->lock();
+            profileFile =
+                m_settings->value(QString("Controllers/Controller%1LastSelected").arg(device->getStringIdentifier()))
+                    .toString();
+            m_settings->getLock()->unlock();
         }
+
+        lines.append(QString("device %1 id=\"%2\" name=\"%3\" set=%4 profile=\"%5\" file=\"%6\"")
+                         .arg(device->getRealJoyNumber())
+                         .arg(device->getStringIdentifier(), device->getSDLName())
+                         .arg(device->getActiveSetNumber() + 1)
+                         .arg(device->getProfileName(), profileFile));
     }
+
+    return lines;
+}
+
+/**
+ * @brief State of every controller followed by the input statistics,
+ *  every line prefixed with "stats" and terminated by "stats end".
+ */
+QStringList LocalAntiMicroServer::statsReport() const
+{
+    QStringList report;
+
+    for (const QString &line : stateReport() + InputStatistics::reportLines(m_joysticks))
+        report.append(QString("stats %1").arg(line));
+
+    report.append("stats end");
+    return report;
+}
+
+/**
+ * @brief Client side of the protocol. Sends a single command over a connected
+ *  socket and collects the reply lines up to the final "OK" or "ERR <reason>".
+ * @returns true if the command was answered with "OK".
+ */
+bool LocalAntiMicroServer::sendCommand(QLocalSocket *socket, const QString &command, QStringList &reply, int timeout)
+{
+    socket->write(command.toUtf8().append('\n'));
+
+    if (!socket->waitForBytesWritten(timeout))
+        return false;
+
+    while (true)
+    {
+        while (socket->canReadLine())
+        {
+            QString line = QString::fromUtf8(socket->readLine()).trimmed();
+
+            if (line == "OK")
+                return true;
+
+            reply.append(line);
+
+            if (line.startsWith("ERR"))
+                return false;
+        }
+
+        if (!socket->waitForReadyRead(timeout))
+            return false;
+    }
+}
+
+/**
+ * @brief Prints the input statistics of the instance connected to socket for --stats.
+ * @return Exit code of the requesting process.
+ */
+int LocalAntiMicroServer::printInstanceStatistics(QLocalSocket *socket)
+{
+    if (socket->state() != QLocalSocket::ConnectedState)
+    {
+        PRINT_STDERR() << "AntiMicroX is not running, no statistics available.\n";
+        return EXIT_FAILURE;
+    }
+
+    QStringList reply;
+    bool success = sendCommand(socket, "stats once", reply);
+
+    for (const QString &line : reply)
+        PRINT_STDOUT() << line << "\n";
+
+    socket->disconnectFromServer();
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+void LocalAntiMicroServer::broadcastStats()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    QStringList report;
+
+    for (auto iter = statsSubscribers.constBegin(); iter != statsSubscribers.constEnd(); ++iter)
+    {
+        QLocalSocket *socket = iter.key();
+
+        if ((now - statsLastSent.value(socket)) < iter.value())
+            continue;
+
+        // Build the report lazily and share it between subscribers due in this tick.
+        if (report.isEmpty())
+            report = statsReport();
+
+        statsLastSent.insert(socket, now);
+        writeLines(socket, report);
+    }
+}
+
+void LocalAntiMicroServer::updateStatsTimer()
+{
+    if (statsSubscribers.isEmpty())
+    {
+        statsTimer.stop();
+        return;
+    }
+
+    int interval = statsSubscribers.constBegin().value();
+
+    for (int subscriberInterval : statsSubscribers)
+        interval = qMin(interval, subscriberInterval);
+
+    if (!statsTimer.isActive() || statsTimer.interval() != interval)
+        statsTimer.start(interval);
+}
+
+void LocalAntiMicroServer::writeLines(QLocalSocket *socket, const QStringList &lines)
+{
+    QByteArray data;
+
+    for (const QString &line : lines)
+        data.append(line.toUtf8()).append('\n');
+
+    // Buffered write, flushed by the event loop once the socket is writable.
+    if (socket->state() == QLocalSocket::ConnectedState)
+        socket->write(data);
+}
+
+void LocalAntiMicroServer::replyOk(QLocalSocket *socket) { writeLines(socket, QStringList("OK")); }
+
+void LocalAntiMicroServer::replyError(QLocalSocket *socket, const QString &reason)
+{
+    writeLines(socket, QStringList(QString("ERR %1").arg(reason)));
 }
 
 QLocalServer *LocalAntiMicroServer::getLocalServer() const { return localServer; }
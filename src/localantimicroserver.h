@@ -20,25 +20,61 @@
 #define LOCALANTIMICROSERVER_H
 
 #include <QLocalSocket>
+#include <QMap>
 #include <QObject>
+#include <QTimer>
+
+#include <SDL2/SDL_joystick.h>
 
 class QLocalServer;
+class InputDevice;
+class AntiMicroSettings;
 
 /**
  * @brief Class used for checking presence of other AntiMicroX instances and communicating with them.
+ *
+ * Clients talk to the server using a newline-delimited text protocol.
+ * Every command is answered with one or more lines, the last of them being
+ * either "OK" or "ERR <reason>". Sockets are served purely from readyRead
+ * notifications so the event loop is never blocked by a slow client.
+ *
+ * Supported commands (controller is a 1-based index, a unique identifier or "all"):
+ *   unhideWindow / show
+ *   load <controller> <profile file>
+ *   unload <controller>
+ *   switch <controller> <profile name>
+ *   set <controller> <set number 1-16>
+ *   state
+ *   stats [interval in ms | once | off]
+ *   quit
  */
 class LocalAntiMicroServer : public QObject
 {
     Q_OBJECT
 
   public:
-    explicit LocalAntiMicroServer(QObject *parent = nullptr);
+    explicit LocalAntiMicroServer(QMap<SDL_JoystickID, InputDevice *> *joysticks = nullptr,
+                                  AntiMicroSettings *settings = nullptr, QObject *parent = nullptr);
 
     QLocalServer *getLocalServer() const;
+    QStringList stateReport() const;
+    QStringList statsReport() const;
+
+    static bool sendCommand(QLocalSocket *socket, const QString &command, QStringList &reply, int timeout = 3000);
+    static int printInstanceStatistics(QLocalSocket *socket);
+
+    static const int MAX_COMMAND_LENGTH = 4096;
+    static const int DEFAULT_STATS_INTERVAL = 1000;
+    static const int MIN_STATS_INTERVAL = 50;
 
   signals:
     void clientdisconnect();
     void showHiddenWindow();
+    void loadProfileRequested(InputDevice *device, QString fileLocation);
+    void unloadProfileRequested(InputDevice *device);
+    void switchProfileRequested(InputDevice *device, QString profileName);
+    void changeSetRequested(InputDevice *device, int setIndex);
+    void quitRequested();
 
   public slots:
     void startLocalServer();
@@ -46,10 +82,24 @@ class LocalAntiMicroServer : public QObject
     void handleSocketDisconnect();
     void close();
 
+  private slots:
+    void readClientCommands();
+    void broadcastStats();
+
   private:
-    void checkForMessages(QLocalSocket *socket);
+    void processCommand(QLocalSocket *socket, const QString &line);
+    void writeLines(QLocalSocket *socket, const QStringList &lines);
+    void replyOk(QLocalSocket *socket);
+    void replyError(QLocalSocket *socket, const QString &reason);
+    bool resolveDevices(const QString &controller, QList<InputDevice *> &devices) const;
+    void updateStatsTimer();
 
     QLocalServer *localServer;
+    QMap<SDL_JoystickID, InputDevice *> *m_joysticks;
+    AntiMicroSettings *m_settings;
+    QMap<QLocalSocket *, int> statsSubscribers; // socket -> interval in ms
+    QMap<QLocalSocket *, qint64> statsLastSent; // socket -> msecs since epoch
+    QTimer statsTimer;
 };
 
 #endif // LOCALANTIMICROSERVER_H
@@ -29,8 +29,11 @@
 #include "joysensortype.h"
 #include "localantimicroserver.h"
 #include "mainwindow.h"
+#include "processspawner.h"
+#include "profileindex.h"
 #include "setjoystick.h"
 #include "simplekeygrabberbutton.h"
+#include "startupprofiler.h"
 
 #include "eventhandlerfactory.h"
 #include "logger.h"
@@ -227,6 +230,7 @@ void importLegacySettingsIfExist()
 
 int main(int argc, char *argv[])
 {
+    StartupProfiler::start();
     qInstallMessageHandler(Logger::loggerMessageHandler);
 
     QApplication antimicrox(argc, argv);
@@ -269,6 +273,8 @@ int main(int argc, char *argv[])
     }
     settings.importFromCommandLine(cmdutility);
     settings.applySettingsToLogger(cmdutility, appLogger);
+    StartupProfiler::setEnabled(cmdutility.isStartupProfileRequested());
+    StartupProfiler::mark("Settings and command line loaded");
 
     Q_INIT_RESOURCE(resources);
 
@@ -317,6 +323,14 @@ int main(int argc, char *argv[])
         qDebug() << "Socket descriptor: " << socket.socketDescriptor();
     }
 
+    if (cmdutility.isStatsRequested())
+    {
+        int result = LocalAntiMicroServer::printInstanceStatistics(&socket);
+        delete joysticks;
+        delete appLogger;
+        return result;
+    }
+
     if (socket.state() == QLocalSocket::ConnectedState)
     {
         // An instance of this program is already running.
@@ -353,7 +367,7 @@ int main(int argc, char *argv[])
 
         int result = antimicrox.exec();
 
-        settings.sync();
+        settings.flush();
         socket.disconnectFromServer();
         if (socket.state() == QLocalSocket::LocalSocketState::ConnectedState ||
             socket.state() == QLocalSocket::LocalSocketState::ClosingState)
@@ -376,8 +390,9 @@ int main(int argc, char *argv[])
         return result;
     }
 
-    LocalAntiMicroServer *localServer = new LocalAntiMicroServer();
+    LocalAntiMicroServer *localServer = new LocalAntiMicroServer(joysticks, &settings);
     localServer->startLocalServer();
+    StartupProfiler::mark("Local server started");
 
 #if defined(Q_OS_WIN)
     qApp->setStyle("fusion");
@@ -449,6 +464,7 @@ int main(int argc, char *argv[])
     }
 
     antimicrox.installTranslator(&myappTranslator);
+    StartupProfiler::mark("Translations loaded");
 
     if (cmdutility.shouldListControllers())
     {
@@ -551,6 +567,7 @@ int main(int argc, char *argv[])
         return EXIT_FAILURE;
     }
     qInfo() << QObject::tr("Using %1 as the event generator.").arg(factory->handler()->getName());
+    StartupProfiler::mark("Event generator initialized");
 #ifdef Q_OS_WIN
     PadderCommon::log_system_config(); // workaround for missing windows logs
 #endif
@@ -558,8 +575,10 @@ int main(int argc, char *argv[])
     QPointer<InputDaemon> joypad_worker = new InputDaemon(joysticks, &settings);
     inputEventThread = new QThread();
     inputEventThread->setObjectName("inputEventThread");
+    StartupProfiler::mark("SDL initialized and devices opened");
 
     MainWindow *mainWindow = new MainWindow(joysticks, &cmdutility, &settings);
+    StartupProfiler::mark("Main window constructed");
 
     mainWindow->setAppTranslator(&qtTranslator);
     mainWindow->setTranslator(&myappTranslator);
@@ -580,7 +599,16 @@ int main(int argc, char *argv[])
     QObject::connect(localServer, &LocalAntiMicroServer::showHiddenWindow, mainWindow, &MainWindow::show);
     QObject::connect(localServer, &LocalAntiMicroServer::clientdisconnect, mainWindow,
                      &MainWindow::handleInstanceDisconnect);
+    QObject::connect(localServer, &LocalAntiMicroServer::loadProfileRequested, mainWindow, &MainWindow::loadRemoteProfile);
+    QObject::connect(localServer, &LocalAntiMicroServer::unloadProfileRequested, mainWindow,
+                     &MainWindow::unloadRemoteProfile);
+    QObject::connect(localServer, &LocalAntiMicroServer::switchProfileRequested, mainWindow,
+                     &MainWindow::switchRemoteProfile);
+    QObject::connect(localServer, &LocalAntiMicroServer::changeSetRequested, mainWindow, &MainWindow::changeRemoteSet);
+    QObject::connect(localServer, &LocalAntiMicroServer::quitRequested, &antimicrox, &QApplication::quit);
     QObject::connect(mainWindow, &MainWindow::mappingUpdated, joypad_worker.data(), &InputDaemon::refreshMapping);
+    QObject::connect(mainWindow, &MainWindow::playerDevicesChanged, joypad_worker.data(),
+                     &InputDaemon::updatePlayerDevices);
     QObject::connect(joypad_worker.data(), &InputDaemon::deviceUpdated, mainWindow, &MainWindow::testMappingUpdateNow);
 
     QObject::connect(joypad_worker.data(), &InputDaemon::deviceRemoved, mainWindow, &MainWindow::removeJoyTab);
@@ -591,6 +619,10 @@ int main(int argc, char *argv[])
     QTimer::singleShot(0, mainWindow, SLOT(fillButtons()));
     QTimer::singleShot(0, mainWindow, SLOT(alterConfigFromSettings()));
     QTimer::singleShot(0, mainWindow, SLOT(changeWindowStatus()));
+    QTimer::singleShot(0, mainWindow, []() {
+        StartupProfiler::mark("Profiles loaded and GUI ready");
+        StartupProfiler::report();
+    });
 
     mainAppHelper.changeMouseThread(inputEventThread);
 
@@ -634,6 +666,8 @@ int main(int argc, char *argv[])
 
     EventHandlerFactory::getInstance()->handler()->cleanup();
     EventHandlerFactory::getInstance()->deleteInstance();
+    ProfileIndex::deleteInstance();
+    ProcessSpawner::deleteInstance();
 
     delete mainWindow;
     mainWindow = nullptr;
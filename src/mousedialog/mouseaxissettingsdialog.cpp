@@ -112,6 +112,7 @@ MouseAxisSettingsDialog::MouseAxisSettingsDialog(JoyAxis *axis, QWidget *parent)
             &MouseAxisSettingsDialog::updateWheelSpeedHorizontalSpeed);
     connect(ui->wheelVertSpeedSpinBox, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this,
             &MouseAxisSettingsDialog::updateWheelSpeedVerticalSpeed);
+    connect(ui->analogWheelCheckBox, &QCheckBox::clicked, axis, &JoyAxis::setButtonsAnalogWheel);
 
     connect(ui->easingDoubleSpinBox, static_cast<void (QDoubleSpinBox::*)(double)>(&QDoubleSpinBox::valueChanged), axis,
             &JoyAxis::setButtonsEasingDuration);
@@ -245,6 +246,7 @@ void MouseAxisSettingsDialog::calculateWheelSpeedPreset()
 
     ui->wheelHoriSpeedSpinBox->setValue(tempWheelSpeedX);
     ui->wheelVertSpeedSpinBox->setValue(tempWheelSpeedY);
+    ui->analogWheelCheckBox->setChecked(paxisbutton->isAnalogWheel() || naxisbutton->isAnalogWheel());
 }
 
 void MouseAxisSettingsDialog::updateWheelSpeedHorizontalSpeed(int value) { axis->setButtonsWheelSpeedX(value); }
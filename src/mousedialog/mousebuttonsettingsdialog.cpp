@@ -62,6 +62,7 @@ MouseButtonSettingsDialog::MouseButtonSettingsDialog(JoyButton *button, QWidget
 
     ui->wheelHoriSpeedSpinBox->setValue(button->getWheelSpeedX());
     ui->wheelVertSpeedSpinBox->setValue(button->getWheelSpeedY());
+    ui->analogWheelCheckBox->setChecked(button->isAnalogWheel());
 
     if (button->isRelativeSpring())
     {
@@ -125,6 +126,7 @@ MouseButtonSettingsDialog::MouseButtonSettingsDialog(JoyButton *button, QWidget
             [button, x](int value) { button->setWheelSpeed(value, x); });
     connect(ui->wheelVertSpeedSpinBox, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), button,
             [button, y](int value) { button->setWheelSpeed(value, y); });
+    connect(ui->analogWheelCheckBox, &QCheckBox::clicked, button, &JoyButton::setAnalogWheel);
 
     connect(ui->easingDoubleSpinBox, static_cast<void (QDoubleSpinBox::*)(double)>(&QDoubleSpinBox::valueChanged), button,
             &JoyButton::setEasingDuration);
@@ -113,6 +113,7 @@ MouseControlStickSettingsDialog::MouseControlStickSettingsDialog(JoyControlStick
             &MouseControlStickSettingsDialog::updateWheelSpeedHorizontalSpeed);
     connect(ui->wheelVertSpeedSpinBox, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this,
             &MouseControlStickSettingsDialog::updateWheelSpeedVerticalSpeed);
+    connect(ui->analogWheelCheckBox, &QCheckBox::clicked, stick, &JoyControlStick::setButtonsAnalogWheel);
 
     connect(ui->easingDoubleSpinBox, static_cast<void (QDoubleSpinBox::*)(double)>(&QDoubleSpinBox::valueChanged), stick,
             &JoyControlStick::setButtonsEasingDuration);
@@ -258,15 +259,18 @@ void MouseControlStickSettingsDialog::calculateWheelSpeedPreset()
     QHashIterator<JoyControlStick::JoyStickDirections, JoyControlStickButton *> iter(*stick->getButtons());
     int tempWheelSpeedX = 0;
     int tempWheelSpeedY = 0;
+    bool analogWheel = false;
     while (iter.hasNext())
     {
         JoyControlStickButton *button = iter.next().value();
         tempWheelSpeedX = qMax(tempWheelSpeedX, button->getWheelSpeedX());
         tempWheelSpeedY = qMax(tempWheelSpeedY, button->getWheelSpeedY());
+        analogWheel = analogWheel || button->isAnalogWheel();
     }
 
     ui->wheelHoriSpeedSpinBox->setValue(tempWheelSpeedX);
     ui->wheelVertSpeedSpinBox->setValue(tempWheelSpeedY);
+    ui->analogWheelCheckBox->setChecked(analogWheel);
 }
 
 void MouseControlStickSettingsDialog::updateWheelSpeedHorizontalSpeed(int value) { stick->setButtonsWheelSpeedX(value); }
@@ -108,6 +108,7 @@ MouseDPadSettingsDialog::MouseDPadSettingsDialog(JoyDPad *dpad, QWidget *parent)
             &MouseDPadSettingsDialog::updateWheelSpeedHorizontalSpeed);
     connect(ui->wheelVertSpeedSpinBox, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this,
             &MouseDPadSettingsDialog::updateWheelSpeedVerticalSpeed);
+    connect(ui->analogWheelCheckBox, &QCheckBox::clicked, dpad, &JoyDPad::setButtonsAnalogWheel);
 
     connect(ui->easingDoubleSpinBox, static_cast<void (QDoubleSpinBox::*)(double)>(&QDoubleSpinBox::valueChanged), dpad,
             &JoyDPad::setButtonsEasingDuration);
@@ -245,15 +246,18 @@ void MouseDPadSettingsDialog::calculateWheelSpeedPreset()
     QHashIterator<int, JoyDPadButton *> iter(*dpad->getButtons());
     int tempWheelSpeedX = 0;
     int tempWheelSpeedY = 0;
+    bool analogWheel = false;
     while (iter.hasNext())
     {
         JoyDPadButton *button = iter.next().value();
         tempWheelSpeedX = qMax(tempWheelSpeedX, button->getWheelSpeedX());
         tempWheelSpeedY = qMax(tempWheelSpeedY, button->getWheelSpeedY());
+        analogWheel = analogWheel || button->isAnalogWheel();
     }
 
     ui->wheelHoriSpeedSpinBox->setValue(tempWheelSpeedX);
     ui->wheelVertSpeedSpinBox->setValue(tempWheelSpeedY);
+    ui->analogWheelCheckBox->setChecked(analogWheel);
 }
 
 void MouseDPadSettingsDialog::updateWheelSpeedHorizontalSpeed(int value) { dpad->setButtonsWheelSpeedX(value); }
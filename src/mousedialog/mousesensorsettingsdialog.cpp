@@ -58,6 +58,7 @@ MouseSensorSettingsDialog::MouseSensorSettingsDialog(JoySensor *sensor, QWidget
             &MouseSensorSettingsDialog::updateWheelSpeedHorizontalSpeed);
     connect(ui->wheelVertSpeedSpinBox, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged), this,
             &MouseSensorSettingsDialog::updateWheelSpeedVerticalSpeed);
+    connect(ui->analogWheelCheckBox, &QCheckBox::clicked, this, &MouseSensorSettingsDialog::updateAnalogWheel);
 }
 
 /**
@@ -94,15 +95,18 @@ void MouseSensorSettingsDialog::calculateWheelSpeedPreset()
     auto buttons = m_sensor->getButtons();
     int wheelSpeedX = 0;
     int wheelSpeedY = 0;
+    bool analogWheel = false;
     for (auto iter = buttons->cbegin(); iter != buttons->cend(); ++iter)
     {
         JoySensorButton *button = iter.value();
         wheelSpeedX = qMax(wheelSpeedX, button->getWheelSpeedX());
         wheelSpeedY = qMax(wheelSpeedY, button->getWheelSpeedY());
+        analogWheel = analogWheel || button->isAnalogWheel();
     }
 
     ui->wheelHoriSpeedSpinBox->setValue(wheelSpeedX);
     ui->wheelVertSpeedSpinBox->setValue(wheelSpeedY);
+    ui->analogWheelCheckBox->setChecked(analogWheel);
 }
 
 /**
@@ -188,6 +192,20 @@ void MouseSensorSettingsDialog::updateWheelSpeedVerticalSpeed(int value)
     }
 }
 
+/**
+ * @brief Analog wheel change UI event handler
+ *  Updates the analog wheel mode on all buttons of the associated sensor.
+ */
+void MouseSensorSettingsDialog::updateAnalogWheel(bool enabled)
+{
+    auto buttons = m_sensor->getButtons();
+    for (auto iter = buttons->begin(); iter != buttons->end(); ++iter)
+    {
+        JoySensorButton *button = iter.value();
+        button->setAnalogWheel(enabled);
+    }
+}
+
 /**
  * @brief Not used for sensors but necessary to implement because it is an
  *  abstract function in the parent class.
@@ -45,6 +45,7 @@ class MouseSensorSettingsDialog : public MouseSettingsDialog
     void updateConfigVerticalSpeed(int value);
     void updateWheelSpeedHorizontalSpeed(int value);
     void updateWheelSpeedVerticalSpeed(int value);
+    void updateAnalogWheel(bool enabled);
 
     virtual void changeMouseMode(int index);
     virtual void changeMouseCurve(int index);
@@ -0,0 +1,230 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "orientationestimator.h"
+
+#include "pt1filter.h"
+
+#include <Qt>
+#include <cmath>
+
+const double OrientationEstimator::STANDARD_GRAVITY = 9.80665;
+// Proportional gain of the accelerometer correction in 1/s.
+// The tilt settles to the accelerometer within roughly one second.
+const double OrientationEstimator::CORRECTION_GAIN = 1.0;
+// Accelerometer samples deviating more than this fraction from
+// gravity are caused by movement and not used for correction.
+const double OrientationEstimator::GRAVITY_TOLERANCE = 0.2;
+// Longer gaps between gyroscope samples mean that samples were lost or the sensor was off.
+const double OrientationEstimator::MAX_STEP_SECS = 0.1;
+
+OrientationEstimator::OrientationEstimator()
+    : m_period(1 / PT1Filter::FALLBACK_RATE)
+    , m_rate_set(false)
+{
+    reset();
+}
+
+/**
+ * @brief Forgets the current orientation. The next accelerometer sample
+ *  initializes it again.
+ */
+void OrientationEstimator::reset()
+{
+    m_quat[0] = 1.0;
+    m_quat[1] = m_quat[2] = m_quat[3] = 0.0;
+    m_accel[0] = m_accel[2] = 0.0;
+    m_accel[1] = STANDARD_GRAVITY;
+    m_last_timestamp = 0;
+    m_has_timestamp = false;
+    m_has_accel = false;
+    m_has_gyro = false;
+    m_initialized = false;
+}
+
+/**
+ * @brief Sets the data rate of the gyroscope which is used as integration step
+ *  when the timestamps of the samples can't be used.
+ * @param[in] rate Data rate in samples per second or zero if unknown.
+ */
+void OrientationEstimator::setRate(double rate)
+{
+    m_period = qFuzzyIsNull(rate) ? 1 / PT1Filter::FALLBACK_RATE : 1 / rate;
+    m_rate_set = true;
+}
+
+/**
+ * @brief Checks if setRate was called already.
+ */
+bool OrientationEstimator::hasRate() const { return m_rate_set; }
+
+/**
+ * @brief Stores the latest accelerometer sample for the next correction.
+ *  Without gyroscope the orientation is taken from the accelerometer directly.
+ * @param[in] values Accelerometer values in m/s²
+ */
+void OrientationEstimator::processAccelerometer(const float *values)
+{
+    m_accel[0] = values[0];
+    m_accel[1] = values[1];
+    m_accel[2] = values[2];
+    m_has_accel = true;
+
+    if (!m_has_gyro || !m_initialized)
+        alignToAccelerometer();
+}
+
+/**
+ * @brief Integrates a gyroscope sample into the orientation and corrects
+ *  the estimated gravity direction towards the last accelerometer sample.
+ * @param[in] values Raw gyroscope values in rad/s
+ * @param[in] offsetX Gyroscope offset of the X axis in rad/s
+ * @param[in] offsetY Gyroscope offset of the Y axis in rad/s
+ * @param[in] offsetZ Gyroscope offset of the Z axis in rad/s
+ * @param[in] timestamp Time of the sample in microseconds
+ */
+void OrientationEstimator::processGyroscope(const float *values, double offsetX, double offsetY, double offsetZ,
+                                            quint64 timestamp)
+{
+    double step = m_period;
+
+    if (m_has_timestamp)
+    {
+        // Samples sharing a timestamp get no time of their own, out of order samples neither.
+        double elapsed = (timestamp > m_last_timestamp) ? (timestamp - m_last_timestamp) * 1e-6 : 0.0;
+
+        if (elapsed <= MAX_STEP_SECS)
+            step = elapsed;
+    }
+
+    if (!m_has_timestamp || (timestamp > m_last_timestamp))
+        m_last_timestamp = timestamp;
+
+    m_has_timestamp = true;
+    m_has_gyro = true;
+
+    if (!m_initialized)
+        return;
+
+    double wx = values[0] - offsetX;
+    double wy = values[1] - offsetY;
+    double wz = values[2] - offsetZ;
+
+    double &qw = m_quat[0];
+    double &qx = m_quat[1];
+    double &qy = m_quat[2];
+    double &qz = m_quat[3];
+
+    double norm = sqrt(m_accel[0] * m_accel[0] + m_accel[1] * m_accel[1] + m_accel[2] * m_accel[2]);
+
+    if (m_has_accel && (std::abs(norm - STANDARD_GRAVITY) < GRAVITY_TOLERANCE * STANDARD_GRAVITY))
+    {
+        double ax = m_accel[0] / norm;
+        double ay = m_accel[1] / norm;
+        double az = m_accel[2] / norm;
+
+        // Estimated direction of gravity in sensor coordinates
+        double vx = 2 * (qx * qy + qw * qz);
+        double vy = 1 - 2 * (qx * qx + qz * qz);
+        double vz = 2 * (qy * qz - qw * qx);
+
+        // Rotating around the cross product moves the estimation towards the measurement
+        wx += CORRECTION_GAIN * (ay * vz - az * vy);
+        wy += CORRECTION_GAIN * (az * vx - ax * vz);
+        wz += CORRECTION_GAIN * (ax * vy - ay * vx);
+    }
+
+    double half = 0.5 * step;
+    double dw = -qx * wx - qy * wy - qz * wz;
+    double dx = qw * wx + qy * wz - qz * wy;
+    double dy = qw * wy - qx * wz + qz * wx;
+    double dz = qw * wz + qx * wy - qy * wx;
+
+    qw += dw * half;
+    qx += dx * half;
+    qy += dy * half;
+    qz += dz * half;
+
+    double length = sqrt(qw * qw + qx * qx + qy * qy + qz * qz);
+    qw /= length;
+    qx /= length;
+    qy /= length;
+    qz /= length;
+}
+
+/**
+ * @brief Checks if an accelerometer sample initialized the orientation yet.
+ */
+bool OrientationEstimator::hasOrientation() const { return m_initialized; }
+
+/**
+ * @brief Gets the fused direction of gravity in sensor coordinates,
+ *  scaled to the values an accelerometer at rest would report.
+ */
+void OrientationEstimator::getGravity(double *x, double *y, double *z) const
+{
+    const double &qw = m_quat[0];
+    const double &qx = m_quat[1];
+    const double &qy = m_quat[2];
+    const double &qz = m_quat[3];
+
+    *x = STANDARD_GRAVITY * 2 * (qx * qy + qw * qz);
+    *y = STANDARD_GRAVITY * (1 - 2 * (qx * qx + qz * qz));
+    *z = STANDARD_GRAVITY * 2 * (qy * qz - qw * qx);
+}
+
+void OrientationEstimator::getQuaternion(double *w, double *x, double *y, double *z) const
+{
+    *w = m_quat[0];
+    *x = m_quat[1];
+    *y = m_quat[2];
+    *z = m_quat[3];
+}
+
+/**
+ * @brief Sets the orientation to the shortest rotation which
+ *  maps the measured gravity onto the world Y axis.
+ *  Yaw can't be observed by the accelerometer and is kept at zero.
+ */
+void OrientationEstimator::alignToAccelerometer()
+{
+    double norm = sqrt(m_accel[0] * m_accel[0] + m_accel[1] * m_accel[1] + m_accel[2] * m_accel[2]);
+
+    if (qFuzzyIsNull(norm))
+        return;
+
+    double ax = m_accel[0] / norm;
+    double ay = m_accel[1] / norm;
+    double az = m_accel[2] / norm;
+
+    if (ay < -0.9999)
+    {
+        // Upside down, rotate half a turn around X
+        m_quat[0] = 0.0;
+        m_quat[1] = 1.0;
+        m_quat[2] = m_quat[3] = 0.0;
+    } else
+    {
+        double length = sqrt(2 * (1 + ay));
+        m_quat[0] = (1 + ay) / length;
+        m_quat[1] = -az / length;
+        m_quat[2] = 0.0;
+        m_quat[3] = ax / length;
+    }
+
+    m_initialized = true;
+}
@@ -0,0 +1,67 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include <QtGlobal>
+
+/**
+ * @brief Fuses accelerometer and gyroscope samples of a controller into
+ *  an orientation quaternion using a complementary (Mahony) filter.
+ *
+ *  Gyroscope samples are integrated over the time between their timestamps,
+ *  which keeps the orientation responsive and free of hand shake. Devices
+ *  reporting several samples with one timestamp still integrate the right
+ *  total time. The nominal data rate is only used for the first sample and
+ *  after gaps longer than MAX_STEP_SECS, e.g. when the sensor was off. The accelerometer
+ *  slowly pulls the estimated gravity direction back to the measured one
+ *  to cancel drift, but only while it measures little more than gravity.
+ *  Without gyroscope data the orientation follows the accelerometer directly.
+ */
+class OrientationEstimator
+{
+  public:
+    OrientationEstimator();
+
+    void reset();
+    void setRate(double rate);
+    bool hasRate() const;
+    void processAccelerometer(const float *values);
+    void processGyroscope(const float *values, double offsetX, double offsetY, double offsetZ, quint64 timestamp);
+
+    bool hasOrientation() const;
+    void getGravity(double *x, double *y, double *z) const;
+    void getQuaternion(double *w, double *x, double *y, double *z) const;
+
+    static const double STANDARD_GRAVITY;
+    static const double CORRECTION_GAIN;
+    static const double GRAVITY_TOLERANCE;
+    static const double MAX_STEP_SECS;
+
+  private:
+    void alignToAccelerometer();
+
+    double m_quat[4]; ///< w, x, y, z, rotates sensor into world coordinates with Y pointing up
+    double m_accel[3];
+    double m_period;
+    quint64 m_last_timestamp;
+    bool m_has_timestamp;
+    bool m_rate_set;
+    bool m_has_accel;
+    bool m_has_gyro;
+    bool m_initialized;
+};
@@ -0,0 +1,302 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "processspawner.h"
+
+#include "common.h"
+#include "logger.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QProcess>
+#include <QTextStream>
+
+#include <cstring>
+
+#if defined(Q_OS_UNIX)
+    #include <signal.h>
+    #include <spawn.h>
+    #include <sys/types.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+
+extern char **environ;
+
+    #if defined(__GLIBC__) && defined(__GLIBC_PREREQ)
+        #if __GLIBC_PREREQ(2, 29)
+            #define SPAWN_HAS_ADDCHDIR
+        #endif
+    #endif
+#endif
+
+ProcessSpawner *ProcessSpawner::instance = nullptr;
+const int ProcessSpawner::REAP_INTERVAL_MSECS = 1000;
+const int ProcessSpawner::MAX_CACHED_COMMANDS = 256;
+
+ProcessSpawner::ProcessSpawner(QObject *parent)
+    : QObject(parent)
+    , m_reap_timer(new QTimer(this))
+{
+    m_thread.setObjectName("ProcessSpawner");
+    m_reap_timer->setInterval(REAP_INTERVAL_MSECS);
+    connect(m_reap_timer, &QTimer::timeout, this, &ProcessSpawner::reapChildren);
+
+    moveToThread(&m_thread);
+    m_thread.start();
+}
+
+ProcessSpawner::~ProcessSpawner()
+{
+    if (m_thread.isRunning())
+    {
+        QMetaObject::invokeMethod(
+            this, [this] { m_reap_timer->stop(); }, Qt::BlockingQueuedConnection);
+        m_thread.quit();
+        m_thread.wait();
+    }
+}
+
+ProcessSpawner *ProcessSpawner::getInstance()
+{
+    if (instance == nullptr)
+        instance = new ProcessSpawner();
+
+    return instance;
+}
+
+void ProcessSpawner::deleteInstance()
+{
+    if (instance != nullptr)
+    {
+        delete instance;
+        instance = nullptr;
+    }
+}
+
+/**
+ * @brief Resolves the command of an executable slot ahead of its first use.
+ *  Called while a profile is loaded.
+ */
+void ProcessSpawner::prepare(const QString &file, const QString &arguments) { getCommand(file, arguments); }
+
+/**
+ * @brief Queues the start of the given file. Returns right away, the process
+ *  is started on the spawner thread.
+ */
+void ProcessSpawner::execute(const QString &file, const QString &arguments)
+{
+    QMetaObject::invokeMethod(
+        this, [this, file, arguments] { launch(file, arguments); }, Qt::QueuedConnection);
+}
+
+/**
+ * @brief Builds the command line for a file. Scripts are handed to their
+ *  interpreter, other files are started directly.
+ */
+SpawnCommand ProcessSpawner::resolveCommand(const QString &file, const QString &arguments)
+{
+    QFileInfo fileInfo(file);
+    SpawnCommand command;
+    command.arguments = PadderCommon::parseArgumentsString(arguments);
+    command.workingDirectory = fileInfo.absoluteDir().path();
+
+    QString interpreter = detectInterpreter(file);
+
+    if (interpreter.isEmpty())
+    {
+        command.program = fileInfo.absoluteFilePath();
+    } else
+    {
+        command.program = interpreter;
+        command.arguments.prepend(fileInfo.absoluteFilePath());
+    }
+
+    return command;
+}
+
+/**
+ * @brief detects executor for selected file (for .py files python, for .exe "" etc)
+ */
+QString ProcessSpawner::detectInterpreter(const QString &file)
+{
+    QFileInfo fileinfo(file);
+    QFile inputFile(file);
+
+    QString firstLine = QString();
+
+    if (inputFile.open(QIODevice::ReadOnly))
+    {
+        QTextStream in(&inputFile);
+        firstLine = in.readLine();
+        inputFile.close();
+    } else
+        WARN() << "Could not open file: " << file;
+
+    if (firstLine.contains("bin/bash"))
+        return "/bin/sh";
+    else if (fileinfo.completeSuffix() == "py" && firstLine.contains("python3"))
+        return "python3";
+    else if (fileinfo.completeSuffix() == "py" && firstLine.contains("python"))
+        return "python";
+    else if (fileinfo.completeSuffix() == "pl" || firstLine.contains("usr/bin/perl"))
+        return "perl";
+    else if (fileinfo.completeSuffix() == "php" || firstLine.contains("/php"))
+        return "php";
+    else if (fileinfo.completeSuffix() == "rb" || firstLine.contains("ruby"))
+        return "ruby";
+
+    // when run "chmod +x file_name"
+    return "";
+}
+
+/**
+ * @brief Returns the cached command of the file, or resolves it when it
+ *  isn't cached yet or the file changed since it was resolved.
+ */
+SpawnCommand ProcessSpawner::getCommand(const QString &file, const QString &arguments)
+{
+    const QString key = file + QChar('\n') + arguments;
+    const QFileInfo fileInfo(file);
+    const QDateTime lastModified = fileInfo.lastModified();
+    const qint64 size = fileInfo.size();
+
+    {
+        QMutexLocker locker(&m_mutex);
+        auto iter = m_commands.constFind(key);
+
+        if (iter != m_commands.constEnd() && iter->lastModified == lastModified && iter->size == size)
+            return iter->command;
+    }
+
+    CachedCommand cached;
+    cached.command = resolveCommand(file, arguments);
+    cached.lastModified = lastModified;
+    cached.size = size;
+
+    QMutexLocker locker(&m_mutex);
+
+    if (m_commands.size() >= MAX_CACHED_COMMANDS && !m_commands.contains(key))
+        m_commands.clear();
+
+    m_commands.insert(key, cached);
+    return cached.command;
+}
+
+void ProcessSpawner::launch(const QString &file, const QString &arguments)
+{
+    SpawnCommand command = getCommand(file, arguments);
+    qint64 pid = 0;
+
+    if (spawn(command, &pid))
+        qInfo() << "Command: " << file << " " << arguments << " executed successfully with pid: " << pid;
+    else
+        qWarning() << "Command " << file << " " << arguments << " cannot be executed, pid: " << pid;
+}
+
+/**
+ * @brief Starts the command without waiting for it. Children started with
+ *  posix_spawn are collected by reapChildren().
+ */
+bool ProcessSpawner::spawn(const SpawnCommand &command, qint64 *pid)
+{
+#if defined(Q_OS_UNIX) && defined(SPAWN_HAS_ADDCHDIR)
+    QByteArray program = QFile::encodeName(command.program);
+    QByteArray workingDirectory = QFile::encodeName(command.workingDirectory);
+    QList<QByteArray> arguments;
+    QVector<char *> argv;
+
+    for (const QString &argument : command.arguments)
+        arguments.append(argument.toLocal8Bit());
+
+    argv.append(program.data());
+
+    for (QByteArray &argument : arguments)
+        argv.append(argument.data());
+
+    argv.append(nullptr);
+
+    posix_spawn_file_actions_t actions;
+    posix_spawnattr_t attributes;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawnattr_init(&attributes);
+
+    // Don't pass on signal handling of the application to the child.
+    sigset_t signals;
+    sigemptyset(&signals);
+    posix_spawnattr_setsigmask(&attributes, &signals);
+    sigfillset(&signals);
+    posix_spawnattr_setsigdefault(&attributes, &signals);
+
+    short flags = POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF;
+    #ifdef POSIX_SPAWN_SETSID
+    flags |= POSIX_SPAWN_SETSID;
+    #endif
+    posix_spawnattr_setflags(&attributes, flags);
+
+    if (!command.workingDirectory.isEmpty())
+        posix_spawn_file_actions_addchdir_np(&actions, workingDirectory.constData());
+
+    pid_t child = 0;
+    int result = posix_spawnp(&child, program.constData(), &actions, &attributes, argv.data(), environ);
+
+    posix_spawnattr_destroy(&attributes);
+    posix_spawn_file_actions_destroy(&actions);
+
+    if (result != 0)
+    {
+        DEBUG() << "posix_spawnp failed: " << strerror(result);
+        return false;
+    }
+
+    *pid = child;
+    m_children.append(child);
+
+    if (!m_reap_timer->isActive())
+        m_reap_timer->start();
+
+    return true;
+#else
+    QProcess process;
+    process.setProgram(command.program);
+    process.setArguments(command.arguments);
+    process.setWorkingDirectory(command.workingDirectory);
+
+    return process.startDetached(pid);
+#endif
+}
+
+/**
+ * @brief Collects finished children so they don't stay around as zombies.
+ */
+void ProcessSpawner::reapChildren()
+{
+#if defined(Q_OS_UNIX)
+    for (int i = m_children.size() - 1; i >= 0; i--)
+    {
+        pid_t result = waitpid(static_cast<pid_t>(m_children.at(i)), nullptr, WNOHANG);
+
+        if (result != 0)
+            m_children.remove(i);
+    }
+#endif
+
+    if (m_children.isEmpty())
+        m_reap_timer->stop();
+}
@@ -0,0 +1,97 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PROCESSSPAWNER_H
+#define PROCESSSPAWNER_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QStringList>
+#include <QThread>
+#include <QTimer>
+#include <QVector>
+
+/**
+ * @brief Program, arguments and working directory of an executable slot.
+ */
+struct SpawnCommand
+{
+    QString program;
+    QStringList arguments;
+    QString workingDirectory;
+};
+
+/**
+ * @brief Starts the programs of JoyExecute slots.
+ *
+ *  Probing the script interpreter and forking can take long enough to be
+ *  noticed in mouse output, so the input thread only queues a request and
+ *  the process is started on a dedicated thread. Commands are resolved
+ *  when a profile is loaded and kept in a cache, so a button press
+ *  doesn't touch the file system. The spawner thread only compares the
+ *  modification time and size of the file before starting it and
+ *  resolves the command again when a script was edited on disk. On Unix
+ *  posix_spawn is used, other platforms fall back to
+ *  QProcess::startDetached.
+ */
+class ProcessSpawner : public QObject
+{
+    Q_OBJECT
+
+  public:
+    static ProcessSpawner *getInstance();
+    static void deleteInstance();
+
+    void prepare(const QString &file, const QString &arguments);
+    void execute(const QString &file, const QString &arguments);
+
+    static SpawnCommand resolveCommand(const QString &file, const QString &arguments);
+    static QString detectInterpreter(const QString &file);
+
+    static const int REAP_INTERVAL_MSECS;
+    static const int MAX_CACHED_COMMANDS;
+
+  private slots:
+    void reapChildren();
+
+  private:
+    struct CachedCommand
+    {
+        SpawnCommand command;
+        QDateTime lastModified;
+        qint64 size;
+    };
+
+    explicit ProcessSpawner(QObject *parent = nullptr);
+    ~ProcessSpawner();
+
+    SpawnCommand getCommand(const QString &file, const QString &arguments);
+    void launch(const QString &file, const QString &arguments);
+    bool spawn(const SpawnCommand &command, qint64 *pid);
+
+    static ProcessSpawner *instance;
+
+    QThread m_thread;
+    QTimer *m_reap_timer;
+    QMutex m_mutex;
+    QHash<QString, CachedCommand> m_commands;
+    QVector<qint64> m_children; ///< only touched by the spawner thread
+};
+
+#endif // PROCESSSPAWNER_H
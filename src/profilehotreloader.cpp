@@ -0,0 +1,422 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "profilehotreloader.h"
+
+#include "common.h"
+#include "gamecontroller/gamecontrollerset.h"
+#include "globalvariables.h"
+#include "inputdevice.h"
+#include "joyaxis.h"
+#include "joybuttontypes/joybutton.h"
+#include "joycontrolstick.h"
+#include "joydpad.h"
+#include "joysensor.h"
+#include "joytouchpad.h"
+#include "logger.h"
+#include "setjoystick.h"
+#include "vdpad.h"
+#include "xml/inputdevicexml.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+#include <QtConcurrent>
+
+#include <SDL2/SDL_gamecontroller.h>
+
+// Editors usually write a file in several steps, wait for the last one.
+const int ProfileHotReloader::RELOAD_DELAY_MSECS = 250;
+
+ProfileHotReloader::ProfileHotReloader(InputDevice *device, QObject *parent)
+    : QObject(parent)
+    , m_device(device)
+{
+    m_reload_timer.setSingleShot(true);
+    m_reload_timer.setInterval(RELOAD_DELAY_MSECS);
+
+    connect(&m_reload_timer, &QTimer::timeout, this, &ProfileHotReloader::reload);
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged, this, &ProfileHotReloader::scheduleReload);
+    connect(&m_parse_watcher, &QFutureWatcher<ProfileSnapshot>::finished, this, &ProfileHotReloader::finishParse);
+}
+
+ProfileHotReloader::~ProfileHotReloader() { m_parse_watcher.waitForFinished(); }
+
+/**
+ * @brief Starts watching the given profile file. An empty path stops watching.
+ * @param[in] filePath Profile which is currently loaded for the device
+ */
+void ProfileHotReloader::watch(const QString &filePath)
+{
+    QString absolute = filePath.isEmpty() ? QString() : QFileInfo(filePath).absoluteFilePath();
+
+    if ((absolute == m_file_path) && (absolute.isEmpty() || m_watcher.files().contains(absolute)))
+        return;
+
+    stop();
+    m_file_path = absolute;
+
+    if (!m_file_path.isEmpty() && QFileInfo::exists(m_file_path))
+        m_watcher.addPath(m_file_path);
+}
+
+void ProfileHotReloader::stop()
+{
+    m_reload_timer.stop();
+
+    if (!m_watcher.files().isEmpty())
+        m_watcher.removePaths(m_watcher.files());
+
+    m_file_path.clear();
+}
+
+QString ProfileHotReloader::getFilePath() const { return m_file_path; }
+
+void ProfileHotReloader::scheduleReload(const QString &path)
+{
+    if (path == m_file_path)
+        m_reload_timer.start();
+}
+
+/**
+ * @brief Reads the changed profile in the background.
+ */
+void ProfileHotReloader::reload()
+{
+    if (m_file_path.isEmpty())
+        return;
+
+    // Files replaced by renaming are dropped by the watcher.
+    if (!m_watcher.files().contains(m_file_path))
+    {
+        if (!QFileInfo::exists(m_file_path))
+            return;
+
+        m_watcher.addPath(m_file_path);
+    }
+
+    if (m_parse_watcher.isRunning())
+    {
+        m_reload_timer.start();
+        return;
+    }
+
+    m_parse_watcher.setFuture(QtConcurrent::run(&ProfileHotReloader::readProfile, m_file_path));
+}
+
+/**
+ * @brief Applies the read profile to the device. Blocks until the input thread
+ *  has compared and updated the sets.
+ */
+void ProfileHotReloader::finishParse()
+{
+    ProfileSnapshot snapshot = m_parse_watcher.result();
+
+    if (!snapshot.valid)
+    {
+        DEBUG() << "Ignoring unreadable profile change of " << m_file_path;
+        return;
+    }
+
+    if (m_device->isDeviceEdited())
+    {
+        INFO() << "Profile " << m_file_path << " changed on disk, keeping unsaved changes of "
+               << m_device->getSDLName();
+        return;
+    }
+
+    InputDevice *device = m_device;
+    int changedElements = 0;
+    Qt::ConnectionType type =
+        (m_device->thread() != QThread::currentThread()) ? Qt::BlockingQueuedConnection : Qt::DirectConnection;
+    QMetaObject::invokeMethod(
+        m_device, [device, snapshot]() { return applySnapshot(device, snapshot); }, type, &changedElements);
+
+    if (changedElements < 0)
+    {
+        INFO() << "Device settings of " << m_file_path << " changed, reloading the whole profile";
+        emit fullReloadRequired(m_file_path);
+    } else if (changedElements > 0)
+    {
+        INFO() << "Reloaded " << changedElements << " changed elements of " << m_file_path;
+        emit profileReloaded(changedElements);
+    }
+}
+
+/**
+ * @brief Reads and splits a profile file. Runs on the global thread pool.
+ */
+ProfileSnapshot ProfileHotReloader::readProfile(const QString &filePath)
+{
+    QFile file(filePath);
+
+    if (!file.open(QFile::ReadOnly))
+        return ProfileSnapshot();
+
+    return parseProfile(file.readAll());
+}
+
+/**
+ * @brief Splits a profile into canonical fragments of the device settings
+ *  and of every set element. Comments and formatting are left out, so a file
+ *  written by antimicrox gives the same bytes as the live device settings.
+ * @param[in] data Content of a profile file
+ */
+ProfileSnapshot ProfileHotReloader::parseProfile(const QByteArray &data)
+{
+    ProfileSnapshot snapshot;
+    QXmlStreamReader xml(data);
+
+    if (!xml.readNextStartElement())
+        return snapshot;
+
+    snapshot.deviceType = xml.name().toString();
+    snapshot.configVersion = xml.attributes().value("configversion").toString().toInt();
+
+    QXmlStreamWriter deviceWriter(&snapshot.deviceSettings);
+
+    while (xml.readNextStartElement())
+    {
+        QString name = xml.name().toString();
+
+        if (name == "sets")
+        {
+            while (xml.readNextStartElement())
+            {
+                if (xml.name().toString() != "set")
+                {
+                    xml.skipCurrentElement();
+                    continue;
+                }
+
+                QMap<QString, QByteArray> &elements = snapshot.sets[xml.attributes().value("index").toString().toInt()];
+
+                while (xml.readNextStartElement())
+                {
+                    QByteArray fragment;
+                    QXmlStreamWriter writer(&fragment);
+                    QString key = elementKey(&xml);
+                    copyElement(&xml, &writer);
+                    elements[key].append(fragment);
+                }
+            }
+        } else if ((name == "sdlname") || (name == "uniqueID") || (name == "guid"))
+        {
+            // Informational only, a profile can be used with any device.
+            xml.skipCurrentElement();
+        } else
+        {
+            copyElement(&xml, &deviceWriter);
+        }
+    }
+
+    snapshot.valid = !xml.hasError();
+    return snapshot;
+}
+
+/**
+ * @brief Compares the snapshot with the current settings of the device and
+ *  applies the differing set elements. Must be called on the input thread.
+ * @returns Number of changed elements, -1 if the profile needs a full reload.
+ */
+int ProfileHotReloader::applySnapshot(InputDevice *device, const ProfileSnapshot &snapshot)
+{
+    QByteArray liveData;
+    QXmlStreamWriter writer(&liveData);
+    InputDeviceXml deviceXml(device);
+    deviceXml.writeConfig(&writer);
+
+    ProfileSnapshot live = parseProfile(liveData);
+
+    if (!live.valid || (snapshot.deviceType != live.deviceType) ||
+        (snapshot.configVersion != PadderCommon::LATESTCONFIGFILEVERSION) ||
+        (snapshot.deviceSettings != live.deviceSettings))
+    {
+        return -1;
+    }
+
+    int changedElements = 0;
+
+    for (int i = 0; i < GlobalVariables::InputDevice::NUMBER_JOYSETS; i++)
+    {
+        const QMap<QString, QByteArray> fileElements = snapshot.sets.value(i + 1);
+        const QMap<QString, QByteArray> liveElements = live.sets.value(i + 1);
+
+        // Sets used by neither side stay unallocated.
+        if (fileElements.isEmpty() && (device->findSetJoystick(i) == nullptr))
+            continue;
+
+        SetJoystick *set = device->getSetJoystick(i);
+        QByteArray changedData;
+
+        // Reset every differing element before reading, so removed ones return to defaults.
+        for (auto iter = liveElements.constBegin(); iter != liveElements.constEnd(); ++iter)
+        {
+            if (fileElements.value(iter.key()) != iter.value())
+            {
+                resetElement(set, iter.key());
+                changedElements++;
+            }
+        }
+
+        for (auto iter = fileElements.constBegin(); iter != fileElements.constEnd(); ++iter)
+        {
+            if (liveElements.value(iter.key()) == iter.value())
+                continue;
+
+            if (!liveElements.contains(iter.key()))
+            {
+                resetElement(set, iter.key());
+                changedElements++;
+            }
+
+            changedData.append(iter.value());
+        }
+
+        if (!changedData.isEmpty())
+        {
+            QByteArray setData = QByteArray("<set index=\"").append(QByteArray::number(i + 1)).append("\">");
+            setData.append(changedData).append("</set>");
+            QXmlStreamReader xml(setData);
+            xml.readNextStartElement();
+            set->readConfig(&xml);
+        }
+    }
+
+    if (changedElements > 0)
+        device->updateSensorDemand();
+
+    return changedElements;
+}
+
+/**
+ * @brief Builds the key of a set element from its name and its index or sensor type.
+ */
+QString ProfileHotReloader::elementKey(QXmlStreamReader *xml)
+{
+    return QString("%1:%2:%3")
+        .arg(xml->name().toString(), xml->attributes().value("index").toString(),
+             xml->attributes().value("type").toString());
+}
+
+/**
+ * @brief Copies the current element with all children, without comments and
+ *  formatting whitespace. Leaves the reader on the end of the element.
+ */
+void ProfileHotReloader::copyElement(QXmlStreamReader *xml, QXmlStreamWriter *writer)
+{
+    int depth = 0;
+
+    do
+    {
+        switch (xml->tokenType())
+        {
+        case QXmlStreamReader::StartElement:
+            writer->writeStartElement(xml->name().toString());
+            writer->writeAttributes(xml->attributes());
+            depth++;
+            break;
+        case QXmlStreamReader::EndElement:
+            writer->writeEndElement();
+            depth--;
+            break;
+        case QXmlStreamReader::Characters:
+            if (!xml->isWhitespace())
+                writer->writeCharacters(xml->text().toString());
+            break;
+        default:
+            break;
+        }
+    } while ((depth > 0) && !xml->atEnd() && (xml->readNext() != QXmlStreamReader::Invalid));
+}
+
+/**
+ * @brief Releases the element of the set with the given key and restores its defaults.
+ */
+void ProfileHotReloader::resetElement(SetJoystick *set, const QString &key)
+{
+    QStringList parts = key.split(':');
+    QString name = parts.value(0);
+    int index = parts.value(1).toInt() - 1;
+
+    if (name == "button")
+    {
+        JoyButton *button = set->getJoyButton(index);
+
+        if (button != nullptr)
+            button->reset();
+    } else if ((name == "axis") && (set->getNumberAxes() > 0))
+    {
+        JoyAxis *axis = set->getJoyAxis(index);
+
+        if (axis != nullptr)
+            axis->reset();
+    } else if ((name == "trigger") && (set->getNumberAxes() > 0))
+    {
+        // Older profiles use 1 and 2 for the triggers.
+        JoyAxis *axis = nullptr;
+
+        if ((index == 0) || (index == 4))
+            axis = set->getJoyAxis(SDL_CONTROLLER_AXIS_TRIGGERLEFT);
+        else if ((index == 1) || (index == 5))
+            axis = set->getJoyAxis(SDL_CONTROLLER_AXIS_TRIGGERRIGHT);
+
+        if (axis != nullptr)
+            axis->reset();
+    } else if (name == "stick")
+    {
+        JoyControlStick *stick = set->getJoyStick(index);
+
+        if (stick != nullptr)
+            stick->reset();
+    } else if (name == "dpad")
+    {
+        // Game controllers map their dpad to a virtual one.
+        JoyDPad *dpad = nullptr;
+
+        if (qobject_cast<GameControllerSet *>(set) != nullptr)
+            dpad = set->getVDPad(index);
+        else
+            dpad = set->getJoyDPad(index);
+
+        if (dpad != nullptr)
+            dpad->reset();
+    } else if (name == "vdpad")
+    {
+        VDPad *vdpad = set->getVDPad(index);
+
+        if (vdpad != nullptr)
+            vdpad->reset();
+    } else if (name == "sensor")
+    {
+        JoySensor *sensor = set->getSensor(static_cast<JoySensorType>(parts.value(2).toInt()));
+
+        if (sensor != nullptr)
+            sensor->reset();
+    } else if (name == GlobalVariables::JoyTouchpad::xmlName)
+    {
+        JoyTouchpad *touchpad = set->getTouchpad(index);
+
+        if (touchpad != nullptr)
+            touchpad->reset();
+    } else if (name == "name")
+    {
+        set->setName(QString());
+    }
+}
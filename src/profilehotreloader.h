@@ -0,0 +1,98 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PROFILEHOTRELOADER_H
+#define PROFILEHOTRELOADER_H
+
+#include <QByteArray>
+#include <QFileSystemWatcher>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QMap>
+#include <QObject>
+#include <QTimer>
+
+class InputDevice;
+class SetJoystick;
+class QXmlStreamReader;
+class QXmlStreamWriter;
+
+/**
+ * @brief Profile split into canonical XML fragments, so it can be compared
+ *  element by element with the settings of a device.
+ */
+struct ProfileSnapshot
+{
+    bool valid = false;
+    QString deviceType; ///< root element, "gamecontroller" or "joystick"
+    int configVersion = 0;
+    QByteArray deviceSettings; ///< all device level elements except the informational ones
+    /// Elements of each set keyed by name and index or type, sets are keyed by their 1 based index.
+    QHash<int, QMap<QString, QByteArray>> sets;
+};
+
+/**
+ * @brief Reloads the loaded profile of a device when its file changes.
+ *
+ *  The file is read and split in the background. The device settings are
+ *  serialized at a safe point on the input thread, between two poll cycles,
+ *  and only the elements of a set (button, axis, stick, dpad, sensor, ...)
+ *  which differ from the file are reset and read again. All other elements
+ *  keep their state, so held buttons and running macros aren't interrupted.
+ *  A change of device level settings needs a full reload.
+ *  Lives on the GUI thread.
+ */
+class ProfileHotReloader : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit ProfileHotReloader(InputDevice *device, QObject *parent = nullptr);
+    ~ProfileHotReloader();
+
+    void watch(const QString &filePath);
+    void stop();
+    QString getFilePath() const;
+
+    static ProfileSnapshot parseProfile(const QByteArray &data);
+    static int applySnapshot(InputDevice *device, const ProfileSnapshot &snapshot);
+
+    static const int RELOAD_DELAY_MSECS;
+
+  signals:
+    void profileReloaded(int changedElements);
+    void fullReloadRequired(QString filePath);
+
+  private slots:
+    void scheduleReload(const QString &path);
+    void reload();
+    void finishParse();
+
+  private:
+    static ProfileSnapshot readProfile(const QString &filePath);
+    static QString elementKey(QXmlStreamReader *xml);
+    static void copyElement(QXmlStreamReader *xml, QXmlStreamWriter *writer);
+    static void resetElement(SetJoystick *set, const QString &key);
+
+    InputDevice *m_device;
+    QString m_file_path;
+    QFileSystemWatcher m_watcher;
+    QTimer m_reload_timer;
+    QFutureWatcher<ProfileSnapshot> m_parse_watcher;
+};
+
+#endif // PROFILEHOTRELOADER_H
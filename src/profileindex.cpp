@@ -0,0 +1,425 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "profileindex.h"
+
+#include "common.h"
+#include "globalvariables.h"
+#include "logger.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QXmlStreamReader>
+#include <QtConcurrent>
+
+ProfileIndex *ProfileIndex::instance = nullptr;
+
+// File system events usually come in bursts while a profile is written.
+const int ProfileIndex::REFRESH_DELAY_MSECS = 500;
+const quint32 ProfileIndex::CACHE_VERSION = 1;
+
+ProfileIndex::ProfileIndex(QObject *parent)
+    : QObject(parent)
+    , m_refresh_pending(false)
+{
+    m_refresh_timer.setSingleShot(true);
+    m_refresh_timer.setInterval(REFRESH_DELAY_MSECS);
+
+    connect(&m_refresh_timer, &QTimer::timeout, this, &ProfileIndex::refresh);
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this, &ProfileIndex::scheduleRefresh);
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged, this, &ProfileIndex::scheduleRefresh);
+    connect(&m_parse_watcher, &QFutureWatcher<ProfileMetadata>::finished, this, &ProfileIndex::finishParse);
+}
+
+ProfileIndex::~ProfileIndex()
+{
+    m_parse_watcher.cancel();
+    m_parse_watcher.waitForFinished();
+}
+
+ProfileIndex *ProfileIndex::getInstance()
+{
+    if (instance == nullptr)
+        instance = new ProfileIndex();
+
+    return instance;
+}
+
+void ProfileIndex::deleteInstance()
+{
+    if (instance != nullptr)
+    {
+        delete instance;
+        instance = nullptr;
+    }
+}
+
+/**
+ * @brief Indexes the profiles of the given directory. The stored index is
+ *  available immediately, changed files are read in the background.
+ * @param[in] directory Profile directory
+ */
+void ProfileIndex::setDirectory(const QString &directory)
+{
+    QString absolute = QDir(directory).absolutePath();
+
+    if (absolute == m_directory)
+        return;
+
+    if (!m_watcher.files().isEmpty())
+        m_watcher.removePaths(m_watcher.files());
+
+    if (!m_watcher.directories().isEmpty())
+        m_watcher.removePaths(m_watcher.directories());
+
+    // Results of the old directory are dropped, refresh() waits for the
+    // canceled parse to finish and then reads the new directory.
+    if (m_parse_watcher.isRunning())
+        m_parse_watcher.cancel();
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_directory = absolute;
+        m_profiles.clear();
+    }
+
+    loadCache();
+    emit indexUpdated();
+
+    if (QFileInfo(absolute).isDir())
+        m_watcher.addPath(absolute);
+
+    refresh();
+}
+
+QString ProfileIndex::getDirectory() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_directory;
+}
+
+/**
+ * @brief Checks if the given file is an indexed profile.
+ *  Can be used instead of probing the file system.
+ */
+bool ProfileIndex::contains(const QString &filePath) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_profiles.contains(filePath);
+}
+
+/**
+ * @brief Gets the metadata of an indexed profile.
+ * @param[in] filePath Absolute path of the profile
+ * @param[out] metadata Metadata of the profile
+ * @returns True if the profile is indexed, false otherwise.
+ */
+bool ProfileIndex::getMetadata(const QString &filePath, ProfileMetadata *metadata) const
+{
+    QMutexLocker locker(&m_mutex);
+    auto iter = m_profiles.constFind(filePath);
+
+    if (iter == m_profiles.constEnd())
+        return false;
+
+    *metadata = iter.value();
+    return true;
+}
+
+QList<ProfileMetadata> ProfileIndex::getProfiles() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_profiles.values();
+}
+
+QStringList ProfileIndex::getProfilePaths() const
+{
+    QMutexLocker locker(&m_mutex);
+    QStringList paths = m_profiles.keys();
+    paths.sort();
+    return paths;
+}
+
+/**
+ * @brief Gets the name stored in the given profile. Falls back to the
+ *  file name if the profile isn't indexed or has no name.
+ */
+QString ProfileIndex::getProfileName(QFileInfo &profile) const
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        auto iter = m_profiles.constFind(profile.absoluteFilePath());
+
+        if ((iter != m_profiles.constEnd()) && !iter.value().name.isEmpty())
+            return iter.value().name;
+    }
+
+    return PadderCommon::getProfileName(profile);
+}
+
+/**
+ * @brief Compares the profile directory with the index and starts reading
+ *  new and modified files in the background.
+ */
+void ProfileIndex::refresh()
+{
+    if (m_parse_watcher.isRunning())
+    {
+        m_refresh_pending = true;
+        return;
+    }
+
+    QDir dir(m_directory);
+    QFileInfoList entries = dir.entryInfoList(QStringList() << "*.amgp"
+                                                            << "*.xml",
+                                              QDir::Files | QDir::Readable);
+    QHash<QString, ProfileMetadata> current;
+    QList<ProfileMetadata> changed;
+    QStringList watchedFiles = m_watcher.files();
+    QStringList newFiles;
+    bool removed = false;
+
+    {
+        QMutexLocker locker(&m_mutex);
+
+        for (const QFileInfo &entry : entries)
+        {
+            QString path = entry.absoluteFilePath();
+            qint64 modified = entry.lastModified().toMSecsSinceEpoch();
+            auto iter = m_profiles.constFind(path);
+
+            // Modified files keep their old metadata until they are parsed,
+            // new files show up once their metadata is known.
+            if (iter != m_profiles.constEnd())
+                current.insert(path, iter.value());
+
+            if ((iter == m_profiles.constEnd()) || (iter.value().modified != modified) ||
+                (iter.value().size != entry.size()))
+            {
+                ProfileMetadata metadata = current.value(path);
+                metadata.filePath = path;
+                metadata.modified = modified;
+                metadata.size = entry.size();
+                changed.append(metadata);
+            }
+
+            if (!watchedFiles.contains(path))
+                newFiles.append(path);
+        }
+
+        removed = current.count() != m_profiles.count();
+        m_profiles = current;
+    }
+
+    for (const QString &path : watchedFiles)
+    {
+        if (!current.contains(path))
+            m_watcher.removePath(path);
+    }
+
+    if (!newFiles.isEmpty())
+        m_watcher.addPaths(newFiles);
+
+    if (!changed.isEmpty())
+    {
+        DEBUG() << "Reading" << changed.count() << "changed profiles in" << m_directory;
+        m_parse_watcher.setFuture(QtConcurrent::mapped(changed, &ProfileIndex::parseProfile));
+    } else if (removed)
+    {
+        saveCache();
+        emit indexUpdated();
+    }
+}
+
+void ProfileIndex::scheduleRefresh() { m_refresh_timer.start(); }
+
+void ProfileIndex::finishParse()
+{
+    if (!m_parse_watcher.isCanceled())
+    {
+        QList<ProfileMetadata> results = m_parse_watcher.future().results();
+        QMutexLocker locker(&m_mutex);
+
+        for (const ProfileMetadata &metadata : results)
+        {
+            // Skip profiles of a directory that was replaced during the parse.
+            if (!metadata.filePath.isEmpty() && (QFileInfo(metadata.filePath).absolutePath() == m_directory))
+                m_profiles.insert(metadata.filePath, metadata);
+        }
+    }
+
+    saveCache();
+    emit indexUpdated();
+
+    if (m_refresh_pending)
+    {
+        m_refresh_pending = false;
+        refresh();
+    }
+}
+
+/**
+ * @brief Reads a profile and extracts its metadata.
+ *  The file isn't parsed if its content hash matches the previous metadata.
+ *  Runs on the global thread pool.
+ * @param[in] previous Previous metadata of the file with current modification time and size
+ * @returns Updated metadata, with an empty file path if the file couldn't be read.
+ */
+ProfileMetadata ProfileIndex::parseProfile(const ProfileMetadata &previous)
+{
+    ProfileMetadata metadata;
+    QFile file(previous.filePath);
+
+    if (!file.open(QIODevice::ReadOnly))
+        return metadata;
+
+    QByteArray data = file.readAll();
+    QByteArray hash = QCryptographicHash::hash(data, QCryptographicHash::Md5);
+
+    if (!previous.hash.isEmpty() && (hash == previous.hash))
+        return previous;
+
+    metadata.filePath = previous.filePath;
+    metadata.modified = previous.modified;
+    metadata.size = previous.size;
+    metadata.hash = hash;
+
+    QXmlStreamReader xml(data);
+
+    if (!xml.readNextStartElement())
+        return metadata;
+
+    metadata.deviceType = xml.name().toString();
+
+    while (xml.readNextStartElement())
+    {
+        if (xml.name().toString() == "sdlname")
+        {
+            metadata.sdlName = xml.readElementText();
+        } else if (xml.name().toString() == "profilename")
+        {
+            metadata.name = xml.readElementText();
+        } else if (xml.name().toString() == "sets")
+        {
+            while (xml.readNextStartElement())
+            {
+                if (xml.name().toString() != "set")
+                {
+                    xml.skipCurrentElement();
+                    continue;
+                }
+
+                int index = xml.attributes().value("index").toString().toInt() - 1;
+                metadata.setsUsed++;
+
+                while (xml.readNextStartElement())
+                {
+                    if ((xml.name().toString() == "name") && (index >= 0) &&
+                        (index < GlobalVariables::InputDevice::NUMBER_JOYSETS))
+                    {
+                        while (metadata.setNames.size() <= index)
+                            metadata.setNames.append(QString());
+
+                        metadata.setNames[index] = xml.readElementText();
+                    } else
+                    {
+                        xml.skipCurrentElement();
+                    }
+                }
+            }
+        } else
+        {
+            xml.skipCurrentElement();
+        }
+    }
+
+    return metadata;
+}
+
+QString ProfileIndex::cacheFilePath() { return QDir(PadderCommon::configPath()).filePath("profileindex.cache"); }
+
+/**
+ * @brief Restores the stored index if it belongs to the current directory.
+ */
+void ProfileIndex::loadCache()
+{
+    QFile file(cacheFilePath());
+
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_10);
+    quint32 version = 0;
+    QString directory;
+    quint32 count = 0;
+
+    stream >> version >> directory >> count;
+
+    if ((version != CACHE_VERSION) || (directory != m_directory) || (stream.status() != QDataStream::Ok))
+        return;
+
+    QHash<QString, ProfileMetadata> profiles;
+
+    for (quint32 i = 0; (i < count) && (stream.status() == QDataStream::Ok); i++)
+    {
+        ProfileMetadata metadata;
+        stream >> metadata.filePath >> metadata.name >> metadata.deviceType >> metadata.sdlName >> metadata.setNames >>
+            metadata.setsUsed >> metadata.modified >> metadata.size >> metadata.hash;
+        profiles.insert(metadata.filePath, metadata);
+    }
+
+    if (stream.status() != QDataStream::Ok)
+    {
+        WARN() << "Ignoring damaged profile index" << file.fileName();
+        return;
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_profiles = profiles;
+}
+
+void ProfileIndex::saveCache() const
+{
+    QSaveFile file(cacheFilePath());
+
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_10);
+    QMutexLocker locker(&m_mutex);
+
+    stream << CACHE_VERSION << m_directory << static_cast<quint32>(m_profiles.count());
+
+    for (const ProfileMetadata &metadata : m_profiles)
+    {
+        stream << metadata.filePath << metadata.name << metadata.deviceType << metadata.sdlName << metadata.setNames
+               << metadata.setsUsed << metadata.modified << metadata.size << metadata.hash;
+    }
+
+    locker.unlock();
+
+    if (!file.commit())
+        WARN() << "Could not write profile index" << file.fileName();
+}
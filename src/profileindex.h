@@ -0,0 +1,108 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PROFILEINDEX_H
+#define PROFILEINDEX_H
+
+#include <QByteArray>
+#include <QFileSystemWatcher>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+
+class QFileInfo;
+
+/**
+ * @brief Metadata of a single profile file kept by ProfileIndex.
+ */
+struct ProfileMetadata
+{
+    QString filePath;
+    QString name;         ///< profilename element, empty if the profile has none
+    QString deviceType;   ///< root element, "gamecontroller" or "joystick"
+    QString sdlName;      ///< SDL name of the device the profile was saved for
+    QStringList setNames; ///< one entry per set, empty if the set has no name
+    int setsUsed = 0;
+    qint64 modified = 0; ///< msecs since epoch
+    qint64 size = 0;
+    QByteArray hash;
+};
+
+/**
+ * @brief Keeps metadata of all profiles in the profile directory.
+ *
+ *  The index is stored in the config directory, so it is available right
+ *  after startup. It is refreshed whenever QFileSystemWatcher reports a
+ *  change. Only files with a different modification time or size are read
+ *  again, in parallel on the global thread pool, and a file whose content
+ *  hash didn't change isn't parsed at all.
+ *  Lives on the GUI thread, the getters can be called from any thread.
+ */
+class ProfileIndex : public QObject
+{
+    Q_OBJECT
+
+  public:
+    static ProfileIndex *getInstance();
+    static void deleteInstance();
+
+    void setDirectory(const QString &directory);
+    QString getDirectory() const;
+
+    bool contains(const QString &filePath) const;
+    bool getMetadata(const QString &filePath, ProfileMetadata *metadata) const;
+    QList<ProfileMetadata> getProfiles() const;
+    QStringList getProfilePaths() const;
+    QString getProfileName(QFileInfo &profile) const;
+
+    static const int REFRESH_DELAY_MSECS;
+    static const quint32 CACHE_VERSION;
+
+  signals:
+    void indexUpdated();
+
+  public slots:
+    void refresh();
+
+  private slots:
+    void scheduleRefresh();
+    void finishParse();
+
+  private:
+    explicit ProfileIndex(QObject *parent = nullptr);
+    ~ProfileIndex();
+
+    static ProfileMetadata parseProfile(const ProfileMetadata &previous);
+    static QString cacheFilePath();
+    void loadCache();
+    void saveCache() const;
+
+    static ProfileIndex *instance;
+
+    mutable QMutex m_mutex;
+    QString m_directory;
+    QHash<QString, ProfileMetadata> m_profiles;
+    QFileSystemWatcher m_watcher;
+    QTimer m_refresh_timer;
+    QFutureWatcher<ProfileMetadata> m_parse_watcher;
+    bool m_refresh_pending;
+};
+
+#endif // PROFILEINDEX_H
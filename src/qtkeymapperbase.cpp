@@ -26,17 +26,38 @@ const int QtKeyMapperBase::nativeKeyPrefix;
 
 QtKeyMapperBase::QtKeyMapperBase(QObject *parent)
     : QObject(parent)
+    , populated(false)
 {
 }
 
+void QtKeyMapperBase::ensurePopulated()
+{
+    if (populated.load(std::memory_order_acquire))
+        return;
+
+    QMutexLocker locker(&populateMutex);
+
+    if (!populated.load(std::memory_order_relaxed))
+    {
+        populateMappingHashes();
+        populateCharKeyInformation();
+        populated.store(true, std::memory_order_release);
+    }
+}
+
 int QtKeyMapperBase::returnQtKey(int key, int scancode)
 {
     Q_UNUSED(scancode);
 
+    ensurePopulated();
     return virtKeyToQtKeyHash.value(key);
 }
 
-int QtKeyMapperBase::returnVirtualKey(int qkey) { return qtKeyToVirtKeyHash.value(qkey); }
+int QtKeyMapperBase::returnVirtualKey(int qkey)
+{
+    ensurePopulated();
+    return qtKeyToVirtKeyHash.value(qkey);
+}
 
 bool QtKeyMapperBase::isModifier(int qkey)
 {
@@ -72,6 +93,8 @@ QtKeyMapperBase::charKeyInformation QtKeyMapperBase::getCharKeyInformation(QChar
     temp.virtualkey = 0;
     temp.modifiers = Qt::NoModifier;
 
+    ensurePopulated();
+
     if (virtkeyToCharKeyInfo.contains(value.unicode()))
         temp = virtkeyToCharKeyInfo.value(value.unicode());
 
@@ -20,8 +20,11 @@
 #define QTKEYMAPPERBASE_H
 
 #include <QHash>
+#include <QMutex>
 #include <QObject>
 
+#include <atomic>
+
 class QtKeyMapperBase : public QObject
 {
     Q_OBJECT
@@ -86,10 +89,21 @@ class QtKeyMapperBase : public QObject
     virtual void populateMappingHashes() = 0;
     virtual void populateCharKeyInformation() = 0;
 
+    /**
+     * @brief Build the lookup tables on first use instead of in the constructor.
+     * Mappers that are never queried (like the native X11 mapper when uinput
+     * is used) then cost nothing at startup.
+     */
+    void ensurePopulated();
+
     QHash<int, int> qtKeyToVirtKeyHash;
     QHash<int, int> virtKeyToQtKeyHash;
     QHash<int, charKeyInformation> virtkeyToCharKeyInfo; // Unicode representation -> VK+Modifier information
     QString identifier;
+
+  private:
+    std::atomic<bool> populated;
+    QMutex populateMutex;
 };
 
 #endif // QTKEYMAPPERBASE_H
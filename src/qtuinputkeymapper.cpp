@@ -31,8 +31,6 @@ QtUInputKeyMapper::QtUInputKeyMapper(QObject *parent)
     : QtKeyMapperBase(parent)
 {
     identifier = "uinput";
-    populateMappingHashes();
-    populateCharKeyInformation();
 }
 
 void QtUInputKeyMapper::populateAlphaHashes()
@@ -23,7 +23,6 @@ QtVMultiKeyMapper::QtVMultiKeyMapper(QObject *parent)
     : QtKeyMapperBase(parent)
 {
     identifier = "vmulti";
-    populateMappingHashes();
 }
 
 void QtVMultiKeyMapper::populateMappingHashes()
@@ -115,8 +115,6 @@ QtWinKeyMapper::QtWinKeyMapper(QObject *parent)
     : QtKeyMapperBase(parent)
 {
     identifier = "sendinput";
-    populateMappingHashes();
-    populateCharKeyInformation();
 }
 
 void QtWinKeyMapper::populateMappingHashes()
@@ -332,6 +330,8 @@ void QtWinKeyMapper::populateMappingHashes()
 
 int QtWinKeyMapper::returnQtKey(int key, int scancode)
 {
+    ensurePopulated();
+
     int tempkey = virtKeyToQtKeyHash.value(key);
     int extended = scancode & WinExtras::EXTENDED_FLAG;
     if (key == VK_RETURN && extended)
@@ -23,7 +23,6 @@
 
 #include "qtx11keymapper.h"
 
-#include <QApplication>
 #include <QChar>
 #include <QDebug>
 #include <QHash>
@@ -40,8 +39,6 @@ QtX11KeyMapper::QtX11KeyMapper(QObject *parent)
     : QtKeyMapperBase(parent)
 {
     identifier = "xtest";
-    populateMappingHashes();
-    populateCharKeyInformation();
 }
 
 /*
@@ -26,7 +26,9 @@
 
 #include <SDL2/SDL.h>
 
+#include <QCoreApplication>
 #include <QDebug>
+#include <QFile>
 #include <QMapIterator>
 #include <QSettings>
 #include <QVariant>
@@ -36,6 +38,7 @@ SDLEventReader::SDLEventReader(QMap<SDL_JoystickID, InputDevice *> *joysticks, A
 {
     this->joysticks = joysticks;
     this->settings = settings;
+    this->databaseIndexed = false;
     settings->getLock()->lock();
     this->pollRate =
         settings->value("GamepadPollRate", GlobalVariables::AntimicroSettings::defaultSDLGamepadPollRate).toUInt();
@@ -86,6 +89,14 @@ void SDLEventReader::initSDL()
             QByteArray temparray = mappingSetting.toUtf8();
             char *mapping = temparray.data();
             SDL_GameControllerAddMapping(mapping); // Let SDL take care of validation
+
+            // User mappings take precedence over the database on hotplug too.
+            if (!tempstring.endsWith("Disable"))
+            {
+                mappingsMutex.lock();
+                loadedMappingGUIDs.insert(tempstring.left(32));
+                mappingsMutex.unlock();
+            }
         }
     }
 
@@ -250,27 +261,131 @@ void SDLEventReader::haltServices()
 }
 
 /**
- * @brief Loading additional gamepad mappings from database
- *
+ * @brief GUID string with the fields cleared which SDL 2.26 and newer ignore
+ *   when matching a mapping: the CRC16 of the device name and the version.
+ *   Only GUIDs built from vendor and product ids carry these fields.
  */
-void SDLEventReader::loadSdlMappingsFromDatabase()
+static QString mappingLookupGUID(const QString &guid, bool clearCRC, bool clearVersion)
 {
+    if ((guid.size() != 32) || (guid.mid(12, 4) != "0000") || (guid.mid(20, 4) != "0000"))
+        return guid;
+
+    QString result = guid;
+
+    if (clearCRC)
+        result.replace(4, 4, "0000");
+
+    if (clearVersion)
+        result.replace(24, 4, "0000");
+
+    return result;
+}
+
+/**
+ * @brief Read gamecontrollerdb.txt once and remember mapping lines of the
+ *   current platform keyed by GUID. Handing the whole database to SDL makes
+ *   it parse and store thousands of mappings of which only a few are used.
+ */
+void SDLEventReader::indexSdlMappingsDatabase()
+{
+    databaseIndexed = true;
+
     QString database_file;
-    database_file = QApplication::applicationDirPath().append("/../share/antimicrox/gamecontrollerdb.txt");
-    if (QFile::exists(database_file))
+    database_file = QCoreApplication::applicationDirPath().append("/../share/antimicrox/gamecontrollerdb.txt");
+    QFile database(database_file);
+
+    if (!database.open(QIODevice::ReadOnly | QIODevice::Text))
     {
-        int result = SDL_GameControllerAddMappingsFromFile(database_file.toStdString().c_str());
-        if (result == -1)
-            qWarning() << "Loading game controller mappings from database: " << database_file << " failed";
-        else
-            DEBUG() << "Loaded " << result << " game controller mappings from database";
-    }
 #ifndef QT_DEBUG
-    else
-    {
         qWarning() << "File with game controller mappings " << database_file << " does not exist";
-    }
 #endif
+        return;
+    }
+
+    const QByteArray platformField = QByteArray("platform:").append(SDL_GetPlatform()).append(',');
+
+    while (!database.atEnd())
+    {
+        QByteArray line = database.readLine().trimmed();
+
+        if (line.isEmpty() || line.startsWith('#') || !line.contains(platformField))
+            continue;
+
+        int guidEnd = line.indexOf(',');
+
+        if (guidEnd > 0)
+        {
+            QString guid = QString::fromLatin1(line.left(guidEnd));
+            QString versionlessGUID = mappingLookupGUID(guid, false, true);
+
+            databaseMappings.insert(guid, line);
+
+            if (!versionlessMappings.contains(versionlessGUID))
+                versionlessMappings.insert(versionlessGUID, line);
+        }
+    }
+
+    DEBUG() << "Indexed " << databaseMappings.size() << " game controller mappings from database";
+}
+
+/**
+ * @brief Loading additional gamepad mappings from database, only for
+ *   devices that are currently connected. Devices plugged in later get their
+ *   mapping through loadMappingForDevice.
+ */
+void SDLEventReader::loadSdlMappingsFromDatabase()
+{
+    QMutexLocker locker(&mappingsMutex);
+
+    // Mappings are dropped by SDL_Quit so every initialization starts fresh.
+    loadedMappingGUIDs.clear();
+
+    if (!databaseIndexed)
+        indexSdlMappingsDatabase();
+
+    locker.unlock();
+
+    for (int i = 0; i < SDL_NumJoysticks(); i++)
+        loadMappingForDevice(i);
+}
+
+/**
+ * @brief Hand the database mapping of a single device to SDL if there is one.
+ *   Called before a newly attached device is checked with SDL_IsGameController.
+ */
+void SDLEventReader::loadMappingForDevice(int deviceIndex)
+{
+    char guidString[65] = {'0'};
+    SDL_JoystickGetGUIDString(SDL_JoystickGetDeviceGUID(deviceIndex), guidString, sizeof(guidString));
+    QString guid = QString(guidString);
+
+    QMutexLocker locker(&mappingsMutex);
+
+    if (loadedMappingGUIDs.contains(guid))
+        return;
+
+    // Same order SDL uses when it looks up a mapping: the exact GUID, a mapping
+    // without CRC, then both again with the version ignored.
+    QByteArray mapping = databaseMappings.value(guid);
+
+    if (mapping.isEmpty())
+        mapping = databaseMappings.value(mappingLookupGUID(guid, true, false));
+
+    if (mapping.isEmpty())
+        mapping = versionlessMappings.value(mappingLookupGUID(guid, false, true));
+
+    if (mapping.isEmpty())
+        mapping = versionlessMappings.value(mappingLookupGUID(guid, true, true));
+
+    if (mapping.isEmpty())
+        return;
+
+    loadedMappingGUIDs.insert(guid);
+
+    if (SDL_GameControllerAddMapping(mapping.constData()) == -1)
+        qWarning() << "Loading game controller mapping for " << guid << " failed: " << SDL_GetError();
+    else
+        DEBUG() << "Loaded game controller mapping from database for " << guid;
 }
 
 QMap<SDL_JoystickID, InputDevice *> *SDLEventReader::getJoysticks() const { return joysticks; }
@@ -21,6 +21,10 @@
 
 #include "joystick.h"
 
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+
 class InputDevice;
 class AntiMicroSettings;
 
@@ -39,6 +43,8 @@ class SDLEventReader : public QObject
     AntiMicroSettings *getSettings() const;
     QTimer const &getPollRateTimer();
 
+    void loadMappingForDevice(int deviceIndex);
+
   protected:
     void initSDL();
     void closeSDL();
@@ -71,6 +77,13 @@ class SDLEventReader : public QObject
     int pollRate;
     QTimer pollRateTimer;
 
+    QHash<QString, QByteArray> databaseMappings;    // GUID -> mapping line for current platform
+    QHash<QString, QByteArray> versionlessMappings; // GUID without version -> first such mapping line
+    QSet<QString> loadedMappingGUIDs;
+    bool databaseIndexed;
+    QMutex mappingsMutex;
+
+    void indexSdlMappingsDatabase();
     void loadSdlMappingsFromDatabase();
 };
 
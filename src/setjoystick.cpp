@@ -23,10 +23,12 @@
 #include "joybuttontypes/joybutton.h"
 #include "joybuttontypes/joycontrolstickbutton.h"
 #include "joybuttontypes/joysensorbutton.h"
+#include "joybuttontypes/joytouchpadbutton.h"
 #include "joycontrolstick.h"
 #include "joydpad.h"
 #include "joysensor.h"
 #include "joysensorfactory.h"
+#include "joytouchpad.h"
 #include "vdpad.h"
 
 #include <QDebug>
@@ -70,6 +72,8 @@ JoyControlStick *SetJoystick::getJoyStick(int index) const { return getSticks().
 
 JoySensor *SetJoystick::getSensor(JoySensorType type) const { return m_sensors.value(type); }
 
+JoyTouchpad *SetJoystick::getTouchpad(int index) const { return m_touchpads.value(index); }
+
 void SetJoystick::refreshButtons()
 {
     deleteButtons();
@@ -134,6 +138,21 @@ void SetJoystick::refreshSensors()
     }
 }
 
+/**
+ * @brief Setup touchpad objects for all touchpads of the device.
+ */
+void SetJoystick::refreshTouchpads()
+{
+    deleteTouchpads();
+
+    for (int i = 0; i < m_device->getNumberRawTouchpads(); i++)
+    {
+        JoyTouchpad *touchpad = new JoyTouchpad(i, m_index, this, this);
+        m_touchpads.insert(i, touchpad);
+        enableTouchpadConnections(touchpad);
+    }
+}
+
 void SetJoystick::deleteButtons()
 {
     QHashIterator<int, JoyButton *> iter(getButtons());
@@ -238,6 +257,20 @@ void SetJoystick::deleteSensors()
     m_sensors.clear();
 }
 
+/**
+ * @brief Destroy all touchpad objects in this set
+ */
+void SetJoystick::deleteTouchpads()
+{
+    for (const auto &touchpad : m_touchpads)
+    {
+        if (touchpad != nullptr)
+            touchpad->deleteLater();
+    }
+
+    m_touchpads.clear();
+}
+
 int SetJoystick::getNumberButtons() const { return getButtons().count(); }
 
 int SetJoystick::getNumberAxes() const { return axes.count(); }
@@ -252,6 +285,8 @@ int SetJoystick::getNumberSticks() const { return getSticks().size(); }
  */
 bool SetJoystick::hasSensor(JoySensorType type) const { return m_sensors.contains(type); }
 
+int SetJoystick::getNumberTouchpads() const { return m_touchpads.size(); }
+
 int SetJoystick::getNumberVDPads() const { return getVdpads().size(); }
 
 /**
@@ -265,6 +300,7 @@ void SetJoystick::reset()
     deleteVDpads();
     refreshAxes();
     refreshSensors();
+    refreshTouchpads();
     refreshButtons();
     refreshHats();
     m_name = QString();
@@ -345,6 +381,9 @@ void SetJoystick::release()
         sensor->joyEvent(values, true);
     }
 
+    for (const auto &touchpad : m_touchpads)
+        touchpad->release();
+
     QHashIterator<int, JoyButton *> iterButtons(getButtons());
 
     while (iterButtons.hasNext())
@@ -412,6 +451,15 @@ bool SetJoystick::isSetEmpty()
             result = false;
     }
 
+    for (const auto &touchpad : m_touchpads)
+    {
+        if (!result)
+            break;
+
+        if (!touchpad->isDefault())
+            result = false;
+    }
+
     QHashIterator<int, VDPad *> iter5(getVdpads());
 
     while (iter5.hasNext() && result)
@@ -925,9 +973,22 @@ void SetJoystick::enableSensorConnections(JoySensor *sensor)
         connect(iter.value(), &JoySensorButton::released, this, &SetJoystick::propagateSetSensorButtonRelease,
                 Qt::QueuedConnection);
         connect(iter.value(), &JoySensorButton::buttonNameChanged, this, &SetJoystick::propagateSetSensorButtonNameChange);
+        connect(iter.value(), &JoySensorButton::slotsChanged, this, &SetJoystick::sensorSlotsChanged);
     }
 }
 
+/**
+ * @brief Establishes connections for event propagation between JoyTouchpad and InputDevice
+ */
+void SetJoystick::enableTouchpadConnections(JoyTouchpad *touchpad)
+{
+    connect(touchpad, &JoyTouchpad::propertyUpdated, this, &SetJoystick::propertyUpdated);
+
+    auto buttons = touchpad->getButtons();
+    for (auto iter = buttons->cbegin(); iter != buttons->cend(); ++iter)
+        connect(iter.value(), &JoyTouchpadButton::setChangeActivated, this, &SetJoystick::propogateSetChange);
+}
+
 InputDevice *SetJoystick::getInputDevice() const { return m_device; }
 
 void SetJoystick::setName(QString name)
@@ -981,6 +1042,14 @@ void SetJoystick::copyAssignments(SetJoystick *destSet)
             sourceSensor->copyAssignments(destSensor);
     }
 
+    for (auto iter = m_touchpads.cbegin(); iter != m_touchpads.cend(); ++iter)
+    {
+        JoyTouchpad *destTouchpad = destSet->getTouchpad(iter.key());
+
+        if (destTouchpad != nullptr)
+            iter.value()->copyAssignments(destTouchpad);
+    }
+
     for (int i = 0; i < m_device->getNumberHats(); i++)
     {
         JoyDPad *sourceDPad = getHats().value(i);
@@ -1013,6 +1082,141 @@ void SetJoystick::copyAssignments(SetJoystick *destSet)
     }
 }
 
+/**
+ * @brief Copies what all sets of a device share to a newly created set:
+ *  element names, axis throttles, control sticks and virtual dpads.
+ *  Assignments are left alone.
+ */
+void SetJoystick::copyLayout(SetJoystick *destSet)
+{
+    for (auto iter = axes.cbegin(); iter != axes.cend(); ++iter)
+    {
+        JoyAxis *sourceAxis = iter.value();
+        JoyAxis *destAxis = destSet->axes.value(iter.key());
+
+        if ((sourceAxis == nullptr) || (destAxis == nullptr))
+            continue;
+
+        destAxis->setThrottle(sourceAxis->getThrottle());
+        destAxis->setAxisName(sourceAxis->getAxisName());
+        destAxis->getNAxisButton()->setButtonName(sourceAxis->getNAxisButton()->getButtonName());
+        destAxis->getPAxisButton()->setButtonName(sourceAxis->getPAxisButton()->getButtonName());
+    }
+
+    for (auto iter = getButtons().cbegin(); iter != getButtons().cend(); ++iter)
+    {
+        JoyButton *destButton = destSet->getJoyButton(iter.key());
+
+        if (destButton != nullptr)
+            destButton->setButtonName(iter.value()->getButtonName());
+    }
+
+    for (auto iter = getHats().cbegin(); iter != getHats().cend(); ++iter)
+    {
+        JoyDPad *destDPad = destSet->getJoyDPad(iter.key());
+
+        if (destDPad == nullptr)
+            continue;
+
+        destDPad->setDPadName(iter.value()->getDpadName());
+
+        for (auto button = iter.value()->getButtons()->cbegin(); button != iter.value()->getButtons()->cend(); ++button)
+        {
+            JoyDPadButton *destButton = destDPad->getJoyButton(button.key());
+
+            if (destButton != nullptr)
+                destButton->setButtonName(button.value()->getButtonName());
+        }
+    }
+
+    for (auto iter = m_sensors.cbegin(); iter != m_sensors.cend(); ++iter)
+    {
+        JoySensor *destSensor = destSet->getSensor(iter.key());
+
+        if (destSensor == nullptr)
+            continue;
+
+        destSensor->setSensorName(iter.value()->getSensorName());
+
+        for (auto button = iter.value()->getButtons()->cbegin(); button != iter.value()->getButtons()->cend(); ++button)
+        {
+            JoySensorButton *destButton = destSensor->getDirectionButton(button.key());
+
+            if (destButton != nullptr)
+                destButton->setButtonName(button.value()->getButtonName());
+        }
+    }
+
+    for (auto iter = getSticks().cbegin(); iter != getSticks().cend(); ++iter)
+    {
+        JoyControlStick *sourceStick = iter.value();
+        JoyControlStick *destStick = destSet->getJoyStick(iter.key());
+
+        if (destStick == nullptr)
+        {
+            JoyAxis *axisX = destSet->getJoyAxis(sourceStick->getAxisX()->getIndex());
+            JoyAxis *axisY = destSet->getJoyAxis(sourceStick->getAxisY()->getIndex());
+
+            if ((axisX == nullptr) || (axisY == nullptr))
+                continue;
+
+            destStick = new JoyControlStick(axisX, axisY, iter.key(), destSet->getIndex(), m_device);
+            destSet->addControlStick(iter.key(), destStick);
+        }
+
+        destStick->setStickName(sourceStick->getStickName());
+
+        for (auto button = sourceStick->getButtons()->cbegin(); button != sourceStick->getButtons()->cend(); ++button)
+        {
+            JoyControlStickButton *destButton = destStick->getDirectionButton(button.key());
+
+            if (destButton != nullptr)
+                destButton->setButtonName(button.value()->getButtonName());
+        }
+    }
+
+    for (auto iter = getVdpads().cbegin(); iter != getVdpads().cend(); ++iter)
+    {
+        VDPad *sourceVDPad = iter.value();
+
+        if ((sourceVDPad == nullptr) || (destSet->getVDPad(iter.key()) != nullptr))
+            continue;
+
+        VDPad *destVDPad = new VDPad(iter.key(), destSet->getIndex(), destSet, destSet);
+        const JoyDPadButton::JoyDPadDirections directions[] = {JoyDPadButton::DpadUp, JoyDPadButton::DpadDown,
+                                                               JoyDPadButton::DpadLeft, JoyDPadButton::DpadRight};
+
+        for (JoyDPadButton::JoyDPadDirections direction : directions)
+        {
+            JoyButton *sourceButton = sourceVDPad->getVButton(direction);
+            JoyAxisButton *sourceAxisButton = qobject_cast<JoyAxisButton *>(sourceButton);
+            JoyButton *destButton = nullptr;
+
+            if (sourceAxisButton != nullptr)
+            {
+                JoyAxis *destAxis = destSet->getJoyAxis(sourceAxisButton->getAxis()->getIndex());
+
+                if (destAxis != nullptr)
+                {
+                    if (sourceAxisButton == sourceAxisButton->getAxis()->getNAxisButton())
+                        destButton = destAxis->getNAxisButton();
+                    else
+                        destButton = destAxis->getPAxisButton();
+                }
+            } else if (sourceButton != nullptr)
+            {
+                destButton = destSet->getJoyButton(sourceButton->getJoyNumber());
+            }
+
+            if (destButton != nullptr)
+                destVDPad->addVButton(direction, destButton);
+        }
+
+        destVDPad->setDPadName(sourceVDPad->getDpadName());
+        destSet->addVDPad(iter.key(), destVDPad);
+    }
+}
+
 QString SetJoystick::getSetLabel()
 {
     QString temp = QString();
@@ -1112,4 +1316,10 @@ QHash<int, JoyControlStick *> const &SetJoystick::getSticks() const { return sti
  */
 QHash<JoySensorType, JoySensor *> const &SetJoystick::getSensors() const { return m_sensors; }
 
+/**
+ * @brief Get all touchpad objects in this set.
+ * @returns Touchpads in this set
+ */
+QHash<int, JoyTouchpad *> const &SetJoystick::getTouchpads() const { return m_touchpads; }
+
 QHash<int, VDPad *> const &SetJoystick::getVdpads() const { return vdpads; }
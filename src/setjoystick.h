@@ -29,6 +29,7 @@ class JoyButton;
 class JoyDPad;
 class JoyControlStick;
 class JoySensor;
+class JoyTouchpad;
 class VDPad;
 
 /**
@@ -50,6 +51,7 @@ class SetJoystick : public SetJoystickXml
     JoyDPad *getJoyDPad(int index) const;
     JoyControlStick *getJoyStick(int index) const;
     JoySensor *getSensor(JoySensorType type) const;
+    JoyTouchpad *getTouchpad(int index) const;
     VDPad *getVDPad(int index) const;
 
     int getNumberButtons() const;
@@ -57,12 +59,14 @@ class SetJoystick : public SetJoystickXml
     int getNumberHats() const;
     int getNumberSticks() const;
     bool hasSensor(JoySensorType type) const;
+    int getNumberTouchpads() const;
     int getNumberVDPads() const;
 
     QHash<int, JoyButton *> const &getButtons() const;
     QHash<int, JoyDPad *> const &getHats() const;
     QHash<int, JoyControlStick *> const &getSticks() const;
     QHash<JoySensorType, JoySensor *> const &getSensors() const;
+    QHash<int, JoyTouchpad *> const &getTouchpads() const;
     QHash<int, VDPad *> const &getVdpads() const;
     QHash<int, JoyAxis *> *getAxes();
 
@@ -72,6 +76,7 @@ class SetJoystick : public SetJoystickXml
     virtual void refreshAxes();    // SetAxis class
     virtual void refreshHats();    // SetHat class
     virtual void refreshSensors();
+    virtual void refreshTouchpads();
     void release();
     void addControlStick(int index, JoyControlStick *stick); // SetStick class
     void removeControlStick(int index);                      // SetStick class
@@ -100,12 +105,14 @@ class SetJoystick : public SetJoystickXml
     void deleteHats();    // SetHat class
     void deleteSticks();  // SetStick class
     void deleteSensors();
+    void deleteTouchpads();
     void deleteVDpads(); // SetVDPad class
 
     void enableButtonConnections(JoyButton *button); // SetButton class
     void enableAxisConnections(JoyAxis *axis);       // SetAxis class
     void enableHatConnections(JoyDPad *dpad);        // SetHat class
     void enableSensorConnections(JoySensor *sensor);
+    void enableTouchpadConnections(JoyTouchpad *touchpad);
 
   signals:
     void setChangeActivated(int index);
@@ -144,10 +151,12 @@ class SetJoystick : public SetJoystickXml
     void setDPadNameChange(int dpadIndex);   // SetHat class
     void setVDPadNameChange(int vdpadIndex); // SetVDPad class
     void propertyUpdated();
+    void sensorSlotsChanged();
 
   public slots:
     virtual void reset();
     void copyAssignments(SetJoystick *destSet);
+    void copyLayout(SetJoystick *destSet);
     void propogateSetChange(int index);
     void propogateSetButtonAssociation(int button, int newset, int mode);                 // SetButton class
     void propogateSetAxisButtonAssociation(int button, int axis, int newset, int mode);   // SetAxis class
@@ -192,6 +201,7 @@ class SetJoystick : public SetJoystickXml
     QHash<int, JoyDPad *> hats;
     QHash<int, JoyControlStick *> sticks;
     QHash<JoySensorType, JoySensor *> m_sensors;
+    QHash<int, JoyTouchpad *> m_touchpads;
     QHash<int, VDPad *> vdpads;
 
     QList<JoyButton *> lastClickedButtons;
@@ -0,0 +1,84 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "startupprofiler.h"
+
+#include "logger.h"
+
+std::atomic<bool> StartupProfiler::enabled(false);
+std::atomic<bool> StartupProfiler::recording(false);
+std::atomic<bool> StartupProfiler::reported(false);
+QElapsedTimer StartupProfiler::timer;
+QList<QPair<QString, qint64>> StartupProfiler::marks;
+QMutex StartupProfiler::mutex;
+
+void StartupProfiler::start()
+{
+    QMutexLocker locker(&mutex);
+
+    recording = true;
+    reported = false;
+    marks.clear();
+    timer.start();
+}
+
+void StartupProfiler::setEnabled(bool status) { enabled = status; }
+
+bool StartupProfiler::isRecording() { return recording; }
+
+void StartupProfiler::mark(const QString &phase)
+{
+    if (!recording)
+        return;
+
+    QMutexLocker locker(&mutex);
+
+    qint64 elapsed = timer.elapsed();
+    qint64 previous = marks.isEmpty() ? 0 : marks.last().second;
+    marks.append(qMakePair(phase, elapsed));
+
+    if (reported)
+        printMark(phase, elapsed, previous);
+}
+
+void StartupProfiler::report()
+{
+    QMutexLocker locker(&mutex);
+
+    if (!enabled)
+    {
+        recording = false;
+        marks.clear();
+        return;
+    }
+
+    PRINT_STDOUT() << "Startup profile (ms since start, delta):\n";
+
+    qint64 previous = 0;
+
+    for (const auto &entry : marks)
+    {
+        printMark(entry.first, entry.second, previous);
+        previous = entry.second;
+    }
+
+    reported = true;
+}
+
+void StartupProfiler::printMark(const QString &phase, qint64 elapsed, qint64 previous)
+{
+    PRINT_STDOUT() << QString("  %1 %2  %3\n").arg(elapsed, 7).arg(QString("(+%1)").arg(elapsed - previous), 9).arg(phase);
+}
@@ -0,0 +1,57 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STARTUPPROFILER_H
+#define STARTUPPROFILER_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+
+#include <atomic>
+
+/**
+ * @brief Collects timestamps of startup phases for --startup-profile.
+ *
+ * Marks are recorded from start() on, because the command line is parsed
+ * only after the first phases already ran. report() prints them if the
+ * option was given and stops recording otherwise. Marks made after the
+ * report are printed immediately, so late phases like the first
+ * dispatched input event still show up.
+ */
+class StartupProfiler
+{
+  public:
+    static void start();
+    static void setEnabled(bool status);
+    static bool isRecording();
+    static void mark(const QString &phase);
+    static void report();
+
+  private:
+    static void printMark(const QString &phase, qint64 elapsed, qint64 previous);
+
+    static std::atomic<bool> enabled;
+    static std::atomic<bool> recording;
+    static std::atomic<bool> reported;
+    static QElapsedTimer timer;
+    static QList<QPair<QString, qint64>> marks;
+    static QMutex mutex;
+};
+
+#endif // STARTUPPROFILER_H
@@ -0,0 +1,108 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STICKEVENTVARIANT_H
+#define STICKEVENTVARIANT_H
+
+#include <type_traits>
+
+/**
+ * @brief Selects the instantiation of a stick event template which is
+ *     specialized on the stick mode, the modifier zone direction and
+ *     whether a direction delay is set.
+ *
+ *  The variant is computed once when one of these properties changes.
+ *  dispatch() turns it into a direct call of the matching instantiation
+ *  through a single switch, so the compiler can inline the specialized
+ *  body, unlike a call through a member function pointer.
+ */
+namespace StickEventVariant {
+
+const int COUNT = 16;
+
+constexpr int select(int mode, bool invertedModifierZone, bool delayed)
+{
+    return (mode << 2) | (invertedModifierZone ? 2 : 0) | (delayed ? 1 : 0);
+}
+
+constexpr int mode(int variant) { return variant >> 2; }
+
+constexpr bool invertedModifierZone(int variant) { return (variant & 2) != 0; }
+
+constexpr bool delayed(int variant) { return (variant & 1) != 0; }
+
+/**
+ * @brief Calls function with std::integral_constant<int, variant>, so it
+ *     can pass the variant on as a template argument.
+ */
+template <typename Function> inline void dispatch(int variant, Function &&function)
+{
+    switch (variant)
+    {
+    case 0:
+        function(std::integral_constant<int, 0>());
+        break;
+    case 1:
+        function(std::integral_constant<int, 1>());
+        break;
+    case 2:
+        function(std::integral_constant<int, 2>());
+        break;
+    case 3:
+        function(std::integral_constant<int, 3>());
+        break;
+    case 4:
+        function(std::integral_constant<int, 4>());
+        break;
+    case 5:
+        function(std::integral_constant<int, 5>());
+        break;
+    case 6:
+        function(std::integral_constant<int, 6>());
+        break;
+    case 7:
+        function(std::integral_constant<int, 7>());
+        break;
+    case 8:
+        function(std::integral_constant<int, 8>());
+        break;
+    case 9:
+        function(std::integral_constant<int, 9>());
+        break;
+    case 10:
+        function(std::integral_constant<int, 10>());
+        break;
+    case 11:
+        function(std::integral_constant<int, 11>());
+        break;
+    case 12:
+        function(std::integral_constant<int, 12>());
+        break;
+    case 13:
+        function(std::integral_constant<int, 13>());
+        break;
+    case 14:
+        function(std::integral_constant<int, 14>());
+        break;
+    case 15:
+        function(std::integral_constant<int, 15>());
+        break;
+    }
+}
+
+} // namespace StickEventVariant
+
+#endif // STICKEVENTVARIANT_H
@@ -0,0 +1,197 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "stickresponsemap.h"
+
+namespace {
+const int RAW_OFFSET = 32768;
+const int CELL_SIZE = 1 << StickResponseMap::GRID_SHIFT;
+const int CELL_DIAGONAL = 363; // ceil(CELL_SIZE * sqrt(2))
+} // namespace
+
+StickResponseMap::StickResponseMap()
+    : m_deadZoneLow(0)
+    , m_deadZoneHigh(0)
+    , m_maxZoneLow(0)
+    , m_maxZoneHigh(0)
+    , m_complete(false)
+{
+}
+
+/**
+ * @brief Samples the passed exact calculations on every grid node.
+ *     Runs GRID_NODES * GRID_NODES evaluations, so it should only be
+ *     called after a stick property changed.
+ */
+void StickResponseMap::rebuild(const DirectionFunction &direction, const DistanceFunction &distance, int deadZone,
+                               int maxZoneLow, int maxZoneHigh)
+{
+    rebuildRows(direction, distance, deadZone, maxZoneLow, maxZoneHigh, 0, GRID_NODES);
+}
+
+/**
+ * @brief Samples the passed exact calculations on up to rowCount grid
+ *     rows starting at firstRow. Starting at row 0 discards the previous
+ *     table, it is used again once the last row was sampled.
+ *     deadZone is the raw radius at which the distance leaves 0.0, it
+ *     reaches 1.0 between the raw radii maxZoneLow and maxZoneHigh.
+ * @return First row which wasn't sampled yet, GRID_NODES when done.
+ */
+int StickResponseMap::rebuildRows(const DirectionFunction &direction, const DistanceFunction &distance, int deadZone,
+                                  int maxZoneLow, int maxZoneHigh, int firstRow, int rowCount)
+{
+    if ((firstRow <= 0) || (m_directions.size() != GRID_NODES * GRID_NODES))
+    {
+        firstRow = 0;
+        m_complete = false;
+        m_directions.resize(GRID_NODES * GRID_NODES);
+        m_distances.resize(GRID_NODES * GRID_NODES);
+        setRadiusBand(deadZone, deadZone, m_deadZoneLow, m_deadZoneHigh);
+        setRadiusBand(maxZoneLow, maxZoneHigh, m_maxZoneLow, m_maxZoneHigh);
+    }
+
+    int lastRow = qMin(firstRow + rowCount, static_cast<int>(GRID_NODES));
+
+    for (int row = firstRow; row < lastRow; row++)
+    {
+        int axisYValue = (row * CELL_SIZE) - RAW_OFFSET;
+
+        for (int column = 0; column < GRID_NODES; column++)
+        {
+            int axisXValue = (column * CELL_SIZE) - RAW_OFFSET;
+            int index = nodeIndex(column, row);
+
+            m_directions[index] = static_cast<quint8>(direction(axisXValue, axisYValue));
+            m_distances[index] = static_cast<float>(distance(axisXValue, axisYValue));
+        }
+    }
+
+    if (lastRow == GRID_NODES)
+        m_complete = true;
+
+    return lastRow;
+}
+
+void StickResponseMap::clear()
+{
+    m_directions.clear();
+    m_distances.clear();
+    m_complete = false;
+}
+
+bool StickResponseMap::isEmpty() const { return !m_complete; }
+
+/**
+ * @brief Gets the direction of the passed position if all corners of its
+ *     cell agree on it and the cell cannot reach the dead zone or max zone
+ *     radius.
+ * @return True if direction was set.
+ */
+bool StickResponseMap::lookupDirection(int axisXValue, int axisYValue, int &direction) const
+{
+    int node = 0;
+    int fractionX = 0;
+    int fractionY = 0;
+
+    if (isEmpty() || !cellFor(axisXValue, axisYValue, node, fractionX, fractionY))
+        return false;
+
+    // Any point of the cell is less than a cell diagonal away from the position.
+    qint64 squareDist = (static_cast<qint64>(axisXValue) * axisXValue) + (static_cast<qint64>(axisYValue) * axisYValue);
+
+    if (((squareDist >= m_deadZoneLow) && (squareDist <= m_deadZoneHigh)) ||
+        ((squareDist >= m_maxZoneLow) && (squareDist <= m_maxZoneHigh)))
+    {
+        return false;
+    }
+
+    const quint8 *corners = m_directions.constData() + node;
+    quint8 topLeft = corners[0];
+
+    if ((corners[1] != topLeft) || (corners[GRID_NODES] != topLeft) || (corners[GRID_NODES + 1] != topLeft))
+        return false;
+
+    direction = topLeft;
+    return true;
+}
+
+/**
+ * @brief Interpolates the distance of the passed position between the
+ *     corners of its cell. Cells that are partly clamped to 0.0 or 1.0
+ *     are left to the exact calculation.
+ * @return True if distance was set.
+ */
+bool StickResponseMap::lookupDistance(int axisXValue, int axisYValue, double &distance) const
+{
+    int node = 0;
+    int fractionX = 0;
+    int fractionY = 0;
+
+    if (isEmpty() || !cellFor(axisXValue, axisYValue, node, fractionX, fractionY))
+        return false;
+
+    const float *corners = m_distances.constData() + node;
+    float topLeft = corners[0];
+    float topRight = corners[1];
+    float bottomLeft = corners[GRID_NODES];
+    float bottomRight = corners[GRID_NODES + 1];
+
+    float low = qMin(qMin(topLeft, topRight), qMin(bottomLeft, bottomRight));
+    float high = qMax(qMax(topLeft, topRight), qMax(bottomLeft, bottomRight));
+
+    if (((low <= 0.0f) || (high >= 1.0f)) && (low != high))
+        return false;
+
+    double weightX = fractionX / static_cast<double>(CELL_SIZE);
+    double weightY = fractionY / static_cast<double>(CELL_SIZE);
+    double top = topLeft + ((topRight - topLeft) * weightX);
+    double bottom = bottomLeft + ((bottomRight - bottomLeft) * weightX);
+
+    distance = top + ((bottom - top) * weightY);
+    return true;
+}
+
+int StickResponseMap::nodeIndex(int column, int row) { return (row * GRID_NODES) + column; }
+
+/**
+ * @brief Squared bounds of the radii within one cell diagonal of the passed
+ *     radius range.
+ */
+void StickResponseMap::setRadiusBand(int lowRadius, int highRadius, qint64 &low, qint64 &high)
+{
+    qint64 inner = qMax(0, lowRadius - CELL_DIAGONAL);
+    qint64 outer = static_cast<qint64>(highRadius) + CELL_DIAGONAL;
+
+    low = inner * inner;
+    high = outer * outer;
+}
+
+bool StickResponseMap::cellFor(int axisXValue, int axisYValue, int &node, int &fractionX, int &fractionY)
+{
+    int offsetX = axisXValue + RAW_OFFSET;
+    int offsetY = axisYValue + RAW_OFFSET;
+
+    int rawRange = GRID_CELLS * CELL_SIZE;
+
+    if ((offsetX < 0) || (offsetY < 0) || (offsetX >= rawRange) || (offsetY >= rawRange))
+        return false;
+
+    node = nodeIndex(offsetX >> GRID_SHIFT, offsetY >> GRID_SHIFT);
+    fractionX = offsetX & (CELL_SIZE - 1);
+    fractionY = offsetY & (CELL_SIZE - 1);
+    return true;
+}
@@ -0,0 +1,80 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef STICKRESPONSEMAP_H
+#define STICKRESPONSEMAP_H
+
+#include <QVector>
+
+#include <functional>
+
+/**
+ * @brief Quantized lookup of a stick's direction and radial distance.
+ *
+ * The raw axis range is split into GRID_CELLS x GRID_CELLS cells and the
+ * exact direction and distance are sampled on every cell corner. A lookup
+ * is answered from the table only when the result cannot differ from the
+ * exact calculation. The direction wedges are convex, so a cell whose four
+ * corners agree on a direction lies inside one wedge. The area in which a
+ * direction acts is a wedge minus the dead zone disk though, which is not
+ * convex, so positions within one cell diagonal of the dead zone or max zone
+ * radius are left to the exact calculation. Distances are interpolated
+ * between the corners unless the cell touches the dead zone or max zone,
+ * where the exact value is needed for clean activation edges.
+ * Lookups returning false must be answered by the exact calculation.
+ *
+ * The table can be filled a few rows at a time with rebuildRows(), so the
+ * owner can spread a rebuild over several event loop iterations. Lookups
+ * return false until the last row was sampled.
+ */
+class StickResponseMap
+{
+  public:
+    typedef std::function<int(int, int)> DirectionFunction;
+    typedef std::function<double(int, int)> DistanceFunction;
+
+    static const int GRID_SHIFT = 8;
+    static const int GRID_CELLS = 256;
+    static const int GRID_NODES = GRID_CELLS + 1;
+
+    StickResponseMap();
+
+    void rebuild(const DirectionFunction &direction, const DistanceFunction &distance, int deadZone, int maxZoneLow,
+                 int maxZoneHigh);
+    int rebuildRows(const DirectionFunction &direction, const DistanceFunction &distance, int deadZone, int maxZoneLow,
+                    int maxZoneHigh, int firstRow, int rowCount);
+    void clear();
+    bool isEmpty() const;
+
+    bool lookupDirection(int axisXValue, int axisYValue, int &direction) const;
+    bool lookupDistance(int axisXValue, int axisYValue, double &distance) const;
+
+  private:
+    static int nodeIndex(int column, int row);
+    static bool cellFor(int axisXValue, int axisYValue, int &node, int &fractionX, int &fractionY);
+    static void setRadiusBand(int lowRadius, int highRadius, qint64 &low, qint64 &high);
+
+    QVector<quint8> m_directions; ///< sampled direction per grid node
+    QVector<float> m_distances;   ///< sampled distance per grid node
+    qint64 m_deadZoneLow;         ///< squared radii around the dead zone
+    qint64 m_deadZoneHigh;        ///< which get no direction lookups
+    qint64 m_maxZoneLow;          ///< squared radii around the max zone
+    qint64 m_maxZoneHigh;         ///< which get no direction lookups
+    bool m_complete;              ///< all rows were sampled
+};
+
+#endif // STICKRESPONSEMAP_H
@@ -0,0 +1,68 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef TURBOPHASE_H
+#define TURBOPHASE_H
+
+#include <cmath>
+
+/**
+ * @brief Position of a turbo button within its press and release period.
+ *
+ *  A period starts with the press and the key is released once the phase
+ *  reaches the duty cycle. Ticks come at a fixed rate, so a part of the
+ *  period shorter than a tick can be passed without a tick inside it.
+ *  Such a part is still sent as a toggle lasting one tick. This applies
+ *  to a short press and to a short release alike. A period shorter than
+ *  two ticks cannot fit both toggles and drops some of them.
+ */
+namespace TurboPhase {
+
+/**
+ * @brief Advances the phase and tells whether the key should be pressed.
+ * @param phase Position within the period, 0 to 1. Updated in place.
+ * @param periods Time since the previous tick in periods
+ * @param duty Part of the period the key stays pressed, 0 to 1
+ * @param pressed Whether the key is pressed now
+ * @return True if the key should be pressed after this tick
+ */
+inline bool advance(double &phase, double periods, double duty, bool pressed)
+{
+    double start = phase;
+    double position = start + periods;
+    phase = position - std::floor(position);
+
+    if (duty >= 1.0)
+        return true;
+    else if (duty <= 0.0)
+        return false;
+
+    bool inPress = (phase < duty);
+    bool passedPress = (std::floor(position) > std::floor(start));
+    bool passedRelease = (std::floor(position - duty) > std::floor(start - duty));
+
+    if (!pressed && !inPress && passedPress)
+        return true;
+    else if (pressed && inPress && passedRelease)
+        return false;
+
+    return inPress;
+}
+
+} // namespace TurboPhase
+
+#endif // TURBOPHASE_H
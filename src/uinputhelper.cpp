@@ -16,7 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <QApplication>
+#include <QCoreApplication>
 #include <linux/input.h>
 #include <linux/uinput.h>
 
@@ -28,7 +28,7 @@ UInputHelper::UInputHelper(QObject *parent)
     : QObject(parent)
 {
     populateKnownAliases();
-    connect(qApp, &QApplication::aboutToQuit, this, &UInputHelper::deleteLater);
+    connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &UInputHelper::deleteLater);
 }
 
 UInputHelper::~UInputHelper() { _instance = nullptr; }
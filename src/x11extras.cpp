@@ -26,6 +26,7 @@
 
 #include <QDebug>
 #include <QFileInfo>
+#include <QSocketNotifier>
 #include <QThreadStorage>
 
 #include "x11extras.h"
@@ -37,9 +38,12 @@ X11Extras *X11Extras::_instance = nullptr;
 X11Extras::X11Extras(QObject *parent)
     : QObject(parent)
     , knownAliases()
+    , keymapNotifier(nullptr)
+    , xkbEventBase(-1)
 {
     _display = XOpenDisplay(nullptr);
     populateKnownAliases();
+    watchKeymap();
     _instance = this;
 }
 
@@ -63,6 +67,12 @@ template <typename T> void freeWindow(T *window)
 
 void X11Extras::freeDisplay()
 {
+    if (keymapNotifier != nullptr)
+    {
+        delete keymapNotifier;
+        keymapNotifier = nullptr;
+    }
+
     if (_display != nullptr)
     {
         XCloseDisplay(_display);
@@ -610,6 +620,85 @@ int X11Extras::getGroup1KeySym(int virtualkey)
     return XkbKeycodeToKeysym(display, temp, 0, 0);
 }
 
+/**
+ * @brief Gets the key code of a KeySym name like "KP_7". Results are cached
+ *  until the keyboard mapping changes.
+ */
+int X11Extras::getKeycode(const QString &keysymName)
+{
+    auto iter = keycodeCache.constFind(keysymName);
+
+    if (iter != keycodeCache.constEnd())
+        return iter.value();
+
+    int keycode = XKeysymToKeycode(display(), XStringToKeysym(keysymName.toUtf8().constData()));
+    keycodeCache.insert(keysymName, keycode);
+    return keycode;
+}
+
+/**
+ * @brief Asks the X server for keyboard mapping notifications on this
+ *  connection and reads them whenever the connection becomes readable.
+ */
+void X11Extras::watchKeymap()
+{
+    int opcode = 0;
+    int errorBase = 0;
+    int major = XkbMajorVersion;
+    int minor = XkbMinorVersion;
+
+    if ((_display == nullptr) || !XkbQueryExtension(_display, &opcode, &xkbEventBase, &errorBase, &major, &minor))
+        return;
+
+    const unsigned int events = XkbNewKeyboardNotifyMask | XkbMapNotifyMask;
+    XkbSelectEvents(_display, XkbUseCoreKbd, events, events);
+    XFlush(_display);
+
+    keymapNotifier = new QSocketNotifier(ConnectionNumber(_display), QSocketNotifier::Read, this);
+    connect(keymapNotifier, &QSocketNotifier::activated, this, &X11Extras::processKeymapEvents);
+}
+
+/**
+ * @brief Xlib only updates its copy of the keyboard mapping while handling
+ *  the notifications, so they are read here although nothing else on this
+ *  connection uses events.
+ */
+void X11Extras::processKeymapEvents()
+{
+    bool changed = false;
+
+    while (XPending(_display) > 0)
+    {
+        XEvent event;
+        XNextEvent(_display, &event);
+
+        if (event.type == MappingNotify)
+        {
+            XRefreshKeyboardMapping(&event.xmapping);
+            changed = true;
+        } else if (event.type == xkbEventBase)
+        {
+            XkbEvent *xkbEvent = reinterpret_cast<XkbEvent *>(&event);
+
+            if (xkbEvent->any.xkb_type == XkbMapNotify)
+            {
+                XkbRefreshKeyboardMapping(&xkbEvent->map);
+                changed = true;
+            } else if (xkbEvent->any.xkb_type == XkbNewKeyboardNotify)
+            {
+                changed = true;
+            }
+        }
+    }
+
+    if (changed)
+    {
+        qDebug() << "Keyboard mapping changed";
+        keycodeCache.clear();
+        emit keymapChanged();
+    }
+}
+
 void X11Extras::x11ResetMouseAccelerationChange(QString pointerName)
 {
     int xi_opcode, event, error;
@@ -26,6 +26,8 @@
 #include <X11/extensions/XInput.h>
 #include <X11/extensions/XInput2.h>
 
+class QSocketNotifier;
+
 class X11Extras : public QObject
 {
     Q_OBJECT
@@ -63,6 +65,7 @@ class X11Extras : public QObject
     QString getWindowClass(Window window);
     unsigned long getWindowInFocus();
     int getGroup1KeySym(int virtualkey);
+    int getKeycode(const QString &keysymName);
 
     void x11ResetMouseAccelerationChange();
     void x11ResetMouseAccelerationChange(QString pointerName);
@@ -88,19 +91,29 @@ class X11Extras : public QObject
 
     static X11Extras *_instance;
 
+  signals:
+    void keymapChanged();
+
   public slots:
     QPoint getPos();
 
+  private slots:
+    void processKeymapEvents();
+
   private:
     void checkPropertyOnWin(bool windowCorrected, Window &window, Window &parent, Window &finalwindow, Window &root,
                             Window *children, Display *display, unsigned int &num_children);
     void freeDisplay();
+    void watchKeymap();
     void checkFeedback(XFeedbackState *temp, int &num_feedbacks, int &feedback_id);
     void findVirtualPtr(int num_devices, XIDeviceInfo *current_devices, XIDeviceInfo *mouse_device,
                         XIDeviceInfo *all_devices, QString pointerName);
 
     QHash<QString, QString> knownAliases;
     Display *_display;
+    QHash<QString, int> keycodeCache;
+    QSocketNotifier *keymapNotifier;
+    int xkbEventBase;
 };
 
 #endif // X11EXTRAS_H
@@ -78,8 +78,12 @@ void InputDeviceXml::readConfig(QXmlStreamReader *xml)
                         int index = xml->attributes().value("index").toString().toInt();
                         index = index - 1;
 
-                        if ((index >= 0) && (index < m_inputDevice->getJoystick_sets().size()))
-                            m_inputDevice->getJoystick_sets().value(index)->readConfig(xml);
+                        SetJoystick *set = m_inputDevice->getSetJoystick(index);
+
+                        if (set != nullptr)
+                            set->readConfig(xml);
+                        else
+                            xml->skipCurrentElement();
                     } else
                     {
                         // If none of the above, skip the element
@@ -104,7 +108,7 @@ void InputDeviceXml::readConfig(QXmlStreamReader *xml)
 
                     for (QList<SetJoystick *>::iterator setJoy = setsList.begin(); setJoy != setsList.end(); setJoy++)
                     {
-                        int i = setJoy - setsList.begin();
+                        int i = (*setJoy)->getIndex();
                         JoyAxis *axis1 = (*setJoy)->getJoyAxis(xAxis);
                         JoyAxis *axis2 = (*setJoy)->getJoyAxis(yAxis);
 
@@ -130,7 +134,7 @@ void InputDeviceXml::readConfig(QXmlStreamReader *xml)
 
                     for (QList<SetJoystick *>::iterator setJoy = setsList.begin(); setJoy != setsList.end(); setJoy++)
                     {
-                        int i = setJoy - setsList.begin();
+                        int i = (*setJoy)->getIndex();
                         VDPad *vdpad = (*setJoy)->getVDPad(vdpadIndex - 1);
 
                         if (vdpad == nullptr)
@@ -16,6 +16,7 @@
  */
 
 #include "joyaxisxml.h"
+#include "eventhandlerfactory.h"
 #include "haptictriggerps5.h"
 #include "inputdevice.h"
 #include "joyaxis.h"
@@ -109,6 +110,9 @@ void JoyAxisXml::writeConfig(QXmlStreamWriter *xml)
 
     xml->writeEndElement();
 
+    if (m_joyAxis->getGamepadOutputAxis() >= 0)
+        xml->writeTextElement("gamepadAxis", QString::number(m_joyAxis->getGamepadOutputAxis()));
+
     if (m_joyAxis->hasHapticTrigger())
     {
         HapticTriggerPs5 *haptic = m_joyAxis->getHapticTrigger();
@@ -184,6 +188,15 @@ bool JoyAxisXml::readMainConfig(QXmlStreamReader *xml)
     {
         found = true;
         m_joyAxis->setHapticTriggerMode(HapticTriggerPs5::from_string(xml->readElementText()));
+    } else if ((xml->name().toString() == "gamepadAxis") && xml->isStartElement())
+    {
+        found = true;
+        m_joyAxis->setGamepadOutputAxis(xml->readElementText().toInt());
+
+        BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+
+        if ((m_joyAxis->getGamepadOutputAxis() >= 0) && (handler != nullptr))
+            handler->createGamepadDevice();
     }
 
     return found;
@@ -17,8 +17,10 @@
 
 #include "joybuttonslotxml.h"
 #include "antkeymapper.h"
+#include "eventhandlerfactory.h"
 #include "globalvariables.h"
 #include "joybuttonslot.h"
+#include "processspawner.h"
 
 #include <QDebug>
 #include <QFileInfo>
@@ -90,7 +92,8 @@ void JoyButtonSlotXml::readConfig(QXmlStreamReader *xml)
 
                 qDebug() << "And now xml name after read next is: " << xml->name().toString();
 
-                JoyButtonSlot *minislot = new JoyButtonSlot();
+                // Owned by the button of the mix, so its events go to the devices of that controller.
+                JoyButtonSlot *minislot = new JoyButtonSlot(m_joyBtnSlot->parent());
 
                 readEachSlot(xml, minislot, profile, tempStringData, extraStringData);
 
@@ -227,6 +230,9 @@ void JoyButtonSlotXml::readEachSlot(QXmlStreamReader *xml, JoyButtonSlot *joyBtn
             } else if (temptext == "mix")
             {
                 joyBtnSlot->setSlotMode(JoyButtonSlot::JoyMix);
+            } else if (temptext == "gamepadbutton")
+            {
+                joyBtnSlot->setSlotMode(JoyButtonSlot::JoyGamepadButton);
             }
         } else
         {
@@ -276,6 +282,17 @@ void JoyButtonSlotXml::setSlotData(JoyButtonSlot *joyBtnSlot, QString profile, Q
     } else if ((joyBtnSlot->getSlotMode() == JoyButtonSlot::JoyTextEntry) && !tempStringData.isEmpty())
     {
         joyBtnSlot->setTextData(tempStringData);
+
+        BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+
+        if (handler != nullptr)
+            handler->prepareTextEntry(tempStringData);
+    } else if (joyBtnSlot->getSlotMode() == JoyButtonSlot::JoyGamepadButton)
+    {
+        BaseEventHandler *handler = EventHandlerFactory::getInstance()->handler();
+
+        if (handler != nullptr)
+            handler->createGamepadDevice();
     } else if ((joyBtnSlot->getSlotMode() == JoyButtonSlot::JoyExecute) && !tempStringData.isEmpty())
     {
         QFileInfo tempFile(tempStringData);
@@ -286,6 +303,8 @@ void JoyButtonSlotXml::setSlotData(JoyButtonSlot *joyBtnSlot, QString profile, Q
 
             if (!extraStringData.isEmpty())
                 joyBtnSlot->setExtraData(QVariant(extraStringData));
+
+            ProcessSpawner::getInstance()->prepare(tempStringData, extraStringData);
         }
     }
 }
@@ -455,6 +474,10 @@ void JoyButtonSlotXml::writeEachSlot(QXmlStreamWriter *xml, JoyButtonSlot *joyBt
     case JoyButtonSlot::JoyMix:
         xml->writeCharacters("mix");
         break;
+
+    case JoyButtonSlot::JoyGamepadButton:
+        xml->writeCharacters("gamepadbutton");
+        break;
     }
 
     xml->writeEndElement();
@@ -246,6 +246,13 @@ bool JoyButtonXml::readButtonConfig(QXmlStreamReader *xml)
 
         if (temptext == "true")
             m_joyButton->setSpringRelativeStatus(true);
+    } else if ((xml->name().toString() == "analogwheel") && xml->isStartElement())
+    {
+        found = true;
+        QString temptext = xml->readElementText();
+
+        if (temptext == "true")
+            m_joyButton->setAnalogWheel(true);
     } else if ((xml->name().toString() == "easingduration") && xml->isStartElement())
     {
         found = true;
@@ -425,6 +432,9 @@ void JoyButtonXml::writeConfig(QXmlStreamWriter *xml)
         if (m_joyButton->getWheelSpeedY() != GlobalVariables::JoyButton::DEFAULTWHEELY)
             xml->writeTextElement("wheelspeedy", QString::number(m_joyButton->getWheelSpeedY()));
 
+        if (m_joyButton->isAnalogWheel())
+            xml->writeTextElement("analogwheel", "true");
+
         if (!m_joyButton->isModifierButton())
         {
             if (m_joyButton->getChangeSetCondition() != JoyButton::SetChangeDisabled)
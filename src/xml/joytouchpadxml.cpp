@@ -0,0 +1,126 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "joytouchpadxml.h"
+
+#include "globalvariables.h"
+#include "joybuttontypes/joytouchpadbutton.h"
+#include "joytouchpad.h"
+#include "xml/joybuttonxml.h"
+
+#include <QXmlStreamReader>
+#include <QXmlStreamWriter>
+
+JoyTouchpadXml::JoyTouchpadXml(JoyTouchpad *touchpad, QObject *parent)
+    : QObject(parent)
+    , m_touchpad(touchpad)
+{
+}
+
+/**
+ * @brief Deserializes the given XML stream into the JoyTouchpad object
+ * @param[in] xml The XML stream to read from
+ */
+void JoyTouchpadXml::readConfig(QXmlStreamReader *xml)
+{
+    const QString &xmlName = GlobalVariables::JoyTouchpad::xmlName;
+
+    if (xml->isStartElement() && (xml->name().toString() == xmlName))
+    {
+        xml->readNextStartElement();
+
+        while (!xml->atEnd() && (!xml->isEndElement() && (xml->name().toString() != xmlName)))
+        {
+            if ((xml->name().toString() == "mouse") && xml->isStartElement())
+            {
+                m_touchpad->setMouseEnabled(xml->readElementText() == "true");
+            } else if ((xml->name().toString() == "scroll") && xml->isStartElement())
+            {
+                m_touchpad->setScrollEnabled(xml->readElementText() == "true");
+            } else if ((xml->name().toString() == "mouseSpeedX") && xml->isStartElement())
+            {
+                m_touchpad->setMouseSpeedX(xml->readElementText().toDouble());
+            } else if ((xml->name().toString() == "mouseSpeedY") && xml->isStartElement())
+            {
+                m_touchpad->setMouseSpeedY(xml->readElementText().toDouble());
+            } else if ((xml->name().toString() == "scrollSpeed") && xml->isStartElement())
+            {
+                m_touchpad->setScrollSpeed(xml->readElementText().toDouble());
+            } else if ((xml->name().toString() == "name") && xml->isStartElement())
+            {
+                m_touchpad->setTouchpadName(xml->readElementText());
+            } else if ((xml->name().toString() == GlobalVariables::JoyTouchpadButton::xmlName) &&
+                       xml->isStartElement())
+            {
+                int index = xml->attributes().value("index").toString().toInt();
+                JoyTouchpadButton *button = m_touchpad->getButtons()->value(index - 1);
+
+                if (button != nullptr)
+                {
+                    JoyButtonXml joyButtonXml(button);
+                    joyButtonXml.readConfig(xml);
+                } else
+                {
+                    xml->skipCurrentElement();
+                }
+            } else
+            {
+                xml->skipCurrentElement();
+            }
+
+            xml->readNextStartElement();
+        }
+    }
+}
+
+/**
+ * @brief Serializes the JoyTouchpad object into the given XML stream
+ * @param[in,out] xml The XML stream to write to
+ */
+void JoyTouchpadXml::writeConfig(QXmlStreamWriter *xml)
+{
+    if (m_touchpad->isDefault())
+        return;
+
+    xml->writeStartElement(GlobalVariables::JoyTouchpad::xmlName);
+    xml->writeAttribute("index", QString::number(m_touchpad->getRealJoyNumber()));
+
+    if (!m_touchpad->getTouchpadName().isEmpty())
+        xml->writeTextElement("name", m_touchpad->getTouchpadName());
+
+    if (m_touchpad->isMouseEnabled())
+        xml->writeTextElement("mouse", "true");
+
+    if (!m_touchpad->isScrollEnabled())
+        xml->writeTextElement("scroll", "false");
+
+    if (!qFuzzyCompare(m_touchpad->getMouseSpeedX(), GlobalVariables::JoyTouchpad::DEFAULTMOUSESPEEDX))
+        xml->writeTextElement("mouseSpeedX", QString::number(m_touchpad->getMouseSpeedX()));
+
+    if (!qFuzzyCompare(m_touchpad->getMouseSpeedY(), GlobalVariables::JoyTouchpad::DEFAULTMOUSESPEEDY))
+        xml->writeTextElement("mouseSpeedY", QString::number(m_touchpad->getMouseSpeedY()));
+
+    if (!qFuzzyCompare(m_touchpad->getScrollSpeed(), GlobalVariables::JoyTouchpad::DEFAULTSCROLLSPEED))
+        xml->writeTextElement("scrollSpeed", QString::number(m_touchpad->getScrollSpeed()));
+
+    for (int i = 0; i < JoyTouchpad::ZONE_COUNT; i++)
+    {
+        JoyButtonXml joyButtonXml(m_touchpad->getButtons()->value(i));
+        joyButtonXml.writeConfig(xml);
+    }
+
+    xml->writeEndElement();
+}
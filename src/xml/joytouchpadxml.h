@@ -0,0 +1,43 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JOYTOUCHPADXML_H
+#define JOYTOUCHPADXML_H
+
+#include <QObject>
+
+class JoyTouchpad;
+class QXmlStreamReader;
+class QXmlStreamWriter;
+
+/**
+ * @brief JoyTouchpad XML serialization/deserialization helper class
+ */
+class JoyTouchpadXml : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit JoyTouchpadXml(JoyTouchpad *touchpad, QObject *parent = nullptr);
+
+    void readConfig(QXmlStreamReader *xml);
+    void writeConfig(QXmlStreamWriter *xml);
+
+  private:
+    JoyTouchpad *m_touchpad;
+};
+
+#endif // JOYTOUCHPADXML_H
@@ -19,14 +19,17 @@
 #include "xml/joyaxisxml.h"
 #include "xml/joybuttonxml.h"
 #include "xml/joydpadxml.h"
+#include "xml/joytouchpadxml.h"
 #include <iostream>
 #include <memory>
 
+#include "globalvariables.h"
 #include "joyaxis.h"
 #include "joybuttontypes/joybutton.h"
 #include "joycontrolstick.h"
 #include "joydpad.h"
 #include "joysensor.h"
+#include "joytouchpad.h"
 #include "vdpad.h"
 
 #include "setjoystick.h"
@@ -111,6 +114,19 @@ void SetJoystickXml::readConfig(QXmlStreamReader *xml)
                     sensor->readConfig(xml);
                 else
                     xml->skipCurrentElement();
+            } else if ((xml->name().toString() == GlobalVariables::JoyTouchpad::xmlName) && xml->isStartElement())
+            {
+                int index = xml->attributes().value("index").toString().toInt();
+                JoyTouchpad *touchpad = m_setJoystick->getTouchpad(index - 1);
+
+                if (touchpad != nullptr)
+                {
+                    JoyTouchpadXml touchpadXml(touchpad);
+                    touchpadXml.readConfig(xml);
+                } else
+                {
+                    xml->skipCurrentElement();
+                }
             } else if ((xml->name().toString() == "vdpad") && xml->isStartElement())
             {
                 int index = xml->attributes().value("index").toString().toInt();
@@ -160,6 +176,12 @@ void SetJoystickXml::writeConfig(QXmlStreamWriter *xml)
         for (const auto &sensor : sensors)
             sensor->writeConfig(xml);
 
+        for (const auto &touchpad : m_setJoystick->getTouchpads())
+        {
+            JoyTouchpadXml touchpadXml(touchpad);
+            touchpadXml.writeConfig(xml);
+        }
+
         QList<VDPad *> vdpadsList = m_setJoystick->getVdpads().values();
         QListIterator<VDPad *> vdpad(vdpadsList);
         while (vdpad.hasNext())
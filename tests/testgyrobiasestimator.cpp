@@ -0,0 +1,165 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "gyrobiasestimator.h"
+
+#include <QtTest/QtTest>
+
+class TestGyroBiasEstimator : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestGyroBiasEstimator(QObject *parent = 0);
+
+  private slots:
+    void learnsOffsetAtRest();
+    void waitsForRest();
+    void ignoresRotationWithoutAccelerometer();
+    void ignoresStaleAccelerometer();
+    void ignoresMovingController();
+    void publishesOnlyNoticeableChanges();
+    void seedIsReported();
+
+  private:
+    static const int SAMPLE_MSECS = 5;
+
+    int feed(GyroBiasEstimator &estimator, unsigned int &timestamp, int msecs, const float *accel,
+             const float *gyro);
+};
+
+static const float RESTING_ACCEL[3] = {0.0f, 9.81f, 0.0f};
+static const float GYRO_OFFSET[3] = {0.01f, -0.02f, 0.005f};
+
+TestGyroBiasEstimator::TestGyroBiasEstimator(QObject *parent)
+    : QObject(parent)
+{
+}
+
+/**
+ * @brief Feeds both sensors every SAMPLE_MSECS, the accelerometer is skipped if accel is null.
+ * @returns Amount of gyroscope samples which changed the published offset.
+ */
+int TestGyroBiasEstimator::feed(GyroBiasEstimator &estimator, unsigned int &timestamp, int msecs, const float *accel,
+                                const float *gyro)
+{
+    int updates = 0;
+
+    for (int elapsed = 0; elapsed < msecs; elapsed += SAMPLE_MSECS)
+    {
+        if (accel != nullptr)
+            estimator.processAccelerometer(accel, timestamp);
+
+        if (estimator.processGyroscope(gyro, timestamp))
+            updates++;
+
+        timestamp += SAMPLE_MSECS;
+    }
+
+    return updates;
+}
+
+void TestGyroBiasEstimator::learnsOffsetAtRest()
+{
+    GyroBiasEstimator estimator;
+    unsigned int timestamp = 1000;
+    feed(estimator, timestamp, 2000, RESTING_ACCEL, GYRO_OFFSET);
+
+    double offset[3];
+    QVERIFY(estimator.hasEstimate());
+    estimator.getBias(&offset[0], &offset[1], &offset[2]);
+
+    for (int i = 0; i < 3; i++)
+        QVERIFY(std::fabs(offset[i] - GYRO_OFFSET[i]) < GyroBiasEstimator::MIN_BIAS_CHANGE);
+}
+
+void TestGyroBiasEstimator::waitsForRest()
+{
+    GyroBiasEstimator estimator;
+    unsigned int timestamp = 1000;
+    QCOMPARE(feed(estimator, timestamp, GyroBiasEstimator::MIN_STILL_MSECS - 2 * SAMPLE_MSECS, RESTING_ACCEL,
+                  GYRO_OFFSET),
+             0);
+    QVERIFY(!estimator.hasEstimate());
+}
+
+void TestGyroBiasEstimator::ignoresRotationWithoutAccelerometer()
+{
+    // A slow steady turn is indistinguishable from an offset for the gyroscope alone.
+    GyroBiasEstimator estimator;
+    unsigned int timestamp = 1000;
+    QCOMPARE(feed(estimator, timestamp, 2000, nullptr, GYRO_OFFSET), 0);
+    QVERIFY(!estimator.hasEstimate());
+}
+
+void TestGyroBiasEstimator::ignoresStaleAccelerometer()
+{
+    GyroBiasEstimator estimator;
+    unsigned int timestamp = 1000;
+    feed(estimator, timestamp, 100, RESTING_ACCEL, GYRO_OFFSET);
+    QVERIFY(!estimator.hasEstimate());
+
+    // The accelerometer stops reporting while the gyroscope goes on.
+    QCOMPARE(feed(estimator, timestamp, 2000, nullptr, GYRO_OFFSET), 0);
+    QVERIFY(!estimator.hasEstimate());
+}
+
+void TestGyroBiasEstimator::ignoresMovingController()
+{
+    GyroBiasEstimator estimator;
+    unsigned int timestamp = 1000;
+    const float shaken[2][3] = {{2.0f, 9.0f, -1.0f}, {-2.0f, 10.5f, 1.0f}};
+    int updates = 0;
+
+    for (int i = 0; i < 400; i++)
+        updates += feed(estimator, timestamp, SAMPLE_MSECS, shaken[i % 2], GYRO_OFFSET);
+
+    QCOMPARE(updates, 0);
+    QVERIFY(!estimator.hasEstimate());
+}
+
+void TestGyroBiasEstimator::publishesOnlyNoticeableChanges()
+{
+    GyroBiasEstimator estimator;
+    unsigned int timestamp = 1000;
+    feed(estimator, timestamp, 2000, RESTING_ACCEL, GYRO_OFFSET);
+    QVERIFY(estimator.hasEstimate());
+
+    // The same offset keeps arriving, the estimate does not move any more.
+    QCOMPARE(feed(estimator, timestamp, 2000, RESTING_ACCEL, GYRO_OFFSET), 0);
+
+    // Drift beyond the threshold is published again.
+    const float drifted[3] = {GYRO_OFFSET[0] + 0.004f, GYRO_OFFSET[1], GYRO_OFFSET[2]};
+    QVERIFY(feed(estimator, timestamp, 2000, RESTING_ACCEL, drifted) > 0);
+}
+
+void TestGyroBiasEstimator::seedIsReported()
+{
+    GyroBiasEstimator estimator;
+    QVERIFY(!estimator.hasEstimate());
+    estimator.seed(0.1, 0.2, 0.3);
+
+    double offset[3];
+    QVERIFY(estimator.hasEstimate());
+    estimator.getBias(&offset[0], &offset[1], &offset[2]);
+    QCOMPARE(offset[0], 0.1);
+    QCOMPARE(offset[1], 0.2);
+    QCOMPARE(offset[2], 0.3);
+}
+
+QTEST_GUILESS_MAIN(TestGyroBiasEstimator)
+#include "testgyrobiasestimator.moc"
@@ -0,0 +1,176 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "joybuttonprogram.h"
+
+#include <QtTest/QtTest>
+
+class TestJoyButtonProgram : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestJoyButtonProgram(QObject *parent = 0);
+
+  private slots:
+    void flagsFollowModes();
+    void cycleDelays();
+    void cursorWalksLikeListIterator();
+    void cursorFindsSequenceEnd();
+    void cursorKeepsItsProgram();
+
+  private:
+    static JoyButtonSlot *slotAt(int index);
+    static JoyButtonProgram build(const QVector<JoyButtonSlot::JoySlotInputAction> &modes);
+};
+
+TestJoyButtonProgram::TestJoyButtonProgram(QObject *parent)
+    : QObject(parent)
+{
+}
+
+/**
+ * @brief The program only compares slot pointers, so distinct addresses
+ *     stand in for real slots which would need the whole event system.
+ */
+JoyButtonSlot *TestJoyButtonProgram::slotAt(int index)
+{
+    static char markers[32];
+    return reinterpret_cast<JoyButtonSlot *>(&markers[index]);
+}
+
+JoyButtonProgram TestJoyButtonProgram::build(const QVector<JoyButtonSlot::JoySlotInputAction> &modes)
+{
+    QVector<JoyButtonProgram::Instruction> instructions;
+
+    for (int i = 0; i < modes.size(); i++)
+        instructions.append({modes.at(i), i, slotAt(i)});
+
+    JoyButtonProgram program;
+    program.compile(instructions);
+    return program;
+}
+
+void TestJoyButtonProgram::flagsFollowModes()
+{
+    JoyButtonProgram empty = build({});
+    QVERIFY(empty.isEmpty());
+    QVERIFY(!empty.hasFlag(JoyButtonProgram::HasSequence));
+
+    JoyButtonProgram keys = build({JoyButtonSlot::JoyKeyboard, JoyButtonSlot::JoyMouseButton});
+    QCOMPARE(keys.size(), 2);
+    QVERIFY(!keys.hasFlag(JoyButtonProgram::HasSequence));
+    QVERIFY(!keys.hasFlag(JoyButtonProgram::HasRelease));
+
+    JoyButtonProgram distance = build({JoyButtonSlot::JoyKeyboard, JoyButtonSlot::JoyDistance});
+    QVERIFY(distance.hasFlag(JoyButtonProgram::HasSequence));
+    QVERIFY(distance.hasFlag(JoyButtonProgram::HasDistance));
+
+    JoyButtonProgram mixed = build({JoyButtonSlot::JoyMix, JoyButtonSlot::JoyRelease, JoyButtonSlot::JoyCycle});
+    QVERIFY(mixed.hasFlag(JoyButtonProgram::HasMix));
+    QVERIFY(mixed.hasFlag(JoyButtonProgram::HasRelease));
+    QVERIFY(mixed.hasFlag(JoyButtonProgram::HasCycle));
+    QVERIFY(!mixed.hasFlag(JoyButtonProgram::HasSequence));
+
+    QCOMPARE(mixed.indexOf(slotAt(1)), 1);
+    QCOMPARE(mixed.indexOf(slotAt(5)), -1);
+    QCOMPARE(mixed.at(2).code, 2);
+}
+
+void TestJoyButtonProgram::cycleDelays()
+{
+    // key, pause | key | key, release
+    JoyButtonProgram program =
+        build({JoyButtonSlot::JoyKeyboard, JoyButtonSlot::JoyPause, JoyButtonSlot::JoyCycle, JoyButtonSlot::JoyKeyboard,
+               JoyButtonSlot::JoyCycle, JoyButtonSlot::JoyKeyboard, JoyButtonSlot::JoyRelease});
+
+    QVERIFY(program.delaysCycle(nullptr));
+    QVERIFY(!program.delaysCycle(slotAt(2)));
+    QVERIFY(program.delaysCycle(slotAt(4)));
+
+    // Slots which aren't part of the program never delay.
+    QVERIFY(!program.delaysCycle(slotAt(20)));
+}
+
+void TestJoyButtonProgram::cursorWalksLikeListIterator()
+{
+    JoyButtonProgram program = build({JoyButtonSlot::JoyKeyboard, JoyButtonSlot::JoyPause, JoyButtonSlot::JoyKeyboard});
+    JoyButtonProgram::Cursor cursor(program);
+
+    QVERIFY(cursor.hasNext());
+    QVERIFY(!cursor.hasPrevious());
+    QCOMPARE(cursor.next().slot, slotAt(0));
+    QCOMPARE(cursor.next().mode, JoyButtonSlot::JoyPause);
+    QCOMPARE(cursor.previous().slot, slotAt(1));
+    QCOMPARE(cursor.position(), 1);
+
+    QVERIFY(cursor.findNext(slotAt(2)));
+    QVERIFY(!cursor.hasNext());
+
+    // Searching never goes backwards, a miss leaves the cursor at the back.
+    cursor.toFront();
+    QVERIFY(cursor.findNext(slotAt(1)));
+    QVERIFY(!cursor.findNext(slotAt(0)));
+    QCOMPARE(cursor.position(), 3);
+    QVERIFY(!cursor.findNext(nullptr));
+
+    cursor.toFront();
+    QCOMPARE(cursor.position(), 0);
+    cursor.toBack();
+    QVERIFY(!cursor.hasNext());
+    QVERIFY(cursor.hasPrevious());
+}
+
+void TestJoyButtonProgram::cursorFindsSequenceEnd()
+{
+    JoyButtonProgram program =
+        build({JoyButtonSlot::JoyKeyboard, JoyButtonSlot::JoyPause, JoyButtonSlot::JoyHold, JoyButtonSlot::JoyKeyboard,
+               JoyButtonSlot::JoyRelease, JoyButtonSlot::JoyKeyboard});
+    JoyButtonProgram::Cursor cursor(program);
+
+    // Stops in front of the hold, a pause doesn't end the sequence.
+    QVERIFY(cursor.findSequenceEnd());
+    QCOMPARE(cursor.position(), 2);
+
+    // The stop in front of the cursor is found again without moving.
+    QVERIFY(cursor.findSequenceEnd());
+    QCOMPARE(cursor.position(), 2);
+
+    cursor.next();
+    QVERIFY(cursor.findSequenceEnd());
+    QCOMPARE(cursor.next().mode, JoyButtonSlot::JoyRelease);
+
+    QVERIFY(!cursor.findSequenceEnd());
+    QVERIFY(!cursor.hasNext());
+}
+
+void TestJoyButtonProgram::cursorKeepsItsProgram()
+{
+    JoyButtonProgram program = build({JoyButtonSlot::JoyKeyboard, JoyButtonSlot::JoyCycle, JoyButtonSlot::JoyKeyboard});
+    JoyButtonProgram::Cursor cursor(program);
+    cursor.next();
+
+    // The button compiles its program again while a sequence is running.
+    program.compile({{JoyButtonSlot::JoyPause, 0, slotAt(10)}});
+    QCOMPARE(program.size(), 1);
+
+    QVERIFY(cursor.hasNext());
+    QCOMPARE(cursor.next().mode, JoyButtonSlot::JoyCycle);
+    QVERIFY(cursor.findNext(slotAt(2)));
+}
+
+QTEST_GUILESS_MAIN(TestJoyButtonProgram)
+#include "testjoybuttonprogram.moc"
@@ -0,0 +1,165 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#define _USE_MATH_DEFINES
+
+#include "orientationestimator.h"
+
+#include <QtTest/QtTest>
+
+#include <cmath>
+
+class TestOrientationEstimator : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestOrientationEstimator(QObject *parent = 0);
+
+  private slots:
+    void initializesFromAccelerometer();
+    void integratesOverTimestamps();
+    void integratesSharedTimestamps();
+    void usesNominalPeriodAfterGap();
+    void followsAccelerometerWhileResting();
+    void resetForgetsOrientation();
+
+  private:
+    static const quint64 START_USECS = 1000000;
+
+    void startLevelWithoutCorrection(OrientationEstimator &estimator);
+    double tiltAngle(const OrientationEstimator &estimator);
+};
+
+static const float LEVEL[3] = {0.0f, static_cast<float>(OrientationEstimator::STANDARD_GRAVITY), 0.0f};
+static const float RESTING[3] = {0.0f, 0.0f, 0.0f};
+
+TestOrientationEstimator::TestOrientationEstimator(QObject *parent)
+    : QObject(parent)
+{
+}
+
+/**
+ * @brief Aligns the estimator with a level controller and then stores an
+ *  accelerometer sample far from gravity, so gyroscope integration is not
+ *  corrected by the accelerometer.
+ */
+void TestOrientationEstimator::startLevelWithoutCorrection(OrientationEstimator &estimator)
+{
+    const float shaken[3] = {0.0f, 30.0f, 0.0f};
+
+    estimator.setRate(200);
+    estimator.processAccelerometer(LEVEL);
+    estimator.processGyroscope(RESTING, 0, 0, 0, START_USECS);
+    estimator.processAccelerometer(shaken);
+}
+
+/**
+ * @brief Angle between the fused gravity direction and the Y axis in radians.
+ */
+double TestOrientationEstimator::tiltAngle(const OrientationEstimator &estimator)
+{
+    double x, y, z;
+    estimator.getGravity(&x, &y, &z);
+    return atan2(sqrt(x * x + z * z), y);
+}
+
+void TestOrientationEstimator::initializesFromAccelerometer()
+{
+    OrientationEstimator estimator;
+    QVERIFY(!estimator.hasOrientation());
+
+    const float tilted[3] = {static_cast<float>(OrientationEstimator::STANDARD_GRAVITY), 0.0f, 0.0f};
+    estimator.processAccelerometer(tilted);
+    QVERIFY(estimator.hasOrientation());
+    QVERIFY(std::abs(tiltAngle(estimator) - M_PI / 2) < 1e-6);
+}
+
+void TestOrientationEstimator::integratesOverTimestamps()
+{
+    // The gyroscope reports at 250 Hz although 200 Hz are expected.
+    OrientationEstimator estimator;
+    startLevelWithoutCorrection(estimator);
+
+    const float turning[3] = {0.0f, 0.0f, static_cast<float>(M_PI / 2)};
+
+    for (quint64 timestamp = START_USECS + 4000; timestamp <= START_USECS + 1000000; timestamp += 4000)
+        estimator.processGyroscope(turning, 0, 0, 0, timestamp);
+
+    QVERIFY(std::abs(tiltAngle(estimator) - M_PI / 2) < 0.01);
+}
+
+void TestOrientationEstimator::integratesSharedTimestamps()
+{
+    // Three samples per report, all with the time of the report.
+    OrientationEstimator estimator;
+    startLevelWithoutCorrection(estimator);
+
+    const float turning[3] = {0.0f, 0.0f, static_cast<float>(M_PI / 2)};
+
+    for (quint64 timestamp = START_USECS + 15000; timestamp <= START_USECS + 990000; timestamp += 15000)
+    {
+        for (int i = 0; i < 3; i++)
+            estimator.processGyroscope(turning, 0, 0, 0, timestamp);
+    }
+
+    QVERIFY(std::abs(tiltAngle(estimator) - M_PI / 2 * 0.99) < 0.01);
+}
+
+void TestOrientationEstimator::usesNominalPeriodAfterGap()
+{
+    OrientationEstimator estimator;
+    startLevelWithoutCorrection(estimator);
+
+    // The sensor was off for half a second, only one nominal period is integrated.
+    const float turning[3] = {0.0f, 0.0f, 10.0f};
+    estimator.processGyroscope(turning, 0, 0, 0, START_USECS + 500000);
+
+    QVERIFY(std::abs(tiltAngle(estimator) - 10.0 / 200) < 0.001);
+}
+
+void TestOrientationEstimator::followsAccelerometerWhileResting()
+{
+    OrientationEstimator estimator;
+    estimator.setRate(200);
+    estimator.processAccelerometer(LEVEL);
+    estimator.processGyroscope(RESTING, 0, 0, 0, START_USECS);
+
+    // Tilted by 30 degrees while the gyroscope reports no rotation.
+    const double angle = M_PI / 6;
+    const float tilted[3] = {static_cast<float>(OrientationEstimator::STANDARD_GRAVITY * sin(angle)),
+                             static_cast<float>(OrientationEstimator::STANDARD_GRAVITY * cos(angle)), 0.0f};
+    estimator.processAccelerometer(tilted);
+
+    for (quint64 timestamp = START_USECS + 5000; timestamp <= START_USECS + 10000000; timestamp += 5000)
+        estimator.processGyroscope(RESTING, 0, 0, 0, timestamp);
+
+    QVERIFY(std::abs(tiltAngle(estimator) - angle) < 0.01);
+}
+
+void TestOrientationEstimator::resetForgetsOrientation()
+{
+    OrientationEstimator estimator;
+    estimator.processAccelerometer(LEVEL);
+    QVERIFY(estimator.hasOrientation());
+
+    estimator.reset();
+    QVERIFY(!estimator.hasOrientation());
+}
+
+QTEST_GUILESS_MAIN(TestOrientationEstimator)
+#include "testorientationestimator.moc"
@@ -0,0 +1,205 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define _USE_MATH_DEFINES
+
+#include "stickresponsemap.h"
+
+#include <QtTest/QtTest>
+
+#include <cmath>
+
+class TestStickResponseMap : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestStickResponseMap(QObject *parent = 0);
+
+  private slots:
+    void emptyMapDefersToExact();
+    void directionsMatchExact();
+    void directionsNearZoneRadiiDeferToExact();
+    void distancesMatchExact();
+    void rowsBuildTheSameMap();
+
+  private:
+    static const int DEAD_ZONE = 8000;
+    static const int MAX_ZONE = 30000;
+
+    static int exactDirection(int axisXValue, int axisYValue);
+    static double exactDistance(int axisXValue, int axisYValue);
+    static StickResponseMap buildMap();
+};
+
+TestStickResponseMap::TestStickResponseMap(QObject *parent)
+    : QObject(parent)
+{
+}
+
+/**
+ * @brief Eight 45 degree zones numbered clockwise from up like the bearing
+ *     based zones of a standard mode stick.
+ */
+int TestStickResponseMap::exactDirection(int axisXValue, int axisYValue)
+{
+    double bearing = atan2(static_cast<double>(axisXValue), -static_cast<double>(axisYValue)) * 180.0 / M_PI;
+
+    if (bearing < 0.0)
+        bearing += 360.0;
+
+    return (static_cast<int>((bearing + 22.5) / 45.0) % 8) + 1;
+}
+
+/**
+ * @brief Radial distance past the dead zone of a round stick.
+ */
+double TestStickResponseMap::exactDistance(int axisXValue, int axisYValue)
+{
+    double radius = std::hypot(static_cast<double>(axisXValue), static_cast<double>(axisYValue));
+    double distance = (radius - DEAD_ZONE) / static_cast<double>(MAX_ZONE - DEAD_ZONE);
+    return qBound(0.0, distance, 1.0);
+}
+
+StickResponseMap TestStickResponseMap::buildMap()
+{
+    StickResponseMap map;
+    map.rebuild(exactDirection, exactDistance, DEAD_ZONE, MAX_ZONE, MAX_ZONE);
+    return map;
+}
+
+void TestStickResponseMap::emptyMapDefersToExact()
+{
+    StickResponseMap map;
+    int direction = 0;
+    double distance = 0.0;
+
+    QVERIFY(map.isEmpty());
+    QVERIFY(!map.lookupDirection(20000, 0, direction));
+    QVERIFY(!map.lookupDistance(20000, 0, distance));
+}
+
+void TestStickResponseMap::directionsMatchExact()
+{
+    StickResponseMap map = buildMap();
+    int answered = 0;
+
+    // A stride which isn't a multiple of the cell size hits every offset inside a cell.
+    for (int axisYValue = -32768; axisYValue <= 32767; axisYValue += 97)
+    {
+        for (int axisXValue = -32768; axisXValue <= 32767; axisXValue += 89)
+        {
+            int direction = 0;
+
+            if (map.lookupDirection(axisXValue, axisYValue, direction))
+            {
+                QCOMPARE(direction, exactDirection(axisXValue, axisYValue));
+                answered++;
+            }
+        }
+    }
+
+    // Only cells on a zone edge or near the dead zone and max zone radii are left to the exact calculation.
+    QVERIFY(answered > 0.9 * (65536 / 97) * (65536 / 89));
+}
+
+void TestStickResponseMap::directionsNearZoneRadiiDeferToExact()
+{
+    StickResponseMap map = buildMap();
+    int direction = 0;
+
+    // Straight right, far from the wedge edges.
+    QVERIFY(map.lookupDirection(20000, 0, direction));
+    QCOMPARE(direction, exactDirection(20000, 0));
+
+    for (int radius : {DEAD_ZONE, MAX_ZONE})
+    {
+        QVERIFY(!map.lookupDirection(radius - 300, 0, direction));
+        QVERIFY(!map.lookupDirection(radius, 0, direction));
+        QVERIFY(!map.lookupDirection(radius + 300, 0, direction));
+        QVERIFY(map.lookupDirection(radius + 400, 0, direction));
+    }
+}
+
+void TestStickResponseMap::distancesMatchExact()
+{
+    StickResponseMap map = buildMap();
+    int answered = 0;
+    double worst = 0.0;
+
+    for (int axisYValue = -32768; axisYValue <= 32767; axisYValue += 97)
+    {
+        for (int axisXValue = -32768; axisXValue <= 32767; axisXValue += 89)
+        {
+            double distance = 0.0;
+
+            if (map.lookupDistance(axisXValue, axisYValue, distance))
+            {
+                worst = qMax(worst, std::fabs(distance - exactDistance(axisXValue, axisYValue)));
+                answered++;
+            }
+        }
+    }
+
+    QVERIFY(answered > 0);
+    QVERIFY2(worst < 0.001, qPrintable(QString::number(worst)));
+
+    // The dead zone edge is always calculated exactly.
+    double distance = 0.0;
+    QVERIFY(!map.lookupDistance(DEAD_ZONE, 0, distance));
+}
+
+void TestStickResponseMap::rowsBuildTheSameMap()
+{
+    StickResponseMap reference = buildMap();
+    StickResponseMap map;
+    int row = 0;
+
+    while (row < StickResponseMap::GRID_NODES)
+    {
+        int direction = 0;
+        QVERIFY(!map.lookupDirection(20000, 20000, direction));
+
+        row = map.rebuildRows(exactDirection, exactDistance, DEAD_ZONE, MAX_ZONE, MAX_ZONE, row, 16);
+    }
+
+    QVERIFY(!map.isEmpty());
+
+    for (int axisYValue = -32768; axisYValue <= 32767; axisYValue += 1021)
+    {
+        for (int axisXValue = -32768; axisXValue <= 32767; axisXValue += 1019)
+        {
+            int direction = 0;
+            int referenceDirection = 0;
+            double distance = 0.0;
+            double referenceDistance = 0.0;
+
+            QCOMPARE(map.lookupDirection(axisXValue, axisYValue, direction),
+                     reference.lookupDirection(axisXValue, axisYValue, referenceDirection));
+            QCOMPARE(direction, referenceDirection);
+            QCOMPARE(map.lookupDistance(axisXValue, axisYValue, distance),
+                     reference.lookupDistance(axisXValue, axisYValue, referenceDistance));
+            QCOMPARE(distance, referenceDistance);
+        }
+    }
+
+    // Starting over discards the table until it is complete again.
+    map.rebuildRows(exactDirection, exactDistance, DEAD_ZONE, MAX_ZONE, MAX_ZONE, 0, 16);
+    QVERIFY(map.isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestStickResponseMap)
+#include "teststickresponsemap.moc"
@@ -0,0 +1,174 @@
+/* antimicrox Gamepad to KB+M event mapper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "turbophase.h"
+
+#include <QtTest/QtTest>
+
+class TestTurboPhase : public QObject
+{
+    Q_OBJECT
+
+  public:
+    TestTurboPhase(QObject *parent = 0);
+
+  private slots:
+    void fullAndEmptyDuty();
+    void periodsStartWithPress();
+    void shortPressLastsOneTick_data();
+    void shortPressLastsOneTick();
+    void shortReleaseLastsOneTick_data();
+    void shortReleaseLastsOneTick();
+    void mirroredDutyTogglesAlike();
+
+  private:
+    /**
+     * @brief Key events produced by running turbo for a number of ticks.
+     */
+    struct Run
+    {
+        int presses = 0;
+        int releases = 0;
+        int pressedTicks = 0;
+        int longestPress = 0;   // Ticks
+        int longestRelease = 0; // Ticks
+    };
+
+    static Run run(double periodsPerTick, double duty, int ticks);
+};
+
+TestTurboPhase::TestTurboPhase(QObject *parent)
+    : QObject(parent)
+{
+}
+
+TestTurboPhase::Run TestTurboPhase::run(double periodsPerTick, double duty, int ticks)
+{
+    Run result;
+    double phase = 0.0;
+    bool pressed = false;
+    int sameState = 0;
+
+    for (int i = 0; i < ticks; i++)
+    {
+        bool press = TurboPhase::advance(phase, periodsPerTick, duty, pressed);
+
+        if (press != pressed)
+        {
+            if (press)
+                result.presses++;
+            else
+                result.releases++;
+
+            sameState = 0;
+            pressed = press;
+        }
+
+        sameState++;
+
+        if (pressed)
+        {
+            result.pressedTicks++;
+            result.longestPress = qMax(result.longestPress, sameState);
+        } else
+        {
+            result.longestRelease = qMax(result.longestRelease, sameState);
+        }
+    }
+
+    return result;
+}
+
+void TestTurboPhase::fullAndEmptyDuty()
+{
+    Run full = run(0.3, 1.0, 100);
+    QCOMPARE(full.presses, 1);
+    QCOMPARE(full.releases, 0);
+
+    Run empty = run(0.3, 0.0, 100);
+    QCOMPARE(empty.presses, 0);
+    QCOMPARE(empty.pressedTicks, 0);
+}
+
+void TestTurboPhase::periodsStartWithPress()
+{
+    // 80 ms period with 5 ms ticks. The last tick starts the 101st period.
+    Run result = run(0.0625, 0.5, 1600);
+
+    QCOMPARE(result.presses, 101);
+    QCOMPARE(result.releases, 100);
+    QCOMPARE(result.pressedTicks, 800);
+}
+
+void TestTurboPhase::shortPressLastsOneTick_data()
+{
+    QTest::addColumn<double>("periodsPerTick");
+    QTest::addColumn<double>("duty");
+
+    QTest::newRow("press of a fifth tick") << 0.3 << 0.06;
+    QTest::newRow("press of half a tick") << 0.4 << 0.2;
+    QTest::newRow("period of a little over two ticks") << 0.45 << 0.1;
+}
+
+void TestTurboPhase::shortPressLastsOneTick()
+{
+    QFETCH(double, periodsPerTick);
+    QFETCH(double, duty);
+
+    Run result = run(periodsPerTick, duty, 1000);
+
+    QVERIFY(result.presses > 0);
+    QCOMPARE(result.longestPress, 1);
+    QVERIFY(qAbs(result.presses - result.releases) <= 1);
+}
+
+void TestTurboPhase::shortReleaseLastsOneTick_data()
+{
+    QTest::addColumn<double>("periodsPerTick");
+    QTest::addColumn<double>("duty");
+
+    QTest::newRow("release of a fifth tick") << 0.3 << 0.94;
+    QTest::newRow("release of half a tick") << 0.4 << 0.8;
+    QTest::newRow("period of a little over two ticks") << 0.45 << 0.9;
+}
+
+void TestTurboPhase::shortReleaseLastsOneTick()
+{
+    QFETCH(double, periodsPerTick);
+    QFETCH(double, duty);
+
+    Run result = run(periodsPerTick, duty, 1000);
+
+    QVERIFY(result.releases > 0);
+    QCOMPARE(result.longestRelease, 1);
+    QVERIFY(qAbs(result.presses - result.releases) <= 1);
+}
+
+void TestTurboPhase::mirroredDutyTogglesAlike()
+{
+    for (double duty : {0.06, 0.2, 0.35})
+    {
+        Run shortPress = run(0.3, duty, 1000);
+        Run shortRelease = run(0.3, 1.0 - duty, 1000);
+
+        QVERIFY(qAbs(shortPress.presses - shortRelease.releases) <= 1);
+        QVERIFY(qAbs(shortPress.releases - shortRelease.presses) <= 1);
+    }
+}
+
+QTEST_GUILESS_MAIN(TestTurboPhase)
+#include "testturbophase.moc"